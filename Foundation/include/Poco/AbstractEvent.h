@@ -46,6 +46,7 @@
 #include "Poco/ActiveResult.h"
 #include "Poco/ActiveMethod.h"
 #include "Poco/Mutex.h"
+#include "Poco/CopyOnWriteStrategy.h"
 
 
 namespace Poco {
@@ -230,17 +231,17 @@ public:
 		/// invoked prior to removal). If one of the delegates throws an exception, 
 		/// the notify method is immediately aborted and the exception is propagated
 		/// to the caller.
+		///
+		/// notify() neither locks the event's mutex, nor copies the list of
+		/// delegates. Instead, adding or removing a delegate copies the list.
 	{
-		Poco::ScopedLockWithUnlock<TMutex> lock(_mutex);
-		
 		if (!_enabled) return;
 		
 		// thread-safeness: 
-		// copy should be faster and safer than blocking until
-		// execution ends
-		TStrategy strategy(_strategy);
-		lock.unlock();
-		strategy.notify(pSender, args);
+		// the strategy is never modified once published, so
+		// it can be used without locking or copying it
+		typename CopyOnWriteStrategy<TStrategy, TDelegate>::Reader reader(_strategy);
+		reader.strategy().notify(pSender, args);
 	}
 
 	ActiveResult<TArgs> notifyAsync(const void* pSender, const TArgs& args)
@@ -265,7 +266,7 @@ public:
 			// make a copy of the strategy here to guarantee that
 			// between notifyAsync and the execution of the method no changes can occur
 				
-			params.ptrStrat = SharedPtr<TStrategy>(new TStrategy(_strategy));
+			params.ptrStrat = SharedPtr<TStrategy>(_strategy.copy());
 			params.enabled  = _enabled;
 		}
 		ActiveResult<TArgs> result = _executeAsync(params);
@@ -304,7 +305,7 @@ public:
 		/// Checks if any delegates are registered at the delegate.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		return _strategy.empty();
+		return _strategy.current()->empty();
 	}
 
 protected:
@@ -336,9 +337,9 @@ protected:
 		return retArgs;
 	}
 
-	TStrategy _strategy; /// The strategy used to notify observers.
-	bool      _enabled;  /// Stores if an event is enabled. Notfies on disabled events have no effect
-	                     /// but it is possible to change the observers.
+	CopyOnWriteStrategy<TStrategy, TDelegate> _strategy; /// The strategy used to notify observers.
+	volatile bool _enabled; /// Stores if an event is enabled. Notfies on disabled events have no effect
+	                        /// but it is possible to change the observers.
 	mutable TMutex _mutex;
 
 private:
@@ -523,17 +524,17 @@ public:
 		/// invoked prior to removal). If one of the delegates throws an exception, 
 		/// the notify method is immediately aborted and the exception is propagated
 		/// to the caller.
+		///
+		/// notify() neither locks the event's mutex, nor copies the list of
+		/// delegates. Instead, adding or removing a delegate copies the list.
 	{
-		Poco::ScopedLockWithUnlock<TMutex> lock(_mutex);
-		
 		if (!_enabled) return;
 		
 		// thread-safeness: 
-		// copy should be faster and safer than blocking until
-		// execution ends
-		TStrategy strategy(_strategy);
-		lock.unlock();
-		strategy.notify(pSender);
+		// the strategy is never modified once published, so
+		// it can be used without locking or copying it
+		typename CopyOnWriteStrategy<TStrategy, TDelegate>::Reader reader(_strategy);
+		reader.strategy().notify(pSender);
 	}
 
 	ActiveResult<void> notifyAsync(const void* pSender)
@@ -558,7 +559,7 @@ public:
 			// make a copy of the strategy here to guarantee that
 			// between notifyAsync and the execution of the method no changes can occur
 				
-			params.ptrStrat = SharedPtr<TStrategy>(new TStrategy(_strategy));
+			params.ptrStrat = SharedPtr<TStrategy>(_strategy.copy());
 			params.enabled  = _enabled;
 		}
 		ActiveResult<void> result = _executeAsync(params);
@@ -597,7 +598,7 @@ public:
 		/// Checks if any delegates are registered at the delegate.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		return _strategy.empty();
+		return _strategy.current()->empty();
 	}
 
 protected:
@@ -627,9 +628,9 @@ protected:
 		return;
 	}
 
-	TStrategy _strategy; /// The strategy used to notify observers.
-	bool      _enabled;  /// Stores if an event is enabled. Notfies on disabled events have no effect
-	                     /// but it is possible to change the observers.
+	CopyOnWriteStrategy<TStrategy, TDelegate> _strategy; /// The strategy used to notify observers.
+	volatile bool _enabled; /// Stores if an event is enabled. Notfies on disabled events have no effect
+	                        /// but it is possible to change the observers.
 	mutable TMutex _mutex;
 
 private:
@@ -0,0 +1,111 @@
+//
+// AbstractNotificationQueue.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  AbstractNotificationQueue
+//
+// Definition of the AbstractNotificationQueue class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_AbstractNotificationQueue_INCLUDED
+#define Foundation_AbstractNotificationQueue_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Notification.h"
+
+
+namespace Poco {
+
+
+class Foundation_API AbstractNotificationQueue
+	/// The common interface of NotificationQueue and
+	/// LockFreeNotificationQueue.
+	///
+	/// Classes that can be configured to use either kind of
+	/// queue hold an AbstractNotificationQueue, created as a
+	/// NotificationQueueAdapter for the actual queue class.
+{
+public:
+	AbstractNotificationQueue();
+		/// Creates the AbstractNotificationQueue.
+
+	virtual ~AbstractNotificationQueue();
+		/// Destroys the AbstractNotificationQueue.
+
+	virtual void enqueueNotification(Notification::Ptr pNotification) = 0;
+		/// Enqueues the given notification by adding it to
+		/// the end of the queue (FIFO). If the queue is bounded
+		/// and full, waits until there is room in the queue.
+
+	virtual bool tryEnqueueNotification(Notification::Ptr pNotification) = 0;
+		/// Enqueues the given notification if there is room
+		/// in the queue. Returns true if the notification has
+		/// been enqueued, or false if the queue is full.
+
+	virtual Notification* waitDequeueNotification() = 0;
+		/// Dequeues the next pending notification, waiting
+		/// for one if the queue is empty. Returns 0 (null)
+		/// if wakeUpAll() has been called by another thread.
+
+	virtual Notification* waitDequeueNotification(long milliseconds) = 0;
+		/// Dequeues the next pending notification, waiting up
+		/// to the specified time for one if the queue is empty.
+		/// Returns 0 (null) if no notification is available, or
+		/// if wakeUpAll() has been called by another thread.
+
+	virtual void wakeUpAll() = 0;
+		/// Wakes up all threads that wait for a notification.
+
+	virtual bool empty() const = 0;
+		/// Returns true iff the queue is empty.
+
+	virtual int size() const = 0;
+		/// Returns the number of notifications in the queue.
+
+	virtual void clear() = 0;
+		/// Removes all notifications from the queue.
+
+	virtual bool hasIdleThreads() const = 0;
+		/// Returns true if the queue has at least one thread
+		/// waiting for a notification.
+
+private:
+	AbstractNotificationQueue(const AbstractNotificationQueue&);
+	AbstractNotificationQueue& operator = (const AbstractNotificationQueue&);
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_AbstractNotificationQueue_INCLUDED
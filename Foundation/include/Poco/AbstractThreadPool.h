@@ -0,0 +1,107 @@
+//
+// AbstractThreadPool.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  AbstractThreadPool
+//
+// Definition of the AbstractThreadPool class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_AbstractThreadPool_INCLUDED
+#define Foundation_AbstractThreadPool_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Thread.h"
+
+
+namespace Poco {
+
+
+class Runnable;
+
+
+class Foundation_API AbstractThreadPool
+	/// The interface used by TaskManager and TCPServerDispatcher
+	/// to start their runnables, so that they can run either in a
+	/// ThreadPool or in a WorkStealingThreadPool.
+	///
+	/// The two kinds of pool differ in what happens if all threads
+	/// are busy: a ThreadPool throws a NoThreadAvailableException
+	/// once it has reached its maximum capacity, while a
+	/// WorkStealingThreadPool queues the runnable until one of its
+	/// fixed number of worker threads becomes available.
+	///
+	/// Use a ThreadPoolAdapter to obtain an AbstractThreadPool
+	/// for an existing pool.
+{
+public:
+	AbstractThreadPool();
+		/// Creates the AbstractThreadPool.
+
+	virtual ~AbstractThreadPool();
+		/// Destroys the AbstractThreadPool.
+
+	virtual int capacity() const = 0;
+		/// Returns the maximum number of runnables that can run
+		/// concurrently, i.e., the maximum number of threads of a
+		/// ThreadPool, or the number of worker threads of a
+		/// WorkStealingThreadPool.
+
+	virtual void start(Runnable& target, const std::string& name) = 0;
+		/// Runs the target in a thread of the pool, which is
+		/// given the name while it runs the target.
+		///
+		/// If all threads are busy, either throws a
+		/// NoThreadAvailableException or queues the target,
+		/// depending on the kind of pool.
+
+	virtual void startWithPriority(Thread::Priority priority, Runnable& target, const std::string& name) = 0;
+		/// Runs the target in a thread of the pool, like start(),
+		/// with the thread's priority set to the given value.
+
+	virtual void joinAll() = 0;
+		/// Waits until all runnables started in the pool
+		/// have completed.
+		///
+		/// Must not be called from a thread of the pool.
+
+private:
+	AbstractThreadPool(const AbstractThreadPool&);
+	AbstractThreadPool& operator = (const AbstractThreadPool&);
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_AbstractThreadPool_INCLUDED
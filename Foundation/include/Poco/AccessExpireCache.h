@@ -64,8 +64,11 @@ class AccessExpireCache: public AbstractCache<TKey, TValue, AccessExpireStrategy
 	/// when "get" is invoked.
 {
 public:
-	AccessExpireCache(Timestamp::TimeDiff expire = 600000): 
-		AbstractCache<TKey, TValue, AccessExpireStrategy<TKey, TValue>, TMutex, TEventMutex>(AccessExpireStrategy<TKey, TValue>(expire))
+	AccessExpireCache(Timestamp::TimeDiff expire = 600000, std::size_t maxPurge = 0): 
+		AbstractCache<TKey, TValue, AccessExpireStrategy<TKey, TValue>, TMutex, TEventMutex>(AccessExpireStrategy<TKey, TValue>(expire, maxPurge))
+		/// Creates the AccessExpireCache. Entries expire after expire milliseconds.
+		/// If maxPurge is not 0, a single cache operation removes at most
+		/// maxPurge expired entries (see ExpireStrategy).
 	{
 	}
 
@@ -61,9 +61,12 @@ class AccessExpireStrategy: public ExpireStrategy<TKey, TValue>
 	/// An AccessExpireStrategy implements time and access based expiration of cache entries
 {
 public:
-	AccessExpireStrategy(Timestamp::TimeDiff expireTimeInMilliSec): ExpireStrategy<TKey, TValue>(expireTimeInMilliSec)
+	AccessExpireStrategy(Timestamp::TimeDiff expireTimeInMilliSec, std::size_t maxPurge = 0): 
+		ExpireStrategy<TKey, TValue>(expireTimeInMilliSec, maxPurge)
 		/// Create an expire strategy. Note that the smallest allowed caching time is 25ms.
 		/// Anything lower than that is not useful with current operating systems.
+		///
+		/// See ExpireStrategy for the meaning of maxPurge.
 	{
 	}
 
@@ -74,14 +77,9 @@ public:
 	void onGet(const void*, const TKey& key)
 	{
 		// get triggers an update to the expiration time
-		typename ExpireStrategy<TKey, TValue>::Iterator it = this->_keys.find(key);
-		if (it != this->_keys.end())
+		if (this->_keys.find(key) != this->_keys.end())
 		{
-			this->_keyIndex.erase(it->second);
-			Timestamp now;
-			typename ExpireStrategy<TKey, TValue>::IndexIterator itIdx =
-				this->_keyIndex.insert(typename ExpireStrategy<TKey, TValue>::TimeIndex::value_type(now, key));
-			it->second = itIdx;
+			this->touch(key);
 		}
 	}
 };
@@ -46,6 +46,7 @@
 #include "Poco/ActiveStarter.h"
 #include "Poco/ActiveRunnable.h"
 #include "Poco/NotificationQueue.h"
+#include "Poco/AbstractNotificationQueue.h"
 
 
 namespace Poco {
@@ -100,6 +101,14 @@ public:
 		/// Creates the ActiveDispatcher and sets
 		/// the priority of its thread.
 
+	ActiveDispatcher(Thread::Priority prio, std::size_t queueCapacity);
+		/// Creates the ActiveDispatcher, sets the priority
+		/// of its thread and uses a LockFreeNotificationQueue
+		/// with the given capacity for queueing method invocations.
+		///
+		/// If the queue is full, start() waits until the
+		/// dispatcher thread has made room in the queue.
+
 	virtual ~ActiveDispatcher();
 		/// Destroys the ActiveDispatcher.
 
@@ -114,8 +123,8 @@ protected:
 	void stop();
 
 private:
-	Thread            _thread;
-	NotificationQueue _queue;
+	Thread                     _thread;
+	AbstractNotificationQueue* _pQueue;
 };
 
 
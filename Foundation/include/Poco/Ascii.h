@@ -41,6 +41,7 @@
 
 
 #include "Poco/Foundation.h"
+#include <cstddef>
 
 
 namespace Poco {
@@ -61,6 +62,10 @@ class Foundation_API Ascii
 	/// causing assertions or inconsistent results (depending
 	/// upon the current locale) on bytes outside the ASCII range,
 	/// as may be produced by Ascii::isSpace(), etc.
+	///
+	/// The buffer functions toLowerInPlace(), toUpperInPlace()
+	/// and icompare() process 16 characters at a time if SSE2
+	/// is available, and 8 characters at a time otherwise.
 {
 public:
 	enum CharacterProperties
@@ -134,6 +139,23 @@ public:
 		/// If the given character is a lowercase character,
 		/// return its uppercase counterpart, otherwise return
 		/// the character.
+
+	static void toLowerInPlace(char* str, std::size_t length);
+		/// Replaces all uppercase characters in the given
+		/// buffer with their lowercase counterparts.
+
+	static void toUpperInPlace(char* str, std::size_t length);
+		/// Replaces all lowercase characters in the given
+		/// buffer with their uppercase counterparts.
+
+	static int icompare(const char* str1, const char* str2, std::size_t length);
+		/// Compares the first length characters of both buffers,
+		/// ignoring case. Returns -1, 0 or 1 if str1 is less than,
+		/// equal to or greater than str2, respectively.
+		///
+		/// Characters are compared as char values after converting
+		/// them to lowercase, which gives the same results as a
+		/// character-by-character comparison using toLower().
 		
 private:
 	static const int CHARACTER_PROPERTIES[128];
@@ -220,7 +242,7 @@ inline bool Ascii::isUpper(int ch)
 
 inline int Ascii::toLower(int ch)
 {
-	if (isUpper(ch))
+	if (static_cast<UInt32>(ch) - 'A' < 26)
 		return ch + 32;
 	else
 		return ch;
@@ -229,7 +251,7 @@ inline int Ascii::toLower(int ch)
 
 inline int Ascii::toUpper(int ch)
 {
-	if (isLower(ch))
+	if (static_cast<UInt32>(ch) - 'a' < 26)
 		return ch - 32;
 	else
 		return ch;
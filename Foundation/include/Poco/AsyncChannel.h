@@ -46,6 +46,7 @@
 #include "Poco/Mutex.h"
 #include "Poco/Runnable.h"
 #include "Poco/NotificationQueue.h"
+#include "Poco/AbstractNotificationQueue.h"
 
 
 namespace Poco {
@@ -101,18 +102,28 @@ public:
 		///    * highest
 		///
 		/// The "priority" property is set-only.
+		///
+		/// The "lockFreeQueue" property, if set to "true", makes the
+		/// channel use a LockFreeNotificationQueue instead of a
+		/// NotificationQueue. This reduces contention if many
+		/// threads log simultaneously. If the queue is full, log()
+		/// waits until the background thread has made room in the queue.
+		/// The property can only be changed while the channel
+		/// is closed; otherwise an IllegalStateException is thrown.
+		/// The "lockFreeQueue" property is set-only.
 
 protected:
 	~AsyncChannel();
 	void run();
 	void setPriority(const std::string& value);
+	void setLockFreeQueue(const std::string& value);
 		
 private:
 	Channel*  _pChannel;
 	Thread    _thread;
 	FastMutex _threadMutex;
 	FastMutex _channelMutex;
-	NotificationQueue _queue;
+	AbstractNotificationQueue* _pQueue;
 };
 
 
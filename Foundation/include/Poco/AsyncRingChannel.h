@@ -0,0 +1,211 @@
+//
+// AsyncRingChannel.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Logging
+// Module:  AsyncRingChannel
+//
+// Definition of the AsyncRingChannel class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_AsyncRingChannel_INCLUDED
+#define Foundation_AsyncRingChannel_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Channel.h"
+#include "Poco/Message.h"
+#include "Poco/Thread.h"
+#include "Poco/Mutex.h"
+#include "Poco/Event.h"
+#include "Poco/Condition.h"
+#include "Poco/Runnable.h"
+#include "Poco/AtomicCounter.h"
+#include <vector>
+
+
+namespace Poco {
+
+
+class Foundation_API AsyncRingChannel: public Channel, public Runnable
+	/// A channel that uses a separate thread for logging, like
+	/// AsyncChannel, but passes the messages to the background
+	/// thread through a preallocated ring buffer of message slots.
+	///
+	/// A logging thread copies the message, claims a free slot
+	/// with an atomic operation and swaps the copy into the slot.
+	/// log() therefore does not acquire a mutex unless the ring
+	/// buffer is full.
+	///
+	/// The background thread passes the messages to the target
+	/// channel in batches, using Channel::logBatch(). A FileChannel,
+	/// for example, writes each batch with a single write operation.
+	///
+	/// What log() does if the ring buffer is full is determined
+	/// by the "overflow" property (see setProperty()). The number
+	/// of messages that have been discarded is available from dropped().
+{
+public:
+	AsyncRingChannel(Channel* pChannel = 0, std::size_t capacity = 1024, Thread::Priority prio = Thread::PRIO_NORMAL);
+		/// Creates the AsyncRingChannel with a ring buffer for
+		/// the given number of messages and connects it to the
+		/// given channel. The capacity is rounded up to the next
+		/// power of two.
+
+	void setChannel(Channel* pChannel);
+		/// Connects the AsyncRingChannel to the given target channel.
+		/// All messages will be forwarded to this channel.
+
+	Channel* getChannel() const;
+		/// Returns the target channel.
+
+	void open();
+		/// Opens the channel and creates the
+		/// background logging thread.
+
+	void close();
+		/// Writes all pending messages to the target channel,
+		/// then closes the channel and stops the background
+		/// logging thread.
+
+	void log(const Message& msg);
+		/// Copies the message into the ring buffer for
+		/// processing by the background thread.
+
+	void setProperty(const std::string& name, const std::string& value);
+		/// Sets or changes a configuration property.
+		///
+		/// The "channel" property allows setting the target
+		/// channel via the LoggingRegistry.
+		/// The "channel" property is set-only.
+		///
+		/// The "priority" property allows setting the thread
+		/// priority. The following values are supported:
+		///    * lowest
+		///    * low
+		///    * normal (default)
+		///    * high
+		///    * highest
+		///
+		/// The "priority" property is set-only.
+		///
+		/// The "capacity" property specifies the number of message
+		/// slots in the ring buffer. The property can only be changed
+		/// while the channel is closed; otherwise an IllegalStateException
+		/// is thrown. It must not be changed while other threads may
+		/// log to the channel.
+		///
+		/// The "overflow" property specifies what log() does if the
+		/// ring buffer is full. The following values are supported:
+		///    * block: wait until the background thread has made room (default).
+		///      A blocked thread yields a few times, then sleeps until
+		///      the background thread has passed messages to the target
+		///      channel.
+		///    * drop: discard the message
+		///    * a priority name (e.g., "warning"): discard messages with a
+		///      lower priority, and wait for room for all other messages.
+		///
+		/// The "batchSize" property specifies the maximum number of
+		/// messages passed to the target channel at once (default 64).
+
+	std::string getProperty(const std::string& name) const;
+		/// Returns the value of the property with the given name.
+		/// See setProperty() for a description of the supported
+		/// properties.
+
+	std::size_t capacity() const;
+		/// Returns the number of message slots in the ring buffer.
+
+	int dropped() const;
+		/// Returns the number of messages that have been discarded
+		/// because the ring buffer was full.
+
+protected:
+	~AsyncRingChannel();
+	void run();
+	void init(std::size_t capacity);
+	std::size_t ready() const;
+	void dispatch(std::size_t count);
+	void wakeUp();
+	void waitForSpace(UInt32 pos);
+	void setPriority(const std::string& value);
+	void setOverflow(const std::string& value);
+
+private:
+	enum
+	{
+		SPIN_COUNT = 16
+	};
+
+	typedef std::vector<Message> MessageVec;
+	typedef std::vector<UInt32> SequenceVec;
+
+	Channel*        _pChannel;
+	Thread          _thread;
+	FastMutex       _threadMutex;
+	FastMutex       _channelMutex;
+	MessageVec      _messages;
+	SequenceVec     _sequences;
+	UInt32          _mask;
+	volatile UInt32 _enqueuePos;
+	volatile UInt32 _dequeuePos;
+	volatile UInt32 _waiting;
+	volatile UInt32 _blocked;
+	volatile UInt32 _open;
+	volatile bool   _stop;
+	Event           _ready;
+	FastMutex       _spaceMutex;
+	Condition       _spaceAvailable;
+	int             _overflowPriority;
+	std::size_t     _batchSize;
+	AtomicCounter   _dropped;
+};
+
+
+//
+// inlines
+//
+inline std::size_t AsyncRingChannel::capacity() const
+{
+	return _messages.size();
+}
+
+
+inline int AsyncRingChannel::dropped() const
+{
+	return _dropped.value();
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_AsyncRingChannel_INCLUDED
@@ -0,0 +1,264 @@
+//
+// AtomicOps.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  AtomicOps
+//
+// Definition of the AtomicOps class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_AtomicOps_INCLUDED
+#define Foundation_AtomicOps_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/AtomicCounter.h"
+#if POCO_OS == POCO_OS_WINDOWS_NT
+	#include "Poco/UnWindows.h"
+#elif POCO_OS == POCO_OS_MAC_OS_X
+	#include <libkern/OSAtomic.h>
+#endif
+
+
+namespace Poco {
+
+
+class Foundation_API AtomicOps
+	/// This class provides the atomic operations on 32-bit
+	/// integers and pointers that are needed to implement
+	/// lock-free data structures, like LockFreeNotificationQueue.
+	///
+	/// compareAndSwap() is a full memory barrier. load() has
+	/// acquire semantics, store() has release semantics.
+	///
+	/// On platforms without support for atomic operations,
+	/// the operations are implemented using a global mutex.
+{
+public:
+	static bool compareAndSwap(volatile UInt32* p, UInt32 expected, UInt32 desired);
+		/// Sets *p to desired if *p equals expected, and returns true.
+		/// Otherwise, leaves *p unchanged and returns false.
+
+	static bool compareAndSwap(void* volatile* p, void* expected, void* desired);
+		/// Sets *p to desired if *p equals expected, and returns true.
+		/// Otherwise, leaves *p unchanged and returns false.
+
+	static UInt32 load(const volatile UInt32* p);
+		/// Returns the value of *p.
+
+	static void* load(void* const volatile* p);
+		/// Returns the value of *p.
+
+	static void store(volatile UInt32* p, UInt32 value);
+		/// Sets *p to value.
+
+	static void store(void* volatile* p, void* value);
+		/// Sets *p to value.
+
+	static void barrier();
+		/// Issues a full memory barrier.
+};
+
+
+//
+// inlines
+//
+#if POCO_OS == POCO_OS_WINDOWS_NT
+
+
+inline bool AtomicOps::compareAndSwap(volatile UInt32* p, UInt32 expected, UInt32 desired)
+{
+	return static_cast<UInt32>(InterlockedCompareExchange(reinterpret_cast<volatile LONG*>(p), static_cast<LONG>(desired), static_cast<LONG>(expected))) == expected;
+}
+
+
+inline bool AtomicOps::compareAndSwap(void* volatile* p, void* expected, void* desired)
+{
+	return InterlockedCompareExchangePointer(p, desired, expected) == expected;
+}
+
+
+inline UInt32 AtomicOps::load(const volatile UInt32* p)
+{
+	return *p; // volatile reads have acquire semantics with Visual C++
+}
+
+
+inline void* AtomicOps::load(void* const volatile* p)
+{
+	return *p;
+}
+
+
+inline void AtomicOps::store(volatile UInt32* p, UInt32 value)
+{
+	*p = value; // volatile writes have release semantics with Visual C++
+}
+
+
+inline void AtomicOps::store(void* volatile* p, void* value)
+{
+	*p = value;
+}
+
+
+inline void AtomicOps::barrier()
+{
+	MemoryBarrier();
+}
+
+
+#elif POCO_OS == POCO_OS_MAC_OS_X
+
+
+inline bool AtomicOps::compareAndSwap(volatile UInt32* p, UInt32 expected, UInt32 desired)
+{
+	return OSAtomicCompareAndSwap32Barrier(static_cast<int32_t>(expected), static_cast<int32_t>(desired), reinterpret_cast<volatile int32_t*>(p));
+}
+
+
+inline bool AtomicOps::compareAndSwap(void* volatile* p, void* expected, void* desired)
+{
+	return OSAtomicCompareAndSwapPtrBarrier(expected, desired, p);
+}
+
+
+inline UInt32 AtomicOps::load(const volatile UInt32* p)
+{
+	UInt32 value = *p;
+	OSMemoryBarrier();
+	return value;
+}
+
+
+inline void* AtomicOps::load(void* const volatile* p)
+{
+	void* value = *p;
+	OSMemoryBarrier();
+	return value;
+}
+
+
+inline void AtomicOps::store(volatile UInt32* p, UInt32 value)
+{
+	OSMemoryBarrier();
+	*p = value;
+}
+
+
+inline void AtomicOps::store(void* volatile* p, void* value)
+{
+	OSMemoryBarrier();
+	*p = value;
+}
+
+
+inline void AtomicOps::barrier()
+{
+	OSMemoryBarrier();
+}
+
+
+#elif defined(POCO_HAVE_GCC_ATOMICS)
+
+
+inline bool AtomicOps::compareAndSwap(volatile UInt32* p, UInt32 expected, UInt32 desired)
+{
+	return __sync_bool_compare_and_swap(p, expected, desired);
+}
+
+
+inline bool AtomicOps::compareAndSwap(void* volatile* p, void* expected, void* desired)
+{
+	return __sync_bool_compare_and_swap(p, expected, desired);
+}
+
+
+inline UInt32 AtomicOps::load(const volatile UInt32* p)
+{
+#if defined(__ATOMIC_ACQUIRE)
+	return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#else
+	UInt32 value = *p;
+	__sync_synchronize();
+	return value;
+#endif
+}
+
+
+inline void* AtomicOps::load(void* const volatile* p)
+{
+#if defined(__ATOMIC_ACQUIRE)
+	return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#else
+	void* value = *p;
+	__sync_synchronize();
+	return value;
+#endif
+}
+
+
+inline void AtomicOps::store(volatile UInt32* p, UInt32 value)
+{
+#if defined(__ATOMIC_RELEASE)
+	__atomic_store_n(p, value, __ATOMIC_RELEASE);
+#else
+	__sync_synchronize();
+	*p = value;
+#endif
+}
+
+
+inline void AtomicOps::store(void* volatile* p, void* value)
+{
+#if defined(__ATOMIC_RELEASE)
+	__atomic_store_n(p, value, __ATOMIC_RELEASE);
+#else
+	__sync_synchronize();
+	*p = value;
+#endif
+}
+
+
+inline void AtomicOps::barrier()
+{
+	__sync_synchronize();
+}
+
+
+#endif // POCO_OS
+
+
+} // namespace Poco
+
+
+#endif // Foundation_AtomicOps_INCLUDED
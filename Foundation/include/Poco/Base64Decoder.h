@@ -43,6 +43,7 @@
 #include "Poco/Foundation.h"
 #include "Poco/UnbufferedStreamBuf.h"
 #include <istream>
+#include <string>
 
 
 namespace Poco {
@@ -64,6 +65,7 @@ public:
 	
 private:
 	int readFromDevice();
+	std::streamsize readBlockFromDevice(char* buffer, std::streamsize length);
 	int readOne();
 
 	unsigned char   _group[3];
@@ -71,9 +73,6 @@ private:
 	int             _groupIndex;
 	std::streambuf& _buf;
 	
-	static unsigned char IN_ENCODING[256];
-	static bool          IN_ENCODING_INIT;
-	
 private:
 	Base64DecoderBuf(const Base64DecoderBuf&);
 	Base64DecoderBuf& operator = (const Base64DecoderBuf&);
@@ -114,6 +113,24 @@ public:
 	Base64Decoder(std::istream& istr);
 	~Base64Decoder();
 
+	static std::size_t decodedLength(std::size_t length);
+		/// Returns the maximum number of bytes decode() writes
+		/// for length characters of base64-encoded data.
+
+	static std::size_t decode(const char* buffer, std::size_t length, char* output);
+		/// Decodes length characters of base64-encoded data from
+		/// buffer, and writes the result to output, which must
+		/// have room for decodedLength(length) bytes.
+		/// Whitespace in the encoded data is ignored.
+		///
+		/// Returns the number of bytes written. Throws a 
+		/// DataFormatException if the data contains an invalid
+		/// character, or ends with an incomplete group.
+
+	static std::string decode(const std::string& data);
+		/// Returns the decoded base64-encoded data.
+		/// Throws a DataFormatException if the data is not valid.
+
 private:
 	Base64Decoder(const Base64Decoder&);
 	Base64Decoder& operator = (const Base64Decoder&);
@@ -43,6 +43,7 @@
 #include "Poco/Foundation.h"
 #include "Poco/UnbufferedStreamBuf.h"
 #include <ostream>
+#include <string>
 
 
 namespace Poco {
@@ -78,6 +79,9 @@ public:
 	
 private:
 	int writeToDevice(char c);
+	std::streamsize writeBlockToDevice(const char* buffer, std::streamsize length);
+	int writeGroup();
+	static void encodeGroups(const unsigned char* buffer, std::size_t groups, char* output);
 
 	unsigned char   _group[3];
 	int             _groupLength;
@@ -88,6 +92,7 @@ private:
 	static const unsigned char OUT_ENCODING[64];
 	
 	friend class Base64DecoderBuf;
+	friend class Base64Encoder;
 
 	Base64EncoderBuf(const Base64EncoderBuf&);
 	Base64EncoderBuf& operator = (const Base64EncoderBuf&);
@@ -132,6 +137,21 @@ public:
 	Base64Encoder(std::ostream& ostr);
 	~Base64Encoder();
 
+	static std::size_t encodedLength(std::size_t length);
+		/// Returns the number of characters encode() writes
+		/// for length bytes of data.
+
+	static std::size_t encode(const char* buffer, std::size_t length, char* output);
+		/// Base64-encodes length bytes from buffer, and writes
+		/// the result, including padding, to output, which must
+		/// have room for encodedLength(length) characters.
+		/// No line breaks are inserted.
+		///
+		/// Returns the number of characters written.
+
+	static std::string encode(const std::string& data);
+		/// Returns the base64 encoding of data, without line breaks.
+
 private:
 	Base64Encoder(const Base64Encoder&);
 	Base64Encoder& operator = (const Base64Encoder&);
@@ -0,0 +1,143 @@
+//
+// BinaryFileChannel.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryFileChannel
+//
+// Definition of the BinaryFileChannel class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_BinaryFileChannel_INCLUDED
+#define Foundation_BinaryFileChannel_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/FileChannel.h"
+#include "Poco/Mutex.h"
+#include <map>
+
+
+namespace Poco {
+
+
+class Foundation_API BinaryFileChannel: public FileChannel
+	/// A FileChannel that writes messages in a compact
+	/// binary format, instead of writing only the message text.
+	///
+	/// Every message is written as a record that contains all
+	/// fields of the Message (except for its parameters), so no
+	/// Formatter is required. The message source, thread name and
+	/// source file name are written only once per log file, and
+	/// referred to by a number in the message records.
+	/// Log files written by BinaryFileChannel can be read
+	/// with BinaryLogReader, and formatted afterwards, for
+	/// example with a PatternFormatter (see the logdecode sample).
+	///
+	/// Rotation, archiving, purging and buffering work
+	/// exactly as with FileChannel, and are controlled by the
+	/// same properties. Every log file starts with the strings
+	/// that have been defined so far, so that every log file
+	/// can be read on its own. To get the full performance
+	/// benefit, set the flush property to false, or set a bufferSize.
+	///
+	/// A log file consists of records, each of them followed by
+	/// a line ending. A record starts with a marker byte, which
+	/// is followed by the size of the rest of the record (not
+	/// including the line ending). A string record (marker byte 0xB2)
+	/// contains the number and the value of a string. A message
+	/// record (marker byte 0xB1) contains:
+	///   * the timestamp (microseconds since the Unix epoch)
+	///   * the priority, as a single byte
+	///   * the process ID
+	///   * the thread ID
+	///   * the message source, thread name and message text
+	///   * the source file name (empty if not available)
+	///   * the source line number
+	///
+	/// Integers are written as variable-length integers, in
+	/// little-endian order and with seven bits per byte (see
+	/// BinaryWriter::write7BitEncoded()). A string is written as a
+	/// number n, followed by n/2 characters if n is even, or
+	/// referring to the string record with the number n/2 if n is odd.
+	/// Fields that may be added in future versions will be
+	/// appended to the records, so readers must skip any data
+	/// after the known fields.
+	///
+	/// Log files may also contain text lines starting with '#',
+	/// which are written by the interval-based rotation strategies.
+{
+public:
+	BinaryFileChannel();
+		/// Creates the BinaryFileChannel.
+
+	BinaryFileChannel(const std::string& path);
+		/// Creates the BinaryFileChannel for a file with the given path.
+
+	void log(const Message& msg);
+		/// Writes the binary record for the given message to the file.
+
+	void logBatch(const Message* pMessages, std::size_t count);
+		/// Writes the binary records for the given messages to
+		/// the file, using a single write operation.
+
+	enum
+	{
+		MESSAGE_RECORD = 0xB1,
+		STRING_RECORD  = 0xB2,
+		MAX_STRINGS    = 1024
+	};
+
+protected:
+	~BinaryFileChannel();
+	void onFileOpened(LogFile& file);
+	void encodeRecord(const Message& msg, std::string& record);
+	void appendString(const std::string& value, std::string& message, std::string& record);
+	void appendFile(const char* file, std::string& message, std::string& record);
+	UInt32 defineString(const char* value, std::size_t length, std::string& record);
+
+private:
+	typedef std::map<std::string, UInt32> StringMap;
+
+	std::string _record;
+	std::string _message;
+	std::string _fileName;
+	StringMap   _strings;
+	std::string _definitions;
+	FastMutex   _recordMutex;
+	FastMutex   _stringMutex;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_BinaryFileChannel_INCLUDED
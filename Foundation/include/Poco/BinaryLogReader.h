@@ -0,0 +1,114 @@
+//
+// BinaryLogReader.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryLogReader
+//
+// Definition of the BinaryLogReader class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_BinaryLogReader_INCLUDED
+#define Foundation_BinaryLogReader_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Message.h"
+#include <istream>
+#include <vector>
+#include <set>
+
+
+namespace Poco {
+
+
+class Foundation_API BinaryLogReader
+	/// This class reads the messages written
+	/// by a BinaryFileChannel from a stream.
+	///
+	/// Example:
+	///     Poco::FileInputStream istr("app.blog");
+	///     Poco::BinaryLogReader reader(istr);
+	///     Poco::PatternFormatter formatter("%Y-%m-%d %H:%M:%S.%i [%p] %s: %t");
+	///     Poco::Message msg;
+	///     while (reader.read(msg))
+	///     {
+	///         std::string text;
+	///         formatter.format(msg, text);
+	///         std::cout << text << std::endl;
+	///     }
+{
+public:
+	BinaryLogReader(std::istream& istr);
+		/// Creates the BinaryLogReader, using the given stream.
+
+	~BinaryLogReader();
+		/// Destroys the BinaryLogReader.
+
+	bool read(Message& msg);
+		/// Reads the next message from the stream.
+		///
+		/// Returns false if the end of the stream has been
+		/// reached. Throws a DataFormatException if the stream
+		/// does not contain a valid binary log record.
+		///
+		/// String records are remembered and used for the
+		/// following message records. Text lines starting with '#',
+		/// which are written by the interval-based rotation
+		/// strategies, are skipped.
+		///
+		/// The source file name set in the message remains
+		/// valid as long as the BinaryLogReader exists.
+
+protected:
+	int readRecord();
+	void readMessage(Message& msg);
+	void readStringRecord();
+
+private:
+	BinaryLogReader();
+	BinaryLogReader(const BinaryLogReader&);
+	BinaryLogReader& operator = (const BinaryLogReader&);
+
+	typedef std::vector<std::string> StringVec;
+	typedef std::set<std::string> StringSet;
+
+	std::istream& _istr;
+	std::string   _record;
+	StringVec     _strings;
+	StringSet     _files;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_BinaryLogReader_INCLUDED
@@ -0,0 +1,105 @@
+//
+// CachePurger.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Cache
+// Module:  CachePurger
+//
+// Definition of the CachePurger class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_CachePurger_INCLUDED
+#define Foundation_CachePurger_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Timer.h"
+
+
+namespace Poco {
+
+
+template <class TCache>
+class CachePurger
+	/// A CachePurger periodically removes expired entries from
+	/// a cache (e.g., an ExpireCache or AccessExpireCache),
+	/// using a background thread.
+	///
+	/// Caches normally only remove expired entries when they
+	/// are modified or accessed. For caches that are not
+	/// accessed for a long time, this means that expired
+	/// entries (and the memory they use) are kept around.
+	/// A CachePurger calls forceReplace() on the cache in
+	/// regular intervals, which also keeps the cost of
+	/// removing expired entries out of the threads using
+	/// the cache.
+	///
+	/// The cache must outlive the CachePurger.
+	///
+	/// Example:
+	///     ExpireCache<int, std::string> cache(60000);
+	///     CachePurger<ExpireCache<int, std::string> > purger(cache, 5000);
+{
+public:
+	CachePurger(TCache& cache, long interval):
+		_cache(cache),
+		_timer(interval, interval)
+		/// Creates the CachePurger and starts purging the
+		/// cache every interval milliseconds.
+	{
+		_timer.start(TimerCallback<CachePurger>(*this, &CachePurger::onTimer));
+	}
+
+	~CachePurger()
+		/// Stops the background thread and destroys the CachePurger.
+	{
+		_timer.stop();
+	}
+
+	void onTimer(Timer& timer)
+	{
+		_cache.forceReplace();
+	}
+
+private:
+	CachePurger();
+	CachePurger(const CachePurger&);
+	CachePurger& operator = (const CachePurger&);
+
+	TCache& _cache;
+	Timer   _timer;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_CachePurger_INCLUDED
@@ -44,6 +44,7 @@
 #include "Poco/Configurable.h"
 #include "Poco/Mutex.h"
 #include "Poco/RefCountedObject.h"
+#include <cstddef>
 
 
 namespace Poco {
@@ -78,6 +79,14 @@ public:
 		///
 		/// If the channel has not been opened yet, the log()
 		/// method will open it.
+
+	virtual void logBatch(const Message* pMessages, std::size_t count);
+		/// Logs count messages, starting at pMessages.
+		///
+		/// The default implementation calls log() for
+		/// every message. Channels that can handle multiple
+		/// messages more efficiently at once, like FileChannel,
+		/// override it.
 		
 	void setProperty(const std::string& name, const std::string& value);
 		/// Throws a PropertyNotSupportedException.
@@ -47,7 +47,7 @@ namespace Poco {
 
 
 class Foundation_API Checksum
-	/// This class calculates CRC-32 or Adler-32 checksums
+	/// This class calculates CRC-32, CRC-32C or Adler-32 checksums
 	/// for arbitrary data.
 	///
 	/// A cyclic redundancy check (CRC) is a type of hash function, which is used to produce a 
@@ -58,13 +58,20 @@ class Foundation_API Checksum
 	/// It is almost as reliable as a 32-bit cyclic redundancy check for protecting against 
 	/// accidental modification of data, such as distortions occurring during a transmission, 
 	/// but is significantly faster to calculate in software.
-	
+	///
+	/// CRC-32C uses the Castagnoli polynomial, which has better error 
+	/// detection properties than the polynomial used by CRC-32. CRC-32C is
+	/// used by iSCSI, SCTP, ext4 and Btrfs, among others. On x86 CPUs supporting 
+	/// SSE 4.2, CRC-32C is calculated using the CPU's CRC32 instruction,
+	/// which is many times faster than calculating CRC-32 in software.
+	/// Whether the CPU supports SSE 4.2 is determined at runtime.
 {
 public:
 	enum Type
 	{
 		TYPE_ADLER32 = 0,
-		TYPE_CRC32
+		TYPE_CRC32,
+		TYPE_CRC32C
 	};
 
 	Checksum();
@@ -0,0 +1,128 @@
+//
+// ChecksumStream.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  ChecksumStream
+//
+// Definition of classes ChecksumInputStream and ChecksumOutputStream.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_ChecksumStream_INCLUDED
+#define Foundation_ChecksumStream_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/BufferedStreamBuf.h"
+#include "Poco/Checksum.h"
+#include <istream>
+#include <ostream>
+
+
+namespace Poco {
+
+
+class Foundation_API ChecksumBuf: public BufferedStreamBuf
+	/// This streambuf computes a checksum of all data going
+	/// through it.
+{
+public:
+	ChecksumBuf(Checksum& checksum);
+	ChecksumBuf(Checksum& checksum, std::istream& istr);
+	ChecksumBuf(Checksum& checksum, std::ostream& ostr);
+	~ChecksumBuf();	
+	int readFromDevice(char* buffer, std::streamsize length);
+	int writeToDevice(const char* buffer, std::streamsize length);
+	void close();
+
+private:
+	Checksum&     _checksum;
+	std::istream* _pIstr;
+	std::ostream* _pOstr;
+	static const int BUFFER_SIZE;
+};
+
+
+class Foundation_API ChecksumIOS: public virtual std::ios
+	/// The base class for ChecksumInputStream and ChecksumOutputStream.
+	///
+	/// This class is needed to ensure the correct initialization
+	/// order of the stream buffer and base classes.
+{
+public:
+	ChecksumIOS(Checksum& checksum);
+	ChecksumIOS(Checksum& checksum, std::istream& istr);
+	ChecksumIOS(Checksum& checksum, std::ostream& ostr);
+	~ChecksumIOS();
+	ChecksumBuf* rdbuf();
+
+protected:
+	ChecksumBuf _buf;
+};
+
+
+class Foundation_API ChecksumInputStream: public ChecksumIOS, public std::istream
+	/// This istream computes a checksum of
+	/// all the data read from it, using
+	/// a Checksum object.
+	///
+	/// Example:
+	///     Poco::Checksum checksum(Poco::Checksum::TYPE_CRC32C);
+	///     Poco::ChecksumInputStream istr(checksum, fileStream);
+	///     Poco::StreamCopier::copyStream(istr, ostr);
+	///     Poco::UInt32 crc = checksum.checksum();
+{
+public:
+	ChecksumInputStream(Checksum& checksum, std::istream& istr);
+	~ChecksumInputStream();
+};
+
+
+class Foundation_API ChecksumOutputStream: public ChecksumIOS, public std::ostream
+	/// This ostream computes a checksum of
+	/// all the data passing through it,
+	/// using a Checksum object.
+	/// To ensure that all data has been incorporated
+	/// into the checksum, call close() or flush() before 
+	/// you obtain the checksum from the Checksum object.
+{
+public:
+	ChecksumOutputStream(Checksum& checksum);
+	ChecksumOutputStream(Checksum& checksum, std::ostream& ostr);
+	~ChecksumOutputStream();
+	void close();
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ChecksumStream_INCLUDED
@@ -0,0 +1,83 @@
+//
+// ConcurrentAccessExpireLRUCache.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Cache
+// Module:  ConcurrentAccessExpireLRUCache
+//
+// Definition of the ConcurrentAccessExpireLRUCache class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_ConcurrentAccessExpireLRUCache_INCLUDED
+#define Foundation_ConcurrentAccessExpireLRUCache_INCLUDED
+
+
+#include "Poco/ConcurrentCache.h"
+
+
+namespace Poco {
+
+
+template <
+	class TKey,
+	class TValue,
+	class TMutex = FastMutex,
+	class TEventMutex = FastMutex,
+	class THash = Hash<TKey>
+>
+class ConcurrentAccessExpireLRUCache: public ConcurrentCache<TKey, TValue, TMutex, TEventMutex, THash>
+	/// A ConcurrentAccessExpireLRUCache combines approximated LRU caching and
+	/// time based expire caching (see ConcurrentCache), and can be used instead
+	/// of an AccessExpireLRUCache that is accessed by many threads.
+	/// It caches entries for a fixed time period (per default 10 minutes)
+	/// after they have last been accessed, but also limits the size of the
+	/// cache (per default: 1024).
+{
+public:
+	ConcurrentAccessExpireLRUCache(long cacheSize = 1024, Timestamp::TimeDiff expire = 600000, int shards = 0):
+		ConcurrentCache<TKey, TValue, TMutex, TEventMutex, THash>(cacheSize, ConcurrentAccessExpireLRUCache::EXPIRE_AFTER_ACCESS, expire, shards)
+	{
+	}
+
+	~ConcurrentAccessExpireLRUCache()
+	{
+	}
+
+private:
+	ConcurrentAccessExpireLRUCache(const ConcurrentAccessExpireLRUCache& aCache);
+	ConcurrentAccessExpireLRUCache& operator = (const ConcurrentAccessExpireLRUCache& aCache);
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ConcurrentAccessExpireLRUCache_INCLUDED
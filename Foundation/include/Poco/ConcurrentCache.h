@@ -0,0 +1,494 @@
+//
+// ConcurrentCache.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Cache
+// Module:  ConcurrentCache
+//
+// Definition of the ConcurrentCache class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_ConcurrentCache_INCLUDED
+#define Foundation_ConcurrentCache_INCLUDED
+
+
+#include "Poco/KeyValueArgs.h"
+#include "Poco/Mutex.h"
+#include "Poco/Exception.h"
+#include "Poco/FIFOEvent.h"
+#include "Poco/EventArgs.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Timestamp.h"
+#include "Poco/OpenHashMap.h"
+#include "Poco/Hash.h"
+#include <vector>
+#include <set>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+template <
+	class TKey,
+	class TValue,
+	class TMutex = FastMutex,
+	class TEventMutex = FastMutex,
+	class THash = Hash<TKey>
+>
+class ConcurrentCache
+	/// A ConcurrentCache is a cache with a fixed maximum size, optional
+	/// time based expiration, and an interface compatible to AbstractCache,
+	/// which scales with the number of threads using it.
+	///
+	/// The cache is divided into a number of shards, each of which
+	/// holds part of the entries and has its own mutex. The shard of an
+	/// entry is determined by the hash value of its key, so that threads
+	/// accessing different keys rarely have to wait for each other.
+	///
+	/// Every shard holds up to size/shards entries. If a shard is
+	/// full, an entry is replaced using the CLOCK algorithm, which
+	/// approximates LRU replacement: get() marks an entry as
+	/// recently used. To find an entry to replace, the shard's
+	/// entries are visited round robin; recently used entries get a
+	/// second chance (the mark is cleared), and the first entry that
+	/// has not been used since it has last been visited is replaced.
+	/// Unlike with LRUStrategy, get() therefore does not have to
+	/// modify any lists.
+	///
+	/// Entries can expire a given time after they have been added
+	/// (like with ExpireStrategy) or after they have last been
+	/// accessed (like with AccessExpireStrategy). Expired entries are
+	/// removed when they are accessed, when they are found while
+	/// looking for an entry to replace, and by size(), getAllKeys()
+	/// and forceReplace().
+	///
+	/// The Add, Update, Remove, Get and Clear events are only fired if
+	/// enabled with enableEvents(), so that a cache nobody listens to
+	/// does not access the (shared) events. Events are fired while
+	/// the shard's mutex is locked. Unlike AbstractCache, the strategy
+	/// is fixed and cannot be extended by registering for events.
+	///
+	/// Keys must be supported by THash (see Hash), and comparable
+	/// for equality.
+{
+public:
+	FIFOEvent<const KeyValueArgs<TKey, TValue >, TEventMutex > Add;
+	FIFOEvent<const KeyValueArgs<TKey, TValue >, TEventMutex > Update;
+	FIFOEvent<const TKey, TEventMutex>                         Remove;
+	FIFOEvent<const TKey, TEventMutex>                         Get;
+	FIFOEvent<const EventArgs, TEventMutex>                    Clear;
+
+	typedef std::set<TKey> KeySet;
+
+	enum ExpireMode
+	{
+		EXPIRE_NEVER,        /// entries do not expire
+		EXPIRE_AFTER_ADD,    /// entries expire a given time after they have been added or updated
+		EXPIRE_AFTER_ACCESS  /// entries expire a given time after they have last been accessed
+	};
+
+	ConcurrentCache(long size = 1024, ExpireMode mode = EXPIRE_NEVER, Timestamp::TimeDiff expire = 600000, int shards = 0):
+		_mode(mode),
+		_expire(expire*1000),
+		_events(false)
+		/// Creates the ConcurrentCache for the given number of entries.
+		///
+		/// If mode is not EXPIRE_NEVER, entries expire after
+		/// expire milliseconds (at least 25 ms).
+		///
+		/// The number of shards is rounded up to a power of two.
+		/// If shards is 0, a suitable number of shards (up to 16)
+		/// is chosen, so that every shard holds at least 32 entries.
+	{
+		if (size < 1) throw InvalidArgumentException("size must be > 0");
+		if (mode != EXPIRE_NEVER && expire < 25) throw InvalidArgumentException("expireTime must be at least 25 ms");
+		if (shards < 0) throw InvalidArgumentException("shards must not be negative");
+
+		std::size_t n = 1;
+		if (shards == 0)
+		{
+			while (n < 16 && static_cast<long>(n*64) <= size) n *= 2;
+		}
+		else
+		{
+			while (n < static_cast<std::size_t>(shards)) n *= 2;
+		}
+		std::size_t capacity = (static_cast<std::size_t>(size) + n - 1)/n;
+		_shards.reserve(n);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			_shards.push_back(new Shard(capacity));
+		}
+		_mask = n - 1;
+	}
+
+	virtual ~ConcurrentCache()
+	{
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			delete *it;
+		}
+	}
+
+	void add(const TKey& key, const TValue& val)
+		/// Adds the key value pair to the cache.
+		/// If for the key already an entry exists, it will be overwritten.
+	{
+		SharedPtr<TValue> pVal(new TValue(val));
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		doAdd(shard, key, pVal, false);
+	}
+
+	void update(const TKey& key, const TValue& val)
+		/// Adds the key value pair to the cache.
+		/// If for the key already an entry exists, it will be overwritten.
+		/// The difference to add is that no remove or add events are thrown in this case,
+		/// just an Update is thrown.
+	{
+		SharedPtr<TValue> pVal(new TValue(val));
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		doAdd(shard, key, pVal, true);
+	}
+
+	void add(const TKey& key, SharedPtr<TValue > val)
+		/// Adds the key value pair to the cache. Note that adding a NULL SharedPtr will fail!
+		/// If for the key already an entry exists, it will be overwritten, ie. first a remove event
+		/// is thrown, then a add event
+	{
+		if (val.isNull()) throw NullPointerException();
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		doAdd(shard, key, val, false);
+	}
+
+	void update(const TKey& key, SharedPtr<TValue > val)
+		/// Adds the key value pair to the cache. Note that adding a NULL SharedPtr will fail!
+		/// If for the key already an entry exists, it will be overwritten.
+		/// The difference to add is that no remove or add events are thrown in this case,
+		/// just an Update is thrown.
+	{
+		if (val.isNull()) throw NullPointerException();
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		doAdd(shard, key, val, true);
+	}
+
+	void remove(const TKey& key)
+		/// Removes an entry from the cache. If the entry is not found,
+		/// the remove is ignored.
+	{
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		typename Index::Iterator it = shard.index.find(key);
+		if (it != shard.index.end()) doRemove(shard, it->second);
+	}
+
+	bool has(const TKey& key) const
+		/// Returns true if the cache contains a value for the key.
+	{
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		typename Index::Iterator it = shard.index.find(key);
+		return it != shard.index.end() && (_mode == EXPIRE_NEVER || shard.entries[it->second].expires > now());
+	}
+
+	SharedPtr<TValue> get(const TKey& key)
+		/// Returns a SharedPtr of the value. The SharedPointer will remain valid
+		/// even when cache replacement removes the element.
+		/// If for the key no value exists, an empty SharedPtr is returned.
+	{
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		typename Index::Iterator it = shard.index.find(key);
+		if (it == shard.index.end()) return SharedPtr<TValue>();
+
+		std::size_t i = it->second;
+		Entry& entry = shard.entries[i];
+		if (_events) Get.notify(this, key);
+		if (_mode != EXPIRE_NEVER)
+		{
+			Timestamp::TimeVal ts = now();
+			if (entry.expires <= ts)
+			{
+				doRemove(shard, i);
+				return SharedPtr<TValue>();
+			}
+			if (_mode == EXPIRE_AFTER_ACCESS) entry.expires = ts + _expire;
+		}
+		entry.referenced = true;
+		return entry.value;
+	}
+
+	void clear()
+		/// Removes all elements from the cache.
+	{
+		if (_events)
+		{
+			static EventArgs _emptyArgs;
+			Clear.notify(this, _emptyArgs);
+		}
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			Shard& shard = **it;
+			typename TMutex::ScopedLock lock(shard.mutex);
+			shard.clear();
+		}
+	}
+
+	std::size_t size()
+		/// Returns the number of cached elements.
+	{
+		forceReplace();
+		std::size_t result = 0;
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			Shard& shard = **it;
+			typename TMutex::ScopedLock lock(shard.mutex);
+			result += shard.index.size();
+		}
+		return result;
+	}
+
+	void forceReplace()
+		/// Removes all expired entries.
+	{
+		if (_mode == EXPIRE_NEVER) return;
+
+		Timestamp::TimeVal ts = now();
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			Shard& shard = **it;
+			typename TMutex::ScopedLock lock(shard.mutex);
+			for (std::size_t i = 0; i < shard.entries.size(); ++i)
+			{
+				if (shard.entries[i].used && shard.entries[i].expires <= ts) doRemove(shard, i);
+			}
+		}
+	}
+
+	std::set<TKey> getAllKeys()
+		/// Returns a copy of all keys stored in the cache.
+	{
+		forceReplace();
+		std::set<TKey> result;
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			Shard& shard = **it;
+			typename TMutex::ScopedLock lock(shard.mutex);
+			for (typename Index::ConstIterator itIdx = shard.index.begin(); itIdx != shard.index.end(); ++itIdx)
+			{
+				result.insert(itIdx->first);
+			}
+		}
+		return result;
+	}
+
+	void enableEvents(bool enable = true)
+		/// Enables or disables firing the Add, Update, Remove,
+		/// Get and Clear events. Events are disabled by default.
+	{
+		_events = enable;
+	}
+
+	bool eventsEnabled() const
+		/// Returns true if events are enabled.
+	{
+		return _events;
+	}
+
+	std::size_t capacity() const
+		/// Returns the maximum number of entries, which
+		/// may be slightly more than the size given
+		/// to the constructor.
+	{
+		return _shards.size()*_shards[0]->entries.size();
+	}
+
+	std::size_t shards() const
+		/// Returns the number of shards.
+	{
+		return _shards.size();
+	}
+
+protected:
+	struct Entry
+	{
+		Entry():
+			key(),
+			expires(0),
+			referenced(false),
+			used(false)
+		{
+		}
+
+		TKey               key;
+		SharedPtr<TValue>  value;
+		Timestamp::TimeVal expires;
+		bool               referenced;
+		bool               used;
+	};
+
+	typedef OpenHashMap<TKey, std::size_t, THash> Index;
+
+	struct Shard
+	{
+		Shard(std::size_t capacity):
+			entries(capacity),
+			index(capacity),
+			hand(0)
+		{
+			clear();
+		}
+
+		void clear()
+		{
+			for (std::size_t i = 0; i < entries.size(); ++i)
+			{
+				entries[i] = Entry();
+			}
+			index.clear();
+			free.clear();
+			for (std::size_t i = entries.size(); i > 0; --i)
+			{
+				free.push_back(i - 1);
+			}
+			hand = 0;
+		}
+
+		std::vector<Entry>       entries;
+		Index                    index;
+		std::vector<std::size_t> free;
+		std::size_t              hand;
+		TMutex                   mutex;
+	};
+
+	typedef std::vector<Shard*> ShardVec;
+
+	Shard& shardFor(const TKey& key) const
+	{
+		std::size_t h = _hash(key);
+		// OpenHashMap uses the upper bits of the (mixed) hash value
+		return *_shards[(h ^ (h >> 16)) & _mask];
+	}
+
+	static Timestamp::TimeVal now()
+	{
+		return Timestamp().epochMicroseconds();
+	}
+
+	void doAdd(Shard& shard, const TKey& key, SharedPtr<TValue>& val, bool update)
+	{
+		Timestamp::TimeVal ts = _mode != EXPIRE_NEVER ? now() : 0;
+		Timestamp::TimeVal expires = ts + _expire;
+		typename Index::Iterator it = shard.index.find(key);
+		if (it != shard.index.end())
+		{
+			if (update)
+			{
+				if (_events)
+				{
+					KeyValueArgs<TKey, TValue> args(key, *val);
+					Update.notify(this, args);
+				}
+				Entry& entry = shard.entries[it->second];
+				entry.value = val;
+				entry.expires = expires;
+				entry.referenced = true;
+				return;
+			}
+			doRemove(shard, it->second);
+		}
+		if (_events)
+		{
+			KeyValueArgs<TKey, TValue> args(key, *val);
+			Add.notify(this, args);
+		}
+		if (shard.free.empty()) evict(shard, ts);
+		std::size_t i = shard.free.back();
+		shard.free.pop_back();
+		Entry& entry = shard.entries[i];
+		entry.key        = key;
+		entry.value      = val;
+		entry.expires    = expires;
+		entry.referenced = false;
+		entry.used       = true;
+		shard.index.insert(typename Index::ValueType(key, i));
+	}
+
+	void doRemove(Shard& shard, std::size_t i)
+	{
+		Entry& entry = shard.entries[i];
+		if (_events) Remove.notify(this, entry.key);
+		shard.index.erase(entry.key);
+		entry.value      = SharedPtr<TValue>();
+		entry.referenced = false;
+		entry.used       = false;
+		shard.free.push_back(i);
+	}
+
+	void evict(Shard& shard, Timestamp::TimeVal ts)
+		/// Removes an expired or not recently used entry.
+	{
+		for (;;)
+		{
+			std::size_t i = shard.hand;
+			if (++shard.hand == shard.entries.size()) shard.hand = 0;
+			Entry& entry = shard.entries[i];
+			if (!entry.used) continue;
+			if (!entry.referenced || (_mode != EXPIRE_NEVER && entry.expires <= ts))
+			{
+				doRemove(shard, i);
+				return;
+			}
+			entry.referenced = false;
+		}
+	}
+
+private:
+	ConcurrentCache(const ConcurrentCache& aCache);
+	ConcurrentCache& operator = (const ConcurrentCache& aCache);
+
+	ShardVec            _shards;
+	std::size_t         _mask;
+	ExpireMode          _mode;
+	Timestamp::TimeDiff _expire;
+	volatile bool       _events;
+	THash               _hash;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ConcurrentCache_INCLUDED
@@ -0,0 +1,81 @@
+//
+// ConcurrentLRUCache.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Cache
+// Module:  ConcurrentLRUCache
+//
+// Definition of the ConcurrentLRUCache class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_ConcurrentLRUCache_INCLUDED
+#define Foundation_ConcurrentLRUCache_INCLUDED
+
+
+#include "Poco/ConcurrentCache.h"
+
+
+namespace Poco {
+
+
+template <
+	class TKey,
+	class TValue,
+	class TMutex = FastMutex,
+	class TEventMutex = FastMutex,
+	class THash = Hash<TKey>
+>
+class ConcurrentLRUCache: public ConcurrentCache<TKey, TValue, TMutex, TEventMutex, THash>
+	/// A ConcurrentLRUCache approximates Least Recently Used caching
+	/// (see ConcurrentCache), and can be used instead of an LRUCache
+	/// that is accessed by many threads. The default size for a cache
+	/// is 1024 entries.
+{
+public:
+	ConcurrentLRUCache(long size = 1024, int shards = 0):
+		ConcurrentCache<TKey, TValue, TMutex, TEventMutex, THash>(size, ConcurrentLRUCache::EXPIRE_NEVER, 600000, shards)
+	{
+	}
+
+	~ConcurrentLRUCache()
+	{
+	}
+
+private:
+	ConcurrentLRUCache(const ConcurrentLRUCache& aCache);
+	ConcurrentLRUCache& operator = (const ConcurrentLRUCache& aCache);
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ConcurrentLRUCache_INCLUDED
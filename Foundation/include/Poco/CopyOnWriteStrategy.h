@@ -0,0 +1,226 @@
+//
+// CopyOnWriteStrategy.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Events
+// Module:  CopyOnWriteStrategy
+//
+// Definition of the CopyOnWriteStrategy class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_CopyOnWriteStrategy_INCLUDED
+#define Foundation_CopyOnWriteStrategy_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/AtomicOps.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Mutex.h"
+#include <vector>
+
+
+namespace Poco {
+
+
+template <class TStrategy, class TDelegate>
+class CopyOnWriteStrategy
+	/// CopyOnWriteStrategy holds the notification strategy
+	/// of an AbstractEvent.
+	///
+	/// The current strategy is never modified. Adding or removing
+	/// a delegate creates a modified copy of the strategy, which
+	/// then replaces the current one. Sending a notification
+	/// therefore neither needs to lock the event's mutex, nor to
+	/// copy the strategy; it only has to keep the strategy
+	/// alive while the delegates are invoked (see Reader).
+	///
+	/// A replaced strategy may still be used by notifications
+	/// in progress. It is deleted as soon as no notification is in
+	/// progress: either by the change that replaces it, or by the
+	/// Reader of the last notification in progress.
+	///
+	/// add(), remove(), clear(), current() and copy() must be called
+	/// with the event's mutex locked.
+{
+public:
+	class Reader
+		/// Reader gives a notifying thread access to the
+		/// current strategy, and keeps the strategy alive
+		/// until the Reader is destroyed.
+	{
+	public:
+		Reader(CopyOnWriteStrategy& holder):
+			_holder(holder)
+		{
+			++_holder._readers;
+			_pStrategy = static_cast<TStrategy*>(AtomicOps::load(&_holder._pCurrent));
+		}
+
+		~Reader()
+		{
+			if (--_holder._readers == 0 && AtomicOps::load(&_holder._hasRetired))
+			{
+				_holder.deleteRetired();
+			}
+		}
+
+		TStrategy& strategy()
+		{
+			return *_pStrategy;
+		}
+
+	private:
+		Reader();
+		Reader(const Reader&);
+		Reader& operator = (const Reader&);
+
+		CopyOnWriteStrategy& _holder;
+		TStrategy*           _pStrategy;
+	};
+
+	CopyOnWriteStrategy():
+		_pCurrent(new TStrategy),
+		_hasRetired(0)
+	{
+	}
+
+	CopyOnWriteStrategy(const TStrategy& strat):
+		_pCurrent(new TStrategy(strat)),
+		_hasRetired(0)
+	{
+	}
+
+	~CopyOnWriteStrategy()
+	{
+		delete current();
+		for (typename StrategyVec::iterator it = _retired.begin(); it != _retired.end(); ++it)
+		{
+			delete *it;
+		}
+	}
+
+	void add(const TDelegate& delegate)
+	{
+		TStrategy* pStrategy = copy();
+		try
+		{
+			pStrategy->add(delegate);
+		}
+		catch (...)
+		{
+			delete pStrategy;
+			throw;
+		}
+		publish(pStrategy);
+	}
+
+	void remove(const TDelegate& delegate)
+	{
+		if (current()->empty()) return;
+
+		TStrategy* pStrategy = copy();
+		pStrategy->remove(delegate);
+		publish(pStrategy);
+	}
+
+	void clear()
+	{
+		if (current()->empty()) return;
+
+		TStrategy* pStrategy = copy();
+		pStrategy->clear();
+		publish(pStrategy);
+	}
+
+	TStrategy* current() const
+		/// Returns the current strategy.
+	{
+		return static_cast<TStrategy*>(_pCurrent);
+	}
+
+	TStrategy* copy() const
+		/// Returns a new copy of the current strategy.
+	{
+		return new TStrategy(*current());
+	}
+
+private:
+	typedef std::vector<TStrategy*> StrategyVec;
+
+	CopyOnWriteStrategy(const CopyOnWriteStrategy&);
+	CopyOnWriteStrategy& operator = (const CopyOnWriteStrategy&);
+
+	void publish(TStrategy* pStrategy)
+	{
+		{
+			FastMutex::ScopedLock lock(_retiredMutex);
+			_retired.push_back(current());
+			AtomicOps::store(&_pCurrent, pStrategy);
+			AtomicOps::store(&_hasRetired, 1);
+		}
+		// Either this sees no reader, or the last Reader sees
+		// _hasRetired, and deletes the retired strategies.
+		AtomicOps::barrier();
+		if (_readers.value() == 0) deleteRetired();
+	}
+
+	void deleteRetired()
+		/// Deletes the retired strategies, if no notification
+		/// is in progress. A Reader increments _readers before
+		/// loading _pCurrent, and strategies are retired before
+		/// _pCurrent is replaced, so if no reader is seen here,
+		/// none can use a retired strategy.
+	{
+		StrategyVec retired;
+		{
+			FastMutex::ScopedLock lock(_retiredMutex);
+			if (_readers.value() != 0) return;
+			retired.swap(_retired);
+			AtomicOps::store(&_hasRetired, 0);
+		}
+		for (typename StrategyVec::iterator it = retired.begin(); it != retired.end(); ++it)
+		{
+			delete *it;
+		}
+	}
+
+	void* volatile  _pCurrent;
+	AtomicCounter   _readers;
+	StrategyVec     _retired;
+	volatile UInt32 _hasRetired;
+	FastMutex       _retiredMutex;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_CopyOnWriteStrategy_INCLUDED
@@ -66,8 +66,11 @@ class ExpireCache: public AbstractCache<TKey, TValue, ExpireStrategy<TKey, TValu
 	/// when "get" is invoked.
 {
 public:
-	ExpireCache(Timestamp::TimeDiff expire = 600000): 
-		AbstractCache<TKey, TValue, ExpireStrategy<TKey, TValue>, TMutex, TEventMutex>(ExpireStrategy<TKey, TValue>(expire))
+	ExpireCache(Timestamp::TimeDiff expire = 600000, std::size_t maxPurge = 0): 
+		AbstractCache<TKey, TValue, ExpireStrategy<TKey, TValue>, TMutex, TEventMutex>(ExpireStrategy<TKey, TValue>(expire, maxPurge))
+		/// Creates the ExpireCache. Entries expire after expire milliseconds.
+		/// If maxPurge is not 0, a single cache operation removes at most
+		/// maxPurge expired entries (see ExpireStrategy).
 	{
 	}
 
@@ -48,6 +48,7 @@
 #include "Poco/EventArgs.h"
 #include <set>
 #include <map>
+#include <list>
 
 
 namespace Poco {
@@ -59,18 +60,36 @@ template <
 >
 class ExpireStrategy: public AbstractStrategy<TKey, TValue>
 	/// An ExpireStrategy implements time based expiration of cache entries
+	///
+	/// As all entries are cached for the same time, entries expire
+	/// in the order they have been added (or accessed, with
+	/// AccessExpireStrategy). The time index is therefore a list,
+	/// ordered by time, so that adding, touching and removing an
+	/// entry takes constant time (in addition to the key lookup),
+	/// and onReplace() only has to look at the oldest entries.
+	/// If the system time has been set back, an entry is inserted
+	/// before all entries with a later time, so the index always
+	/// stays ordered.
 {
 public:
-	typedef std::multimap<Timestamp, TKey>     TimeIndex;
-	typedef typename TimeIndex::iterator       IndexIterator;
-	typedef typename TimeIndex::const_iterator ConstIndexIterator;
-	typedef std::map<TKey, IndexIterator>      Keys;
-	typedef typename Keys::iterator            Iterator;
+	typedef std::list<std::pair<Timestamp, TKey> > TimeIndex;
+	typedef typename TimeIndex::iterator           IndexIterator;
+	typedef typename TimeIndex::const_iterator     ConstIndexIterator;
+	typedef std::map<TKey, IndexIterator>          Keys;
+	typedef typename Keys::iterator                Iterator;
 
 public:
-	ExpireStrategy(Timestamp::TimeDiff expireTimeInMilliSec): _expireTime(expireTimeInMilliSec * 1000)
+	ExpireStrategy(Timestamp::TimeDiff expireTimeInMilliSec, std::size_t maxPurge = 0): 
+		_expireTime(expireTimeInMilliSec * 1000),
+		_maxPurge(maxPurge)
 		/// Create an expire strategy. Note that the smallest allowed caching time is 25ms.
 		/// Anything lower than that is not useful with current operating systems.
+		///
+		/// If maxPurge is not 0, onReplace() reports at most maxPurge
+		/// expired entries at a time, which limits the time a single
+		/// cache operation spends removing expired entries. Remaining
+		/// expired entries are still reported as invalid, and removed
+		/// by later cache operations.
 	{
 		if (_expireTime < 25000) throw InvalidArgumentException("expireTime must be at least 25 ms");  
 	}
@@ -81,16 +100,7 @@ public:
 
 	void onAdd(const void*, const KeyValueArgs <TKey, TValue>& args)
 	{
-		Timestamp now;
-		typename TimeIndex::value_type tiValue(now, args.key());
-		IndexIterator it = _keyIndex.insert(tiValue);
-		typename Keys::value_type kValue(args.key(), it);
-		std::pair<Iterator, bool> stat = _keys.insert(kValue);
-		if (!stat.second)
-		{
-			_keyIndex.erase(stat.first->second);
-			stat.first->second = it;
-		}
+		touch(args.key());
 	}
 
 	void onRemove(const void*, const TKey& key)
@@ -133,18 +143,62 @@ public:
 		// Note: replace only informs the cache which elements
 		// it would like to remove!
 		// it does not remove them on its own!
+		if (_keyIndex.empty()) return;
+
+		Timestamp now;
+		std::size_t n = 0;
 		IndexIterator it = _keyIndex.begin();
-		while (it != _keyIndex.end() && it->first.isElapsed(_expireTime))
+		while (it != _keyIndex.end() && now - it->first >= _expireTime && (_maxPurge == 0 || n < _maxPurge))
 		{
 			elemsToRemove.insert(it->second);
 			++it;
+			++n;
 		}
 	}
 
 protected:
+	void touch(const TKey& key)
+		/// Sets the time of the given key to the current time,
+		/// and moves the key to the end of the time index.
+		/// Adds the key if it does not exist yet.
+	{
+		Timestamp now;
+		Iterator it = _keys.find(key);
+		if (it != _keys.end())
+		{
+			IndexIterator itIdx = it->second;
+			itIdx->first = now;
+			IndexIterator pos = insertPosition(now, itIdx);
+			if (pos != itIdx) _keyIndex.splice(pos, _keyIndex, itIdx);
+		}
+		else
+		{
+			IndexIterator itIdx = _keyIndex.insert(insertPosition(now, _keyIndex.end()), typename TimeIndex::value_type(now, key));
+			_keys.insert(typename Keys::value_type(key, itIdx));
+		}
+	}
+
+	IndexIterator insertPosition(const Timestamp& time, IndexIterator skip)
+		/// Returns the position in the time index before which
+		/// an entry with the given time must be inserted, ignoring
+		/// the entry skip. This is the end of the index, unless the
+		/// system time has been set back.
+	{
+		IndexIterator pos = _keyIndex.end();
+		while (pos != _keyIndex.begin())
+		{
+			IndexIterator prev = pos;
+			--prev;
+			if (prev != skip && !(time < prev->first)) break;
+			pos = prev;
+		}
+		return pos;
+	}
+
 	Timestamp::TimeDiff _expireTime;
-	Keys      _keys;     /// For faster replacement of keys, the iterator points to the _keyIndex map
-	TimeIndex _keyIndex; /// Maps time to key value
+	std::size_t         _maxPurge;
+	Keys      _keys;     /// For faster replacement of keys, the iterator points to the _keyIndex list
+	TimeIndex _keyIndex; /// Keys ordered by time, oldest first
 };
 
 
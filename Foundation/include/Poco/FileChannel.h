@@ -53,6 +53,7 @@ class LogFile;
 class RotateStrategy;
 class ArchiveStrategy;
 class PurgeStrategy;
+class Timer;
 
 
 class Foundation_API FileChannel: public Channel
@@ -183,6 +184,35 @@ class Foundation_API FileChannel: public Channel
 	///            if it exists (unless other conditions for a rotation are met). 
 	///            This is the default.
 	///
+	/// On busy servers, writing every message to the file separately
+	/// may make logging a bottleneck. The bufferSize property enables
+	/// a user-space write buffer, in which messages are collected
+	/// and then written with a single write operation. The
+	/// bufferSize property can have the following values:
+	///
+	///   * none or 0:     Every message is written immediately (default).
+	///   * <n>:           The buffer is written when it holds at least <n> bytes.
+	///   * <n> K:         The buffer is written when it holds at least <n> Kilobytes.
+	///   * <n> M:         The buffer is written when it holds at least <n> Megabytes.
+	///
+	/// The buffer is also written when a message with a priority equal
+	/// to or higher than the one given in the flushPriority property
+	/// (default: error) is logged, and periodically in the interval,
+	/// given in milliseconds, by the flushInterval property (default: 1000,
+	/// 0 disables periodic writing). Rotation takes buffered messages
+	/// into account, and the buffer is written before the file is archived.
+	///
+	/// The syncInterval property specifies an interval in milliseconds
+	/// in which the log file is synchronized with the storage device
+	/// (using fdatasync() or fsync() on POSIX platforms and FlushFileBuffers()
+	/// on Windows), to limit the amount of messages that may be lost if
+	/// the system crashes. The default is 0 (no synchronization).
+	///
+	/// Periodic writing and synchronization are done by a timer thread,
+	/// which is started when the channel is opened. Changes to bufferSize,
+	/// flushInterval and syncInterval take effect immediately, also while
+	/// the channel is open.
+	///
 	/// For a more lightweight file channel class, see SimpleFileChannel.
 {
 public:
@@ -200,6 +230,12 @@ public:
 
 	void log(const Message& msg);
 		/// Logs the given message to the file.
+
+	void logBatch(const Message* pMessages, std::size_t count);
+		/// Logs the given messages to the file, using
+		/// a single write operation.
+		///
+		/// Rotation is checked once for the entire batch.
 		
 	void setProperty(const std::string& name, const std::string& value);
 		/// Sets the property with the given name. 
@@ -226,6 +262,17 @@ public:
 		///                   for details.
 		///   * rotateOnOpen: Specifies whether an existing log file should be 
 		///                   rotated and archived when the channel is opened.
+		///   * bufferSize:   The size of the write buffer. See the FileChannel
+		///                   class for details.
+		///   * flushInterval: The interval in milliseconds in which buffered
+		///                   messages are written. See the FileChannel class
+		///                   for details.
+		///   * flushPriority: The lowest priority of messages that cause the
+		///                   buffer to be written immediately. See the FileChannel
+		///                   class for details.
+		///   * syncInterval: The interval in milliseconds in which the
+		///                   log file is synchronized with the storage device.
+		///                   See the FileChannel class for details.
 
 	std::string getProperty(const std::string& name) const;
 		/// Returns the value of the property with the given name.
@@ -250,6 +297,10 @@ public:
 	static const std::string PROP_PURGECOUNT;
 	static const std::string PROP_FLUSH;
 	static const std::string PROP_ROTATEONOPEN;
+	static const std::string PROP_BUFFERSIZE;
+	static const std::string PROP_FLUSHINTERVAL;
+	static const std::string PROP_FLUSHPRIORITY;
+	static const std::string PROP_SYNCINTERVAL;
 
 protected:
 	~FileChannel();
@@ -260,7 +311,30 @@ protected:
 	void setPurgeCount(const std::string& count);
 	void setFlush(const std::string& flush);
 	void setRotateOnOpen(const std::string& rotateOnOpen);
+	void setBufferSize(const std::string& bufferSize);
+	void setFlushPriority(const std::string& priority);
 	void purge();
+	void rotate();
+	void startTimer();
+	void stopTimer();
+	void onTimer(Timer& timer);
+	void write(const std::string& text, int priority);
+		/// Opens the log file if necessary, rotates it if the
+		/// rotation strategy says so, and writes the given text,
+		/// followed by a line ending, to it.
+		///
+		/// The priority is used to decide whether buffered
+		/// text must be written immediately.
+
+	virtual void onFileOpened(LogFile& file);
+		/// Called whenever a log file has been opened, either
+		/// by open() or after rotating the log file, before
+		/// any messages are written to it. The mutex protecting
+		/// the log file is held during the call.
+		///
+		/// Subclasses can override this method to write
+		/// a header to the file. The default implementation
+		/// does nothing.
 
 private:
 	std::string      _path;
@@ -272,6 +346,15 @@ private:
 	std::string      _purgeCount;
 	bool             _flush;
 	bool             _rotateOnOpen;
+	std::string      _bufferSize;
+	std::size_t      _bufferLimit;
+	long             _flushInterval;
+	std::string      _flushPriority;
+	int              _flushLevel;
+	long             _syncInterval;
+	Timestamp        _lastFlush;
+	Timestamp        _lastSync;
+	Timer*           _pTimer;
 	LogFile*         _pFile;
 	RotateStrategy*  _pRotateStrategy;
 	ArchiveStrategy* _pArchiveStrategy;
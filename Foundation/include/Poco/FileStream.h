@@ -93,6 +93,13 @@ public:
 	FileStreamBuf* rdbuf();
 		/// Returns a pointer to the underlying streambuf.
 
+	FileStreamBuf::NativeHandle nativeHandle() const;
+		/// Returns the native file descriptor (POSIX) or file
+		/// handle (Windows) of the underlying file.
+		///
+		/// The handle remains owned by the stream and must not
+		/// be closed.
+
 protected:
 	FileStreamBuf _buf;
 	std::ios::openmode _defaultMode;
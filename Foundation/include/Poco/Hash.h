@@ -42,6 +42,8 @@
 
 #include "Poco/Foundation.h"
 #include <cstddef>
+#include <cstring>
+#include <string>
 
 
 namespace Poco {
@@ -56,6 +58,28 @@ std::size_t Foundation_API hash(UInt32 n);
 std::size_t Foundation_API hash(Int64 n);
 std::size_t Foundation_API hash(UInt64 n);
 std::size_t Foundation_API hash(const std::string& str);
+std::size_t Foundation_API hash(const char* str, std::size_t length);
+	/// Returns hash64(str, length, 0), truncated to std::size_t
+	/// if necessary.
+
+
+UInt64 Foundation_API hash64(const char* data, std::size_t length, UInt64 seed = 0);
+	/// Returns a 64-bit hash of the given data, computed with the
+	/// given seed.
+	///
+	/// The hash function processes the data 16 bytes at a time and
+	/// uses 64x64 -> 128 bit multiplications for mixing, so it is
+	/// fast for long keys and distributes keys that differ only in a
+	/// few characters (like URL paths or header names) well.
+	/// It is not a cryptographic hash function.
+	///
+	/// For a given seed, the result does not depend on the platform,
+	/// so it can be used for sharding or persistent data.
+
+
+UInt64 Foundation_API hashSeed();
+	/// Returns a random seed for hash64(), which is created
+	/// once per process. See SeededHash.
 
 
 template <class T>
@@ -70,6 +94,80 @@ struct Hash
 };
 
 
+template <>
+struct Hash<std::string>
+	/// The hash function for strings.
+	///
+	/// Also accepts a const char*, and returns the same hash value
+	/// as for an equal std::string. Hash tables supporting lookup by a
+	/// different key type (like OpenHashTable) can therefore find
+	/// std::string elements without creating a temporary string.
+{
+	std::size_t operator () (const std::string& value) const
+		/// Returns the hash for the given string.
+	{
+		return Poco::hash(value.data(), value.size());
+	}
+
+	std::size_t operator () (const char* value) const
+		/// Returns the hash for the given zero-terminated string.
+	{
+		return Poco::hash(value, std::strlen(value));
+	}
+};
+
+
+struct SeededHash
+	/// A hash function for strings, using hash64() with
+	/// a seed.
+	///
+	/// A default-constructed SeededHash uses the per-process random
+	/// seed returned by hashSeed(). Hash tables whose keys come from
+	/// untrusted sources (e.g., HTTP header names or request paths)
+	/// should use SeededHash instead of Hash, as an attacker then cannot
+	/// precompute a set of colliding keys to degrade lookups
+	/// ("hash flooding"), for example:
+	///
+	///     Poco::HashMap<std::string, int, Poco::SeededHash> map;
+	///
+	/// Note that hash values differ between processes, so they must not
+	/// be persisted or sent to other processes.
+{
+	SeededHash():
+		_seed(hashSeed())
+		/// Creates the SeededHash, using the seed returned by hashSeed().
+	{
+	}
+
+	explicit SeededHash(UInt64 seed):
+		_seed(seed)
+		/// Creates the SeededHash, using the given seed.
+	{
+	}
+
+	std::size_t operator () (const std::string& value) const
+		/// Returns the hash for the given string.
+	{
+		return static_cast<std::size_t>(Poco::hash64(value.data(), value.size(), _seed));
+	}
+
+	std::size_t operator () (const char* value) const
+		/// Returns the hash for the given zero-terminated string.
+	{
+		return static_cast<std::size_t>(Poco::hash64(value, std::strlen(value), _seed));
+	}
+
+	UInt64 seed() const
+		/// Returns the seed.
+	{
+		return _seed;
+	}
+
+private:
+	UInt64 _seed;
+};
+
+
 //
 // inlines
 //
@@ -83,6 +83,14 @@ struct HashMapEntry
 	{
 		return first != entry.first;
 	}
+
+	template <class K>
+	bool operator == (const K& key) const
+		/// Compares the entry's key with a key, which is used
+		/// by OpenHashMap to look up entries by their key.
+	{
+		return first == key;
+	}
 };
 
 
@@ -95,6 +103,12 @@ struct HashMapEntryHash
 		return _func(entry.first);
 	}
 
+	template <class K>
+	std::size_t operator () (const K& key) const
+	{
+		return _func(key);
+	}
+
 private:
 	KeyHashFunc _func;
 };
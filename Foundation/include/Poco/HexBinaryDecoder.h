@@ -43,6 +43,7 @@
 #include "Poco/Foundation.h"
 #include "Poco/UnbufferedStreamBuf.h"
 #include <istream>
+#include <string>
 
 
 namespace Poco {
@@ -68,6 +69,7 @@ public:
 	
 private:
 	int readFromDevice();
+	std::streamsize readBlockFromDevice(char* buffer, std::streamsize length);
 	int readOne();
 
 	std::streambuf& _buf;
@@ -107,6 +109,20 @@ class Foundation_API HexBinaryDecoder: public HexBinaryDecoderIOS, public std::i
 public:
 	HexBinaryDecoder(std::istream& istr);
 	~HexBinaryDecoder();
+
+	static std::size_t decode(const char* buffer, std::size_t length, char* output);
+		/// Decodes length characters of hexBinary-encoded data from
+		/// buffer, and writes the result to output, which must
+		/// have room for length/2 bytes. Whitespace in the encoded
+		/// data is ignored.
+		///
+		/// Returns the number of bytes written. Throws a 
+		/// DataFormatException if the data contains an invalid
+		/// character, or an odd number of digits.
+
+	static std::string decode(const std::string& data);
+		/// Returns the decoded hexBinary-encoded data.
+		/// Throws a DataFormatException if the data is not valid.
 };
 
 
@@ -43,6 +43,7 @@
 #include "Poco/Foundation.h"
 #include "Poco/UnbufferedStreamBuf.h"
 #include <ostream>
+#include <string>
 
 
 namespace Poco {
@@ -85,6 +86,7 @@ public:
 	
 private:
 	int writeToDevice(char c);
+	std::streamsize writeBlockToDevice(const char* buffer, std::streamsize length);
 
 	int _pos;
 	int _lineLength;
@@ -130,6 +132,16 @@ class Foundation_API HexBinaryEncoder: public HexBinaryEncoderIOS, public std::o
 public:
 	HexBinaryEncoder(std::ostream& ostr);
 	~HexBinaryEncoder();
+
+	static std::size_t encode(const char* buffer, std::size_t length, char* output, bool uppercase = false);
+		/// Encodes length bytes from buffer and writes the result
+		/// to output, which must have room for 2*length characters.
+		/// No line breaks are inserted.
+		///
+		/// Returns the number of characters written.
+
+	static std::string encode(const std::string& data, bool uppercase = false);
+		/// Returns the hexBinary encoding of data, without line breaks.
 };
 
 
@@ -0,0 +1,107 @@
+//
+// InterfaceAdapter.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  InterfaceAdapter
+//
+// Definition of the InterfaceAdapter class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_InterfaceAdapter_INCLUDED
+#define Foundation_InterfaceAdapter_INCLUDED
+
+
+#include "Poco/Foundation.h"
+
+
+namespace Poco {
+
+
+template <class I, class A>
+class InterfaceAdapter: public I
+	/// The common base class for adapters that implement an
+	/// abstract interface I for a class A, which provides the
+	/// operations of I without deriving from it.
+	///
+	/// This lets classes like TaskManager or AsyncChannel work
+	/// with any of several implementations, while the
+	/// implementations themselves (e.g., ThreadPool and
+	/// WorkStealingThreadPool) do not need virtual functions.
+	///
+	/// If A is a class type, the adapter creates and owns the
+	/// adaptee. If A is a reference type, the adapter refers to
+	/// an existing object, which must outlive the adapter.
+	///
+	/// Subclasses implement the member functions of I by
+	/// forwarding the calls to _adaptee.
+	///
+	/// See NotificationQueueAdapter and ThreadPoolAdapter
+	/// for examples.
+{
+public:
+	InterfaceAdapter()
+		/// Creates the InterfaceAdapter, using the default
+		/// constructor of the adaptee.
+	{
+	}
+
+	template <class Arg>
+	explicit InterfaceAdapter(Arg& arg):
+		_adaptee(arg)
+		/// Creates the InterfaceAdapter, passing the given
+		/// argument to the adaptee's constructor, or binding
+		/// the adaptee to the given object if A is a reference type.
+	{
+	}
+
+	template <class Arg>
+	explicit InterfaceAdapter(const Arg& arg):
+		_adaptee(arg)
+		/// Creates the InterfaceAdapter, passing the given
+		/// argument to the adaptee's constructor.
+	{
+	}
+
+	~InterfaceAdapter()
+		/// Destroys the InterfaceAdapter.
+	{
+	}
+
+protected:
+	A _adaptee;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_InterfaceAdapter_INCLUDED
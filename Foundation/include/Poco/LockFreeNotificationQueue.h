@@ -0,0 +1,216 @@
+//
+// LockFreeNotificationQueue.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  LockFreeNotificationQueue
+//
+// Definition of the LockFreeNotificationQueue class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_LockFreeNotificationQueue_INCLUDED
+#define Foundation_LockFreeNotificationQueue_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Notification.h"
+#include "Poco/Semaphore.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include <vector>
+
+
+namespace Poco {
+
+
+class NotificationCenter;
+
+
+class Foundation_API LockFreeNotificationQueue
+	/// A bounded, lock-free, multiple-producer/multiple-consumer
+	/// notification queue.
+	///
+	/// LockFreeNotificationQueue can be used in place of a
+	/// NotificationQueue where many threads enqueue and dequeue
+	/// notifications concurrently, and contention on the single
+	/// mutex of NotificationQueue becomes a bottleneck.
+	///
+	/// The queue is implemented as a fixed-size ring buffer,
+	/// with producers and consumers claiming slots using
+	/// atomic compare-and-swap operations. Consumer threads
+	/// calling waitDequeueNotification() only block if the queue
+	/// is empty. Producers only have to wake up a consumer (which
+	/// requires a system call) if a consumer is actually waiting.
+	///
+	/// Unlike NotificationQueue, the capacity of the queue is limited.
+	/// If the queue is full, enqueueNotification() waits until a
+	/// consumer has made room. Urgent notifications are not supported,
+	/// as notifications are always dequeued in FIFO order.
+	///
+	/// On platforms without support for atomic compare-and-swap
+	/// operations, the queue falls back to using a mutex internally.
+	///
+	/// The same shutdown sequence as for NotificationQueue
+	/// should be used:
+	///   1. set a termination flag for every worker thread
+	///   2. call the wakeUpAll() method
+	///   3. join each worker thread
+	///   4. destroy the notification queue.
+{
+public:
+	enum
+	{
+		DEFAULT_CAPACITY = 1024
+	};
+
+	explicit LockFreeNotificationQueue(std::size_t capacity = DEFAULT_CAPACITY);
+		/// Creates the LockFreeNotificationQueue, which can hold
+		/// at least the given number of notifications.
+		///
+		/// The capacity is rounded up to the next power of two.
+
+	~LockFreeNotificationQueue();
+		/// Destroys the LockFreeNotificationQueue.
+
+	void enqueueNotification(Notification::Ptr pNotification);
+		/// Enqueues the given notification by adding it to
+		/// the end of the queue (FIFO).
+		/// The queue takes ownership of the notification, thus
+		/// a call like
+		///     notificationQueue.enqueueNotification(new MyNotification);
+		/// does not result in a memory leak.
+		///
+		/// If the queue is full, the calling thread yields a few
+		/// times, then sleeps until a consumer has dequeued a
+		/// notification.
+
+	bool tryEnqueueNotification(Notification::Ptr pNotification);
+		/// Enqueues the given notification by adding it to
+		/// the end of the queue (FIFO), if there is room in the
+		/// queue. Returns true if the notification has been
+		/// enqueued, or false if the queue is full.
+
+	Notification* dequeueNotification();
+		/// Dequeues the next pending notification.
+		/// Returns 0 (null) if no notification is available.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+
+	Notification* waitDequeueNotification();
+		/// Dequeues the next pending notification.
+		/// If no notification is available, waits for a notification
+		/// to be enqueued.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		/// This method returns 0 (null) if wakeUpAll()
+		/// has been called by another thread.
+
+	Notification* waitDequeueNotification(long milliseconds);
+		/// Dequeues the next pending notification.
+		/// If no notification is available, waits for a notification
+		/// to be enqueued up to the specified time.
+		/// Returns 0 (null) if no notification is available
+		/// after the specified time, or if wakeUpAll()
+		/// has been called by another thread.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+
+	void dispatch(NotificationCenter& notificationCenter);
+		/// Dispatches all queued notifications to the given
+		/// notification center.
+
+	void wakeUpAll();
+		/// Wakes up all threads that wait for a notification.
+
+	bool empty() const;
+		/// Returns true iff the queue is empty.
+
+	int size() const;
+		/// Returns the number of notifications in the queue.
+		///
+		/// As other threads may concurrently modify the queue,
+		/// the result is only a snapshot.
+
+	std::size_t capacity() const;
+		/// Returns the maximum number of notifications
+		/// the queue can hold.
+
+	void clear();
+		/// Removes all notifications from the queue.
+
+	bool hasIdleThreads() const;
+		/// Returns true if the queue has at least one thread waiting
+		/// for a notification.
+
+protected:
+	Notification* dequeueOne();
+	bool enqueueOne(Notification* pNotification);
+	void wakeUpOne();
+	void cancelWait();
+	void waitForSpace(Poco::UInt32 pos);
+
+private:
+	struct Cell
+	{
+		volatile Poco::UInt32 sequence;
+		Notification*         pNf;
+	};
+	typedef std::vector<Cell> CellVec;
+
+	enum
+	{
+		CACHE_LINE_SIZE = 64,
+		SPIN_COUNT = 16
+	};
+
+	LockFreeNotificationQueue(const LockFreeNotificationQueue&);
+	LockFreeNotificationQueue& operator = (const LockFreeNotificationQueue&);
+
+	CellVec               _cells;
+	Poco::UInt32          _mask;
+	char                  _pad1[CACHE_LINE_SIZE];
+	volatile Poco::UInt32 _enqueuePos;
+	char                  _pad2[CACHE_LINE_SIZE];
+	volatile Poco::UInt32 _dequeuePos;
+	char                  _pad3[CACHE_LINE_SIZE];
+	volatile Poco::UInt32 _waiting;
+	volatile Poco::UInt32 _generation;
+	Semaphore             _sema;
+	volatile Poco::UInt32 _blocked;
+	FastMutex             _spaceMutex;
+	Condition             _spaceAvailable;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_LockFreeNotificationQueue_INCLUDED
@@ -41,6 +41,7 @@
 
 
 #include "Poco/Foundation.h"
+#include <cstddef>
 
 
 #if defined(POCO_OS_FAMILY_WINDOWS) && defined(POCO_WIN32_UTF8)
@@ -60,42 +61,80 @@ namespace Poco {
 class Foundation_API LogFile: public LogFileImpl
 	/// This class is used by FileChannel to work
 	/// with a log file.
+	///
+	/// LogFile can optionally collect log messages in a
+	/// user-space buffer and write them to the file with a
+	/// single operation once the buffer is full, or when
+	/// flush() is called. See setBufferSize().
 {
 public:
 	LogFile(const std::string& path);
 		/// Creates the LogFile.
 
 	~LogFile();
-		/// Destroys the LogFile.
+		/// Writes any buffered text to the file and
+		/// destroys the LogFile.
 
 	void write(const std::string& text, bool flush = true);
 		/// Writes the given text to the log file.
 		/// If flush is true, the text will be immediately
 		/// flushed to the file.
+		///
+		/// If a buffer size has been set, the text is added to
+		/// the buffer instead. Once the buffer holds at least
+		/// the given number of bytes, it is written to the file
+		/// and passed to the operating system. In this case,
+		/// flush applies to the buffer as a whole.
+
+	void flush();
+		/// Writes any buffered text to the file, and flushes
+		/// the file's stream buffer, so that the text is passed
+		/// to the operating system.
+
+	void sync();
+		/// Like flush(), but additionally makes sure that the
+		/// written text has been physically stored on disk
+		/// (using fdatasync() or fsync() on POSIX platforms,
+		/// and FlushFileBuffers() on Windows).
+		///
+		/// Does nothing if nothing has been written since
+		/// the last call to sync().
+
+	void setBufferSize(std::size_t size);
+		/// Sets the size of the user-space write buffer, in bytes.
+		/// If size is 0 (the default), write() writes every text
+		/// to the file immediately.
+		///
+		/// Any buffered text is written to the file first.
+
+	std::size_t getBufferSize() const;
+		/// Returns the size of the write buffer.
 
 	UInt64 size() const;
-		/// Returns the current size in bytes of the log file.
+		/// Returns the current size in bytes of the log file,
+		/// including any buffered text.
 	
 	Timestamp creationDate() const;
 		/// Returns the date and time the log file was created.
 	
 	const std::string& path() const;
 		/// Returns the path given in the constructor.
+
+private:
+	void writeBuffer(bool flush);
+
+	std::string _buffer;
+	std::size_t _bufferSize;
+	bool        _unsynced;
 };
 
 
 //
 // inlines
 //
-inline void LogFile::write(const std::string& text, bool flush)
-{
-	writeImpl(text, flush);
-}
-
-
-inline UInt64 LogFile::size() const
+inline std::size_t LogFile::getBufferSize() const
 {
-	return sizeImpl();
+	return _bufferSize;
 }
 
 
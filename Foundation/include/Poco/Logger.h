@@ -44,6 +44,8 @@
 #include "Poco/Channel.h"
 #include "Poco/Message.h"
 #include "Poco/Format.h"
+#include "Poco/Mutex.h"
+#include "Poco/AtomicOps.h"
 #include <map>
 #include <vector>
 #include <cstddef>
@@ -96,6 +98,16 @@ class Foundation_API Logger: public Channel
 	/// Variants of these macros that allow message formatting with Poco::format()
 	/// are also available. Up to four arguments are supported.
 	///
+	/// The member functions taking a format string and Any arguments
+	/// (e.g., information(fmt, value1, value2)) also check the log level
+	/// before the message text is formatted. However, unlike with the macros,
+	/// the arguments are still evaluated and converted to Any.
+	///
+	/// To avoid memory allocations for every log message, a thread started
+	/// with Poco::Thread reuses the same Message object and text buffer for
+	/// all of its messages. Channels must therefore not keep references to
+	/// a Message beyond the Channel::log() call, but copy it, if needed.
+	///
 	/// Examples:
 	///     poco_warning(logger, "This is a warning");
 	///     poco_information_f2(logger, "An informational message with args: %d, %d", 1, 2);
@@ -416,6 +428,17 @@ public:
 		/// Returns a reference to the Logger with the given name.
 		/// If the Logger does not yet exist, it is created, based
 		/// on its parent logger.
+		///
+		/// Existing Loggers are found without locking a mutex.
+		/// Nevertheless, code that logs frequently should keep
+		/// a reference to its Logger, or use a LoggerHandle.
+		///
+		/// get(), root() and has() may be called concurrently with
+		/// any other member function, including destroy() and
+		/// shutdown(). However, a reference obtained from get()
+		/// becomes invalid when the Logger is destroyed, so a
+		/// Logger must not be destroyed while other threads still
+		/// use it.
 
 	static Logger& unsafeGet(const std::string& name);
 		/// Returns a reference to the Logger with the given name.
@@ -450,6 +473,11 @@ public:
 	static void shutdown();
 		/// Shuts down the logging framework and releases all
 		/// Loggers.
+		///
+		/// The index used by get() to find existing Loggers without
+		/// locking is not freed, since other threads may still be
+		/// searching it. Only its references to the Loggers are
+		/// removed.
 		
 	static void names(std::vector<std::string>& names);
 		/// Fills the given vector with the names
@@ -482,11 +510,22 @@ protected:
 	
 	void log(const std::string& text, Message::Priority prio);
 	void log(const std::string& text, Message::Priority prio, const char* file, int line);
+	void logText(const std::string& text, Message::Priority prio, const char* file, int line);
+	void logFormat(Message::Priority prio, const std::string& fmt, const Any& value1);
+	void logFormat(Message::Priority prio, const std::string& fmt, const Any& value1, const Any& value2);
+	void logFormat(Message::Priority prio, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3);
+	void logFormat(Message::Priority prio, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4);
+	void logFormat(Message::Priority prio, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5);
+	void logFormat(Message::Priority prio, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6);
 
 	static std::string format(const std::string& fmt, int argc, std::string argv[]);
 	static Logger& parent(const std::string& name);
 	static void add(Logger* pLogger);
 	static Logger* find(const std::string& name);
+	static Logger* lookup(const std::string& name);
+	static void index(const std::string& name, Logger* pLogger);
+	static void clearIndex();
+	static UInt32 generation();
 
 private:
 	Logger();
@@ -497,8 +536,63 @@ private:
 	Channel*    _pChannel;
 	int         _level;
 
-	static LoggerMap* _pLoggerMap;
-	static Mutex      _mapMtx;
+	static LoggerMap*      _pLoggerMap;
+	static Mutex           _mapMtx;
+	static volatile UInt32 _generation;
+
+	friend class LoggerHandle;
+};
+
+
+class Foundation_API LoggerHandle
+	/// A LoggerHandle caches a reference to the Logger
+	/// with the given name, so that the Logger does not
+	/// have to be looked up for every log statement.
+	///
+	/// The handle stays valid if the Logger is destroyed,
+	/// or if the logging framework is shut down. In this case,
+	/// the Logger is looked up (and created, if necessary)
+	/// again the next time the handle is used.
+	///
+	/// A LoggerHandle can be shared by multiple threads.
+	///
+	/// Example:
+	///     static Poco::LoggerHandle logger("HTTPServer");
+	///     ...
+	///     poco_information(*logger, "Request received");
+{
+public:
+	explicit LoggerHandle(const std::string& name);
+		/// Creates the LoggerHandle for the Logger with the given name.
+		/// The Logger is not looked up until the handle is used.
+
+	~LoggerHandle();
+		/// Destroys the LoggerHandle.
+
+	Logger& logger() const;
+		/// Returns a reference to the Logger.
+
+	Logger& operator * () const;
+		/// Returns a reference to the Logger.
+
+	Logger* operator -> () const;
+		/// Returns a pointer to the Logger.
+
+	const std::string& name() const;
+		/// Returns the name of the Logger.
+
+protected:
+	Logger& refresh() const;
+
+private:
+	LoggerHandle();
+	LoggerHandle(const LoggerHandle&);
+	LoggerHandle& operator = (const LoggerHandle&);
+
+	std::string             _name;
+	mutable void* volatile  _pLogger;
+	mutable volatile UInt32 _generation;
+	mutable FastMutex       _mutex;
 };
 
 
@@ -648,6 +742,12 @@ inline const std::string& Logger::name() const
 }
 
 
+inline UInt32 Logger::generation()
+{
+	return AtomicOps::load(&_generation);
+}
+
+
 inline int Logger::getLevel() const
 {
 	return _level;
@@ -658,7 +758,7 @@ inline void Logger::log(const std::string& text, Message::Priority prio)
 {
 	if (_level >= prio && _pChannel)
 	{
-		_pChannel->log(Message(_name, text, prio));
+		logText(text, prio, 0, 0);
 	}
 }
 
@@ -667,7 +767,7 @@ inline void Logger::log(const std::string& text, Message::Priority prio, const c
 {
 	if (_level >= prio && _pChannel)
 	{
-		_pChannel->log(Message(_name, text, prio, file, line));
+		logText(text, prio, file, line);
 	}
 }
 
@@ -686,37 +786,37 @@ inline void Logger::fatal(const std::string& msg, const char* file, int line)
 
 inline void Logger::fatal(const std::string& fmt, const Any& value1)
 {
-	log(Poco::format(fmt, value1), Message::PRIO_FATAL);
+	if (_level >= Message::PRIO_FATAL) logFormat(Message::PRIO_FATAL, fmt, value1);
 }
 
 
 inline void Logger::fatal(const std::string& fmt, const Any& value1, const Any& value2)
 {
-	log(Poco::format(fmt, value1, value2), Message::PRIO_FATAL);
+	if (_level >= Message::PRIO_FATAL) logFormat(Message::PRIO_FATAL, fmt, value1, value2);
 }
 
 
 inline void Logger::fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
 {
-	log(Poco::format(fmt, value1, value2, value3), Message::PRIO_FATAL);
+	if (_level >= Message::PRIO_FATAL) logFormat(Message::PRIO_FATAL, fmt, value1, value2, value3);
 }
 
 
 inline void Logger::fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4), Message::PRIO_FATAL);
+	if (_level >= Message::PRIO_FATAL) logFormat(Message::PRIO_FATAL, fmt, value1, value2, value3, value4);
 }
 
 
 inline void Logger::fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5), Message::PRIO_FATAL);
+	if (_level >= Message::PRIO_FATAL) logFormat(Message::PRIO_FATAL, fmt, value1, value2, value3, value4, value5);
 }
 
 
 inline void Logger::fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6), Message::PRIO_FATAL);
+	if (_level >= Message::PRIO_FATAL) logFormat(Message::PRIO_FATAL, fmt, value1, value2, value3, value4, value5, value6);
 }
 
 
@@ -734,37 +834,37 @@ inline void Logger::critical(const std::string& msg, const char* file, int line)
 
 inline void Logger::critical(const std::string& fmt, const Any& value1)
 {
-	log(Poco::format(fmt, value1), Message::PRIO_CRITICAL);
+	if (_level >= Message::PRIO_CRITICAL) logFormat(Message::PRIO_CRITICAL, fmt, value1);
 }
 
 
 inline void Logger::critical(const std::string& fmt, const Any& value1, const Any& value2)
 {
-	log(Poco::format(fmt, value1, value2), Message::PRIO_CRITICAL);
+	if (_level >= Message::PRIO_CRITICAL) logFormat(Message::PRIO_CRITICAL, fmt, value1, value2);
 }
 
 
 inline void Logger::critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
 {
-	log(Poco::format(fmt, value1, value2, value3), Message::PRIO_CRITICAL);
+	if (_level >= Message::PRIO_CRITICAL) logFormat(Message::PRIO_CRITICAL, fmt, value1, value2, value3);
 }
 
 
 inline void Logger::critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4), Message::PRIO_CRITICAL);
+	if (_level >= Message::PRIO_CRITICAL) logFormat(Message::PRIO_CRITICAL, fmt, value1, value2, value3, value4);
 }
 
 
 inline void Logger::critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5), Message::PRIO_CRITICAL);
+	if (_level >= Message::PRIO_CRITICAL) logFormat(Message::PRIO_CRITICAL, fmt, value1, value2, value3, value4, value5);
 }
 
 
 inline void Logger::critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6), Message::PRIO_CRITICAL);
+	if (_level >= Message::PRIO_CRITICAL) logFormat(Message::PRIO_CRITICAL, fmt, value1, value2, value3, value4, value5, value6);
 }
 
 
@@ -782,37 +882,37 @@ inline void Logger::error(const std::string& msg, const char* file, int line)
 
 inline void Logger::error(const std::string& fmt, const Any& value1)
 {
-	log(Poco::format(fmt, value1), Message::PRIO_ERROR);
+	if (_level >= Message::PRIO_ERROR) logFormat(Message::PRIO_ERROR, fmt, value1);
 }
 
 
 inline void Logger::error(const std::string& fmt, const Any& value1, const Any& value2)
 {
-	log(Poco::format(fmt, value1, value2), Message::PRIO_ERROR);
+	if (_level >= Message::PRIO_ERROR) logFormat(Message::PRIO_ERROR, fmt, value1, value2);
 }
 
 
 inline void Logger::error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
 {
-	log(Poco::format(fmt, value1, value2, value3), Message::PRIO_ERROR);
+	if (_level >= Message::PRIO_ERROR) logFormat(Message::PRIO_ERROR, fmt, value1, value2, value3);
 }
 
 
 inline void Logger::error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4), Message::PRIO_ERROR);
+	if (_level >= Message::PRIO_ERROR) logFormat(Message::PRIO_ERROR, fmt, value1, value2, value3, value4);
 }
 
 
 inline void Logger::error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5), Message::PRIO_ERROR);
+	if (_level >= Message::PRIO_ERROR) logFormat(Message::PRIO_ERROR, fmt, value1, value2, value3, value4, value5);
 }
 
 
 inline void Logger::error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6), Message::PRIO_ERROR);
+	if (_level >= Message::PRIO_ERROR) logFormat(Message::PRIO_ERROR, fmt, value1, value2, value3, value4, value5, value6);
 }
 
 
@@ -830,37 +930,37 @@ inline void Logger::warning(const std::string& msg, const char* file, int line)
 
 inline void Logger::warning(const std::string& fmt, const Any& value1)
 {
-	log(Poco::format(fmt, value1), Message::PRIO_WARNING);
+	if (_level >= Message::PRIO_WARNING) logFormat(Message::PRIO_WARNING, fmt, value1);
 }
 
 
 inline void Logger::warning(const std::string& fmt, const Any& value1, const Any& value2)
 {
-	log(Poco::format(fmt, value1, value2), Message::PRIO_WARNING);
+	if (_level >= Message::PRIO_WARNING) logFormat(Message::PRIO_WARNING, fmt, value1, value2);
 }
 
 
 inline void Logger::warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
 {
-	log(Poco::format(fmt, value1, value2, value3), Message::PRIO_WARNING);
+	if (_level >= Message::PRIO_WARNING) logFormat(Message::PRIO_WARNING, fmt, value1, value2, value3);
 }
 
 
 inline void Logger::warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4), Message::PRIO_WARNING);
+	if (_level >= Message::PRIO_WARNING) logFormat(Message::PRIO_WARNING, fmt, value1, value2, value3, value4);
 }
 
 
 inline void Logger::warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5), Message::PRIO_WARNING);
+	if (_level >= Message::PRIO_WARNING) logFormat(Message::PRIO_WARNING, fmt, value1, value2, value3, value4, value5);
 }
 
 
 inline void Logger::warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6), Message::PRIO_WARNING);
+	if (_level >= Message::PRIO_WARNING) logFormat(Message::PRIO_WARNING, fmt, value1, value2, value3, value4, value5, value6);
 }
 
 
@@ -878,37 +978,37 @@ inline void Logger::notice(const std::string& msg, const char* file, int line)
 
 inline void Logger::notice(const std::string& fmt, const Any& value1)
 {
-	log(Poco::format(fmt, value1), Message::PRIO_NOTICE);
+	if (_level >= Message::PRIO_NOTICE) logFormat(Message::PRIO_NOTICE, fmt, value1);
 }
 
 
 inline void Logger::notice(const std::string& fmt, const Any& value1, const Any& value2)
 {
-	log(Poco::format(fmt, value1, value2), Message::PRIO_NOTICE);
+	if (_level >= Message::PRIO_NOTICE) logFormat(Message::PRIO_NOTICE, fmt, value1, value2);
 }
 
 
 inline void Logger::notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
 {
-	log(Poco::format(fmt, value1, value2, value3), Message::PRIO_NOTICE);
+	if (_level >= Message::PRIO_NOTICE) logFormat(Message::PRIO_NOTICE, fmt, value1, value2, value3);
 }
 
 
 inline void Logger::notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4), Message::PRIO_NOTICE);
+	if (_level >= Message::PRIO_NOTICE) logFormat(Message::PRIO_NOTICE, fmt, value1, value2, value3, value4);
 }
 
 
 inline void Logger::notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5), Message::PRIO_NOTICE);
+	if (_level >= Message::PRIO_NOTICE) logFormat(Message::PRIO_NOTICE, fmt, value1, value2, value3, value4, value5);
 }
 
 
 inline void Logger::notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6), Message::PRIO_NOTICE);
+	if (_level >= Message::PRIO_NOTICE) logFormat(Message::PRIO_NOTICE, fmt, value1, value2, value3, value4, value5, value6);
 }
 
 
@@ -926,37 +1026,37 @@ inline void Logger::information(const std::string& msg, const char* file, int li
 
 inline void Logger::information(const std::string& fmt, const Any& value1)
 {
-	log(Poco::format(fmt, value1), Message::PRIO_INFORMATION);
+	if (_level >= Message::PRIO_INFORMATION) logFormat(Message::PRIO_INFORMATION, fmt, value1);
 }
 
 
 inline void Logger::information(const std::string& fmt, const Any& value1, const Any& value2)
 {
-	log(Poco::format(fmt, value1, value2), Message::PRIO_INFORMATION);
+	if (_level >= Message::PRIO_INFORMATION) logFormat(Message::PRIO_INFORMATION, fmt, value1, value2);
 }
 
 
 inline void Logger::information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
 {
-	log(Poco::format(fmt, value1, value2, value3), Message::PRIO_INFORMATION);
+	if (_level >= Message::PRIO_INFORMATION) logFormat(Message::PRIO_INFORMATION, fmt, value1, value2, value3);
 }
 
 
 inline void Logger::information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4), Message::PRIO_INFORMATION);
+	if (_level >= Message::PRIO_INFORMATION) logFormat(Message::PRIO_INFORMATION, fmt, value1, value2, value3, value4);
 }
 
 
 inline void Logger::information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5), Message::PRIO_INFORMATION);
+	if (_level >= Message::PRIO_INFORMATION) logFormat(Message::PRIO_INFORMATION, fmt, value1, value2, value3, value4, value5);
 }
 
 
 inline void Logger::information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6), Message::PRIO_INFORMATION);
+	if (_level >= Message::PRIO_INFORMATION) logFormat(Message::PRIO_INFORMATION, fmt, value1, value2, value3, value4, value5, value6);
 }
 
 
@@ -974,37 +1074,37 @@ inline void Logger::debug(const std::string& msg, const char* file, int line)
 
 inline void Logger::debug(const std::string& fmt, const Any& value1)
 {
-	log(Poco::format(fmt, value1), Message::PRIO_DEBUG);
+	if (_level >= Message::PRIO_DEBUG) logFormat(Message::PRIO_DEBUG, fmt, value1);
 }
 
 
 inline void Logger::debug(const std::string& fmt, const Any& value1, const Any& value2)
 {
-	log(Poco::format(fmt, value1, value2), Message::PRIO_DEBUG);
+	if (_level >= Message::PRIO_DEBUG) logFormat(Message::PRIO_DEBUG, fmt, value1, value2);
 }
 
 
 inline void Logger::debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
 {
-	log(Poco::format(fmt, value1, value2, value3), Message::PRIO_DEBUG);
+	if (_level >= Message::PRIO_DEBUG) logFormat(Message::PRIO_DEBUG, fmt, value1, value2, value3);
 }
 
 
 inline void Logger::debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4), Message::PRIO_DEBUG);
+	if (_level >= Message::PRIO_DEBUG) logFormat(Message::PRIO_DEBUG, fmt, value1, value2, value3, value4);
 }
 
 
 inline void Logger::debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5), Message::PRIO_DEBUG);
+	if (_level >= Message::PRIO_DEBUG) logFormat(Message::PRIO_DEBUG, fmt, value1, value2, value3, value4, value5);
 }
 
 
 inline void Logger::debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6), Message::PRIO_DEBUG);
+	if (_level >= Message::PRIO_DEBUG) logFormat(Message::PRIO_DEBUG, fmt, value1, value2, value3, value4, value5, value6);
 }
 
 
@@ -1022,37 +1122,37 @@ inline void Logger::trace(const std::string& msg, const char* file, int line)
 
 inline void Logger::trace(const std::string& fmt, const Any& value1)
 {
-	log(Poco::format(fmt, value1), Message::PRIO_TRACE);
+	if (_level >= Message::PRIO_TRACE) logFormat(Message::PRIO_TRACE, fmt, value1);
 }
 
 
 inline void Logger::trace(const std::string& fmt, const Any& value1, const Any& value2)
 {
-	log(Poco::format(fmt, value1, value2), Message::PRIO_TRACE);
+	if (_level >= Message::PRIO_TRACE) logFormat(Message::PRIO_TRACE, fmt, value1, value2);
 }
 
 
 inline void Logger::trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
 {
-	log(Poco::format(fmt, value1, value2, value3), Message::PRIO_TRACE);
+	if (_level >= Message::PRIO_TRACE) logFormat(Message::PRIO_TRACE, fmt, value1, value2, value3);
 }
 
 
 inline void Logger::trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4), Message::PRIO_TRACE);
+	if (_level >= Message::PRIO_TRACE) logFormat(Message::PRIO_TRACE, fmt, value1, value2, value3, value4);
 }
 
 
 inline void Logger::trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5), Message::PRIO_TRACE);
+	if (_level >= Message::PRIO_TRACE) logFormat(Message::PRIO_TRACE, fmt, value1, value2, value3, value4, value5);
 }
 
 
 inline void Logger::trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6), Message::PRIO_TRACE);
+	if (_level >= Message::PRIO_TRACE) logFormat(Message::PRIO_TRACE, fmt, value1, value2, value3, value4, value5, value6);
 }
 
 
@@ -1110,6 +1210,33 @@ inline bool Logger::trace() const
 }
 
 
+inline Logger& LoggerHandle::logger() const
+{
+	if (AtomicOps::load(&_generation) == Logger::generation())
+		return *static_cast<Logger*>(AtomicOps::load(&_pLogger));
+	else
+		return refresh();
+}
+
+
+inline Logger& LoggerHandle::operator * () const
+{
+	return logger();
+}
+
+
+inline Logger* LoggerHandle::operator -> () const
+{
+	return &logger();
+}
+
+
+inline const std::string& LoggerHandle::name() const
+{
+	return _name;
+}
+
+
 } // namespace Poco
 
 
@@ -61,11 +61,34 @@ class Foundation_API MemoryPool
 	/// All allocated blocks are retained for future use.
 	/// A limit on the number of blocks can be specified.
 	/// Blocks can be preallocated.
+	///
+	/// Optionally, a MemoryPool can keep a small cache of
+	/// blocks (a "magazine") for every thread using the pool.
+	/// get() and release() then only access the pool's
+	/// shared list of blocks, which is protected by a mutex,
+	/// when a thread's cache runs empty or is full. Blocks are
+	/// moved between the caches and the shared list in batches
+	/// of half the cache size. Thread caches are only used by
+	/// threads created with Poco::Thread. Other threads (such as
+	/// the main thread) always use the shared list.
+	///
+	/// A thread cache lives in the thread's thread local storage,
+	/// so its blocks are returned to the pool when the thread
+	/// terminates, or when a ThreadPool thread has finished
+	/// running a task. Blocks still held by a thread cache when
+	/// the pool is destroyed are freed when the thread terminates.
 {
 public:
 	MemoryPool(std::size_t blockSize, int preAlloc = 0, int maxAlloc = 0);
 		/// Creates a MemoryPool for blocks with the given blockSize.
 		/// The number of blocks given in preAlloc are preallocated.
+
+	MemoryPool(std::size_t blockSize, int preAlloc, int maxAlloc, int threadCacheSize);
+		/// Creates a MemoryPool for blocks with the given blockSize.
+		/// The number of blocks given in preAlloc are preallocated.
+		///
+		/// If threadCacheSize is greater than zero, every thread
+		/// caches up to threadCacheSize blocks.
 		
 	~MemoryPool();
 
@@ -87,6 +110,26 @@ public:
 		
 	int available() const;
 		/// Returns the number of available blocks in the pool.
+		///
+		/// Blocks held in thread caches are not included.
+
+	int threadCacheSize() const;
+		/// Returns the maximum number of blocks cached per thread,
+		/// or 0 if the pool does not use thread caches.
+
+	UInt64 cacheHits() const;
+		/// Returns the number of calls to get() that
+		/// have been served from a thread cache.
+		///
+		/// The statistics of a thread are added up whenever
+		/// its cache exchanges blocks with the pool's shared list
+		/// of blocks, and when the thread cache is destroyed.
+
+	UInt64 cacheMisses() const;
+		/// Returns the number of calls to get() that found
+		/// the calling thread's cache empty.
+		///
+		/// See cacheHits() for when the statistics are updated.
 
 private:
 	MemoryPool();
@@ -99,12 +142,26 @@ private:
 	};
 	
 	typedef std::vector<char*> BlockVec;
+
+	class ThreadCache;
+
+	void init(int preAlloc, int maxAlloc);
+	char* getBlock();
+	void releaseBlock(char* ptr);
+	char* refill(BlockVec& blocks, std::size_t count, UInt64 hits, UInt64 misses);
+	void drain(BlockVec& blocks, std::size_t count, UInt64 hits, UInt64 misses);
 	
-	std::size_t _blockSize;
-	int         _maxAlloc;
-	int         _allocated;
-	BlockVec    _blocks;
-	FastMutex   _mutex;
+	std::size_t  _blockSize;
+	int          _threadCacheSize;
+	int          _maxAlloc;
+	int          _allocated;
+	BlockVec     _blocks;
+	ThreadCache* _pCache;
+	UInt64       _hits;
+	UInt64       _misses;
+	mutable FastMutex _mutex;
+
+	friend class ThreadCache;
 };
 
 
@@ -129,6 +186,28 @@ inline int MemoryPool::available() const
 }
 
 
+inline int MemoryPool::threadCacheSize() const
+{
+	return _threadCacheSize;
+}
+
+
+inline UInt64 MemoryPool::cacheHits() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _hits;
+}
+
+
+inline UInt64 MemoryPool::cacheMisses() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _misses;
+}
+
+
 } // namespace Poco
 
 
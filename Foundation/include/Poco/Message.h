@@ -189,6 +189,14 @@ public:
 		/// If the parameter does not exist, it is created with an
 		/// empty string value.
 
+	bool has(const std::string& param) const;
+		/// Returns true if a parameter with the given name exists.
+
+	const std::string& get(const std::string& param, const std::string& defaultValue) const;
+		/// Returns a const reference to the value of the parameter
+		/// with the given name. If the parameter does not exist,
+		/// defaultValue is returned.
+
 protected:
 	void init();
 	typedef std::map<std::string, std::string> StringMap;
@@ -0,0 +1,148 @@
+//
+// NotificationQueueAdapter.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  NotificationQueueAdapter
+//
+// Definition of the NotificationQueueAdapter class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_NotificationQueueAdapter_INCLUDED
+#define Foundation_NotificationQueueAdapter_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/AbstractNotificationQueue.h"
+#include "Poco/InterfaceAdapter.h"
+#include "Poco/NotificationQueue.h"
+#include "Poco/LockFreeNotificationQueue.h"
+
+
+namespace Poco {
+
+
+template <class Q>
+class NotificationQueueAdapter: public InterfaceAdapter<AbstractNotificationQueue, Q>
+	/// Implements the AbstractNotificationQueue interface
+	/// for NotificationQueue or LockFreeNotificationQueue.
+	/// The adapter creates and owns the queue.
+	///
+	/// Example:
+	///     AbstractNotificationQueue* pQueue = lockFree
+	///         ? static_cast<AbstractNotificationQueue*>(new NotificationQueueAdapter<LockFreeNotificationQueue>(capacity))
+	///         : new NotificationQueueAdapter<NotificationQueue>;
+{
+public:
+	typedef InterfaceAdapter<AbstractNotificationQueue, Q> Base;
+
+	NotificationQueueAdapter()
+	{
+	}
+
+	explicit NotificationQueueAdapter(std::size_t capacity):
+		Base(capacity)
+		/// Creates the adapter for a bounded queue with
+		/// the given capacity.
+	{
+	}
+
+	~NotificationQueueAdapter()
+	{
+	}
+
+	void enqueueNotification(Notification::Ptr pNotification)
+	{
+		this->_adaptee.enqueueNotification(pNotification);
+	}
+
+	bool tryEnqueueNotification(Notification::Ptr pNotification)
+	{
+		return this->_adaptee.tryEnqueueNotification(pNotification);
+	}
+
+	Notification* waitDequeueNotification()
+	{
+		return this->_adaptee.waitDequeueNotification();
+	}
+
+	Notification* waitDequeueNotification(long milliseconds)
+	{
+		return this->_adaptee.waitDequeueNotification(milliseconds);
+	}
+
+	void wakeUpAll()
+	{
+		this->_adaptee.wakeUpAll();
+	}
+
+	bool empty() const
+	{
+		return this->_adaptee.empty();
+	}
+
+	int size() const
+	{
+		return this->_adaptee.size();
+	}
+
+	void clear()
+	{
+		this->_adaptee.clear();
+	}
+
+	bool hasIdleThreads() const
+	{
+		return this->_adaptee.hasIdleThreads();
+	}
+
+	Q& queue()
+		/// Returns the adapted queue.
+	{
+		return this->_adaptee;
+	}
+};
+
+
+template <>
+inline bool NotificationQueueAdapter<NotificationQueue>::tryEnqueueNotification(Notification::Ptr pNotification)
+	/// A NotificationQueue is unbounded, so
+	/// enqueueing always succeeds.
+{
+	this->_adaptee.enqueueNotification(pNotification);
+	return true;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_NotificationQueueAdapter_INCLUDED
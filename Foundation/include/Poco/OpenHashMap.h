@@ -0,0 +1,219 @@
+//
+// OpenHashMap.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Hashing
+// Module:  OpenHashMap
+//
+// Definition of the OpenHashMap class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_OpenHashMap_INCLUDED
+#define Foundation_OpenHashMap_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/OpenHashTable.h"
+#include "Poco/HashMap.h"
+#include "Poco/Exception.h"
+#include <utility>
+
+
+namespace Poco {
+
+
+template <class Key, class Mapped, class HashFunc = Hash<Key> >
+class OpenHashMap
+	/// This class implements a map using an OpenHashTable.
+	///
+	/// An OpenHashMap can be used just like a std::map, or
+	/// a HashMap. Unlike with a HashMap, inserting or erasing
+	/// an element invalidates all iterators.
+	///
+	/// Elements can also be looked up and erased using a key of a
+	/// different type, like a const char* for a std::string key
+	/// (see OpenHashTable).
+{
+public:
+	typedef Key                 KeyType;
+	typedef Mapped              MappedType;
+	typedef Mapped&             Reference;
+	typedef const Mapped&       ConstReference;
+	typedef Mapped*             Pointer;
+	typedef const Mapped*       ConstPointer;
+	
+	typedef HashMapEntry<Key, Mapped>      ValueType;
+	typedef std::pair<KeyType, MappedType> PairType;
+	
+	typedef HashMapEntryHash<ValueType, HashFunc> HashType;
+	typedef OpenHashTable<ValueType, HashType>    HashTable;
+	
+	typedef typename HashTable::Iterator      Iterator;
+	typedef typename HashTable::ConstIterator ConstIterator;
+	
+	OpenHashMap()
+		/// Creates an empty OpenHashMap.
+	{
+	}
+	
+	OpenHashMap(std::size_t initialReserve):
+		_table(initialReserve)
+		/// Creates the OpenHashMap with room for initialReserve entries.
+	{
+	}
+	
+	OpenHashMap(const OpenHashMap& map):
+		_table(map._table)
+		/// Creates the OpenHashMap by copying another one.
+	{
+	}
+	
+	OpenHashMap& operator = (const OpenHashMap& map)
+		/// Assigns another OpenHashMap.
+	{
+		OpenHashMap tmp(map);
+		swap(tmp);
+		return *this;
+	}
+	
+	void swap(OpenHashMap& map)
+		/// Swaps the OpenHashMap with another one.
+	{
+		_table.swap(map._table);
+	}
+	
+	ConstIterator begin() const
+	{
+		return _table.begin();
+	}
+	
+	ConstIterator end() const
+	{
+		return _table.end();
+	}
+	
+	Iterator begin()
+	{
+		return _table.begin();
+	}
+	
+	Iterator end()
+	{
+		return _table.end();
+	}
+	
+	template <class K>
+	ConstIterator find(const K& key) const
+	{
+		return _table.find(key);
+	}
+
+	template <class K>
+	Iterator find(const K& key)
+	{
+		return _table.find(key);
+	}
+
+	template <class K>
+	std::size_t count(const K& key) const
+	{
+		return _table.count(key);
+	}
+
+	std::pair<Iterator, bool> insert(const PairType& pair)
+	{
+		ValueType value(pair.first, pair.second);
+		return _table.insert(value);
+	}
+
+	std::pair<Iterator, bool> insert(const ValueType& value)
+	{
+		return _table.insert(value);
+	}
+	
+	void erase(Iterator it)
+	{
+		_table.erase(it);
+	}
+	
+	template <class K>
+	void erase(const K& key)
+	{
+		_table.erase(key);
+	}
+	
+	void clear()
+	{
+		_table.clear();
+	}
+
+	void reserve(std::size_t n)
+	{
+		_table.reserve(n);
+	}
+
+	std::size_t size() const
+	{
+		return _table.size();
+	}
+
+	bool empty() const
+	{
+		return _table.empty();
+	}
+
+	ConstReference operator [] (const KeyType& key) const
+	{
+		ConstIterator it = _table.find(key);
+		if (it != _table.end())
+			return it->second;
+		else
+			throw NotFoundException();
+	}
+
+	Reference operator [] (const KeyType& key)
+	{
+		Iterator it = _table.find(key);
+		if (it != _table.end()) return it->second;
+		ValueType value(key);
+		std::pair<Iterator, bool> res = _table.insert(value);
+		return res.first->second;
+	}
+
+private:
+	HashTable _table;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_OpenHashMap_INCLUDED
@@ -0,0 +1,607 @@
+//
+// OpenHashTable.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Hashing
+// Module:  OpenHashTable
+//
+// Definition of the OpenHashTable class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_OpenHashTable_INCLUDED
+#define Foundation_OpenHashTable_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Hash.h"
+#include "Poco/Exception.h"
+#include <iterator>
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+template <class Value, class HashFunc = Hash<Value> >
+class OpenHashTable
+	/// This class implements a hash table using open addressing
+	/// with linear probing and Robin Hood hashing.
+	///
+	/// All elements are stored in a single array of slots. Every
+	/// slot also holds the distance of its element from the slot its
+	/// hash value points to (or 0 for an empty slot). Lookups scan a
+	/// few adjacent slots, which are usually in the same cache line,
+	/// and never follow pointers.
+	/// When inserting, an element takes the slot of an element that
+	/// is closer to its own preferred slot (Robin Hood hashing), which
+	/// keeps probe sequences short even at high load factors. Erasing
+	/// an element shifts the following elements back, so no
+	/// "deleted" markers are needed.
+	///
+	/// The table grows by doubling its size if more than 7/8
+	/// of the slots are used. The table never shrinks, except
+	/// through swap() or assignment.
+	///
+	/// The OpenHashTable is not thread safe.
+	///
+	/// Value must be default-constructible, swappable
+	/// and support comparison for equality.
+	///
+	/// Elements can be looked up using a key of a different type K,
+	/// as long as HashFunc provides an operator () (const K&) that
+	/// returns the same hash value as for an equal Value, and
+	/// Value == K is defined. This allows to find std::string elements
+	/// using a const char* (see Hash<std::string>), without creating
+	/// a temporary std::string.
+	///
+	/// Inserting and erasing elements invalidates all iterators.
+	///
+	/// An element can be stored at most 254 slots away from its
+	/// preferred slot. If an insertion would exceed this distance,
+	/// the table grows once; if this does not help, e.g. because
+	/// too many elements have the same hash value, insert() throws
+	/// a RangeException.
+{
+public:
+	typedef Value               ValueType;
+	typedef Value&              Reference;
+	typedef const Value&        ConstReference;
+	typedef Value*              Pointer;
+	typedef const Value*        ConstPointer;
+	typedef HashFunc            Hash;
+
+	struct Slot
+		/// A slot of the table, holding an element and its
+		/// distance from its preferred slot, or 0 if the slot
+		/// is empty. Used internally by OpenHashTable.
+	{
+		Slot():
+			dist(0),
+			value()
+		{
+		}
+
+		UInt8 dist;
+		Value value;
+	};
+
+	typedef std::vector<Slot> SlotVec;
+
+	class ConstIterator: public std::iterator<std::forward_iterator_tag, Value>
+	{
+	public:
+		ConstIterator():
+			_pSlot(0)
+		{
+		}
+
+		ConstIterator(Slot* pSlot):
+			_pSlot(pSlot)
+		{
+		}
+
+		bool operator == (const ConstIterator& it) const
+		{
+			return _pSlot == it._pSlot;
+		}
+
+		bool operator != (const ConstIterator& it) const
+		{
+			return _pSlot != it._pSlot;
+		}
+
+		const Value& operator * () const
+		{
+			return _pSlot->value;
+		}
+
+		const Value* operator -> () const
+		{
+			return &_pSlot->value;
+		}
+
+		ConstIterator& operator ++ () // prefix
+		{
+			// the slot array ends with a non-empty sentinel
+			do
+			{
+				++_pSlot;
+			}
+			while (_pSlot->dist == 0);
+			return *this;
+		}
+
+		ConstIterator operator ++ (int) // postfix
+		{
+			ConstIterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+	protected:
+		Slot* _pSlot;
+
+		friend class OpenHashTable;
+	};
+
+	class Iterator: public ConstIterator
+	{
+	public:
+		Iterator()
+		{
+		}
+
+		Iterator(Slot* pSlot):
+			ConstIterator(pSlot)
+		{
+		}
+
+		Value& operator * ()
+		{
+			return this->_pSlot->value;
+		}
+
+		const Value& operator * () const
+		{
+			return this->_pSlot->value;
+		}
+
+		Value* operator -> ()
+		{
+			return &this->_pSlot->value;
+		}
+
+		const Value* operator -> () const
+		{
+			return &this->_pSlot->value;
+		}
+
+		Iterator& operator ++ () // prefix
+		{
+			ConstIterator::operator ++ ();
+			return *this;
+		}
+
+		Iterator operator ++ (int) // postfix
+		{
+			Iterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+		friend class OpenHashTable;
+	};
+
+	OpenHashTable(std::size_t initialReserve = 64):
+		_size(0)
+		/// Creates the OpenHashTable, with room for at least
+		/// initialReserve elements.
+	{
+		allocate(calcCapacity(initialReserve));
+	}
+
+	OpenHashTable(std::size_t initialReserve, const HashFunc& hash):
+		_size(0),
+		_hash(hash)
+		/// Creates the OpenHashTable, with room for at least
+		/// initialReserve elements, using the given hash
+		/// function object (e.g., a SeededHash with a
+		/// specific seed).
+	{
+		allocate(calcCapacity(initialReserve));
+	}
+
+	OpenHashTable(const OpenHashTable& table):
+		_slots(table._slots),
+		_mask(table._mask),
+		_shift(table._shift),
+		_limit(table._limit),
+		_size(table._size),
+		_hash(table._hash)
+		/// Creates the OpenHashTable by copying another one.
+	{
+	}
+
+	~OpenHashTable()
+		/// Destroys the OpenHashTable.
+	{
+	}
+
+	OpenHashTable& operator = (const OpenHashTable& table)
+		/// Assigns another OpenHashTable.
+	{
+		OpenHashTable tmp(table);
+		swap(tmp);
+		return *this;
+	}
+
+	void swap(OpenHashTable& table)
+		/// Swaps the OpenHashTable with another one.
+	{
+		using std::swap;
+		swap(_slots, table._slots);
+		swap(_mask, table._mask);
+		swap(_shift, table._shift);
+		swap(_limit, table._limit);
+		swap(_size, table._size);
+		swap(_hash, table._hash);
+	}
+
+	ConstIterator begin() const
+		/// Returns an iterator pointing to the first entry, if one exists.
+	{
+		ConstIterator it(&_slots[0]);
+		if (_slots[0].dist == 0) ++it;
+		return it;
+	}
+
+	ConstIterator end() const
+		/// Returns an iterator pointing to the end of the table.
+	{
+		return ConstIterator(&_slots[0] + _mask + 1);
+	}
+
+	Iterator begin()
+		/// Returns an iterator pointing to the first entry, if one exists.
+	{
+		Iterator it(&_slots[0]);
+		if (_slots[0].dist == 0) ++it;
+		return it;
+	}
+
+	Iterator end()
+		/// Returns an iterator pointing to the end of the table.
+	{
+		return Iterator(&_slots[0] + _mask + 1);
+	}
+
+	template <class K>
+	ConstIterator find(const K& key) const
+		/// Finds an entry in the table.
+	{
+		std::size_t i = lookup(key);
+		if (i <= _mask)
+			return ConstIterator(&_slots[i]);
+		else
+			return end();
+	}
+
+	template <class K>
+	Iterator find(const K& key)
+		/// Finds an entry in the table.
+	{
+		std::size_t i = lookup(key);
+		if (i <= _mask)
+			return Iterator(&_slots[i]);
+		else
+			return end();
+	}
+
+	template <class K>
+	std::size_t count(const K& key) const
+		/// Returns the number of elements with the given
+		/// key, with is either 1 or 0.
+	{
+		return lookup(key) <= _mask ? 1 : 0;
+	}
+
+	std::pair<Iterator, bool> insert(const Value& value)
+		/// Inserts an element into the table.
+		///
+		/// If the element already exists in the table,
+		/// a pair(iterator, false) with iterator pointing to the
+		/// existing element is returned.
+		/// Otherwise, the element is inserted an a
+		/// pair(iterator, true) with iterator
+		/// pointing to the new element is returned.
+		///
+		/// Throws a RangeException if the element cannot be
+		/// stored close enough to its preferred slot, even
+		/// after growing the table.
+	{
+		std::size_t hash = _hash(value);
+		std::size_t i = home(hash);
+		UInt8 dist = 1;
+		while (dist < MAX_DISTANCE && _slots[i].dist >= dist)
+		{
+			if (_slots[i].dist == dist && _slots[i].value == value)
+				return std::make_pair(Iterator(&_slots[i]), false);
+			i = (i + 1) & _mask;
+			++dist;
+		}
+		if (_size >= _limit)
+		{
+			grow();
+			i = probe(hash, dist);
+		}
+		if (!canPlace(i, dist))
+		{
+			// Growing spreads elements with different hash values,
+			// but not elements with the same hash value, so the
+			// table is grown only once for this reason.
+			grow();
+			i = probe(hash, dist);
+			if (!canPlace(i, dist)) throw RangeException("OpenHashTable", "too many elements with the same hash value");
+		}
+		Value tmp(value);
+		place(i, dist, tmp);
+		++_size;
+		return std::make_pair(Iterator(&_slots[i]), true);
+	}
+
+	void erase(Iterator it)
+		/// Erases the element pointed to by it.
+	{
+		if (it != end())
+		{
+			remove(static_cast<std::size_t>(it._pSlot - &_slots[0]));
+		}
+	}
+
+	template <class K>
+	void erase(const K& key)
+		/// Erases the element with the given key, if it exists.
+	{
+		std::size_t i = lookup(key);
+		if (i <= _mask) remove(i);
+	}
+
+	void clear()
+		/// Erases all elements. The capacity of the table
+		/// is not changed.
+	{
+		for (std::size_t i = 0; i <= _mask; ++i)
+		{
+			if (_slots[i].dist)
+			{
+				Value empty;
+				using std::swap;
+				swap(_slots[i].value, empty);
+				_slots[i].dist = 0;
+			}
+		}
+		_size = 0;
+	}
+
+	void reserve(std::size_t n)
+		/// Makes sure that n elements can be stored without
+		/// growing the table.
+	{
+		while (n > _limit) grow();
+	}
+
+	std::size_t size() const
+		/// Returns the number of elements in the table.
+	{
+		return _size;
+	}
+
+	bool empty() const
+		/// Returns true iff the table is empty.
+	{
+		return _size == 0;
+	}
+
+	std::size_t buckets() const
+		/// Returns the number of allocated slots.
+	{
+		return _mask + 1;
+	}
+
+protected:
+	enum
+	{
+		MAX_DISTANCE = 255
+			/// Stored distances are always less than MAX_DISTANCE.
+			/// The sentinel slot at the end uses MAX_DISTANCE.
+	};
+
+	std::size_t home(std::size_t hash) const
+		/// Returns the preferred slot for the given hash value.
+		/// Multiplying with the golden ratio and using the upper
+		/// bits of the result spreads hash values that only differ
+		/// in their upper bits, or are multiples of a power of two.
+	{
+#if defined(POCO_PTR_IS_64_BIT)
+		return static_cast<std::size_t>((static_cast<UInt64>(hash)*0x9E3779B97F4A7C15ULL) >> _shift);
+#else
+		return static_cast<std::size_t>((static_cast<UInt32>(hash)*0x9E3779B9U) >> _shift);
+#endif
+	}
+
+	template <class K>
+	std::size_t lookup(const K& key) const
+		/// Returns the slot of the element with the given key,
+		/// or a value greater than _mask if there is none.
+	{
+		std::size_t i = home(_hash(key));
+		UInt8 dist = 1;
+		while (dist < MAX_DISTANCE && _slots[i].dist >= dist)
+		{
+			if (_slots[i].dist == dist && _slots[i].value == key) return i;
+			i = (i + 1) & _mask;
+			++dist;
+		}
+		return _mask + 1;
+	}
+
+	std::size_t probe(std::size_t hash, UInt8& dist) const
+		/// Returns the slot where an element with the given
+		/// hash value must be placed, and its distance from
+		/// the preferred slot in dist.
+	{
+		std::size_t i = home(hash);
+		dist = 1;
+		while (dist < MAX_DISTANCE && _slots[i].dist >= dist)
+		{
+			i = (i + 1) & _mask;
+			++dist;
+		}
+		return i;
+	}
+
+	bool canPlace(std::size_t i, UInt8 dist) const
+		/// Returns true if an element can be placed at slot i,
+		/// with distance dist, without exceeding MAX_DISTANCE.
+		///
+		/// Placing an element moves all elements up to the next
+		/// empty slot one slot further, so their distances grow by one.
+	{
+		if (dist >= MAX_DISTANCE) return false;
+		while (_slots[i].dist != 0)
+		{
+			if (_slots[i].dist >= MAX_DISTANCE - 1) return false;
+			i = (i + 1) & _mask;
+		}
+		return true;
+	}
+
+	void place(std::size_t i, UInt8 dist, Value& value)
+		/// Stores value (by swapping) in the empty or "richer"
+		/// slot i, and moves the displaced elements further.
+		/// The caller must make sure that no distance exceeds
+		/// MAX_DISTANCE, by checking canPlace().
+	{
+		using std::swap;
+		while (_slots[i].dist != 0)
+		{
+			if (_slots[i].dist < dist)
+			{
+				swap(_slots[i].value, value);
+				swap(_slots[i].dist, dist);
+			}
+			i = (i + 1) & _mask;
+			++dist;
+			poco_assert (dist < MAX_DISTANCE);
+		}
+		swap(_slots[i].value, value);
+		_slots[i].dist = dist;
+	}
+
+	void insertUnique(Value& value)
+		/// Places an element when growing the table. Doubling the
+		/// size never increases the distance of an element from
+		/// its preferred slot, so this always succeeds.
+	{
+		UInt8 dist;
+		std::size_t i = probe(_hash(value), dist);
+		place(i, dist, value);
+	}
+
+	void remove(std::size_t i)
+	{
+		using std::swap;
+		std::size_t next = (i + 1) & _mask;
+		while (_slots[next].dist > 1)
+		{
+			swap(_slots[i].value, _slots[next].value);
+			_slots[i].dist = static_cast<UInt8>(_slots[next].dist - 1);
+			i = next;
+			next = (next + 1) & _mask;
+		}
+		Value empty;
+		swap(_slots[i].value, empty);
+		_slots[i].dist = 0;
+		--_size;
+	}
+
+	void grow()
+	{
+		SlotVec slots;
+		slots.swap(_slots);
+		std::size_t capacity = slots.size() - 1;
+		allocate(2*capacity);
+		for (std::size_t i = 0; i < capacity; ++i)
+		{
+			if (slots[i].dist) insertUnique(slots[i].value);
+		}
+	}
+
+	void allocate(std::size_t capacity)
+	{
+		// one extra sentinel slot for iterators
+		_slots.resize(capacity + 1);
+		_slots[capacity].dist = MAX_DISTANCE;
+		_mask = capacity - 1;
+		_shift = 8*sizeof(std::size_t);
+		while (capacity > 1)
+		{
+			--_shift;
+			capacity /= 2;
+		}
+		_limit = _mask + 1 - (_mask + 1)/8;
+	}
+
+	static std::size_t calcCapacity(std::size_t initialReserve)
+	{
+		std::size_t capacity = 8;
+		while (capacity - capacity/8 < initialReserve) capacity *= 2;
+		return capacity;
+	}
+
+private:
+	// Just as in LinearHashTable, _slots must be mutable because
+	// ConstIterator holds a non-const pointer.
+	mutable SlotVec _slots;
+	std::size_t     _mask;
+	unsigned        _shift;
+	std::size_t     _limit;
+	std::size_t     _size;
+	HashFunc        _hash;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_OpenHashTable_INCLUDED
@@ -43,7 +43,8 @@
 #include "Poco/Foundation.h"
 #include "Poco/Formatter.h"
 #include "Poco/Message.h"
-
+#include "Poco/DateTime.h"
+#include "Poco/Mutex.h"
 #include <vector>
 
 namespace Poco {
@@ -95,6 +96,14 @@ class Foundation_API PatternFormatter: public Formatter
 	///   * %v[width] - the message source (%s) but text length is padded/cropped to 'width'
 	///   * %[name] - the value of the message parameter with the given name
 	///   * %% - percent sign
+	///
+	/// The format pattern is parsed only once, when it is set. Consecutive
+	/// date and time fields that change at most once per second (like
+	/// "%Y-%m-%d %H:%M:%S") are formatted only once per second; the
+	/// result is cached and reused for all messages logged within the same
+	/// second. To keep contention low if multiple threads use the same
+	/// PatternFormatter, there is a small number of caches, and every
+	/// thread uses the one selected by its thread ID.
 
 {
 public:
@@ -138,6 +147,12 @@ public:
 protected:
 	static const std::string& getPriorityName(int);
 		/// Returns a string for the given priority value.
+
+	static int cacheIndex();
+		/// Returns the index of the cache used by the calling
+		/// thread. Threads created by Poco::Thread are distributed
+		/// over the caches according to their id, other threads
+		/// according to a hash of their thread id.
 	
 private:
 
@@ -151,16 +166,51 @@ private:
 		std::string prepend;
 	};
 
-	std::vector<PatternAction>  _patternActions;
+	typedef std::vector<PatternAction> ActionVec;
+
+	struct Cache
+		/// Caches the formatted date/time runs for one second.
+	{
+		Cache(): seconds(0), valid(false), sizeHint(0) {}
+
+		FastMutex                mutex;
+		Timestamp::TimeVal       seconds;
+		bool                     valid;
+		std::vector<std::string> runs;
+		std::string::size_type   sizeHint;
+	};
+
+	enum
+	{
+		CACHE_COUNT = 16
+	};
+
+	ActionVec                   _patternActions;
+	std::vector<ActionVec>      _runs;
 	bool                        _localTime;
 	Timestamp::TimeDiff         _localTimeOffset;
 	std::string                 _pattern;
+	Cache                       _caches[CACHE_COUNT];
 
 
 	void ParsePattern();
 		/// Will parse the _pattern string into the vector of PatternActions,
 		/// which contains the message key, any text that needs to be written first
 		/// a proprety in case of %[] and required length.
+		///
+		/// Consecutive actions that change at most once per second are
+		/// combined into runs, which are stored in _runs.
+
+	void formatAction(const PatternAction& action, const Message& msg, int micros, std::string& text) const;
+		/// Formats a single action that is not part of a run and
+		/// appends the result to text. micros is the fractional
+		/// part of the message's time, in microseconds.
+
+	void formatRun(const ActionVec& run, const Message& msg, const DateTime& dateTime, std::string& text) const;
+		/// Formats all actions of a run and appends the result to text.
+
+	void invalidateCaches();
+		/// Invalidates all caches.
 };
 
 
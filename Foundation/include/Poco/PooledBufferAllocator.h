@@ -0,0 +1,115 @@
+//
+// PooledBufferAllocator.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Streams
+// Module:  PooledBufferAllocator
+//
+// Definition of the PooledBufferAllocator class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_PooledBufferAllocator_INCLUDED
+#define Foundation_PooledBufferAllocator_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/MemoryPool.h"
+#include "Poco/SingletonHolder.h"
+#include <ios>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+template <typename ch, std::size_t SIZE, int CACHE_SIZE = 16>
+class PooledBufferAllocator
+	/// A BufferAllocator for stream buffers that takes
+	/// buffers of SIZE characters from a MemoryPool with
+	/// thread caches, so that creating and destroying stream
+	/// buffers does not require a lock in most cases.
+	///
+	/// Buffers of other sizes are allocated with new.
+	///
+	/// Thread caches are only used by threads created with
+	/// Poco::Thread. Other threads, such as the main thread,
+	/// take the pool's mutex for every allocate() and
+	/// deallocate() call.
+	///
+	/// Example:
+	///     typedef BasicBufferedStreamBuf<char, std::char_traits<char>, PooledBufferAllocator<char, 1024> > MyStreamBuf;
+{
+public:
+	typedef ch char_type;
+
+	static char_type* allocate(std::streamsize size)
+	{
+		if (size == static_cast<std::streamsize>(SIZE))
+			return reinterpret_cast<char_type*>(memoryPool().get());
+		else
+			return new char_type[static_cast<std::size_t>(size)];
+	}
+	
+	static void deallocate(char_type* ptr, std::streamsize size)
+	{
+		if (size == static_cast<std::streamsize>(SIZE))
+			memoryPool().release(ptr);
+		else
+			delete [] ptr;
+	}
+
+	static const MemoryPool& pool()
+		/// Returns the MemoryPool used by the allocator.
+	{
+		return memoryPool();
+	}
+
+private:
+	class Pool: public MemoryPool
+	{
+	public:
+		Pool(): MemoryPool(SIZE*sizeof(ch), 0, 0, CACHE_SIZE)
+		{
+		}
+	};
+
+	static MemoryPool& memoryPool()
+	{
+		static SingletonHolder<Pool> sh;
+		return *sh.get();
+	}
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_PooledBufferAllocator_INCLUDED
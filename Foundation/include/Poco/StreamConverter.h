@@ -57,6 +57,10 @@ class Foundation_API StreamConverterBuf: public UnbufferedStreamBuf
 	/// is used instead.
 	/// If a byte sequence is not valid in inEncoding, defaultChar is used
 	/// instead and the encoding error count is incremented.
+	///
+	/// If both encodings are ASCII compatible, runs of ASCII
+	/// characters (and, from UTF-8 to UTF-8, runs of legal
+	/// UTF-8 sequences) are copied without conversion.
 {
 public:
 	StreamConverterBuf(std::istream& istr, const TextEncoding& inEncoding, const TextEncoding& outEncoding, int defaultChar = '?');
@@ -76,6 +80,8 @@ public:
 protected:
 	int readFromDevice();
 	int writeToDevice(char c);
+	std::streamsize readBlockFromDevice(char* buffer, std::streamsize length);
+	std::streamsize writeBlockToDevice(const char* buffer, std::streamsize length);
 
 private:
 	std::istream*       _pIstr;
@@ -87,6 +93,8 @@ private:
 	int                 _sequenceLength;
 	int                 _pos;
 	int                 _errors;
+	bool                _ascii;
+	bool                _utf8;
 };
 
 
@@ -133,16 +133,63 @@ S& trimInPlace(S& str)
 }
 
 
+namespace Impl {
+
+	template <class C>
+	void toUpperInPlace(C* str, std::size_t length)
+	{
+		for (C* end = str + length; str != end; ++str) *str = static_cast<C>(Ascii::toUpper(*str));
+	}
+
+	inline void toUpperInPlace(char* str, std::size_t length)
+	{
+		Ascii::toUpperInPlace(str, length);
+	}
+
+	template <class C>
+	void toLowerInPlace(C* str, std::size_t length)
+	{
+		for (C* end = str + length; str != end; ++str) *str = static_cast<C>(Ascii::toLower(*str));
+	}
+
+	inline void toLowerInPlace(char* str, std::size_t length)
+	{
+		Ascii::toLowerInPlace(str, length);
+	}
+
+	template <class C>
+	int icompare(const C* str1, std::size_t n1, const C* str2, std::size_t n2)
+	{
+		const C* end1 = str1 + (n1 < n2 ? n1 : n2);
+		while (str1 != end1)
+		{
+			C c1(static_cast<C>(Ascii::toLower(*str1)));
+			C c2(static_cast<C>(Ascii::toLower(*str2)));
+			if (c1 < c2)
+				return -1;
+			else if (c1 > c2)
+				return 1;
+			++str1; ++str2;
+		}
+		return n1 < n2 ? -1 : (n1 > n2 ? 1 : 0);
+	}
+
+	inline int icompare(const char* str1, std::size_t n1, const char* str2, std::size_t n2)
+	{
+		int result = Ascii::icompare(str1, str2, n1 < n2 ? n1 : n2);
+		if (result == 0) result = n1 < n2 ? -1 : (n1 > n2 ? 1 : 0);
+		return result;
+	}
+
+} // namespace Impl
+
+
 template <class S>
 S toUpper(const S& str)
 	/// Returns a copy of str containing all upper-case characters.
 {
-	typename S::const_iterator it  = str.begin();
-	typename S::const_iterator end = str.end();
-
-	S result;
-	result.reserve(str.size());
-	while (it != end) result += Ascii::toUpper(*it++);
+	S result(str);
+	if (!result.empty()) Impl::toUpperInPlace(&result[0], result.size());
 	return result;
 }
 
@@ -151,10 +198,7 @@ template <class S>
 S& toUpperInPlace(S& str)
 	/// Replaces all characters in str with their upper-case counterparts.
 {
-	typename S::iterator it  = str.begin();
-	typename S::iterator end = str.end();
-
-	while (it != end) { *it = Ascii::toUpper(*it); ++it; }
+	if (!str.empty()) Impl::toUpperInPlace(&str[0], str.size());
 	return str;
 }
 
@@ -163,12 +207,8 @@ template <class S>
 S toLower(const S& str)
 	/// Returns a copy of str containing all lower-case characters.
 {
-	typename S::const_iterator it  = str.begin();
-	typename S::const_iterator end = str.end();
-
-	S result;
-	result.reserve(str.size());
-	while (it != end) result += Ascii::toLower(*it++);
+	S result(str);
+	if (!result.empty()) Impl::toLowerInPlace(&result[0], result.size());
 	return result;
 }
 
@@ -177,10 +217,7 @@ template <class S>
 S& toLowerInPlace(S& str)
 	/// Replaces all characters in str with their lower-case counterparts.
 {
-	typename S::iterator it  = str.begin();
-	typename S::iterator end = str.end();
-
-	while (it != end) { *it = Ascii::toLower(*it); ++it; }
+	if (!str.empty()) Impl::toLowerInPlace(&str[0], str.size());
 	return str;
 }
 
@@ -224,33 +261,16 @@ template <class S>
 int icompare(const S& str1, const S& str2)
 	// A special optimization for an often used case.
 {
-	typename S::const_iterator it1(str1.begin());
-	typename S::const_iterator end1(str1.end());
-	typename S::const_iterator it2(str2.begin());
-	typename S::const_iterator end2(str2.end());
-	while (it1 != end1 && it2 != end2)
-	{
-		typename S::value_type c1(Ascii::toLower(*it1));
-		typename S::value_type c2(Ascii::toLower(*it2));
-		if (c1 < c2)
-			return -1;
-		else if (c1 > c2)
-			return 1;
-		++it1; ++it2;
-	}
-	
-	if (it1 == end1)
-		return it2 == end2 ? 0 : -1;
-	else
-		return 1;
+	return Impl::icompare(str1.data(), str1.size(), str2.data(), str2.size());
 }
 
 
 template <class S>
 int icompare(const S& str1, typename S::size_type n1, const S& str2, typename S::size_type n2)
 {
+	if (n1 > str1.size()) n1 = str1.size();
 	if (n2 > str2.size()) n2 = str2.size();
-	return icompare(str1, 0, n1, str2.begin(), str2.begin() + n2);
+	return Impl::icompare(str1.data(), n1, str2.data(), n2);
 }
 
 
@@ -258,14 +278,17 @@ template <class S>
 int icompare(const S& str1, typename S::size_type n, const S& str2)
 {
 	if (n > str2.size()) n = str2.size();
-	return icompare(str1, 0, n, str2.begin(), str2.begin() + n);
+	return icompare(str1, n, str2, n);
 }
 
 
 template <class S>
 int icompare(const S& str1, typename S::size_type pos, typename S::size_type n, const S& str2)
 {
-	return icompare(str1, pos, n, str2.begin(), str2.end());
+	typename S::size_type sz = str1.size();
+	if (pos > sz) pos = sz;
+	if (n > sz - pos) n = sz - pos;
+	return Impl::icompare(str1.data() + pos, n, str2.data(), str2.size());
 }
 
 
@@ -278,10 +301,13 @@ int icompare(
 	typename S::size_type pos2,
 	typename S::size_type n2)
 {
+	typename S::size_type sz1 = str1.size();
+	if (pos1 > sz1) pos1 = sz1;
+	if (n1 > sz1 - pos1) n1 = sz1 - pos1;
 	typename S::size_type sz2 = str2.size();
 	if (pos2 > sz2) pos2 = sz2;
-	if (pos2 + n2 > sz2) n2 = sz2 - pos2;
-	return icompare(str1, pos1, n1, str2.begin() + pos2, str2.begin() + pos2 + n2);
+	if (n2 > sz2 - pos2) n2 = sz2 - pos2;
+	return Impl::icompare(str1.data() + pos1, n1, str2.data() + pos2, n2);
 }
 
 
@@ -295,8 +321,8 @@ int icompare(
 {
 	typename S::size_type sz2 = str2.size();
 	if (pos2 > sz2) pos2 = sz2;
-	if (pos2 + n > sz2) n = sz2 - pos2;
-	return icompare(str1, pos1, n, str2.begin() + pos2, str2.begin() + pos2 + n);
+	if (n > sz2 - pos2) n = sz2 - pos2;
+	return icompare(str1, pos1, n, str2, pos2, n);
 }
 
 
@@ -310,24 +336,8 @@ int icompare(
 	poco_check_ptr (ptr);
 	typename S::size_type sz = str.size();
 	if (pos > sz) pos = sz;
-	if (pos + n > sz) n = sz - pos;
-	typename S::const_iterator it  = str.begin() + pos; 
-	typename S::const_iterator end = str.begin() + pos + n;
-	while (it != end && *ptr)
-	{
-		typename S::value_type c1(Ascii::toLower(*it));
-		typename S::value_type c2(Ascii::toLower(*ptr));
-		if (c1 < c2)
-			return -1;
-		else if (c1 > c2)
-			return 1;
-		++it; ++ptr;
-	}
-	
-	if (it == end)
-		return *ptr == 0 ? 0 : -1;
-	else
-		return 1;
+	if (n > sz - pos) n = sz - pos;
+	return Impl::icompare(str.data() + pos, n, ptr, S::traits_type::length(ptr));
 }
 
 
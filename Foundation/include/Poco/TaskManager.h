@@ -54,6 +54,8 @@ namespace Poco {
 
 class Notification;
 class ThreadPool;
+class WorkStealingThreadPool;
+class AbstractThreadPool;
 class Exception;
 
 
@@ -80,6 +82,14 @@ public:
 		/// Creates the TaskManager, using the
 		/// given ThreadPool.
 
+	TaskManager(WorkStealingThreadPool& pool);
+		/// Creates the TaskManager, using the
+		/// given WorkStealingThreadPool.
+		///
+		/// If all threads of the pool are busy, started
+		/// tasks remain in state TASK_STARTING until
+		/// a thread becomes available.
+
 	~TaskManager();
 		/// Destroys the TaskManager.
 
@@ -132,11 +142,11 @@ protected:
 	void taskFailed(Task* pTask, const Exception& exc);
 
 private:
-	ThreadPool&        _threadPool;
-	TaskList           _taskList;
-	Timestamp          _lastProgressNotification;
-	NotificationCenter _nc;
-	mutable FastMutex  _mutex;
+	AbstractThreadPool* _pThreadPool;
+	TaskList            _taskList;
+	Timestamp           _lastProgressNotification;
+	NotificationCenter  _nc;
+	mutable FastMutex   _mutex;
 
 	friend class Task;
 };
@@ -99,6 +99,17 @@ public:
 		/// in source).
 
 private:
+	void convertFast(const unsigned char*& it, const unsigned char* end, std::string& destination, Transform trans);
+		/// Converts the characters at it that can be copied or converted
+		/// without decoding them (runs of ASCII characters, and runs of
+		/// legal UTF-8 sequences if both encodings are UTF-8), and
+		/// advances it past them.
+		///
+		/// Must only be called if both encodings are ASCII compatible.
+
+	void append(int ch, std::string& destination);
+		/// Appends ch, converted to outEncoding, to destination.
+
 	TextConverter();
 	TextConverter(const TextConverter&);
 	TextConverter& operator = (const TextConverter&);
@@ -106,6 +117,9 @@ private:
 	const TextEncoding& _inEncoding;
 	const TextEncoding& _outEncoding;
 	int                 _defaultChar;
+	bool                _ascii;
+	bool                _utf8In;
+	bool                _utf8;
 };
 
 
@@ -154,6 +154,15 @@ public:
 		/// the byte sequence remains unchanged.
 		/// The default implementation simply returns 0.
 
+	bool isAsciiCompatible() const;
+		/// Returns true if the character map maps all ASCII
+		/// characters (0 .. 127) to themselves, i.e. if ASCII text
+		/// is represented the same in this encoding and in ASCII.
+		///
+		/// TextConverter and StreamConverter copy runs of ASCII
+		/// characters without converting them if both encodings
+		/// are ASCII compatible.
+
 	static TextEncoding& byName(const std::string& encodingName);
 		/// Returns the TextEncoding object for the given encoding name.
 		///
@@ -0,0 +1,105 @@
+//
+// ThreadPoolAdapter.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  ThreadPoolAdapter
+//
+// Definition of the ThreadPoolAdapter class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_ThreadPoolAdapter_INCLUDED
+#define Foundation_ThreadPoolAdapter_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/AbstractThreadPool.h"
+#include "Poco/InterfaceAdapter.h"
+
+
+namespace Poco {
+
+
+template <class P>
+class ThreadPoolAdapter: public InterfaceAdapter<AbstractThreadPool, P&>
+	/// Implements the AbstractThreadPool interface
+	/// for ThreadPool or WorkStealingThreadPool.
+	///
+	/// Thread pools are usually shared, so the adapter only
+	/// refers to the pool, which must outlive the adapter.
+	///
+	/// Example:
+	///     AbstractThreadPool* pPool = new ThreadPoolAdapter<ThreadPool>(ThreadPool::defaultPool());
+{
+public:
+	typedef InterfaceAdapter<AbstractThreadPool, P&> Base;
+
+	explicit ThreadPoolAdapter(P& pool):
+		Base(pool)
+	{
+	}
+
+	~ThreadPoolAdapter()
+	{
+	}
+
+	int capacity() const
+	{
+		return this->_adaptee.capacity();
+	}
+
+	void start(Runnable& target, const std::string& name)
+	{
+		this->_adaptee.start(target, name);
+	}
+
+	void startWithPriority(Thread::Priority priority, Runnable& target, const std::string& name)
+	{
+		this->_adaptee.startWithPriority(priority, target, name);
+	}
+
+	void joinAll()
+	{
+		this->_adaptee.joinAll();
+	}
+
+	P& pool()
+		/// Returns the adapted pool.
+	{
+		return this->_adaptee;
+	}
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ThreadPoolAdapter_INCLUDED
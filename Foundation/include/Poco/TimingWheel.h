@@ -0,0 +1,284 @@
+//
+// TimingWheel.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  TimingWheel
+//
+// Definition of the TimingWheel class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_TimingWheel_INCLUDED
+#define Foundation_TimingWheel_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Notification.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Timespan.h"
+#include <vector>
+#include <deque>
+
+
+namespace Poco {
+
+
+class Foundation_API TimingWheel
+	/// A TimingWheel holds notifications that expire at a given
+	/// time, similar to a TimedNotificationQueue. It is intended
+	/// for large numbers of timeouts that are mostly cancelled
+	/// before they expire, like per-connection idle timeouts.
+	///
+	/// Time is divided into ticks of a configurable resolution.
+	/// Notifications are kept in a hierarchy of four wheels of
+	/// slots, each slot holding a doubly-linked list of entries.
+	/// The first wheel has one slot per tick for the next 256 ticks,
+	/// the following wheels each cover a 64 times longer period with
+	/// coarser slots. Entries are moved to a lower wheel when the
+	/// ticks covered by their slot come closer. Scheduling and
+	/// cancelling a notification therefore take constant time,
+	/// regardless of the number of pending notifications.
+	///
+	/// A notification never expires before its time, but may expire
+	/// up to one tick later. Notifications expiring within the same
+	/// tick are not ordered by their time. With the default resolution
+	/// of 10 milliseconds, the wheels cover about a week; notifications
+	/// further in the future are kept in the last wheel until they
+	/// come into range.
+	///
+	/// Expired notifications can either be dequeued one by one,
+	/// like from a TimedNotificationQueue (see waitDequeueNotification()),
+	/// or collected in batches with expire(). The latter is
+	/// useful for SocketReactor based servers that handle idle
+	/// timeouts in the reactor thread, e.g. in a handler for
+	/// the reactor's TimeoutNotification:
+	///
+	///     std::vector<Notification::Ptr> expired;
+	///     wheel.expire(expired);
+	///     for (std::vector<Notification::Ptr>::iterator it = expired.begin(); it != expired.end(); ++it)
+	///     {
+	///         // close the idle connection
+	///     }
+	///
+	/// All member functions are thread-safe. Multiple threads may
+	/// dequeue notifications simultaneously.
+{
+public:
+	class Foundation_API Entry: public RefCountedObject
+		/// The handle for a scheduled notification,
+		/// which can be used to cancel it.
+	{
+	public:
+		typedef AutoPtr<Entry> Ptr;
+
+		Notification::Ptr notification() const;
+			/// Returns the notification, or null if the notification
+			/// has expired or has been cancelled. The entry releases
+			/// the notification as soon as it leaves the wheel.
+
+		bool cancel();
+			/// Cancels the notification. Same as calling cancel()
+			/// on the TimingWheel the entry has been scheduled on.
+			///
+			/// Returns false if the notification has already expired
+			/// or been cancelled, or if the TimingWheel has been
+			/// destroyed. Must not be called while the TimingWheel
+			/// is being destroyed.
+
+	protected:
+		Entry(Notification::Ptr pNotification);
+		~Entry();
+
+	private:
+		Entry();
+		Entry(const Entry&);
+		Entry& operator = (const Entry&);
+
+		Notification::Ptr detach();
+			/// Called by the TimingWheel, with the wheel's mutex
+			/// held, when the entry leaves the wheel. Returns the
+			/// notification and resets the entry.
+
+		Notification::Ptr _pNotification;
+		UInt64            _expires;
+		Entry*            _pPrev;
+		Entry*            _pNext;
+		int               _slot;
+		TimingWheel*      _pWheel;
+		mutable FastMutex _mutex;
+
+		friend class TimingWheel;
+	};
+
+	TimingWheel();
+		/// Creates the TimingWheel with a tick resolution
+		/// of 10 milliseconds.
+
+	explicit TimingWheel(const Timespan& resolution);
+		/// Creates the TimingWheel with the given tick resolution,
+		/// which must be at least one microsecond.
+
+	~TimingWheel();
+		/// Destroys the TimingWheel, releasing all notifications.
+
+	Entry::Ptr schedule(Notification::Ptr pNotification, const Timestamp& time);
+		/// Schedules the given notification to expire at the given time,
+		/// and returns an Entry that can be passed to cancel().
+		///
+		/// If the time lies in the past, the notification expires
+		/// immediately.
+
+	void enqueueNotification(Notification::Ptr pNotification, const Timestamp& time);
+		/// Same as schedule(), but does not return the Entry.
+		/// For compatibility with TimedNotificationQueue.
+
+	void enqueueUrgentNotification(Notification::Ptr pNotification);
+		/// Makes the given notification available for dequeueing
+		/// immediately, ahead of all notifications that have
+		/// already expired. Such a notification cannot be cancelled.
+
+	bool cancel(Entry::Ptr pEntry);
+		/// Cancels a scheduled notification.
+		///
+		/// Returns true if the notification has been removed
+		/// from the wheel, or false if it has already expired
+		/// or been cancelled.
+
+	std::size_t expire(std::vector<Notification::Ptr>& expired);
+		/// Appends all expired notifications to the given vector,
+		/// and returns the number of notifications added.
+		/// Does not wait.
+
+	std::size_t expire(const Timestamp& now, std::vector<Notification::Ptr>& expired);
+		/// Appends all notifications that have expired at the given
+		/// time to the given vector, and returns the number of
+		/// notifications added.
+		///
+		/// The wheel never moves backwards; notifications that
+		/// have already expired are returned regardless of the
+		/// given time.
+
+	Notification* dequeueNotification();
+		/// Dequeues the next expired notification.
+		/// Returns 0 (null) if no notification has expired.
+		///
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+
+	Notification* waitDequeueNotification();
+		/// Dequeues the next expired notification.
+		/// If no notification has expired, waits until one expires.
+		///
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+
+	Notification* waitDequeueNotification(long milliseconds);
+		/// Dequeues the next expired notification.
+		/// If no notification has expired, waits up to the given
+		/// number of milliseconds for one to expire.
+		/// Returns 0 (null) if no notification has expired
+		/// within the given time.
+		///
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+
+	bool empty() const;
+		/// Returns true if the wheel holds no notifications.
+
+	int size() const;
+		/// Returns the number of scheduled and expired
+		/// notifications that have not been dequeued yet.
+
+	void clear();
+		/// Removes all notifications from the wheel.
+
+	Timespan resolution() const;
+		/// Returns the tick resolution.
+
+protected:
+	enum
+	{
+		WHEELS       = 4,
+		ROOT_BITS    = 8,
+		LEVEL_BITS   = 6,
+		ROOT_SLOTS   = 1 << ROOT_BITS,
+		LEVEL_SLOTS  = 1 << LEVEL_BITS,
+		SLOT_COUNT   = ROOT_SLOTS + (WHEELS - 1)*LEVEL_SLOTS,
+		HORIZON_BITS = ROOT_BITS + (WHEELS - 1)*LEVEL_BITS
+	};
+
+	UInt64 tickOf(const Timestamp& time, bool roundUp) const;
+	Timestamp timeOf(UInt64 tick) const;
+	void insert(Entry* pEntry);
+	void unlink(Entry* pEntry);
+	void advance(const Timestamp& now);
+	void cascade(int slot);
+	void expireSlot(int slot);
+	bool nextTick(UInt64& tick) const;
+	Notification* dequeueOne();
+
+private:
+	TimingWheel(const TimingWheel&);
+	TimingWheel& operator = (const TimingWheel&);
+
+	typedef std::deque<Notification::Ptr> NfQueue;
+
+	Timestamp::TimeDiff _resolution;
+	Timestamp           _base;
+	UInt64              _currentTick;
+	int                 _scheduled;
+	int                 _rootScheduled;
+	std::vector<Entry*> _slots;
+	NfQueue             _expired;
+	int                 _waiting;
+	UInt64              _wakeUpTick;
+	mutable FastMutex   _mutex;
+	Condition           _nfAvailable;
+};
+
+
+//
+// inlines
+//
+inline Timespan TimingWheel::resolution() const
+{
+	return Timespan(_resolution);
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_TimingWheel_INCLUDED
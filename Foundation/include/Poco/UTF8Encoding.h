@@ -71,6 +71,21 @@ public:
 		/// Adapted from ftp://ftp.unicode.org/Public/PROGRAMS/CVTUTF/ConvertUTF.c
 		/// Copyright 2001-2004 Unicode, Inc.
 
+	static std::size_t asciiLength(const char* bytes, std::size_t length);
+		/// Returns the number of ASCII characters (bytes < 0x80)
+		/// at the beginning of the given buffer.
+		///
+		/// The buffer is checked 16 bytes at a time if SSE2 is
+		/// available, and 8 bytes at a time otherwise.
+
+	static std::size_t legalLength(const char* bytes, std::size_t length);
+		/// Returns the length of the longest prefix of the given
+		/// buffer that consists of complete, legal UTF-8 sequences
+		/// (see isLegal()). The buffer is legal UTF-8 if the result
+		/// is equal to length.
+		///
+		/// Runs of ASCII characters are skipped using asciiLength().
+
 private:
 	static const char* _names[];
 	static const CharacterMap _charMap;
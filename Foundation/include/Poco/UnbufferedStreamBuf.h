@@ -146,17 +146,25 @@ public:
 		/// of xsgetn for this streambuf implementation.
 	{
 		std::streamsize copied = 0;
-		while (count > 0)
+		if (count > 0 && _ispb)
 		{
-			int_type c = uflow();
-			if (c == char_traits::eof()) break;
-			*p++ = char_traits::to_char_type(c);
+			_ispb = false;
+			*p++ = char_traits::to_char_type(_pb);
 			++copied;
 			--count;
 		}
+		if (count > 0)
+		{
+			copied += readBlockFromDevice(p, count);
+		}
 		return copied;
 	}
 
+	virtual std::streamsize xsputn(const char_type* p, std::streamsize count)
+	{
+		return writeBlockToDevice(p, count);
+	}
+
 protected:
 	static int_type charToInt(char_type c)
 	{
@@ -174,6 +182,41 @@ private:
 		return char_traits::eof();
 	}
 
+	virtual std::streamsize readBlockFromDevice(char_type* buffer, std::streamsize length)
+		/// Reads up to length characters into buffer and returns
+		/// the number of characters read, or 0 at the end of the data.
+		///
+		/// The default implementation calls readFromDevice() for
+		/// every character. Derived classes can override it to
+		/// read blocks of characters more efficiently.
+	{
+		std::streamsize n = 0;
+		while (n < length)
+		{
+			int_type c = readFromDevice();
+			if (c == char_traits::eof()) break;
+			buffer[n++] = char_traits::to_char_type(c);
+		}
+		return n;
+	}
+
+	virtual std::streamsize writeBlockToDevice(const char_type* buffer, std::streamsize length)
+		/// Writes length characters from buffer and returns
+		/// the number of characters written.
+		///
+		/// The default implementation calls writeToDevice() for
+		/// every character. Derived classes can override it to
+		/// write blocks of characters more efficiently.
+	{
+		std::streamsize n = 0;
+		while (n < length)
+		{
+			if (writeToDevice(buffer[n]) == char_traits::eof()) break;
+			++n;
+		}
+		return n;
+	}
+
 	int_type _pb;
 	bool     _ispb;
 	
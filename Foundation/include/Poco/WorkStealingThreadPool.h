@@ -0,0 +1,310 @@
+//
+// WorkStealingThreadPool.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  WorkStealingThreadPool
+//
+// Definition of the WorkStealingThreadPool class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_WorkStealingThreadPool_INCLUDED
+#define Foundation_WorkStealingThreadPool_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Thread.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/ActiveRunnable.h"
+#include <vector>
+
+
+namespace Poco {
+
+
+class Runnable;
+class TaskGroup;
+class WorkStealingWorker;
+struct WorkStealingTask;
+
+
+class Foundation_API WorkStealingThreadPool
+	/// A thread pool with a fixed number of worker threads
+	/// that distributes work using work stealing.
+	///
+	/// Every worker thread has its own double-ended queue of
+	/// runnables. A runnable started from within a worker
+	/// thread is put into the queue of that worker, and is
+	/// taken from there in LIFO order, which keeps related work
+	/// on the same CPU. Runnables started by other threads are
+	/// distributed over the workers' queues in a round-robin
+	/// fashion. A worker that runs out of work steals the oldest
+	/// runnable from the queue of another, randomly chosen, worker.
+	/// Workers only block if there is no work left in any queue.
+	///
+	/// Unlike ThreadPool, WorkStealingThreadPool does not throw
+	/// a NoThreadAvailableException if all threads are busy.
+	/// Instead, the runnable is queued and started as soon as
+	/// a worker thread becomes available. Therefore, runnables
+	/// should be short, and should not block for a long time.
+	/// Long-running runnables (like a TCPServerDispatcher) each
+	/// occupy one of the worker threads.
+	///
+	/// The interface of WorkStealingThreadPool is compatible to
+	/// ThreadPool, so that WorkStealingThreadPool can be used with
+	/// TaskManager, TCPServer and ActiveMethod (see
+	/// WorkStealingActiveStarter). To wait for the completion of a
+	/// set of runnables, use a TaskGroup.
+{
+public:
+	WorkStealingThreadPool(int threads = 0, int stackSize = POCO_THREAD_STACK_SIZE);
+		/// Creates a thread pool with the given number of worker
+		/// threads. If threads is 0, one thread per processor
+		/// is created. Threads are created with given stack size.
+
+	WorkStealingThreadPool(const std::string& name, int threads = 0, int stackSize = POCO_THREAD_STACK_SIZE);
+		/// Creates a thread pool with the given name and the given
+		/// number of worker threads. If threads is 0, one thread
+		/// per processor is created. Threads are created with given
+		/// stack size.
+
+	~WorkStealingThreadPool();
+		/// Destroys the thread pool.
+		///
+		/// Waits until all queued runnables have completed,
+		/// then stops all worker threads.
+
+	int capacity() const;
+		/// Returns the number of worker threads.
+
+	int used() const;
+		/// Returns the number of worker threads currently
+		/// executing a runnable.
+
+	int allocated() const;
+		/// Returns the number of worker threads.
+
+	int available() const;
+		/// Returns the number of worker threads currently
+		/// not executing a runnable.
+
+	int queued() const;
+		/// Returns the number of runnables waiting for
+		/// a worker thread.
+
+	void start(Runnable& target);
+		/// Queues the target for execution by a worker thread.
+
+	void start(Runnable& target, const std::string& name);
+		/// Queues the target for execution by a worker thread.
+		/// Assigns the given name to the thread while the
+		/// target is running.
+
+	void startWithPriority(Thread::Priority priority, Runnable& target);
+		/// Queues the target for execution by a worker thread.
+		/// The worker thread's priority is adjusted while the
+		/// target is running.
+
+	void startWithPriority(Thread::Priority priority, Runnable& target, const std::string& name);
+		/// Queues the target for execution by a worker thread.
+		/// The worker thread's priority is adjusted and the given
+		/// name is assigned to the thread while the target is running.
+
+	void joinAll();
+		/// Waits until all queued and running runnables have completed.
+		///
+		/// Must not be called from a worker thread of the pool.
+
+	const std::string& name() const;
+		/// Returns the name of the thread pool,
+		/// or an empty string if no name has been
+		/// specified in the constructor.
+
+	static WorkStealingThreadPool& defaultPool();
+		/// Returns a reference to the default
+		/// work stealing thread pool, which has one
+		/// thread per processor.
+
+protected:
+	void enqueue(Runnable& target, TaskGroup* pGroup, Thread::Priority priority, const std::string& name);
+	WorkStealingWorker* currentWorker() const;
+	bool takeTask(WorkStealingWorker* pWorker, WorkStealingTask& task);
+	void runTask(WorkStealingWorker& worker, WorkStealingTask& task);
+	bool waitForTask();
+	void waitForTask(TaskGroup& group);
+	void init(int threads, int stackSize);
+
+private:
+	WorkStealingThreadPool(const WorkStealingThreadPool&);
+	WorkStealingThreadPool& operator = (const WorkStealingThreadPool&);
+
+	typedef std::vector<WorkStealingWorker*> WorkerVec;
+
+	std::string       _name;
+	WorkerVec         _workers;
+	AtomicCounter     _queued;
+	AtomicCounter     _pending;
+	AtomicCounter     _busy;
+	AtomicCounter     _idle;
+	AtomicCounter     _next;
+	volatile bool     _stopped;
+	mutable FastMutex _mutex;
+	Condition         _taskAvailable;
+	Condition         _allDone;
+
+	friend class WorkStealingWorker;
+	friend class TaskGroup;
+};
+
+
+class Foundation_API TaskGroup
+	/// A TaskGroup is used to start a number of runnables in
+	/// a WorkStealingThreadPool, and to wait for their completion.
+	///
+	/// If wait() is called from a worker thread of the pool
+	/// (for example, from a runnable that has split its work
+	/// into smaller pieces), the waiting thread executes queued
+	/// runnables until all runnables of the group have completed.
+	/// Nested groups therefore do not exhaust the pool's threads.
+	///
+	/// Example:
+	///     TaskGroup group(WorkStealingThreadPool::defaultPool());
+	///     group.start(worker1);
+	///     group.start(worker2);
+	///     group.wait();
+{
+public:
+	explicit TaskGroup(WorkStealingThreadPool& pool);
+		/// Creates the TaskGroup for the given pool.
+
+	~TaskGroup();
+		/// Waits for all runnables of the group to
+		/// complete and destroys the TaskGroup.
+
+	void start(Runnable& target);
+		/// Queues the target for execution by a worker thread
+		/// of the pool.
+
+	void wait();
+		/// Waits until all runnables started through this
+		/// group have completed.
+
+	int pending() const;
+		/// Returns the number of runnables of this group
+		/// that have not yet completed.
+
+protected:
+	void taskDone();
+
+private:
+	TaskGroup();
+	TaskGroup(const TaskGroup&);
+	TaskGroup& operator = (const TaskGroup&);
+
+	WorkStealingThreadPool& _pool;
+	AtomicCounter           _pending;
+	int                     _helpers;
+	FastMutex               _mutex;
+	Condition               _done;
+
+	friend class WorkStealingThreadPool;
+};
+
+
+template <class OwnerType>
+class WorkStealingActiveStarter
+	/// An implementation of the StarterType policy for
+	/// ActiveMethod that starts the method in the default
+	/// WorkStealingThreadPool.
+	///
+	/// Example:
+	///     ActiveMethod<int, int, ActiveObject, WorkStealingActiveStarter<ActiveObject> > exampleActiveMethod;
+{
+public:
+	static void start(OwnerType* pOwner, ActiveRunnableBase::Ptr pRunnable)
+	{
+		pRunnable->duplicate(); // The runnable will release itself.
+		WorkStealingThreadPool::defaultPool().start(*pRunnable);
+	}
+};
+
+
+//
+// inlines
+//
+inline int WorkStealingThreadPool::capacity() const
+{
+	return static_cast<int>(_workers.size());
+}
+
+
+inline int WorkStealingThreadPool::used() const
+{
+	return _busy.value();
+}
+
+
+inline int WorkStealingThreadPool::allocated() const
+{
+	return static_cast<int>(_workers.size());
+}
+
+
+inline int WorkStealingThreadPool::available() const
+{
+	return capacity() - used();
+}
+
+
+inline int WorkStealingThreadPool::queued() const
+{
+	return _queued.value();
+}
+
+
+inline const std::string& WorkStealingThreadPool::name() const
+{
+	return _name;
+}
+
+
+inline int TaskGroup::pending() const
+{
+	return _pending.value();
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_WorkStealingThreadPool_INCLUDED
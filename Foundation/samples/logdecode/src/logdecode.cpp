@@ -0,0 +1,87 @@
+//
+// logdecode.cpp
+//
+// $Id: //poco/1.4/Foundation/samples/logdecode/src/logdecode.cpp#1 $
+//
+// This sample demonstrates the BinaryLogReader and PatternFormatter classes.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/BinaryLogReader.h"
+#include "Poco/PatternFormatter.h"
+#include "Poco/Message.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Exception.h"
+#include <iostream>
+#include <fstream>
+
+
+using Poco::BinaryLogReader;
+using Poco::PatternFormatter;
+using Poco::Message;
+using Poco::AutoPtr;
+
+
+int main(int argc, char** argv)
+{
+	if (argc != 2 && argc != 3)
+	{
+		std::cout << "usage: " << argv[0] << ": <input_file> [<pattern>]" << std::endl
+		          << "       read a log file written by a BinaryFileChannel and write its" << std::endl
+		          << "       messages to standard output, formatted with a PatternFormatter" << std::endl;
+		return 1;
+	}
+	
+	std::ifstream istr(argv[1], std::ios::binary);
+	if (!istr)
+	{
+		std::cerr << "cannot open input file: " << argv[1] << std::endl;
+		return 2;
+	}
+	
+	AutoPtr<PatternFormatter> pFormatter = new PatternFormatter(argc == 3 ? argv[2] : "%Y-%m-%d %H:%M:%S.%i [%p] %s <%T>: %t");
+	BinaryLogReader reader(istr);
+	Message msg;
+	std::string text;
+	try
+	{
+		while (reader.read(msg))
+		{
+			text.clear();
+			pFormatter->format(msg, text);
+			std::cout << text << std::endl;
+		}
+	}
+	catch (Poco::Exception& exc)
+	{
+		std::cerr << exc.displayText() << std::endl;
+		return 3;
+	}
+	
+	return 0;
+}
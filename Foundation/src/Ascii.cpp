@@ -35,11 +35,95 @@
 
 
 #include "Poco/Ascii.h"
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define POCO_HAVE_ASCII_SSE2
+#endif
 
 
 namespace Poco {
 
 
+namespace
+{
+	const UInt64 ONES = 0x0101010101010101ULL;
+
+	inline UInt64 load(const char* p)
+	{
+		UInt64 v;
+		std::memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	inline void store(char* p, UInt64 v)
+	{
+		std::memcpy(p, &v, sizeof(v));
+	}
+
+	inline UInt64 caseBits(UInt64 v, char first, char last)
+		/// Returns 0x20 in every byte of v that is an ASCII
+		/// character in the range first .. last, and 0 in all
+		/// other bytes. XOR-ing the result with v switches the
+		/// case of these characters.
+	{
+		UInt64 low7 = v & (0x7F*ONES);
+		UInt64 geFirst = low7 + (0x80 - first)*ONES;
+		UInt64 gtLast  = low7 + (0x7F - last)*ONES;
+		return ((geFirst ^ gtLast) & ~v & (0x80*ONES)) >> 2;
+	}
+
+	inline UInt64 foldCase(UInt64 v)
+	{
+		return v ^ caseBits(v, 'A', 'Z');
+	}
+
+#if defined(POCO_HAVE_ASCII_SSE2)
+
+	inline __m128i caseBits(__m128i v, char first, char last)
+		/// Returns 0x20 in every byte of v that is in the
+		/// range first .. last, and 0 in all other bytes.
+	{
+		// Bias the characters so that the range starts at -128,
+		// then a single signed comparison tests for the range.
+		__m128i biased = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - first)));
+		__m128i inRange = _mm_cmplt_epi8(biased, _mm_set1_epi8(static_cast<char>(-128 + last - first + 1)));
+		return _mm_and_si128(inRange, _mm_set1_epi8(0x20));
+	}
+
+	inline __m128i foldCase(__m128i v)
+	{
+		return _mm_xor_si128(v, caseBits(v, 'A', 'Z'));
+	}
+
+#endif
+
+	inline void switchCase(char* str, std::size_t length, char first, char last)
+	{
+		char* end = str + length;
+#if defined(POCO_HAVE_ASCII_SSE2)
+		while (end - str >= 16)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(str), _mm_xor_si128(v, caseBits(v, first, last)));
+			str += 16;
+		}
+#endif
+		while (end - str >= 8)
+		{
+			UInt64 v = load(str);
+			store(str, v ^ caseBits(v, first, last));
+			str += 8;
+		}
+		while (str != end)
+		{
+			if (*str >= first && *str <= last) *str ^= 0x20;
+			++str;
+		}
+	}
+}
+
+
 const int Ascii::CHARACTER_PROPERTIES[128] = 
 {
 	/* 00 . */ ACP_CONTROL,
@@ -173,4 +257,45 @@ const int Ascii::CHARACTER_PROPERTIES[128] =
 };
 
 
+void Ascii::toLowerInPlace(char* str, std::size_t length)
+{
+	switchCase(str, length, 'A', 'Z');
+}
+
+
+void Ascii::toUpperInPlace(char* str, std::size_t length)
+{
+	switchCase(str, length, 'a', 'z');
+}
+
+
+int Ascii::icompare(const char* str1, const char* str2, std::size_t length)
+{
+	std::size_t i = 0;
+#if defined(POCO_HAVE_ASCII_SSE2)
+	for (; i + 16 <= length; i += 16)
+	{
+		__m128i v1 = foldCase(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str1 + i)));
+		__m128i v2 = foldCase(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str2 + i)));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(v1, v2)) != 0xFFFF) break;
+	}
+#endif
+	for (; i + 8 <= length; i += 8)
+	{
+		if (foldCase(load(str1 + i)) != foldCase(load(str2 + i))) break;
+	}
+	// find the first differing character
+	for (; i < length; ++i)
+	{
+		char c1 = static_cast<char>(toLower(str1[i]));
+		char c2 = static_cast<char>(toLower(str2[i]));
+		if (c1 < c2)
+			return -1;
+		else if (c1 > c2)
+			return 1;
+	}
+	return 0;
+}
+
+
 } // namespace Poco
@@ -35,12 +35,14 @@
 
 
 #include "Poco/AsyncChannel.h"
+#include "Poco/NotificationQueueAdapter.h"
 #include "Poco/Notification.h"
 #include "Poco/Message.h"
 #include "Poco/Formatter.h"
 #include "Poco/AutoPtr.h"
 #include "Poco/LoggingRegistry.h"
 #include "Poco/Exception.h"
+#include "Poco/String.h"
 
 
 namespace Poco {
@@ -70,17 +72,38 @@ private:
 
 AsyncChannel::AsyncChannel(Channel* pChannel, Thread::Priority prio): 
 	_pChannel(pChannel), 
-	_thread("AsyncChannel")
+	_thread("AsyncChannel"),
+	_pQueue(new NotificationQueueAdapter<NotificationQueue>)
 {
 	if (_pChannel) _pChannel->duplicate();
 	_thread.setPriority(prio);
 }
 
 
+void AsyncChannel::setLockFreeQueue(const std::string& value)
+{
+	bool flag = icompare(value, "true") == 0;
+
+	FastMutex::ScopedLock lock(_threadMutex);
+
+	if (_thread.isRunning())
+		throw IllegalStateException("Cannot change the queue of an open AsyncChannel");
+
+	AbstractNotificationQueue* pQueue;
+	if (flag)
+		pQueue = new NotificationQueueAdapter<LockFreeNotificationQueue>;
+	else
+		pQueue = new NotificationQueueAdapter<NotificationQueue>;
+	delete _pQueue;
+	_pQueue = pQueue;
+}
+
+
 AsyncChannel::~AsyncChannel()
 {
 	close();
 	if (_pChannel) _pChannel->release();
+	delete _pQueue;
 }
 
 
@@ -113,11 +136,11 @@ void AsyncChannel::close()
 {
 	if (_thread.isRunning())
 	{
-		while (!_queue.empty()) Thread::sleep(100);
+		while (!_pQueue->empty()) Thread::sleep(100);
 		
 		do 
 		{
-			_queue.wakeUpAll(); 
+			_pQueue->wakeUpAll(); 
 		}
 		while (!_thread.tryJoin(100));
 	}
@@ -128,7 +151,7 @@ void AsyncChannel::log(const Message& msg)
 {
 	open();
 
-	_queue.enqueueNotification(new MessageNotification(msg));
+	_pQueue->enqueueNotification(new MessageNotification(msg));
 }
 
 
@@ -138,6 +161,8 @@ void AsyncChannel::setProperty(const std::string& name, const std::string& value
 		setChannel(LoggingRegistry::defaultRegistry().channelForName(value));
 	else if (name == "priority")
 		setPriority(value);
+	else if (name == "lockFreeQueue")
+		setLockFreeQueue(value);
 	else
 		Channel::setProperty(name, value);
 }
@@ -145,7 +170,7 @@ void AsyncChannel::setProperty(const std::string& name, const std::string& value
 
 void AsyncChannel::run()
 {
-	AutoPtr<Notification> nf = _queue.waitDequeueNotification();
+	AutoPtr<Notification> nf = _pQueue->waitDequeueNotification();
 	while (nf)
 	{
 		MessageNotification* pNf = dynamic_cast<MessageNotification*>(nf.get());
@@ -154,7 +179,7 @@ void AsyncChannel::run()
 
 			if (pNf && _pChannel) _pChannel->log(pNf->message());
 		}
-		nf = _queue.waitDequeueNotification();
+		nf = _pQueue->waitDequeueNotification();
 	}
 }
 		
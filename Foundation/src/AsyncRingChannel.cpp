@@ -0,0 +1,390 @@
+//
+// AsyncRingChannel.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Logging
+// Module:  AsyncRingChannel
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/AsyncRingChannel.h"
+#include "Poco/AtomicOps.h"
+#include "Poco/LoggingRegistry.h"
+#include "Poco/Logger.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Exception.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/String.h"
+
+
+namespace Poco {
+
+
+AsyncRingChannel::AsyncRingChannel(Channel* pChannel, std::size_t capacity, Thread::Priority prio):
+	_pChannel(pChannel),
+	_thread("AsyncRingChannel"),
+	_mask(0),
+	_enqueuePos(0),
+	_dequeuePos(0),
+	_waiting(0),
+	_blocked(0),
+	_open(0),
+	_stop(false),
+	_overflowPriority(Message::PRIO_TRACE),
+	_batchSize(64)
+{
+	init(capacity);
+	if (_pChannel) _pChannel->duplicate();
+	_thread.setPriority(prio);
+}
+
+
+AsyncRingChannel::~AsyncRingChannel()
+{
+	close();
+	if (_pChannel) _pChannel->release();
+}
+
+
+void AsyncRingChannel::init(std::size_t capacity)
+{
+	poco_assert (capacity > 0 && capacity <= 0x40000000);
+
+	std::size_t size = 2;
+	while (size < capacity) size <<= 1;
+	_messages.clear();
+	_messages.resize(size);
+	_sequences.resize(size);
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		_sequences[i] = static_cast<UInt32>(i);
+	}
+	_mask = static_cast<UInt32>(size - 1);
+	_enqueuePos = 0;
+	_dequeuePos = 0;
+	AtomicOps::barrier();
+}
+
+
+void AsyncRingChannel::setChannel(Channel* pChannel)
+{
+	FastMutex::ScopedLock lock(_channelMutex);
+
+	if (_pChannel) _pChannel->release();
+	_pChannel = pChannel;
+	if (_pChannel) _pChannel->duplicate();
+}
+
+
+Channel* AsyncRingChannel::getChannel() const
+{
+	return _pChannel;
+}
+
+
+void AsyncRingChannel::open()
+{
+	FastMutex::ScopedLock lock(_threadMutex);
+
+	if (!_thread.isRunning())
+	{
+		_stop = false;
+		_thread.start(*this);
+	}
+	AtomicOps::store(&_open, 1);
+}
+
+
+void AsyncRingChannel::close()
+{
+	FastMutex::ScopedLock lock(_threadMutex);
+
+	if (_thread.isRunning())
+	{
+		// The background thread writes all pending
+		// messages before it terminates.
+		_stop = true;
+		AtomicOps::barrier();
+		_ready.set();
+		_thread.join();
+		_stop = false;
+	}
+	AtomicOps::store(&_open, 0);
+}
+
+
+void AsyncRingChannel::log(const Message& msg)
+{
+	if (!AtomicOps::load(&_open)) open();
+
+	// Copy the message before claiming a slot, so that
+	// the slot is published without further delay.
+	Message tmp(msg);
+
+	int spins = 0;
+	UInt32 pos = AtomicOps::load(&_enqueuePos);
+	for (;;)
+	{
+		UInt32 seq = AtomicOps::load(&_sequences[pos & _mask]);
+		Int32 diff = static_cast<Int32>(seq - pos);
+		if (diff == 0)
+		{
+			if (AtomicOps::compareAndSwap(&_enqueuePos, pos, pos + 1)) break;
+		}
+		else if (diff < 0)
+		{
+			// ring buffer is full
+			if (msg.getPriority() > _overflowPriority)
+			{
+				++_dropped;
+				return;
+			}
+			wakeUp();
+			if (++spins < SPIN_COUNT)
+				Thread::yield();
+			else
+				waitForSpace(pos);
+		}
+		pos = AtomicOps::load(&_enqueuePos);
+	}
+	_messages[pos & _mask].swap(tmp);
+	AtomicOps::store(&_sequences[pos & _mask], pos + 1);
+	wakeUp();
+}
+
+
+void AsyncRingChannel::setProperty(const std::string& name, const std::string& value)
+{
+	if (name == "channel")
+	{
+		setChannel(LoggingRegistry::defaultRegistry().channelForName(value));
+	}
+	else if (name == "priority")
+	{
+		setPriority(value);
+	}
+	else if (name == "capacity")
+	{
+		std::size_t capacity = static_cast<std::size_t>(NumberParser::parseUnsigned(value));
+		FastMutex::ScopedLock lock(_threadMutex);
+		if (_thread.isRunning())
+			throw IllegalStateException("Cannot change the capacity of an open AsyncRingChannel");
+		init(capacity);
+	}
+	else if (name == "overflow")
+	{
+		setOverflow(value);
+	}
+	else if (name == "batchSize")
+	{
+		unsigned batchSize = NumberParser::parseUnsigned(value);
+		if (batchSize == 0) throw InvalidArgumentException("batchSize", value);
+		_batchSize = batchSize;
+	}
+	else
+	{
+		Channel::setProperty(name, value);
+	}
+}
+
+
+std::string AsyncRingChannel::getProperty(const std::string& name) const
+{
+	if (name == "capacity")
+	{
+		return NumberFormatter::format(capacity());
+	}
+	else if (name == "overflow")
+	{
+		switch (_overflowPriority)
+		{
+		case 0:                           return "drop";
+		case Message::PRIO_FATAL:         return "fatal";
+		case Message::PRIO_CRITICAL:      return "critical";
+		case Message::PRIO_ERROR:         return "error";
+		case Message::PRIO_WARNING:       return "warning";
+		case Message::PRIO_NOTICE:        return "notice";
+		case Message::PRIO_INFORMATION:   return "information";
+		case Message::PRIO_DEBUG:         return "debug";
+		default:                          return "block";
+		}
+	}
+	else if (name == "batchSize")
+	{
+		return NumberFormatter::format(_batchSize);
+	}
+	else
+	{
+		return Channel::getProperty(name);
+	}
+}
+
+
+void AsyncRingChannel::run()
+{
+	for (;;)
+	{
+		std::size_t n = ready();
+		if (n > 0)
+		{
+			dispatch(n);
+			continue;
+		}
+		if (_stop && AtomicOps::load(&_enqueuePos) == _dequeuePos) break;
+
+		// A producer publishes its message before it checks
+		// _waiting, and we set _waiting before we check for
+		// messages again, so at least one of us sees the other.
+		AtomicOps::store(&_waiting, 1);
+		AtomicOps::barrier();
+		if (ready() == 0 && !_stop)
+		{
+			_ready.wait();
+		}
+		AtomicOps::store(&_waiting, 0);
+	}
+}
+
+
+std::size_t AsyncRingChannel::ready() const
+{
+	// Only complete slots up to the end of the ring buffer
+	// can be passed to the target channel at once.
+	UInt32 pos = _dequeuePos;
+	std::size_t limit = _messages.size() - (pos & _mask);
+	if (limit > _batchSize) limit = _batchSize;
+	std::size_t n = 0;
+	while (n < limit && AtomicOps::load(&_sequences[(pos + n) & _mask]) == pos + n + 1) ++n;
+	return n;
+}
+
+
+void AsyncRingChannel::dispatch(std::size_t count)
+{
+	UInt32 pos = _dequeuePos;
+	{
+		FastMutex::ScopedLock lock(_channelMutex);
+
+		if (_pChannel)
+		{
+			try
+			{
+				_pChannel->logBatch(&_messages[pos & _mask], count);
+			}
+			catch (Exception& exc)
+			{
+				ErrorHandler::handle(exc);
+			}
+			catch (std::exception& exc)
+			{
+				ErrorHandler::handle(exc);
+			}
+			catch (...)
+			{
+				ErrorHandler::handle();
+			}
+		}
+	}
+	UInt32 size = _mask + 1;
+	for (UInt32 i = 0; i < count; ++i)
+	{
+		AtomicOps::store(&_sequences[(pos + i) & _mask], pos + i + size);
+	}
+	AtomicOps::store(&_dequeuePos, pos + static_cast<UInt32>(count));
+
+	// A blocked producer sets _blocked before it checks
+	// for room again, so at least one of us sees the other.
+	AtomicOps::barrier();
+	if (AtomicOps::load(&_blocked))
+	{
+		FastMutex::ScopedLock lock(_spaceMutex);
+		_spaceAvailable.broadcast();
+	}
+}
+
+
+void AsyncRingChannel::wakeUp()
+{
+	AtomicOps::barrier();
+	if (AtomicOps::load(&_waiting) && AtomicOps::compareAndSwap(&_waiting, 1, 0))
+	{
+		_ready.set();
+	}
+}
+
+
+void AsyncRingChannel::waitForSpace(UInt32 pos)
+{
+	FastMutex::ScopedLock lock(_spaceMutex);
+
+	AtomicOps::store(&_blocked, _blocked + 1);
+	AtomicOps::barrier();
+	while (static_cast<Int32>(AtomicOps::load(&_sequences[pos & _mask]) - pos) < 0 && AtomicOps::load(&_enqueuePos) == pos)
+	{
+		_spaceAvailable.wait(_spaceMutex);
+	}
+	AtomicOps::store(&_blocked, _blocked - 1);
+}
+
+
+void AsyncRingChannel::setPriority(const std::string& value)
+{
+	Thread::Priority prio = Thread::PRIO_NORMAL;
+
+	if (value == "lowest")
+		prio = Thread::PRIO_LOWEST;
+	else if (value == "low")
+		prio = Thread::PRIO_LOW;
+	else if (value == "normal")
+		prio = Thread::PRIO_NORMAL;
+	else if (value == "high")
+		prio = Thread::PRIO_HIGH;
+	else if (value == "highest")
+		prio = Thread::PRIO_HIGHEST;
+	else
+		throw InvalidArgumentException("thread priority", value);
+
+	_thread.setPriority(prio);
+}
+
+
+void AsyncRingChannel::setOverflow(const std::string& value)
+{
+	if (icompare(value, "block") == 0)
+		_overflowPriority = Message::PRIO_TRACE;
+	else if (icompare(value, "drop") == 0)
+		_overflowPriority = 0;
+	else
+		_overflowPriority = Logger::parseLevel(value);
+}
+
+
+} // namespace Poco
@@ -0,0 +1,113 @@
+//
+// AtomicOps.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  AtomicOps
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/AtomicOps.h"
+#if POCO_OS != POCO_OS_WINDOWS_NT && POCO_OS != POCO_OS_MAC_OS_X && !defined(POCO_HAVE_GCC_ATOMICS)
+#include "Poco/Mutex.h"
+#endif
+
+
+namespace Poco {
+
+
+#if POCO_OS != POCO_OS_WINDOWS_NT && POCO_OS != POCO_OS_MAC_OS_X && !defined(POCO_HAVE_GCC_ATOMICS)
+
+
+//
+// generic implementation based on FastMutex
+//
+namespace
+{
+	FastMutex atomicMutex;
+}
+
+
+bool AtomicOps::compareAndSwap(volatile UInt32* p, UInt32 expected, UInt32 desired)
+{
+	FastMutex::ScopedLock lock(atomicMutex);
+	if (*p != expected) return false;
+	*p = desired;
+	return true;
+}
+
+
+bool AtomicOps::compareAndSwap(void* volatile* p, void* expected, void* desired)
+{
+	FastMutex::ScopedLock lock(atomicMutex);
+	if (*p != expected) return false;
+	*p = desired;
+	return true;
+}
+
+
+UInt32 AtomicOps::load(const volatile UInt32* p)
+{
+	FastMutex::ScopedLock lock(atomicMutex);
+	return *p;
+}
+
+
+void* AtomicOps::load(void* const volatile* p)
+{
+	FastMutex::ScopedLock lock(atomicMutex);
+	return *p;
+}
+
+
+void AtomicOps::store(volatile UInt32* p, UInt32 value)
+{
+	FastMutex::ScopedLock lock(atomicMutex);
+	*p = value;
+}
+
+
+void AtomicOps::store(void* volatile* p, void* value)
+{
+	FastMutex::ScopedLock lock(atomicMutex);
+	*p = value;
+}
+
+
+void AtomicOps::barrier()
+{
+	FastMutex::ScopedLock lock(atomicMutex);
+}
+
+
+#endif
+
+
+} // namespace Poco
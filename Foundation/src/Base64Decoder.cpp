@@ -35,21 +35,94 @@
 
 
 #include "Poco/Base64Decoder.h"
-#include "Poco/Base64Encoder.h"
 #include "Poco/Exception.h"
-#include "Poco/Mutex.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define POCO_HAVE_BASE64_SSE2
+#endif
 
 
 namespace Poco {
 
 
-unsigned char Base64DecoderBuf::IN_ENCODING[256];
-bool Base64DecoderBuf::IN_ENCODING_INIT = false;
-
-
 namespace
 {
-	static FastMutex mutex;
+	enum
+	{
+		PAD     = 0x40,
+		SPACE   = 0x41,
+		INVALID = 0xFF
+	};
+
+	// Maps base64 characters to their values, '=' to PAD,
+	// whitespace to SPACE and all other characters to INVALID.
+	static const unsigned char IN_ENCODING[256] =
+	{
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x41, 0x41, 0xFF, 0xFF, 0x41, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x41, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+	0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0x40, 0xFF, 0xFF,
+	0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+	0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+	0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+	};
+
+#if defined(POCO_HAVE_BASE64_SSE2)
+
+	inline __m128i inRange(__m128i v, char first, char last)
+		/// Returns 0xFF in every byte of v that is in the
+		/// range first .. last, and 0 in all other bytes.
+	{
+		__m128i biased = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - first)));
+		return _mm_cmplt_epi8(biased, _mm_set1_epi8(static_cast<char>(-128 + last - first + 1)));
+	}
+
+	inline bool decodeChars(const unsigned char* in, char* out)
+		/// Decodes 16 base64 characters into 12 bytes. Returns false,
+		/// without writing anything, if the characters contain
+		/// whitespace, padding or invalid characters.
+	{
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+		__m128i upper = inRange(v, 'A', 'Z');
+		__m128i lower = inRange(v, 'a', 'z');
+		__m128i digit = inRange(v, '0', '9');
+		__m128i plus  = _mm_cmpeq_epi8(v, _mm_set1_epi8('+'));
+		__m128i slash = _mm_cmpeq_epi8(v, _mm_set1_epi8('/'));
+		__m128i valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(plus, slash)));
+		if (_mm_movemask_epi8(valid) != 0xFFFF) return false;
+
+		__m128i offset = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+		offset = _mm_or_si128(offset, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+		offset = _mm_or_si128(offset, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+		offset = _mm_or_si128(offset, _mm_and_si128(plus, _mm_set1_epi8(62 - '+')));
+		offset = _mm_or_si128(offset, _mm_and_si128(slash, _mm_set1_epi8(63 - '/')));
+		v = _mm_add_epi8(v, offset);
+
+		// Combine the four 6-bit values of every 32-bit lane into a 24-bit group.
+		v = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(v, _mm_set1_epi16(0x00FF)), 6), _mm_srli_epi16(v, 8));
+		v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+		UInt32 groups[4];
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(groups), v);
+		for (int i = 0; i < 4; ++i)
+		{
+			out[0] = static_cast<char>(groups[i] >> 16);
+			out[1] = static_cast<char>(groups[i] >> 8);
+			out[2] = static_cast<char>(groups[i]);
+			out += 3;
+		}
+		return true;
+	}
+
+#endif
 }
 
 
@@ -58,20 +131,6 @@ Base64DecoderBuf::Base64DecoderBuf(std::istream& istr):
 	_groupIndex(0),
 	_buf(*istr.rdbuf())
 {
-	FastMutex::ScopedLock lock(mutex);
-	if (!IN_ENCODING_INIT)
-	{
-		for (unsigned i = 0; i < sizeof(IN_ENCODING); i++)
-		{
-			IN_ENCODING[i] = 0xFF;
-		}
-		for (unsigned i = 0; i < sizeof(Base64EncoderBuf::OUT_ENCODING); i++)
-		{
-			IN_ENCODING[Base64EncoderBuf::OUT_ENCODING[i]] = i;
-		}
-		IN_ENCODING[static_cast<unsigned char>('=')] = '\0';
-		IN_ENCODING_INIT = true;
-	}
 }
 
 
@@ -88,37 +147,63 @@ int Base64DecoderBuf::readFromDevice()
 	}
 	else
 	{
-		unsigned char buffer[4];
+		char buffer[4];
 		int c;
 		if ((c = readOne()) == -1) return -1;
-		buffer[0] = (unsigned char) c;
-		if (IN_ENCODING[buffer[0]] == 0xFF) throw DataFormatException();
-		if ((c = readOne()) == -1) throw DataFormatException();
-		buffer[1] = (unsigned char) c;
-		if (IN_ENCODING[buffer[1]] == 0xFF) throw DataFormatException();
-		if ((c = readOne()) == -1) throw DataFormatException();
-		buffer[2] = c;
-		if (IN_ENCODING[buffer[2]] == 0xFF) throw DataFormatException();
-		if ((c = readOne()) == -1) throw DataFormatException();
-		buffer[3] = c;
-		if (IN_ENCODING[buffer[3]] == 0xFF) throw DataFormatException();
-		
-		_group[0] = (IN_ENCODING[buffer[0]] << 2) | (IN_ENCODING[buffer[1]] >> 4);
-		_group[1] = ((IN_ENCODING[buffer[1]] & 0x0F) << 4) | (IN_ENCODING[buffer[2]] >> 2);
-		_group[2] = (IN_ENCODING[buffer[2]] << 6) | IN_ENCODING[buffer[3]];
-
-		if (buffer[2] == '=')
-			_groupLength = 1;
-		else if (buffer[3] == '=') 
-			_groupLength = 2;
-		else
-			_groupLength = 3;
+		buffer[0] = (char) c;
+		for (int i = 1; i < 4; ++i)
+		{
+			if ((c = readOne()) == -1) throw DataFormatException();
+			buffer[i] = (char) c;
+		}
+		_groupLength = static_cast<int>(Base64Decoder::decode(buffer, 4, reinterpret_cast<char*>(_group)));
 		_groupIndex = 1;
 		return _group[0];
 	}
 }
 
 
+std::streamsize Base64DecoderBuf::readBlockFromDevice(char* buffer, std::streamsize length)
+{
+	std::streamsize n = 0;
+	while (n < length && _groupIndex < _groupLength)
+	{
+		buffer[n++] = static_cast<char>(_group[_groupIndex++]);
+	}
+	char input[4096 + 4];
+	while (length - n >= 3)
+	{
+		// Read no more characters than needed for the requested
+		// number of bytes, so that the underlying stream is
+		// positioned exactly as when reading one group at a time.
+		std::streamsize size = (length - n)/3*4;
+		if (size > 4096) size = 4096;
+		std::streamsize count = _buf.sgetn(input, size);
+		if (count == 0) break;
+		int chars = 0;
+		for (std::streamsize i = 0; i < count; ++i)
+		{
+			if (IN_ENCODING[static_cast<unsigned char>(input[i])] != SPACE) ++chars;
+		}
+		while (chars % 4 != 0)
+		{
+			int c = readOne();
+			if (c == -1) throw DataFormatException();
+			input[count++] = (char) c;
+			++chars;
+		}
+		n += static_cast<std::streamsize>(Base64Decoder::decode(input, static_cast<std::size_t>(count), buffer + n));
+	}
+	while (n < length)
+	{
+		int c = readFromDevice();
+		if (c == -1) break;
+		buffer[n++] = static_cast<char>(c);
+	}
+	return n;
+}
+
+
 int Base64DecoderBuf::readOne()
 {
 	int ch = _buf.sbumpc();
@@ -155,4 +240,85 @@ Base64Decoder::~Base64Decoder()
 }
 
 
+std::size_t Base64Decoder::decodedLength(std::size_t length)
+{
+	return (length + 3)/4*3;
+}
+
+
+std::size_t Base64Decoder::decode(const char* buffer, std::size_t length, char* output)
+{
+	const unsigned char* it  = reinterpret_cast<const unsigned char*>(buffer);
+	const unsigned char* end = it + length;
+	char* out = output;
+	for (;;)
+	{
+		// fast path: groups without whitespace and padding
+#if defined(POCO_HAVE_BASE64_SSE2)
+		while (end - it >= 16 && decodeChars(it, out))
+		{
+			it  += 16;
+			out += 12;
+		}
+#endif
+		while (end - it >= 4)
+		{
+			UInt32 a = IN_ENCODING[it[0]];
+			UInt32 b = IN_ENCODING[it[1]];
+			UInt32 c = IN_ENCODING[it[2]];
+			UInt32 d = IN_ENCODING[it[3]];
+			if ((a | b | c | d) >= PAD) break;
+			UInt32 group = (a << 18) | (b << 12) | (c << 6) | d;
+			out[0] = static_cast<char>(group >> 16);
+			out[1] = static_cast<char>(group >> 8);
+			out[2] = static_cast<char>(group);
+			out += 3;
+			it  += 4;
+		}
+		unsigned char chars[4];
+		UInt32 group = 0;
+		int n = 0;
+		while (n < 4 && it != end)
+		{
+			unsigned char ch  = *it++;
+			unsigned char val = IN_ENCODING[ch];
+			if (val == SPACE) continue;
+			if (val == INVALID) throw DataFormatException();
+			chars[n++] = ch;
+			group = (group << 6) | (val == PAD ? 0 : val);
+		}
+		if (n == 0) break;
+		if (n < 4) throw DataFormatException();
+		out[0] = static_cast<char>(group >> 16);
+		if (chars[2] == '=')
+		{
+			out += 1;
+		}
+		else if (chars[3] == '=')
+		{
+			out[1] = static_cast<char>(group >> 8);
+			out += 2;
+		}
+		else
+		{
+			out[1] = static_cast<char>(group >> 8);
+			out[2] = static_cast<char>(group);
+			out += 3;
+		}
+	}
+	return out - output;
+}
+
+
+std::string Base64Decoder::decode(const std::string& data)
+{
+	std::string result(decodedLength(data.size()), '\0');
+	if (!data.empty())
+	{
+		result.resize(decode(data.data(), data.size(), &result[0]));
+	}
+	return result;
+}
+
+
 } // namespace Poco
@@ -35,11 +35,38 @@
 
 
 #include "Poco/Base64Encoder.h"
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define POCO_HAVE_BASE64_SSE2
+#endif
 
 
 namespace Poco {
 
 
+#if defined(POCO_HAVE_BASE64_SSE2)
+
+
+namespace
+{
+	inline __m128i encodeIndexes(__m128i idx)
+		/// Maps the 6-bit values in every byte of idx
+		/// to the corresponding base64 characters.
+	{
+		__m128i offset = _mm_set1_epi8('A');
+		offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpgt_epi8(idx, _mm_set1_epi8(25)), _mm_set1_epi8('a' - 'A' - 26)));
+		offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpgt_epi8(idx, _mm_set1_epi8(51)), _mm_set1_epi8('0' - 'a' - 26)));
+		offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpgt_epi8(idx, _mm_set1_epi8(61)), _mm_set1_epi8('+' - '0' - 10)));
+		offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpgt_epi8(idx, _mm_set1_epi8(62)), _mm_set1_epi8('/' - '+' - 1)));
+		return _mm_add_epi8(idx, offset);
+	}
+}
+
+
+#endif
+
+
 const unsigned char Base64EncoderBuf::OUT_ENCODING[64] =
 {
 	'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',
@@ -88,30 +115,123 @@ int Base64EncoderBuf::getLineLength() const
 
 int Base64EncoderBuf::writeToDevice(char c)
 {
-	static const int eof = std::char_traits<char>::eof();
-
 	_group[_groupLength++] = (unsigned char) c;
 	if (_groupLength == 3)
 	{
-		unsigned char idx;
-		idx = _group[0] >> 2;
-		if (_buf.sputc(OUT_ENCODING[idx]) == eof) return eof;
-		idx = ((_group[0] & 0x03) << 4) | (_group[1] >> 4);
-		if (_buf.sputc(OUT_ENCODING[idx]) == eof) return eof;
-		idx = ((_group[1] & 0x0F) << 2) | (_group[2] >> 6);
-		if (_buf.sputc(OUT_ENCODING[idx]) == eof) return eof;
-		idx = _group[2] & 0x3F;
-		if (_buf.sputc(OUT_ENCODING[idx]) == eof) return eof;
-		_pos += 4;
-		if (_lineLength > 0 && _pos >= _lineLength) 
+		if (writeGroup() == std::char_traits<char>::eof()) return std::char_traits<char>::eof();
+	}
+	return charToInt(c);
+}
+
+
+std::streamsize Base64EncoderBuf::writeBlockToDevice(const char* buffer, std::streamsize length)
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	const unsigned char* it  = reinterpret_cast<const unsigned char*>(buffer);
+	const unsigned char* end = it + length;
+	while (_groupLength != 0 && it != end)
+	{
+		if (writeToDevice(static_cast<char>(*it)) == eof) return it - reinterpret_cast<const unsigned char*>(buffer);
+		++it;
+	}
+	char output[4096];
+	while (end - it >= 3)
+	{
+		const unsigned char* chunk = it;
+		std::size_t n = 0;
+		while (end - it >= 3 && n + 6 <= sizeof(output))
 		{
-			if (_buf.sputc('\r') == eof) return eof;
-			if (_buf.sputc('\n') == eof) return eof;
-			_pos = 0;
+			std::size_t groups = (end - it)/3;
+			std::size_t room = (sizeof(output) - n - 2)/4;
+			if (groups > room) groups = room;
+			if (_lineLength > 0)
+			{
+				int lineGroups = (_lineLength - _pos + 3)/4;
+				if (lineGroups < 1) lineGroups = 1;
+				if (groups > static_cast<std::size_t>(lineGroups)) groups = lineGroups;
+			}
+			encodeGroups(it, groups, output + n);
+			it  += 3*groups;
+			n   += 4*groups;
+			_pos += 4*static_cast<int>(groups);
+			if (_lineLength > 0 && _pos >= _lineLength)
+			{
+				output[n++] = '\r';
+				output[n++] = '\n';
+				_pos = 0;
+			}
 		}
-		_groupLength = 0;
+		if (_buf.sputn(output, static_cast<std::streamsize>(n)) != static_cast<std::streamsize>(n)) return chunk - reinterpret_cast<const unsigned char*>(buffer);
+	}
+	while (it != end)
+	{
+		_group[_groupLength++] = *it++;
+	}
+	return length;
+}
+
+
+int Base64EncoderBuf::writeGroup()
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	unsigned char idx;
+	idx = _group[0] >> 2;
+	if (_buf.sputc(OUT_ENCODING[idx]) == eof) return eof;
+	idx = ((_group[0] & 0x03) << 4) | (_group[1] >> 4);
+	if (_buf.sputc(OUT_ENCODING[idx]) == eof) return eof;
+	idx = ((_group[1] & 0x0F) << 2) | (_group[2] >> 6);
+	if (_buf.sputc(OUT_ENCODING[idx]) == eof) return eof;
+	idx = _group[2] & 0x3F;
+	if (_buf.sputc(OUT_ENCODING[idx]) == eof) return eof;
+	_pos += 4;
+	if (_lineLength > 0 && _pos >= _lineLength) 
+	{
+		if (_buf.sputc('\r') == eof) return eof;
+		if (_buf.sputc('\n') == eof) return eof;
+		_pos = 0;
+	}
+	_groupLength = 0;
+	return 0;
+}
+
+
+void Base64EncoderBuf::encodeGroups(const unsigned char* buffer, std::size_t groups, char* output)
+{
+#if defined(POCO_HAVE_BASE64_SSE2)
+	// Encode four groups at a time. Every 32-bit lane receives one
+	// group (plus one byte of the next group, which is ignored), so
+	// at least one more group must follow.
+	for (; groups > 4; groups -= 4)
+	{
+		UInt32 lanes[4];
+		std::memcpy(&lanes[0], buffer, 4);
+		std::memcpy(&lanes[1], buffer + 3, 4);
+		std::memcpy(&lanes[2], buffer + 6, 4);
+		std::memcpy(&lanes[3], buffer + 9, 4);
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes));
+		__m128i idx = _mm_and_si128(_mm_srli_epi32(v, 2), _mm_set1_epi32(0x3F));
+		idx = _mm_or_si128(idx, _mm_slli_epi32(_mm_and_si128(v, _mm_set1_epi32(0x03)), 12));
+		idx = _mm_or_si128(idx, _mm_srli_epi32(_mm_and_si128(v, _mm_set1_epi32(0xF000)), 4));
+		idx = _mm_or_si128(idx, _mm_slli_epi32(_mm_and_si128(v, _mm_set1_epi32(0x0F00)), 10));
+		idx = _mm_or_si128(idx, _mm_srli_epi32(_mm_and_si128(v, _mm_set1_epi32(0xC00000)), 6));
+		idx = _mm_or_si128(idx, _mm_slli_epi32(_mm_and_si128(v, _mm_set1_epi32(0x3F0000)), 8));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(output), encodeIndexes(idx));
+		buffer += 12;
+		output += 16;
+	}
+#endif
+	for (; groups > 0; --groups)
+	{
+		UInt32 group = (UInt32(buffer[0]) << 16) | (UInt32(buffer[1]) << 8) | buffer[2];
+		output[0] = OUT_ENCODING[group >> 18];
+		output[1] = OUT_ENCODING[(group >> 12) & 0x3F];
+		output[2] = OUT_ENCODING[(group >> 6) & 0x3F];
+		output[3] = OUT_ENCODING[group & 0x3F];
+		buffer += 3;
+		output += 4;
 	}
-	return charToInt(c);
 }
 
 
@@ -181,4 +301,41 @@ Base64Encoder::~Base64Encoder()
 }
 
 
+std::size_t Base64Encoder::encodedLength(std::size_t length)
+{
+	return (length + 2)/3*4;
+}
+
+
+std::size_t Base64Encoder::encode(const char* buffer, std::size_t length, char* output)
+{
+	const unsigned char* in = reinterpret_cast<const unsigned char*>(buffer);
+	std::size_t groups = length/3;
+	Base64EncoderBuf::encodeGroups(in, groups, output);
+	in += 3*groups;
+	char* out = output + 4*groups;
+	std::size_t rest = length - 3*groups;
+	if (rest > 0)
+	{
+		unsigned char last[3] = {in[0], static_cast<unsigned char>(rest > 1 ? in[1] : 0), 0};
+		Base64EncoderBuf::encodeGroups(last, 1, out);
+		if (rest == 1) out[2] = '=';
+		out[3] = '=';
+		out += 4;
+	}
+	return out - output;
+}
+
+
+std::string Base64Encoder::encode(const std::string& data)
+{
+	std::string result(encodedLength(data.size()), '\0');
+	if (!data.empty())
+	{
+		encode(data.data(), data.size(), &result[0]);
+	}
+	return result;
+}
+
+
 } // namespace Poco
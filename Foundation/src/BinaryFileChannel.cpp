@@ -0,0 +1,217 @@
+//
+// BinaryFileChannel.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryFileChannel
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/BinaryFileChannel.h"
+#include "Poco/LogFile.h"
+#include "Poco/Message.h"
+#include <cstring>
+
+
+namespace Poco {
+
+
+namespace
+{
+	inline void appendUInt(std::string& record, UInt64 value)
+	{
+		while (value >= 0x80)
+		{
+			record += static_cast<char>((value & 0x7F) | 0x80);
+			value >>= 7;
+		}
+		record += static_cast<char>(value);
+	}
+
+	inline void appendInline(std::string& record, const char* value, std::size_t length)
+	{
+		appendUInt(record, static_cast<UInt64>(length) << 1);
+		record.append(value, length);
+	}
+
+	void insertSize(std::string& record, std::string::size_type pos)
+	{
+		char size[10];
+		std::size_t n = 0;
+		UInt64 value = record.size() - pos;
+		while (value >= 0x80)
+		{
+			size[n++] = static_cast<char>((value & 0x7F) | 0x80);
+			value >>= 7;
+		}
+		size[n++] = static_cast<char>(value);
+		record.insert(pos, size, n);
+	}
+
+	// LogFile appends the line ending after the last record
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	const char EOL[] = "\r\n";
+#else
+	const char EOL[] = "\n";
+#endif
+}
+
+
+BinaryFileChannel::BinaryFileChannel()
+{
+}
+
+
+BinaryFileChannel::BinaryFileChannel(const std::string& path): FileChannel(path)
+{
+}
+
+
+BinaryFileChannel::~BinaryFileChannel()
+{
+}
+
+
+void BinaryFileChannel::log(const Message& msg)
+{
+	FastMutex::ScopedLock lock(_recordMutex);
+
+	_record.clear();
+	encodeRecord(msg, _record);
+	write(_record, msg.getPriority());
+}
+
+
+void BinaryFileChannel::logBatch(const Message* pMessages, std::size_t count)
+{
+	if (count == 0) return;
+
+	FastMutex::ScopedLock lock(_recordMutex);
+
+	_record.clear();
+	int priority = Message::PRIO_TRACE;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		if (i > 0) _record.append(EOL);
+		encodeRecord(pMessages[i], _record);
+		if (pMessages[i].getPriority() < priority) priority = pMessages[i].getPriority();
+	}
+	write(_record, priority);
+}
+
+
+void BinaryFileChannel::onFileOpened(LogFile& file)
+{
+	FastMutex::ScopedLock lock(_stringMutex);
+
+	if (!_definitions.empty())
+	{
+		// the last line ending is appended by LogFile
+		file.write(_definitions.substr(0, _definitions.size() - std::strlen(EOL)), false);
+	}
+}
+
+
+void BinaryFileChannel::encodeRecord(const Message& msg, std::string& record)
+{
+	// String records for strings used for the first time
+	// are appended to record before the message record.
+	_message.clear();
+	_message += static_cast<char>(MESSAGE_RECORD);
+	appendUInt(_message, static_cast<UInt64>(msg.getTime().epochMicroseconds()));
+	_message += static_cast<char>(msg.getPriority());
+	appendUInt(_message, static_cast<UInt64>(msg.getPid()));
+	appendUInt(_message, static_cast<UInt64>(msg.getTid()));
+	{
+		FastMutex::ScopedLock lock(_stringMutex);
+
+		appendString(msg.getSource(), _message, record);
+		appendString(msg.getThread(), _message, record);
+		appendInline(_message, msg.getText().data(), msg.getText().size());
+		appendFile(msg.getSourceFile(), _message, record);
+	}
+	appendUInt(_message, static_cast<UInt64>(msg.getSourceLine()));
+	insertSize(_message, 1);
+	record.append(_message);
+}
+
+
+void BinaryFileChannel::appendString(const std::string& value, std::string& message, std::string& record)
+{
+	if (value.empty())
+	{
+		appendUInt(message, 0);
+		return;
+	}
+	StringMap::const_iterator it = _strings.find(value);
+	if (it != _strings.end())
+	{
+		appendUInt(message, (static_cast<UInt64>(it->second) << 1) | 1);
+	}
+	else if (_strings.size() < MAX_STRINGS)
+	{
+		UInt32 id = defineString(value.data(), value.size(), record);
+		_strings[value] = id;
+		appendUInt(message, (static_cast<UInt64>(id) << 1) | 1);
+	}
+	else appendInline(message, value.data(), value.size());
+}
+
+
+void BinaryFileChannel::appendFile(const char* file, std::string& message, std::string& record)
+{
+	if (!file)
+	{
+		appendUInt(message, 0);
+		return;
+	}
+	// File names are looked up by their contents, like other
+	// strings. The name is copied into a member buffer first,
+	// which avoids allocating a temporary string.
+	_fileName.assign(file);
+	appendString(_fileName, message, record);
+}
+
+
+UInt32 BinaryFileChannel::defineString(const char* value, std::size_t length, std::string& record)
+{
+	UInt32 id = static_cast<UInt32>(_strings.size());
+	std::string::size_type pos = _definitions.size();
+	_definitions += static_cast<char>(STRING_RECORD);
+	appendUInt(_definitions, id);
+	_definitions.append(value, length);
+	insertSize(_definitions, pos + 1);
+	_definitions.append(EOL);
+	record.append(_definitions, pos, std::string::npos);
+	return id;
+}
+
+
+} // namespace Poco
@@ -0,0 +1,217 @@
+//
+// BinaryLogReader.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryLogReader
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/BinaryLogReader.h"
+#include "Poco/BinaryFileChannel.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+
+
+namespace
+{
+	class RecordParser
+	{
+	public:
+		RecordParser(const std::string& record, const std::vector<std::string>& strings):
+			_it(record.begin()),
+			_end(record.end()),
+			_strings(strings)
+		{
+		}
+
+		UInt64 readUInt()
+		{
+			UInt64 value = 0;
+			int shift = 0;
+			for (;;)
+			{
+				if (_it == _end || shift > 63) throw DataFormatException("Invalid binary log record");
+				unsigned char c = static_cast<unsigned char>(*_it++);
+				value |= static_cast<UInt64>(c & 0x7F) << shift;
+				if ((c & 0x80) == 0) break;
+				shift += 7;
+			}
+			return value;
+		}
+
+		void readString(std::string& value)
+		{
+			UInt64 n = readUInt();
+			if (n & 1)
+			{
+				UInt64 id = n >> 1;
+				if (id >= _strings.size()) throw DataFormatException("Undefined string in binary log record");
+				value = _strings[static_cast<std::size_t>(id)];
+			}
+			else
+			{
+				UInt64 length = n >> 1;
+				if (length > static_cast<UInt64>(_end - _it)) throw DataFormatException("Invalid binary log record");
+				value.assign(_it, _it + static_cast<std::string::size_type>(length));
+				_it += static_cast<std::string::size_type>(length);
+			}
+		}
+
+		void readRest(std::string& value)
+		{
+			value.assign(_it, _end);
+			_it = _end;
+		}
+
+		int readByte()
+		{
+			if (_it == _end) throw DataFormatException("Invalid binary log record");
+			return static_cast<unsigned char>(*_it++);
+		}
+
+	private:
+		std::string::const_iterator     _it;
+		std::string::const_iterator     _end;
+		const std::vector<std::string>& _strings;
+	};
+}
+
+
+BinaryLogReader::BinaryLogReader(std::istream& istr):
+	_istr(istr)
+{
+}
+
+
+BinaryLogReader::~BinaryLogReader()
+{
+}
+
+
+bool BinaryLogReader::read(Message& msg)
+{
+	for (;;)
+	{
+		int type = readRecord();
+		if (type == BinaryFileChannel::MESSAGE_RECORD)
+		{
+			readMessage(msg);
+			return true;
+		}
+		else if (type == BinaryFileChannel::STRING_RECORD)
+		{
+			readStringRecord();
+		}
+		else return false;
+	}
+}
+
+
+int BinaryLogReader::readRecord()
+{
+	int c = _istr.get();
+	while (c == '\r' || c == '\n' || c == '#')
+	{
+		if (c == '#')
+		{
+			while (c != '\n' && c != std::char_traits<char>::eof()) c = _istr.get();
+		}
+		c = _istr.get();
+	}
+	if (c == std::char_traits<char>::eof()) return c;
+	if (c != BinaryFileChannel::MESSAGE_RECORD && c != BinaryFileChannel::STRING_RECORD)
+		throw DataFormatException("Not a binary log record");
+
+	int type = c;
+	UInt64 size = 0;
+	int shift = 0;
+	do
+	{
+		c = _istr.get();
+		if (c == std::char_traits<char>::eof() || shift > 63) throw DataFormatException("Truncated binary log record");
+		size |= static_cast<UInt64>(c & 0x7F) << shift;
+		shift += 7;
+	}
+	while (c & 0x80);
+	if (size > 0x7FFFFFFF) throw DataFormatException("Invalid binary log record size");
+
+	_record.resize(static_cast<std::string::size_type>(size));
+	if (size > 0)
+	{
+		_istr.read(&_record[0], static_cast<std::streamsize>(size));
+		if (_istr.gcount() != static_cast<std::streamsize>(size)) throw DataFormatException("Truncated binary log record");
+	}
+	return type;
+}
+
+
+void BinaryLogReader::readMessage(Message& msg)
+{
+	RecordParser parser(_record, _strings);
+	msg.setTime(Timestamp(static_cast<Timestamp::TimeVal>(parser.readUInt())));
+	msg.setPriority(static_cast<Message::Priority>(parser.readByte()));
+	msg.setPid(static_cast<long>(parser.readUInt()));
+	msg.setTid(static_cast<long>(parser.readUInt()));
+	std::string value;
+	parser.readString(value);
+	msg.setSource(value);
+	parser.readString(value);
+	msg.setThread(value);
+	parser.readString(value);
+	msg.setText(value);
+	parser.readString(value);
+	if (value.empty())
+		msg.setSourceFile(0);
+	else
+		msg.setSourceFile(_files.insert(value).first->c_str());
+	msg.setSourceLine(static_cast<int>(parser.readUInt()));
+}
+
+
+void BinaryLogReader::readStringRecord()
+{
+	RecordParser parser(_record, _strings);
+	UInt64 id = parser.readUInt();
+	if (id > _strings.size()) throw DataFormatException("Invalid string number in binary log record");
+	std::string value;
+	parser.readRest(value);
+	// every log file repeats the strings defined so far
+	if (id == _strings.size())
+		_strings.push_back(value);
+	else
+		_strings[static_cast<std::size_t>(id)] = value;
+}
+
+
+} // namespace Poco
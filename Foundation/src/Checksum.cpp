@@ -40,11 +40,164 @@
 #else
 #include "Poco/zlib.h"
 #endif
+#include <cstring>
+#if defined(_MSC_VER) && _MSC_VER >= 1500 && (defined(_M_IX86) || defined(_M_X64))
+	#include <intrin.h>
+	#include <nmmintrin.h>
+	#define POCO_HAVE_CRC32C_SSE42
+#elif defined(__GNUC__) && !defined(__clang__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)) && (defined(__i386__) || defined(__x86_64__))
+	#include <cpuid.h>
+	#define POCO_HAVE_CRC32C_SSE42
+#endif
 
 
 namespace Poco {
 
 
+namespace
+{
+	class CRC32C
+		/// Calculates CRC-32C checksums, using the CRC32 
+		/// instruction if the CPU supports SSE 4.2, or
+		/// a slicing-by-8 table-driven algorithm otherwise.
+	{
+	public:
+		CRC32C()
+		{
+			for (UInt32 i = 0; i < 256; ++i)
+			{
+				UInt32 crc = i;
+				for (int k = 0; k < 8; ++k)
+				{
+					crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78 : (crc >> 1);
+				}
+				_table[0][i] = crc;
+			}
+			for (UInt32 i = 0; i < 256; ++i)
+			{
+				for (int t = 1; t < 8; ++t)
+				{
+					_table[t][i] = (_table[t - 1][i] >> 8) ^ _table[0][_table[t - 1][i] & 0xFF];
+				}
+			}
+#if defined(POCO_HAVE_CRC32C_SSE42)
+			_hardware = haveSSE42();
+#else
+			_hardware = false;
+#endif
+		}
+
+		UInt32 update(UInt32 crc, const unsigned char* data, std::size_t length) const
+		{
+#if defined(POCO_HAVE_CRC32C_SSE42)
+			if (_hardware) return ~updateSSE42(~crc, data, length);
+#endif
+			return ~updateTable(~crc, data, length);
+		}
+
+	private:
+		UInt32 updateTable(UInt32 crc, const unsigned char* data, std::size_t length) const
+		{
+			for (; length >= 8; length -= 8)
+			{
+				UInt32 lo = crc ^ (UInt32(data[0]) | (UInt32(data[1]) << 8) | (UInt32(data[2]) << 16) | (UInt32(data[3]) << 24));
+				UInt32 hi = UInt32(data[4]) | (UInt32(data[5]) << 8) | (UInt32(data[6]) << 16) | (UInt32(data[7]) << 24);
+				crc = _table[7][lo & 0xFF] ^ _table[6][(lo >> 8) & 0xFF] ^ _table[5][(lo >> 16) & 0xFF] ^ _table[4][lo >> 24]
+				    ^ _table[3][hi & 0xFF] ^ _table[2][(hi >> 8) & 0xFF] ^ _table[1][(hi >> 16) & 0xFF] ^ _table[0][hi >> 24];
+				data += 8;
+			}
+			for (; length > 0; --length)
+			{
+				crc = _table[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+			}
+			return crc;
+		}
+
+#if defined(POCO_HAVE_CRC32C_SSE42)
+#if defined(_MSC_VER)
+
+		static bool haveSSE42()
+		{
+			int info[4];
+			__cpuid(info, 1);
+			return (info[2] & (1 << 20)) != 0;
+		}
+
+		static UInt32 updateSSE42(UInt32 crc, const unsigned char* data, std::size_t length)
+		{
+#if defined(_M_X64)
+			UInt64 crc64 = crc;
+			for (; length >= 8; length -= 8)
+			{
+				UInt64 value;
+				std::memcpy(&value, data, 8);
+				crc64 = _mm_crc32_u64(crc64, value);
+				data += 8;
+			}
+			crc = static_cast<UInt32>(crc64);
+#endif
+			for (; length >= 4; length -= 4)
+			{
+				UInt32 value;
+				std::memcpy(&value, data, 4);
+				crc = _mm_crc32_u32(crc, value);
+				data += 4;
+			}
+			for (; length > 0; --length)
+			{
+				crc = _mm_crc32_u8(crc, *data++);
+			}
+			return crc;
+		}
+
+#else
+
+		static bool haveSSE42()
+		{
+			unsigned eax, ebx, ecx, edx;
+			return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSE4_2) != 0;
+		}
+
+		__attribute__((target("sse4.2")))
+		static UInt32 updateSSE42(UInt32 crc, const unsigned char* data, std::size_t length)
+		{
+#if defined(__x86_64__)
+			unsigned long long crc64 = crc;
+			for (; length >= 8; length -= 8)
+			{
+				unsigned long long value;
+				std::memcpy(&value, data, 8);
+				crc64 = __builtin_ia32_crc32di(crc64, value);
+				data += 8;
+			}
+			crc = static_cast<UInt32>(crc64);
+#endif
+			for (; length >= 4; length -= 4)
+			{
+				UInt32 value;
+				std::memcpy(&value, data, 4);
+				crc = __builtin_ia32_crc32si(crc, value);
+				data += 4;
+			}
+			for (; length > 0; --length)
+			{
+				crc = __builtin_ia32_crc32qi(crc, *data++);
+			}
+			return crc;
+		}
+
+#endif
+#endif // POCO_HAVE_CRC32C_SSE42
+
+		UInt32 _table[8][256];
+		bool   _hardware;
+	};
+
+
+	static const CRC32C crc32c;
+}
+
+
 Checksum::Checksum():
 	_type(TYPE_CRC32),
 	_value(crc32(0L, Z_NULL, 0))
@@ -58,7 +211,7 @@ Checksum::Checksum(Type t):
 {
 	if (t == TYPE_CRC32)
 		_value = crc32(0L, Z_NULL, 0);
-	else
+	else if (t == TYPE_ADLER32)
 		_value = adler32(0L, Z_NULL, 0);
 }
 
@@ -72,6 +225,8 @@ void Checksum::update(const char* data, unsigned length)
 {
 	if (_type == TYPE_ADLER32)
 		_value = adler32(_value, reinterpret_cast<const Bytef*>(data), length);
+	else if (_type == TYPE_CRC32C)
+		_value = crc32c.update(_value, reinterpret_cast<const unsigned char*>(data), length);
 	else
 		_value = crc32(_value, reinterpret_cast<const Bytef*>(data), length);
 }
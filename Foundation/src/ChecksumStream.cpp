@@ -0,0 +1,172 @@
+//
+// ChecksumStream.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  ChecksumStream
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/ChecksumStream.h"
+
+
+namespace Poco {
+
+
+const int ChecksumBuf::BUFFER_SIZE = 4096;
+
+
+ChecksumBuf::ChecksumBuf(Checksum& checksum): 
+	BufferedStreamBuf(BUFFER_SIZE, std::ios::out), 
+	_checksum(checksum), 
+	_pIstr(0),
+	_pOstr(0) 
+{
+}
+
+
+ChecksumBuf::ChecksumBuf(Checksum& checksum, std::istream& istr): 
+	BufferedStreamBuf(BUFFER_SIZE, std::ios::in), 
+	_checksum(checksum), 
+	_pIstr(&istr), 
+	_pOstr(0)
+{
+}
+
+
+ChecksumBuf::ChecksumBuf(Checksum& checksum, std::ostream& ostr): 
+	BufferedStreamBuf(BUFFER_SIZE, std::ios::out), 
+	_checksum(checksum), 
+	_pIstr(0), 
+	_pOstr(&ostr)
+{
+}
+
+
+ChecksumBuf::~ChecksumBuf()
+{
+}
+
+
+int ChecksumBuf::readFromDevice(char* buffer, std::streamsize length)
+{
+	if (_pIstr && _pIstr->good())
+	{
+		_pIstr->read(buffer, length);
+		std::streamsize n = _pIstr->gcount();
+		if (n > 0) _checksum.update(buffer, static_cast<unsigned>(n));
+		return static_cast<int>(n);
+	}
+	return -1;
+}
+
+
+int ChecksumBuf::writeToDevice(const char* buffer, std::streamsize length)
+{
+	_checksum.update(buffer, static_cast<unsigned>(length));
+	if (_pOstr) _pOstr->write(buffer, length);
+	return static_cast<int>(length);
+}
+
+
+void ChecksumBuf::close()
+{
+	sync();
+	if (_pOstr) _pOstr->flush();
+}
+
+
+ChecksumIOS::ChecksumIOS(Checksum& checksum): _buf(checksum)
+{
+	poco_ios_init(&_buf);
+}
+
+
+ChecksumIOS::ChecksumIOS(Checksum& checksum, std::istream& istr): _buf(checksum, istr)
+{
+	poco_ios_init(&_buf);
+}
+
+
+ChecksumIOS::ChecksumIOS(Checksum& checksum, std::ostream& ostr): _buf(checksum, ostr)
+{
+	poco_ios_init(&_buf);
+}
+
+
+ChecksumIOS::~ChecksumIOS()
+{
+}
+
+
+ChecksumBuf* ChecksumIOS::rdbuf()
+{
+	return &_buf;
+}
+
+
+ChecksumInputStream::ChecksumInputStream(Checksum& checksum, std::istream& istr): 
+	ChecksumIOS(checksum, istr), 
+	std::istream(&_buf)
+{
+}
+
+
+ChecksumInputStream::~ChecksumInputStream()
+{
+}
+
+
+ChecksumOutputStream::ChecksumOutputStream(Checksum& checksum): 
+	ChecksumIOS(checksum), 
+	std::ostream(&_buf)
+{
+}
+
+
+ChecksumOutputStream::ChecksumOutputStream(Checksum& checksum, std::ostream& ostr): 
+	ChecksumIOS(checksum, ostr), 
+	std::ostream(&_buf)
+{
+}
+
+
+ChecksumOutputStream::~ChecksumOutputStream()
+{
+}
+
+
+void ChecksumOutputStream::close()
+{
+	_buf.close();
+}
+
+
+} // namespace Poco
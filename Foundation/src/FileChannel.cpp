@@ -40,6 +40,7 @@
 #include "Poco/PurgeStrategy.h"
 #include "Poco/Message.h"
 #include "Poco/NumberParser.h"
+#include "Poco/NumberFormatter.h"
 #include "Poco/DateTimeFormatter.h"
 #include "Poco/DateTime.h"
 #include "Poco/LocalDateTime.h"
@@ -47,6 +48,8 @@
 #include "Poco/Timespan.h"
 #include "Poco/Exception.h"
 #include "Poco/Ascii.h"
+#include "Poco/Logger.h"
+#include "Poco/Timer.h"
 
 
 namespace Poco {
@@ -59,14 +62,25 @@ const std::string FileChannel::PROP_TIMES        = "times";
 const std::string FileChannel::PROP_COMPRESS     = "compress";
 const std::string FileChannel::PROP_PURGEAGE     = "purgeAge";
 const std::string FileChannel::PROP_PURGECOUNT   = "purgeCount";
-const std::string FileChannel::PROP_FLUSH        = "flush	";
+const std::string FileChannel::PROP_FLUSH        = "flush";
 const std::string FileChannel::PROP_ROTATEONOPEN = "rotateOnOpen";
+const std::string FileChannel::PROP_BUFFERSIZE   = "bufferSize";
+const std::string FileChannel::PROP_FLUSHINTERVAL = "flushInterval";
+const std::string FileChannel::PROP_FLUSHPRIORITY = "flushPriority";
+const std::string FileChannel::PROP_SYNCINTERVAL = "syncInterval";
 
 FileChannel::FileChannel(): 
 	_times("utc"),
 	_compress(false),
 	_flush(true),
 	_rotateOnOpen(false),
+	_bufferSize("none"),
+	_bufferLimit(0),
+	_flushInterval(1000),
+	_flushPriority("error"),
+	_flushLevel(Message::PRIO_ERROR),
+	_syncInterval(0),
+	_pTimer(0),
 	_pFile(0),
 	_pRotateStrategy(0),
 	_pArchiveStrategy(new ArchiveByNumberStrategy),
@@ -81,6 +95,13 @@ FileChannel::FileChannel(const std::string& path):
 	_compress(false),
 	_flush(true),
 	_rotateOnOpen(false),
+	_bufferSize("none"),
+	_bufferLimit(0),
+	_flushInterval(1000),
+	_flushPriority("error"),
+	_flushLevel(Message::PRIO_ERROR),
+	_syncInterval(0),
+	_pTimer(0),
 	_pFile(0),
 	_pRotateStrategy(0),
 	_pArchiveStrategy(new ArchiveByNumberStrategy),
@@ -117,12 +138,17 @@ void FileChannel::open()
 				_pFile = new LogFile(_path);
 			}
 		}
+		_pFile->setBufferSize(_bufferLimit);
+		onFileOpened(*_pFile);
+		startTimer();
 	}
 }
 
 
 void FileChannel::close()
 {
+	stopTimer();
+
 	FastMutex::ScopedLock lock(_mutex);
 
 	delete _pFile;
@@ -131,13 +157,61 @@ void FileChannel::close()
 
 
 void FileChannel::log(const Message& msg)
+{
+	write(msg.getText(), msg.getPriority());
+}
+
+
+void FileChannel::logBatch(const Message* pMessages, std::size_t count)
+{
+	if (count == 0) return;
+
+	// LogFile appends the line ending after the last message
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	const char* EOL = "\r\n";
+	const std::size_t EOL_SIZE = 2;
+#else
+	const char* EOL = "\n";
+	const std::size_t EOL_SIZE = 1;
+#endif
+	std::string::size_type size = 0;
+	int priority = Message::PRIO_TRACE;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		size += pMessages[i].getText().size() + EOL_SIZE;
+		if (pMessages[i].getPriority() < priority) priority = pMessages[i].getPriority();
+	}
+	std::string text;
+	text.reserve(size);
+	text = pMessages[0].getText();
+	for (std::size_t i = 1; i < count; ++i)
+	{
+		text += EOL;
+		text += pMessages[i].getText();
+	}
+	write(text, priority);
+}
+
+
+void FileChannel::write(const std::string& text, int priority)
 {
 	open();
 
 	FastMutex::ScopedLock lock(_mutex);
 
+	rotate();
+	_pFile->write(text, _flush);
+	if (_bufferLimit > 0 && priority <= _flushLevel)
+		_pFile->flush();
+}
+
+
+void FileChannel::rotate()
+{
 	if (_pRotateStrategy && _pArchiveStrategy && _pRotateStrategy->mustRotate(_pFile))
 	{
+		// buffered messages belong to the file being archived
+		_pFile->flush();
 		try
 		{
 			_pFile = _pArchiveStrategy->archive(_pFile);
@@ -151,8 +225,14 @@ void FileChannel::log(const Message& msg)
 		// RotateByIntervalStrategy a chance to write its timestamp
 		// to the new file.
 		_pRotateStrategy->mustRotate(_pFile);
+		_pFile->setBufferSize(_bufferLimit);
+		onFileOpened(*_pFile);
 	}
-	_pFile->write(msg.getText(), _flush);
+}
+
+
+void FileChannel::onFileOpened(LogFile& file)
+{
 }
 
 	
@@ -186,6 +266,23 @@ void FileChannel::setProperty(const std::string& name, const std::string& value)
 		setFlush(value);
 	else if (name == PROP_ROTATEONOPEN)
 		setRotateOnOpen(value);
+	else if (name == PROP_BUFFERSIZE)
+	{
+		setBufferSize(value);
+		if (_pFile) startTimer();
+	}
+	else if (name == PROP_FLUSHINTERVAL)
+	{
+		_flushInterval = NumberParser::parse(value);
+		if (_pFile) startTimer();
+	}
+	else if (name == PROP_FLUSHPRIORITY)
+		setFlushPriority(value);
+	else if (name == PROP_SYNCINTERVAL)
+	{
+		_syncInterval = NumberParser::parse(value);
+		if (_pFile) startTimer();
+	}
 	else
 		Channel::setProperty(name, value);
 }
@@ -211,6 +308,14 @@ std::string FileChannel::getProperty(const std::string& name) const
 		return std::string(_flush ? "true" : "false");
 	else if (name == PROP_ROTATEONOPEN)
 		return std::string(_rotateOnOpen ? "true" : "false");
+	else if (name == PROP_BUFFERSIZE)
+		return _bufferSize;
+	else if (name == PROP_FLUSHINTERVAL)
+		return NumberFormatter::format(_flushInterval);
+	else if (name == PROP_FLUSHPRIORITY)
+		return _flushPriority;
+	else if (name == PROP_SYNCINTERVAL)
+		return NumberFormatter::format(_syncInterval);
 	else
 		return Channel::getProperty(name);
 }
@@ -402,6 +507,106 @@ void FileChannel::setRotateOnOpen(const std::string& rotateOnOpen)
 }
 
 
+void FileChannel::setBufferSize(const std::string& bufferSize)
+{
+	std::string::const_iterator it  = bufferSize.begin();
+	std::string::const_iterator end = bufferSize.end();
+	std::size_t n = 0;
+	while (it != end && Ascii::isSpace(*it)) ++it;
+	while (it != end && Ascii::isDigit(*it)) { n *= 10; n += *it++ - '0'; }
+	while (it != end && Ascii::isSpace(*it)) ++it;
+	std::string unit;
+	while (it != end && Ascii::isAlpha(*it)) unit += *it++;
+
+	if (unit == "K")
+		n *= 1024;
+	else if (unit == "M")
+		n *= 1024*1024;
+	else if (unit == "none")
+		n = 0;
+	else if (!unit.empty())
+		throw InvalidArgumentException("bufferSize", bufferSize);
+
+	if (_pFile) _pFile->setBufferSize(n);
+	_bufferLimit = n;
+	_bufferSize = bufferSize;
+}
+
+
+void FileChannel::setFlushPriority(const std::string& priority)
+{
+	_flushLevel = Logger::parseLevel(priority);
+	_flushPriority = priority;
+}
+
+
+void FileChannel::startTimer()
+{
+	// must be called with the mutex held
+	long interval = _bufferLimit > 0 ? _flushInterval : 0;
+	if (_syncInterval > 0 && (interval <= 0 || _syncInterval < interval))
+		interval = _syncInterval;
+	if (interval <= 0)
+	{
+		// A running timer is left alone, as it cannot be stopped
+		// while holding the mutex. onTimer() does nothing if both
+		// intervals are disabled.
+		return;
+	}
+	if (!_pTimer)
+	{
+		_lastFlush.update();
+		_lastSync.update();
+		_pTimer = new Timer(interval, interval);
+		_pTimer->start(TimerCallback<FileChannel>(*this, &FileChannel::onTimer));
+	}
+	else if (_pTimer->getPeriodicInterval() != interval)
+	{
+		// restart() does not wait for a running onTimer()
+		_pTimer->restart(interval);
+	}
+}
+
+
+void FileChannel::stopTimer()
+{
+	Timer* pTimer;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		pTimer = _pTimer;
+		_pTimer = 0;
+	}
+	// The timer must be stopped without holding the mutex,
+	// as stop() waits for a running onTimer() to complete.
+	if (pTimer)
+	{
+		pTimer->stop();
+		delete pTimer;
+	}
+}
+
+
+void FileChannel::onTimer(Timer& timer)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (!_pFile) return;
+	// Intervals are checked with a little slack, as the
+	// timer may fire slightly before an interval has elapsed.
+	if (_bufferLimit > 0 && _flushInterval > 0 && _lastFlush.isElapsed(Timestamp::TimeDiff(_flushInterval)*900))
+	{
+		_pFile->flush();
+		_lastFlush.update();
+	}
+	if (_syncInterval > 0 && _lastSync.isElapsed(Timestamp::TimeDiff(_syncInterval)*900))
+	{
+		_pFile->sync();
+		_lastSync.update();
+	}
+}
+
+
 void FileChannel::purge()
 {
 	if (_pPurgeStrategy)
@@ -80,6 +80,12 @@ FileStreamBuf* FileIOS::rdbuf()
 }
 
 
+FileStreamBuf::NativeHandle FileIOS::nativeHandle() const
+{
+	return _buf.nativeHandle();
+}
+
+
 FileInputStream::FileInputStream():
 	FileIOS(std::ios::in),
 	std::istream(&_buf)
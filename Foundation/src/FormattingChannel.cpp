@@ -38,6 +38,7 @@
 #include "Poco/Formatter.h"
 #include "Poco/Message.h"
 #include "Poco/LoggingRegistry.h"
+#include <vector>
 
 
 namespace Poco {
@@ -120,6 +121,31 @@ void FormattingChannel::log(const Message& msg)
 }
 
 
+void FormattingChannel::logBatch(const Message* pMessages, std::size_t count)
+{
+	if (_pChannel && count > 0)
+	{
+		if (_pFormatter)
+		{
+			std::vector<Message> messages;
+			messages.reserve(count);
+			std::string text;
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				text.clear();
+				_pFormatter->format(pMessages[i], text);
+				messages.push_back(Message(pMessages[i], text));
+			}
+			_pChannel->logBatch(&messages[0], count);
+		}
+		else
+		{
+			_pChannel->logBatch(pMessages, count);
+		}
+	}
+}
+
+
 void FormattingChannel::setProperty(const std::string& name, const std::string& value)
 {
 	if (name == "channel")
@@ -35,21 +35,165 @@
 
 
 #include "Poco/Hash.h"
+#include "Poco/ByteOrder.h"
+#include "Poco/RandomStream.h"
+#include "Poco/SingletonHolder.h"
+#include <cstring>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 
 
 namespace Poco {
 
 
+namespace
+{
+	// The string hash is based on the design of wyhash
+	// (Wang Yi, public domain): input is consumed in 64-bit words,
+	// each pair of words is combined with a 64x64->128 bit
+	// multiplication, and the two halves of the product are
+	// folded together.
+
+	const UInt64 SECRET0 = 0xa0761d6478bd642fULL;
+	const UInt64 SECRET1 = 0xe7037ed1a0b428dbULL;
+	const UInt64 SECRET2 = 0x8ebc6af09c88c6e3ULL;
+	const UInt64 SECRET3 = 0x589965cc75374cc3ULL;
+
+	inline void multiply(UInt64& a, UInt64& b)
+		/// Replaces a with the low and b with the high 64 bits
+		/// of the 128-bit product of a and b.
+	{
+#if defined(__SIZEOF_INT128__)
+		unsigned __int128 r = a;
+		r *= b;
+		a = static_cast<UInt64>(r);
+		b = static_cast<UInt64>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+		a = _umul128(a, b, &b);
+#else
+		UInt64 ha = a >> 32, hb = b >> 32, la = static_cast<UInt32>(a), lb = static_cast<UInt32>(b);
+		UInt64 rh = ha*hb, rm0 = ha*lb, rm1 = hb*la, rl = la*lb;
+		UInt64 t = rl + (rm0 << 32);
+		UInt64 c = t < rl;
+		UInt64 lo = t + (rm1 << 32);
+		c += lo < t;
+		UInt64 hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+		a = lo;
+		b = hi;
+#endif
+	}
+
+	inline UInt64 mix(UInt64 a, UInt64 b)
+	{
+		multiply(a, b);
+		return a ^ b;
+	}
+
+	inline UInt64 read64(const unsigned char* p)
+	{
+		UInt64 v;
+		std::memcpy(&v, p, sizeof(v));
+		return ByteOrder::fromLittleEndian(v);
+	}
+
+	inline UInt64 read32(const unsigned char* p)
+	{
+		UInt32 v;
+		std::memcpy(&v, p, sizeof(v));
+		return ByteOrder::fromLittleEndian(v);
+	}
+
+	inline UInt64 read3(const unsigned char* p, std::size_t k)
+	{
+		return (static_cast<UInt64>(p[0]) << 16) | (static_cast<UInt64>(p[k >> 1]) << 8) | p[k - 1];
+	}
+
+	struct HashSeed
+	{
+		HashSeed(): value(0)
+		{
+			RandomInputStream rnd;
+			rnd.read(reinterpret_cast<char*>(&value), sizeof(value));
+		}
+
+		UInt64 value;
+	};
+
+	static SingletonHolder<HashSeed> seedHolder;
+}
+
+
 std::size_t hash(const std::string& str)
 {
-	std::size_t h = 0;
-	std::string::const_iterator it  = str.begin();
-	std::string::const_iterator end = str.end();
-	while (it != end)
+	return hash(str.data(), str.size());
+}
+
+
+std::size_t hash(const char* str, std::size_t length)
+{
+	return static_cast<std::size_t>(hash64(str, length, 0));
+}
+
+
+UInt64 hash64(const char* data, std::size_t length, UInt64 seed)
+{
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+	seed ^= mix(seed ^ SECRET0, SECRET1);
+	UInt64 a;
+	UInt64 b;
+	if (length <= 16)
+	{
+		if (length >= 4)
+		{
+			std::size_t off = (length >> 3) << 2;
+			a = (read32(p) << 32) | read32(p + off);
+			b = (read32(p + length - 4) << 32) | read32(p + length - 4 - off);
+		}
+		else if (length > 0)
+		{
+			a = read3(p, length);
+			b = 0;
+		}
+		else a = b = 0;
+	}
+	else
 	{
-		h = h * 0xf4243 ^ *it++;
+		std::size_t i = length;
+		if (i > 48)
+		{
+			UInt64 seed1 = seed;
+			UInt64 seed2 = seed;
+			do
+			{
+				seed  = mix(read64(p)      ^ SECRET1, read64(p + 8)  ^ seed);
+				seed1 = mix(read64(p + 16) ^ SECRET2, read64(p + 24) ^ seed1);
+				seed2 = mix(read64(p + 32) ^ SECRET3, read64(p + 40) ^ seed2);
+				p += 48;
+				i -= 48;
+			}
+			while (i > 48);
+			seed ^= seed1 ^ seed2;
+		}
+		while (i > 16)
+		{
+			seed = mix(read64(p) ^ SECRET1, read64(p + 8) ^ seed);
+			p += 16;
+			i -= 16;
+		}
+		a = read64(p + i - 16);
+		b = read64(p + i - 8);
 	}
-	return h;
+	a ^= SECRET1;
+	b ^= seed;
+	multiply(a, b);
+	return mix(a ^ SECRET0 ^ length, b ^ SECRET1);
+}
+
+
+UInt64 hashSeed()
+{
+	return seedHolder.get()->value;
 }
 
 
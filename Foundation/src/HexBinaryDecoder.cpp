@@ -36,11 +36,89 @@
 
 #include "Poco/HexBinaryDecoder.h"
 #include "Poco/Exception.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define POCO_HAVE_HEXBINARY_SSE2
+#endif
 
 
 namespace Poco {
 
 
+namespace
+{
+	enum
+	{
+		SPACE   = 0x10,
+		INVALID = 0xFF
+	};
+
+	// Maps hexadecimal digits to their values, whitespace
+	// to SPACE and all other characters to INVALID.
+	static const unsigned char DIGITS[256] =
+	{
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x10, 0x10, 0xFF, 0xFF, 0x10, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x10, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+	};
+
+#if defined(POCO_HAVE_HEXBINARY_SSE2)
+
+	inline __m128i inRange(__m128i v, char first, char last)
+		/// Returns 0xFF in every byte of v that is in the
+		/// range first .. last, and 0 in all other bytes.
+	{
+		__m128i biased = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - first)));
+		return _mm_cmplt_epi8(biased, _mm_set1_epi8(static_cast<char>(-128 + last - first + 1)));
+	}
+
+	inline bool digitValues(__m128i& v)
+		/// Replaces the hexadecimal digits in v by their values.
+		/// Returns false if v contains other characters.
+	{
+		__m128i digit = inRange(v, '0', '9');
+		__m128i lower = inRange(v, 'a', 'f');
+		__m128i upper = inRange(v, 'A', 'F');
+		if (_mm_movemask_epi8(_mm_or_si128(digit, _mm_or_si128(lower, upper))) != 0xFFFF) return false;
+		__m128i offset = _mm_and_si128(digit, _mm_set1_epi8(-'0'));
+		offset = _mm_or_si128(offset, _mm_and_si128(lower, _mm_set1_epi8(10 - 'a')));
+		offset = _mm_or_si128(offset, _mm_and_si128(upper, _mm_set1_epi8(10 - 'A')));
+		v = _mm_add_epi8(v, offset);
+		return true;
+	}
+
+	inline bool decodeDigits(const unsigned char* in, char* out)
+		/// Decodes 32 hexadecimal digits into 16 bytes. Returns false,
+		/// without writing anything, if the characters contain
+		/// whitespace or invalid characters.
+	{
+		__m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+		__m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16));
+		if (!digitValues(v1) || !digitValues(v2)) return false;
+		__m128i mask = _mm_set1_epi16(0x00FF);
+		v1 = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(v1, mask), 4), _mm_srli_epi16(v1, 8));
+		v2 = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(v2, mask), 4), _mm_srli_epi16(v2, 8));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(v1, v2));
+		return true;
+	}
+
+#endif
+}
+
+
 HexBinaryDecoderBuf::HexBinaryDecoderBuf(std::istream& istr): 
 	_buf(*istr.rdbuf())
 {
@@ -57,23 +135,40 @@ int HexBinaryDecoderBuf::readFromDevice()
 	int c;
 	int n;
 	if ((n = readOne()) == -1) return -1;
-	if (n >= '0' && n <= '9')
-		c = n - '0';
-	else if (n >= 'A' && n <= 'F')
-		c = n - 'A' + 10;
-	else if (n >= 'a' && n <= 'f')
-		c = n - 'a' + 10;
-	else throw DataFormatException();
-	c <<= 4;
+	if ((c = DIGITS[static_cast<unsigned char>(n)]) >= SPACE) throw DataFormatException();
 	if ((n = readOne()) == -1) throw DataFormatException();
-	if (n >= '0' && n <= '9')
-		c |= n - '0';
-	else if (n >= 'A' && n <= 'F')
-		c |= n - 'A' + 10;
-	else if (n >= 'a' && n <= 'f')
-		c |= n - 'a' + 10;
-	else throw DataFormatException();
-	return c;
+	if (DIGITS[static_cast<unsigned char>(n)] >= SPACE) throw DataFormatException();
+	return (c << 4) | DIGITS[static_cast<unsigned char>(n)];
+}
+
+
+std::streamsize HexBinaryDecoderBuf::readBlockFromDevice(char* buffer, std::streamsize length)
+{
+	std::streamsize n = 0;
+	char input[4096 + 1];
+	while (n < length)
+	{
+		// Read no more characters than needed for the requested
+		// number of bytes, so that the underlying stream is
+		// positioned exactly as when reading one byte at a time.
+		std::streamsize size = 2*(length - n);
+		if (size > 4096) size = 4096;
+		std::streamsize count = _buf.sgetn(input, size);
+		if (count == 0) break;
+		int digits = 0;
+		for (std::streamsize i = 0; i < count; ++i)
+		{
+			if (DIGITS[static_cast<unsigned char>(input[i])] != SPACE) ++digits;
+		}
+		if (digits % 2 != 0)
+		{
+			int c = readOne();
+			if (c == -1) throw DataFormatException();
+			input[count++] = (char) c;
+		}
+		n += static_cast<std::streamsize>(HexBinaryDecoder::decode(input, static_cast<std::size_t>(count), buffer + n));
+	}
+	return n;
 }
 
 
@@ -113,4 +208,53 @@ HexBinaryDecoder::~HexBinaryDecoder()
 }
 
 
+std::size_t HexBinaryDecoder::decode(const char* buffer, std::size_t length, char* output)
+{
+	const unsigned char* it  = reinterpret_cast<const unsigned char*>(buffer);
+	const unsigned char* end = it + length;
+	char* out = output;
+	for (;;)
+	{
+		// fast path: digit pairs without whitespace
+#if defined(POCO_HAVE_HEXBINARY_SSE2)
+		while (end - it >= 32 && decodeDigits(it, out))
+		{
+			it  += 32;
+			out += 16;
+		}
+#endif
+		while (end - it >= 2)
+		{
+			unsigned hi = DIGITS[it[0]];
+			unsigned lo = DIGITS[it[1]];
+			if ((hi | lo) >= SPACE) break;
+			*out++ = static_cast<char>((hi << 4) | lo);
+			it += 2;
+		}
+		unsigned value = 0;
+		int n = 0;
+		while (n < 2 && it != end)
+		{
+			unsigned digit = DIGITS[*it++];
+			if (digit == SPACE) continue;
+			if (digit == INVALID) throw DataFormatException();
+			value = (value << 4) | digit;
+			++n;
+		}
+		if (n == 0) break;
+		if (n < 2) throw DataFormatException();
+		*out++ = static_cast<char>(value);
+	}
+	return out - output;
+}
+
+
+std::string HexBinaryDecoder::decode(const std::string& data)
+{
+	std::string result(data.size()/2 + 1, '\0');
+	result.resize(decode(data.data(), data.size(), &result[0]));
+	return result;
+}
+
+
 } // namespace Poco
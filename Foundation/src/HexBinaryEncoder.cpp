@@ -35,11 +35,58 @@
 
 
 #include "Poco/HexBinaryEncoder.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define POCO_HAVE_HEXBINARY_SSE2
+#endif
 
 
 namespace Poco {
 
 
+namespace
+{
+	static const char DIGITS[] = "0123456789abcdef0123456789ABCDEF";
+
+#if defined(POCO_HAVE_HEXBINARY_SSE2)
+
+	inline __m128i encodeNibbles(__m128i n, __m128i letterOffset)
+		/// Maps the 4-bit values in every byte of n
+		/// to the corresponding hexadecimal digits.
+	{
+		__m128i letters = _mm_and_si128(_mm_cmpgt_epi8(n, _mm_set1_epi8(9)), letterOffset);
+		return _mm_add_epi8(_mm_add_epi8(n, _mm_set1_epi8('0')), letters);
+	}
+
+#endif
+
+	inline void encodeBytes(const unsigned char* buffer, std::size_t length, char* output, int uppercase)
+	{
+#if defined(POCO_HAVE_HEXBINARY_SSE2)
+		__m128i letterOffset = _mm_set1_epi8(static_cast<char>((uppercase ? 'A' : 'a') - '0' - 10));
+		for (; length >= 16; length -= 16)
+		{
+			__m128i v  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer));
+			__m128i hi = encodeNibbles(_mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F)), letterOffset);
+			__m128i lo = encodeNibbles(_mm_and_si128(v, _mm_set1_epi8(0x0F)), letterOffset);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_unpacklo_epi8(hi, lo));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output + 16), _mm_unpackhi_epi8(hi, lo));
+			buffer += 16;
+			output += 32;
+		}
+#endif
+		const char* digits = DIGITS + uppercase;
+		for (; length > 0; --length)
+		{
+			output[0] = digits[*buffer >> 4];
+			output[1] = digits[*buffer & 0xF];
+			++buffer;
+			output += 2;
+		}
+	}
+}
+
+
 HexBinaryEncoderBuf::HexBinaryEncoderBuf(std::ostream& ostr): 
 	_pos(0),
 	_lineLength(72),
@@ -82,11 +129,10 @@ void HexBinaryEncoderBuf::setUppercase(bool flag)
 int HexBinaryEncoderBuf::writeToDevice(char c)
 {
 	static const int eof = std::char_traits<char>::eof();
-	static const char digits[] = "0123456789abcdef0123456789ABCDEF";
 	
-	if (_buf.sputc(digits[_uppercase + ((c >> 4) & 0xF)]) == eof) return eof;
+	if (_buf.sputc(DIGITS[_uppercase + ((c >> 4) & 0xF)]) == eof) return eof;
 	++_pos;
-	if (_buf.sputc(digits[_uppercase + (c & 0xF)]) == eof) return eof;
+	if (_buf.sputc(DIGITS[_uppercase + (c & 0xF)]) == eof) return eof;
 	if (++_pos >= _lineLength && _lineLength > 0) 
 	{
 		if (_buf.sputc('\n') == eof) return eof;
@@ -96,6 +142,42 @@ int HexBinaryEncoderBuf::writeToDevice(char c)
 }
 
 
+std::streamsize HexBinaryEncoderBuf::writeBlockToDevice(const char* buffer, std::streamsize length)
+{
+	const unsigned char* it  = reinterpret_cast<const unsigned char*>(buffer);
+	const unsigned char* end = it + length;
+	char output[4096];
+	while (it != end)
+	{
+		const unsigned char* chunk = it;
+		std::size_t n = 0;
+		while (it != end && n + 3 <= sizeof(output))
+		{
+			std::size_t count = end - it;
+			std::size_t room = (sizeof(output) - n - 1)/2;
+			if (count > room) count = room;
+			if (_lineLength > 0)
+			{
+				int lineCount = (_lineLength - _pos + 1)/2;
+				if (lineCount < 1) lineCount = 1;
+				if (count > static_cast<std::size_t>(lineCount)) count = lineCount;
+			}
+			encodeBytes(it, count, output + n, _uppercase);
+			it   += count;
+			n    += 2*count;
+			_pos += 2*static_cast<int>(count);
+			if (_lineLength > 0 && _pos >= _lineLength)
+			{
+				output[n++] = '\n';
+				_pos = 0;
+			}
+		}
+		if (_buf.sputn(output, static_cast<std::streamsize>(n)) != static_cast<std::streamsize>(n)) return chunk - reinterpret_cast<const unsigned char*>(buffer);
+	}
+	return length;
+}
+
+
 int HexBinaryEncoderBuf::close()
 {
 	sync();
@@ -136,4 +218,22 @@ HexBinaryEncoder::~HexBinaryEncoder()
 }
 
 
+std::size_t HexBinaryEncoder::encode(const char* buffer, std::size_t length, char* output, bool uppercase)
+{
+	encodeBytes(reinterpret_cast<const unsigned char*>(buffer), length, output, uppercase ? 16 : 0);
+	return 2*length;
+}
+
+
+std::string HexBinaryEncoder::encode(const std::string& data, bool uppercase)
+{
+	std::string result(2*data.size(), '\0');
+	if (!data.empty())
+	{
+		encode(data.data(), data.size(), &result[0], uppercase);
+	}
+	return result;
+}
+
+
 } // namespace Poco
@@ -0,0 +1,362 @@
+//
+// LockFreeNotificationQueue.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  LockFreeNotificationQueue
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/LockFreeNotificationQueue.h"
+#include "Poco/NotificationCenter.h"
+#include "Poco/AtomicOps.h"
+#include "Poco/Thread.h"
+#include "Poco/Timestamp.h"
+#include <limits>
+
+
+namespace Poco {
+
+
+LockFreeNotificationQueue::LockFreeNotificationQueue(std::size_t capacity):
+	_mask(0),
+	_enqueuePos(0),
+	_dequeuePos(0),
+	_waiting(0),
+	_generation(0),
+	_sema(0, std::numeric_limits<int>::max()),
+	_blocked(0)
+{
+	poco_assert (capacity > 0 && capacity <= 0x40000000);
+
+	std::size_t size = 2;
+	while (size < capacity) size <<= 1;
+	_cells.resize(size);
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		_cells[i].sequence = static_cast<UInt32>(i);
+		_cells[i].pNf = 0;
+	}
+	_mask = static_cast<UInt32>(size - 1);
+	AtomicOps::barrier();
+}
+
+
+LockFreeNotificationQueue::~LockFreeNotificationQueue()
+{
+	clear();
+}
+
+
+void LockFreeNotificationQueue::enqueueNotification(Notification::Ptr pNotification)
+{
+	poco_check_ptr (pNotification);
+
+	Notification* pNf = pNotification.duplicate();
+	int spins = 0;
+	for (;;)
+	{
+		UInt32 pos = AtomicOps::load(&_enqueuePos);
+		if (enqueueOne(pNf)) break;
+		if (++spins < SPIN_COUNT)
+			Thread::yield();
+		else
+			waitForSpace(pos);
+	}
+	wakeUpOne();
+}
+
+
+bool LockFreeNotificationQueue::tryEnqueueNotification(Notification::Ptr pNotification)
+{
+	poco_check_ptr (pNotification);
+
+	Notification* pNf = pNotification.duplicate();
+	if (enqueueOne(pNf))
+	{
+		wakeUpOne();
+		return true;
+	}
+	else
+	{
+		pNf->release();
+		return false;
+	}
+}
+
+
+Notification* LockFreeNotificationQueue::dequeueNotification()
+{
+	return dequeueOne();
+}
+
+
+Notification* LockFreeNotificationQueue::waitDequeueNotification()
+{
+	UInt32 generation = AtomicOps::load(&_generation);
+	for (;;)
+	{
+		Notification* pNf = dequeueOne();
+		if (pNf) return pNf;
+		for (;;)
+		{
+			UInt32 waiting = AtomicOps::load(&_waiting);
+			if (AtomicOps::compareAndSwap(&_waiting, waiting, waiting + 1)) break;
+		}
+		pNf = dequeueOne();
+		if (pNf)
+		{
+			cancelWait();
+			return pNf;
+		}
+		if (AtomicOps::load(&_generation) != generation)
+		{
+			cancelWait();
+			return 0;
+		}
+		_sema.wait();
+		if (AtomicOps::load(&_generation) != generation) return 0;
+	}
+}
+
+
+Notification* LockFreeNotificationQueue::waitDequeueNotification(long milliseconds)
+{
+	UInt32 generation = AtomicOps::load(&_generation);
+	Timestamp start;
+	for (;;)
+	{
+		Notification* pNf = dequeueOne();
+		if (pNf) return pNf;
+		long remaining = milliseconds - static_cast<long>(start.elapsed()/1000);
+		if (remaining <= 0) return 0;
+		for (;;)
+		{
+			UInt32 waiting = AtomicOps::load(&_waiting);
+			if (AtomicOps::compareAndSwap(&_waiting, waiting, waiting + 1)) break;
+		}
+		pNf = dequeueOne();
+		if (pNf)
+		{
+			cancelWait();
+			return pNf;
+		}
+		if (AtomicOps::load(&_generation) != generation)
+		{
+			cancelWait();
+			return 0;
+		}
+		if (!_sema.tryWait(remaining))
+		{
+			cancelWait();
+			return dequeueOne();
+		}
+		if (AtomicOps::load(&_generation) != generation) return 0;
+	}
+}
+
+
+void LockFreeNotificationQueue::dispatch(NotificationCenter& notificationCenter)
+{
+	Notification* pNf = dequeueOne();
+	while (pNf)
+	{
+		Notification::Ptr ptr(pNf);
+		notificationCenter.postNotification(ptr);
+		pNf = dequeueOne();
+	}
+}
+
+
+void LockFreeNotificationQueue::wakeUpAll()
+{
+	for (;;)
+	{
+		UInt32 generation = AtomicOps::load(&_generation);
+		if (AtomicOps::compareAndSwap(&_generation, generation, generation + 1)) break;
+	}
+	for (;;)
+	{
+		UInt32 waiting = AtomicOps::load(&_waiting);
+		if (AtomicOps::compareAndSwap(&_waiting, waiting, 0))
+		{
+			while (waiting-- > 0) _sema.set();
+			break;
+		}
+	}
+}
+
+
+bool LockFreeNotificationQueue::empty() const
+{
+	return size() == 0;
+}
+
+
+int LockFreeNotificationQueue::size() const
+{
+	UInt32 dequeuePos = AtomicOps::load(&_dequeuePos);
+	UInt32 enqueuePos = AtomicOps::load(&_enqueuePos);
+	int n = static_cast<int>(enqueuePos - dequeuePos);
+	return n > 0 ? n : 0;
+}
+
+
+std::size_t LockFreeNotificationQueue::capacity() const
+{
+	return _cells.size();
+}
+
+
+void LockFreeNotificationQueue::clear()
+{
+	Notification* pNf = dequeueOne();
+	while (pNf)
+	{
+		pNf->release();
+		pNf = dequeueOne();
+	}
+}
+
+
+bool LockFreeNotificationQueue::hasIdleThreads() const
+{
+	return AtomicOps::load(&_waiting) > 0;
+}
+
+
+bool LockFreeNotificationQueue::enqueueOne(Notification* pNotification)
+{
+	UInt32 pos = AtomicOps::load(&_enqueuePos);
+	Cell* pCell;
+	for (;;)
+	{
+		pCell = &_cells[pos & _mask];
+		UInt32 seq = AtomicOps::load(&pCell->sequence);
+		Int32 diff = static_cast<Int32>(seq - pos);
+		if (diff == 0)
+		{
+			if (AtomicOps::compareAndSwap(&_enqueuePos, pos, pos + 1)) break;
+		}
+		else if (diff < 0)
+		{
+			return false; // queue is full
+		}
+		pos = AtomicOps::load(&_enqueuePos);
+	}
+	pCell->pNf = pNotification;
+	AtomicOps::store(&pCell->sequence, pos + 1);
+	return true;
+}
+
+
+Notification* LockFreeNotificationQueue::dequeueOne()
+{
+	UInt32 pos = AtomicOps::load(&_dequeuePos);
+	Cell* pCell;
+	for (;;)
+	{
+		pCell = &_cells[pos & _mask];
+		UInt32 seq = AtomicOps::load(&pCell->sequence);
+		Int32 diff = static_cast<Int32>(seq - (pos + 1));
+		if (diff == 0)
+		{
+			if (AtomicOps::compareAndSwap(&_dequeuePos, pos, pos + 1)) break;
+		}
+		else if (diff < 0)
+		{
+			return 0; // queue is empty
+		}
+		pos = AtomicOps::load(&_dequeuePos);
+	}
+	Notification* pNf = pCell->pNf;
+	pCell->pNf = 0;
+	AtomicOps::store(&pCell->sequence, pos + _mask + 1);
+
+	// A blocked producer sets _blocked before it checks
+	// for room again, so at least one of us sees the other.
+	AtomicOps::barrier();
+	if (AtomicOps::load(&_blocked))
+	{
+		FastMutex::ScopedLock lock(_spaceMutex);
+		_spaceAvailable.broadcast();
+	}
+	return pNf;
+}
+
+
+void LockFreeNotificationQueue::wakeUpOne()
+{
+	// The barrier ensures that a consumer that has registered itself
+	// as waiting either sees the new notification, or is seen by us.
+	AtomicOps::barrier();
+	for (;;)
+	{
+		UInt32 waiting = AtomicOps::load(&_waiting);
+		if (waiting == 0) break;
+		if (AtomicOps::compareAndSwap(&_waiting, waiting, waiting - 1))
+		{
+			_sema.set();
+			break;
+		}
+	}
+}
+
+
+void LockFreeNotificationQueue::cancelWait()
+{
+	// If a producer has already claimed this waiter, the semaphore
+	// has been (or will be) signalled. The resulting extra wake-up
+	// of some waiting thread is harmless, as it will find the queue
+	// empty and wait again.
+	for (;;)
+	{
+		UInt32 waiting = AtomicOps::load(&_waiting);
+		if (waiting == 0) break;
+		if (AtomicOps::compareAndSwap(&_waiting, waiting, waiting - 1)) break;
+	}
+}
+
+
+void LockFreeNotificationQueue::waitForSpace(UInt32 pos)
+{
+	FastMutex::ScopedLock lock(_spaceMutex);
+
+	AtomicOps::store(&_blocked, _blocked + 1);
+	AtomicOps::barrier();
+	while (static_cast<Int32>(AtomicOps::load(&_cells[pos & _mask].sequence) - pos) < 0 && AtomicOps::load(&_enqueuePos) == pos)
+	{
+		_spaceAvailable.wait(_spaceMutex);
+	}
+	AtomicOps::store(&_blocked, _blocked - 1);
+}
+
+
+} // namespace Poco
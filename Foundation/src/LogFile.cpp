@@ -51,13 +51,112 @@
 namespace Poco {
 
 
-LogFile::LogFile(const std::string& path): LogFileImpl(path)
+namespace
+{
+	// LogFileImpl::writeImpl() appends the line ending
+	// after the last text in the buffer.
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	const char EOL[] = "\r\n";
+#else
+	const char EOL[] = "\n";
+#endif
+	const std::size_t EOL_SIZE = sizeof(EOL) - 1;
+}
+
+
+LogFile::LogFile(const std::string& path): 
+	LogFileImpl(path),
+	_bufferSize(0),
+	_unsynced(false)
 {
 }
 
 
 LogFile::~LogFile()
 {
+	try
+	{
+		flush();
+	}
+	catch (...)
+	{
+	}
+}
+
+
+void LogFile::write(const std::string& text, bool flush)
+{
+	_unsynced = true;
+	if (_bufferSize == 0)
+	{
+		writeImpl(text, flush);
+	}
+	else
+	{
+		if (!_buffer.empty()) _buffer.append(EOL, EOL_SIZE);
+		_buffer.append(text);
+		if (_buffer.size() >= _bufferSize)
+		{
+			writeBuffer(flush);
+			flushImpl();
+		}
+	}
+}
+
+
+void LogFile::flush()
+{
+	writeBuffer(false);
+	flushImpl();
+}
+
+
+void LogFile::sync()
+{
+	if (_unsynced)
+	{
+		writeBuffer(false);
+		syncImpl();
+		_unsynced = false;
+	}
+}
+
+
+void LogFile::setBufferSize(std::size_t size)
+{
+	flush();
+	_bufferSize = size;
+	std::string tmp;
+	_buffer.swap(tmp);
+	_buffer.reserve(size + size/4);
+}
+
+
+UInt64 LogFile::size() const
+{
+	UInt64 size = sizeImpl();
+	if (!_buffer.empty()) size += _buffer.size() + EOL_SIZE;
+	return size;
+}
+
+
+void LogFile::writeBuffer(bool flush)
+{
+	if (!_buffer.empty())
+	{
+		// the buffer is cleared even if writing fails,
+		// as retrying would probably fail again
+		try
+		{
+			writeImpl(_buffer, flush);
+		}
+		catch (...)
+		{
+			_buffer.clear();
+			throw;
+		}
+		_buffer.clear();
+	}
 }
 
 
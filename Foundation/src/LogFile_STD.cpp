@@ -37,6 +37,7 @@
 #include "Poco/LogFile_STD.h"
 #include "Poco/File.h"
 #include "Poco/Exception.h"
+#include <unistd.h>
 
 
 namespace Poco {
@@ -69,6 +70,25 @@ void LogFileImpl::writeImpl(const std::string& text, bool flush)
 }
 
 
+void LogFileImpl::flushImpl()
+{
+	_str.flush();
+	if (!_str.good()) throw WriteFileException(_path);
+}
+
+
+void LogFileImpl::syncImpl()
+{
+	flushImpl();
+#if POCO_OS == POCO_OS_LINUX
+	int rc = fdatasync(_str.nativeHandle());
+#else
+	int rc = fsync(_str.nativeHandle());
+#endif
+	if (rc != 0) throw WriteFileException(_path);
+}
+
+
 UInt64 LogFileImpl::sizeImpl() const
 {
 	return (UInt64) _str.tellp();
@@ -37,6 +37,7 @@
 #include "Poco/LogFile_VMS.h"
 #include "Poco/File.h"
 #include "Poco/Exception.h"
+#include <unistd.h>
 
 
 namespace Poco {
@@ -73,6 +74,21 @@ void LogFileImpl::writeImpl(const std::string& text, bool flush)
 }
 
 
+void LogFileImpl::flushImpl()
+{
+	int rc = fflush(_file);
+	if (rc == EOF) throw WriteFileException(_path);
+}
+
+
+void LogFileImpl::syncImpl()
+{
+	flushImpl();
+	int rc = fsync(fileno(_file));
+	if (rc != 0) throw WriteFileException(_path);
+}
+
+
 UInt64 LogFileImpl::sizeImpl() const
 {
 	return (UInt64) ftell(_file);
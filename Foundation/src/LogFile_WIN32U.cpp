@@ -79,6 +79,22 @@ void LogFileImpl::writeImpl(const std::string& text, bool flush)
 }
 
 
+void LogFileImpl::flushImpl()
+{
+	// WriteFile() does not buffer data in user space
+}
+
+
+void LogFileImpl::syncImpl()
+{
+	if (INVALID_HANDLE_VALUE != _hFile)
+	{
+		BOOL res = FlushFileBuffers(_hFile);
+		if (!res) throw WriteFileException(_path);
+	}
+}
+
+
 UInt64 LogFileImpl::sizeImpl() const
 {
 	if (INVALID_HANDLE_VALUE == _hFile)
@@ -40,13 +40,156 @@
 #include "Poco/Exception.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/String.h"
+#include "Poco/ThreadLocal.h"
+#include "Poco/Thread.h"
+#include "Poco/Timestamp.h"
+#include "Poco/AtomicOps.h"
+#include "Poco/Hash.h"
 
 
 namespace Poco {
 
 
+namespace
+{
+	struct MessageBuffer
+	{
+		MessageBuffer(): busy(false)
+		{
+		}
+
+		bool        busy;
+		std::string text;
+		Message     message;
+	};
+
+	ThreadLocal<MessageBuffer> messageBuffer;
+
+	class MessageHolder
+		/// Provides the Message object and text buffer of the
+		/// current thread, so that they can be reused for all
+		/// log messages of the thread, without allocating memory
+		/// for every message. The process and thread IDs are
+		/// only determined once, when the thread's Message object
+		/// is created.
+		///
+		/// Since ThreadLocal does not work reliably for threads not
+		/// created by Poco::Thread, and since a channel may log itself
+		/// while a message is being logged, a temporary Message is used
+		/// for these cases.
+	{
+	public:
+		MessageHolder(): _pBuffer(0)
+		{
+			if (Thread::current())
+			{
+				MessageBuffer& buffer = messageBuffer.get();
+				if (!buffer.busy)
+				{
+					buffer.busy = true;
+					_pBuffer = &buffer;
+				}
+			}
+		}
+
+		~MessageHolder()
+		{
+			if (_pBuffer) _pBuffer->busy = false;
+		}
+
+		std::string& text()
+			/// Returns an empty string for building the message text.
+		{
+			if (_pBuffer)
+			{
+				_pBuffer->text.clear();
+				return _pBuffer->text;
+			}
+			else return _text;
+		}
+
+		void log(Channel* pChannel, const std::string& source, const std::string& text, Message::Priority prio, const char* file, int line)
+		{
+			if (_pBuffer)
+			{
+				Message& msg = _pBuffer->message;
+				msg.setSource(source);
+				msg.setText(text);
+				msg.setPriority(prio);
+				msg.setTime(Timestamp());
+				msg.setThread(Thread::current()->name());
+				msg.setSourceFile(file);
+				msg.setSourceLine(line);
+				pChannel->log(msg);
+			}
+			else pChannel->log(Message(source, text, prio, file, line));
+		}
+
+	private:
+		MessageBuffer* _pBuffer;
+		std::string    _text;
+	};
+}
+
+
+namespace
+{
+	struct IndexEntry
+	{
+		IndexEntry(const std::string& n, UInt32 h, Logger* p):
+			name(n),
+			hash(h),
+			pLogger(p)
+		{
+		}
+
+		std::string    name;
+		UInt32         hash;
+		void* volatile pLogger;
+	};
+
+	struct IndexTable
+	{
+		IndexTable(UInt32 size):
+			mask(size - 1),
+			count(0),
+			slots(new void*[size]),
+			pRetired(0)
+		{
+			for (UInt32 i = 0; i < size; ++i) slots[i] = 0;
+		}
+
+		~IndexTable()
+		{
+			delete [] slots;
+		}
+
+		UInt32          mask;
+		UInt32          count;
+		void* volatile* slots;
+		IndexTable*     pRetired;
+	};
+
+	void* volatile pIndexTable = 0;
+
+	inline UInt32 hashName(const std::string& name)
+	{
+		return static_cast<UInt32>(hash64(name.data(), name.size()));
+	}
+
+	void insertEntry(IndexTable* pTable, IndexEntry* pEntry)
+	{
+		UInt32 i = pEntry->hash & pTable->mask;
+		while (pTable->slots[i]) i = (i + 1) & pTable->mask;
+		++pTable->count;
+		AtomicOps::store(&pTable->slots[i], pEntry);
+	}
+}
+
+
 Logger::LoggerMap* Logger::_pLoggerMap = 0;
 Mutex Logger::_mapMtx;
+volatile UInt32 Logger::_generation = 1;
 const std::string Logger::ROOT;
 
 
@@ -124,9 +267,90 @@ void Logger::dump(const std::string& msg, const void* buffer, std::size_t length
 {
 	if (_level >= prio && _pChannel)
 	{
-		std::string text(msg);
+		MessageHolder holder;
+		std::string& text = holder.text();
+		text.append(msg);
 		formatDump(text, buffer, length);
-		_pChannel->log(Message(_name, text, prio));
+		holder.log(_pChannel, _name, text, prio, 0, 0);
+	}
+}
+
+
+void Logger::logText(const std::string& text, Message::Priority prio, const char* file, int line)
+{
+	MessageHolder holder;
+	holder.log(_pChannel, _name, text, prio, file, line);
+}
+
+
+void Logger::logFormat(Message::Priority prio, const std::string& fmt, const Any& value1)
+{
+	if (_pChannel)
+	{
+		MessageHolder holder;
+		std::string& text = holder.text();
+		Poco::format(text, fmt, value1);
+		holder.log(_pChannel, _name, text, prio, 0, 0);
+	}
+}
+
+
+void Logger::logFormat(Message::Priority prio, const std::string& fmt, const Any& value1, const Any& value2)
+{
+	if (_pChannel)
+	{
+		MessageHolder holder;
+		std::string& text = holder.text();
+		Poco::format(text, fmt, value1, value2);
+		holder.log(_pChannel, _name, text, prio, 0, 0);
+	}
+}
+
+
+void Logger::logFormat(Message::Priority prio, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
+{
+	if (_pChannel)
+	{
+		MessageHolder holder;
+		std::string& text = holder.text();
+		Poco::format(text, fmt, value1, value2, value3);
+		holder.log(_pChannel, _name, text, prio, 0, 0);
+	}
+}
+
+
+void Logger::logFormat(Message::Priority prio, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
+{
+	if (_pChannel)
+	{
+		MessageHolder holder;
+		std::string& text = holder.text();
+		Poco::format(text, fmt, value1, value2, value3, value4);
+		holder.log(_pChannel, _name, text, prio, 0, 0);
+	}
+}
+
+
+void Logger::logFormat(Message::Priority prio, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
+{
+	if (_pChannel)
+	{
+		MessageHolder holder;
+		std::string& text = holder.text();
+		Poco::format(text, fmt, value1, value2, value3, value4, value5);
+		holder.log(_pChannel, _name, text, prio, 0, 0);
+	}
+}
+
+
+void Logger::logFormat(Message::Priority prio, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
+{
+	if (_pChannel)
+	{
+		MessageHolder holder;
+		std::string& text = holder.text();
+		Poco::format(text, fmt, value1, value2, value3, value4, value5, value6);
+		holder.log(_pChannel, _name, text, prio, 0, 0);
 	}
 }
 
@@ -303,6 +527,9 @@ void Logger::formatDump(std::string& message, const void* buffer, std::size_t le
 
 Logger& Logger::get(const std::string& name)
 {
+	Logger* pLogger = lookup(name);
+	if (pLogger) return *pLogger;
+
 	Mutex::ScopedLock lock(_mapMtx);
 
 	return unsafeGet(name);
@@ -342,6 +569,9 @@ Logger& Logger::create(const std::string& name, Channel* pChannel, int level)
 
 Logger& Logger::root()
 {
+	Logger* pLogger = lookup(ROOT);
+	if (pLogger) return *pLogger;
+
 	Mutex::ScopedLock lock(_mapMtx);
 
 	return unsafeGet(ROOT);
@@ -350,9 +580,7 @@ Logger& Logger::root()
 
 Logger* Logger::has(const std::string& name)
 {
-	Mutex::ScopedLock lock(_mapMtx);
-
-	return find(name);
+	return lookup(name);
 }
 
 
@@ -369,6 +597,7 @@ void Logger::shutdown()
 		delete _pLoggerMap;
 		_pLoggerMap = 0;
 	}
+	clearIndex();
 }
 
 
@@ -393,6 +622,7 @@ void Logger::destroy(const std::string& name)
 		LoggerMap::iterator it = _pLoggerMap->find(name);
 		if (it != _pLoggerMap->end())
 		{
+			index(name, 0);
 			it->second->release();
 			_pLoggerMap->erase(it);
 		}
@@ -480,6 +710,107 @@ void Logger::add(Logger* pLogger)
 	if (!_pLoggerMap)
 		_pLoggerMap = new LoggerMap;
 	_pLoggerMap->insert(LoggerMap::value_type(pLogger->name(), pLogger));
+	index(pLogger->name(), pLogger);
+}
+
+
+Logger* Logger::lookup(const std::string& name)
+{
+	IndexTable* pTable = static_cast<IndexTable*>(AtomicOps::load(&pIndexTable));
+	if (pTable)
+	{
+		UInt32 hash = hashName(name);
+		for (UInt32 i = hash & pTable->mask;; i = (i + 1) & pTable->mask)
+		{
+			IndexEntry* pEntry = static_cast<IndexEntry*>(AtomicOps::load(&pTable->slots[i]));
+			if (!pEntry) break;
+			if (pEntry->hash == hash && pEntry->name == name)
+				return static_cast<Logger*>(AtomicOps::load(&pEntry->pLogger));
+		}
+	}
+	return 0;
+}
+
+
+void Logger::index(const std::string& name, Logger* pLogger)
+{
+	IndexTable* pTable = static_cast<IndexTable*>(pIndexTable);
+	UInt32 hash = hashName(name);
+	if (pTable)
+	{
+		for (UInt32 i = hash & pTable->mask; pTable->slots[i]; i = (i + 1) & pTable->mask)
+		{
+			IndexEntry* pEntry = static_cast<IndexEntry*>(pTable->slots[i]);
+			if (pEntry->hash == hash && pEntry->name == name)
+			{
+				AtomicOps::store(&pEntry->pLogger, pLogger);
+				if (!pLogger) AtomicOps::store(&_generation, _generation + 1);
+				return;
+			}
+		}
+	}
+	if (!pLogger) return;
+
+	if (!pTable || 2*(pTable->count + 1) > pTable->mask + 1)
+	{
+		// Readers may still be using the old table, so it
+		// is never deleted.
+		IndexTable* pNewTable = new IndexTable(pTable ? 2*(pTable->mask + 1) : 64);
+		if (pTable)
+		{
+			for (UInt32 i = 0; i <= pTable->mask; ++i)
+			{
+				if (pTable->slots[i]) insertEntry(pNewTable, static_cast<IndexEntry*>(pTable->slots[i]));
+			}
+			pNewTable->pRetired = pTable;
+		}
+		AtomicOps::store(&pIndexTable, pNewTable);
+		pTable = pNewTable;
+	}
+	insertEntry(pTable, new IndexEntry(name, hash, pLogger));
+}
+
+
+void Logger::clearIndex()
+{
+	// Readers search the index without holding the mutex, so
+	// neither the tables nor the entries can be deleted. Entries
+	// are reused if a Logger with the same name is created again.
+	IndexTable* pTable = static_cast<IndexTable*>(pIndexTable);
+	if (pTable)
+	{
+		for (UInt32 i = 0; i <= pTable->mask; ++i)
+		{
+			IndexEntry* pEntry = static_cast<IndexEntry*>(pTable->slots[i]);
+			if (pEntry) AtomicOps::store(&pEntry->pLogger, 0);
+		}
+	}
+	AtomicOps::store(&_generation, _generation + 1);
+}
+
+
+LoggerHandle::LoggerHandle(const std::string& name):
+	_name(name),
+	_pLogger(0),
+	_generation(0)
+{
+}
+
+
+LoggerHandle::~LoggerHandle()
+{
+}
+
+
+Logger& LoggerHandle::refresh() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	UInt32 generation = Logger::generation();
+	Logger& logger = Logger::get(_name);
+	AtomicOps::store(&_pLogger, &logger);
+	AtomicOps::store(&_generation, generation);
+	return logger;
 }
 
 
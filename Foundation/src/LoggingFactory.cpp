@@ -37,6 +37,8 @@
 #include "Poco/LoggingFactory.h"
 #include "Poco/SingletonHolder.h"
 #include "Poco/AsyncChannel.h"
+#include "Poco/AsyncRingChannel.h"
+#include "Poco/BinaryFileChannel.h"
 #include "Poco/ConsoleChannel.h"
 #include "Poco/FileChannel.h"
 #include "Poco/FormattingChannel.h"
@@ -108,6 +110,7 @@ LoggingFactory& LoggingFactory::defaultFactory()
 void LoggingFactory::registerBuiltins()
 {
 	_channelFactory.registerClass("AsyncChannel", new Instantiator<AsyncChannel, Channel>);
+	_channelFactory.registerClass("AsyncRingChannel", new Instantiator<AsyncRingChannel, Channel>);
 #if defined(POCO_OS_FAMILY_WINDOWS) && !defined(_WIN32_WCE)
 	_channelFactory.registerClass("ConsoleChannel", new Instantiator<WindowsConsoleChannel, Channel>);
 #else
@@ -115,6 +118,7 @@ void LoggingFactory::registerBuiltins()
 #endif
 #ifndef POCO_NO_FILECHANNEL
 	_channelFactory.registerClass("FileChannel", new Instantiator<FileChannel, Channel>);
+	_channelFactory.registerClass("BinaryFileChannel", new Instantiator<BinaryFileChannel, Channel>);
 #endif
 	_channelFactory.registerClass("FormattingChannel", new Instantiator<FormattingChannel, Channel>);
 #ifndef POCO_NO_SPLITTERCHANNEL
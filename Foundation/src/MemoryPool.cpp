@@ -35,16 +35,209 @@
 
 
 #include "Poco/MemoryPool.h"
+#include "Poco/ThreadLocal.h"
+#include "Poco/Thread.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/AutoPtr.h"
 #include "Poco/Exception.h"
+#include <new>
 
 
 namespace Poco {
 
 
+class MemoryPool::ThreadCache
+	/// The per-thread block caches of a MemoryPool.
+{
+public:
+	class Owner: public RefCountedObject
+		/// Shared by the pool and all its thread caches.
+		/// Once the pool has been destroyed, thread caches
+		/// free their blocks instead of returning them.
+	{
+	public:
+		Owner(MemoryPool* pPool):
+			_pPool(pPool)
+		{
+		}
+
+		void detach()
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			_pPool = 0;
+		}
+
+		void drain(BlockVec& blocks, UInt64 hits, UInt64 misses)
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			if (_pPool)
+			{
+				_pPool->drain(blocks, blocks.size(), hits, misses);
+			}
+			else
+			{
+				for (BlockVec::iterator it = blocks.begin(); it != blocks.end(); ++it)
+				{
+					delete [] *it;
+				}
+				blocks.clear();
+			}
+		}
+
+	protected:
+		~Owner()
+		{
+		}
+
+	private:
+		MemoryPool* _pPool;
+		FastMutex   _mutex;
+	};
+
+	class Magazine
+		/// The blocks cached by one thread.
+	{
+	public:
+		Magazine():
+			hits(0),
+			misses(0)
+		{
+		}
+
+		~Magazine()
+		{
+			if (pOwner) pOwner->drain(blocks, hits, misses);
+		}
+
+		AutoPtr<Owner> pOwner;
+		BlockVec       blocks;
+		UInt64         hits;
+		UInt64         misses;
+	};
+
+	ThreadCache(MemoryPool& pool, int size):
+		_pool(pool),
+		_pOwner(new Owner(&pool)),
+		_size(size),
+		_batch(size > 1 ? size/2 : 1)
+	{
+	}
+
+	~ThreadCache()
+	{
+		_pOwner->detach();
+	}
+
+	Magazine* magazine()
+	{
+		if (!Thread::current()) return 0;
+
+		Magazine& mag = _magazine.get();
+		if (mag.pOwner != _pOwner)
+		{
+			// either a new magazine, or one left over from a
+			// destroyed pool that had the same address
+			if (mag.pOwner) mag.pOwner->drain(mag.blocks, mag.hits, mag.misses);
+			mag.pOwner = _pOwner;
+			mag.blocks.reserve(_size);
+			mag.hits   = 0;
+			mag.misses = 0;
+		}
+		return &mag;
+	}
+
+	char* get()
+	{
+		Magazine* pMag = magazine();
+		if (!pMag) return _pool.getBlock();
+
+		if (pMag->blocks.empty())
+		{
+			++pMag->misses;
+			char* ptr = _pool.refill(pMag->blocks, _batch, pMag->hits, pMag->misses);
+			pMag->hits   = 0;
+			pMag->misses = 0;
+			return ptr;
+		}
+		else
+		{
+			++pMag->hits;
+			char* ptr = pMag->blocks.back();
+			pMag->blocks.pop_back();
+			return ptr;
+		}
+	}
+
+	void release(char* ptr)
+	{
+		Magazine* pMag = magazine();
+		if (!pMag)
+		{
+			_pool.releaseBlock(ptr);
+			return;
+		}
+
+		if (pMag->blocks.size() >= static_cast<std::size_t>(_size))
+		{
+			_pool.drain(pMag->blocks, _batch, pMag->hits, pMag->misses);
+			pMag->hits   = 0;
+			pMag->misses = 0;
+		}
+		pMag->blocks.push_back(ptr);
+	}
+
+private:
+	MemoryPool&          _pool;
+	AutoPtr<Owner>       _pOwner;
+	int                  _size;
+	std::size_t          _batch;
+	ThreadLocal<Magazine> _magazine;
+};
+
+
 MemoryPool::MemoryPool(std::size_t blockSize, int preAlloc, int maxAlloc):
 	_blockSize(blockSize),
+	_threadCacheSize(0),
+	_maxAlloc(maxAlloc),
+	_allocated(preAlloc),
+	_pCache(0),
+	_hits(0),
+	_misses(0)
+{
+	init(preAlloc, maxAlloc);
+}
+
+
+MemoryPool::MemoryPool(std::size_t blockSize, int preAlloc, int maxAlloc, int threadCacheSize):
+	_blockSize(blockSize),
+	_threadCacheSize(threadCacheSize),
 	_maxAlloc(maxAlloc),
-	_allocated(preAlloc)
+	_allocated(preAlloc),
+	_pCache(0),
+	_hits(0),
+	_misses(0)
+{
+	poco_assert (threadCacheSize >= 0);
+
+	init(preAlloc, maxAlloc);
+	if (threadCacheSize > 0)
+	{
+		_pCache = new ThreadCache(*this, threadCacheSize);
+	}
+}
+
+	
+MemoryPool::~MemoryPool()
+{
+	delete _pCache;
+	for (BlockVec::iterator it = _blocks.begin(); it != _blocks.end(); ++it)
+	{
+		delete [] *it;
+	}
+}
+
+
+void MemoryPool::init(int preAlloc, int maxAlloc)
 {
 	poco_assert (maxAlloc == 0 || maxAlloc >= preAlloc);
 	poco_assert (preAlloc >= 0 && maxAlloc >= 0);
@@ -61,17 +254,26 @@ MemoryPool::MemoryPool(std::size_t blockSize, int preAlloc, int maxAlloc):
 	}
 }
 
+
+void* MemoryPool::get()
+{
+	if (_pCache)
+		return _pCache->get();
+	else
+		return getBlock();
+}
+
 	
-MemoryPool::~MemoryPool()
+void MemoryPool::release(void* ptr)
 {
-	for (BlockVec::iterator it = _blocks.begin(); it != _blocks.end(); ++it)
-	{
-		delete [] *it;
-	}
+	if (_pCache)
+		_pCache->release(reinterpret_cast<char*>(ptr));
+	else
+		releaseBlock(reinterpret_cast<char*>(ptr));
 }
 
 
-void* MemoryPool::get()
+char* MemoryPool::getBlock()
 {
 	FastMutex::ScopedLock lock(_mutex);
 	
@@ -92,12 +294,68 @@ void* MemoryPool::get()
 	}
 }
 
-	
-void MemoryPool::release(void* ptr)
+
+void MemoryPool::releaseBlock(char* ptr)
 {
 	FastMutex::ScopedLock lock(_mutex);
 	
-	_blocks.push_back(reinterpret_cast<char*>(ptr));
+	_blocks.push_back(ptr);
+}
+
+
+char* MemoryPool::refill(BlockVec& blocks, std::size_t count, UInt64 hits, UInt64 misses)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_hits   += hits;
+	_misses += misses;
+	if (_blocks.empty())
+	{
+		if (_maxAlloc != 0 && _allocated >= _maxAlloc)
+			throw OutOfMemoryException("MemoryPool exhausted");
+
+		// allocate a whole batch, so that the next
+		// calls are served from the thread cache
+		std::size_t n = count;
+		if (_maxAlloc != 0 && n > static_cast<std::size_t>(_maxAlloc - _allocated))
+			n = static_cast<std::size_t>(_maxAlloc - _allocated);
+		char* ptr = new char[_blockSize];
+		++_allocated;
+		try
+		{
+			while (--n > 0)
+			{
+				blocks.push_back(new char[_blockSize]);
+				++_allocated;
+			}
+		}
+		catch (std::bad_alloc&)
+		{
+			// the first block is enough for the caller
+		}
+		return ptr;
+	}
+	char* ptr = _blocks.back();
+	_blocks.pop_back();
+	while (--count > 0 && !_blocks.empty())
+	{
+		blocks.push_back(_blocks.back());
+		_blocks.pop_back();
+	}
+	return ptr;
+}
+
+
+void MemoryPool::drain(BlockVec& blocks, std::size_t count, UInt64 hits, UInt64 misses)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_hits   += hits;
+	_misses += misses;
+	if (count > blocks.size()) count = blocks.size();
+	// return the least recently used blocks
+	_blocks.insert(_blocks.end(), blocks.begin(), blocks.begin() + count);
+	blocks.erase(blocks.begin(), blocks.begin() + count);
 }
 
 
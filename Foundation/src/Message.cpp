@@ -240,4 +240,21 @@ std::string& Message::operator [] (const std::string& param)
 }
 
 
+bool Message::has(const std::string& param) const
+{
+	return _pMap && _pMap->find(param) != _pMap->end();
+}
+
+
+const std::string& Message::get(const std::string& param, const std::string& defaultValue) const
+{
+	if (_pMap)
+	{
+		StringMap::const_iterator it = _pMap->find(param);
+		if (it != _pMap->end()) return it->second;
+	}
+	return defaultValue;
+}
+
+
 } // namespace Poco
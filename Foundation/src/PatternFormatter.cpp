@@ -44,11 +44,44 @@
 #include "Poco/Timezone.h"
 #include "Poco/Environment.h"
 #include "Poco/NumberParser.h"
+#include "Poco/Thread.h"
+#include <cstring>
 
 
 namespace Poco {
 
 
+namespace
+{
+	// Actions in the same run (see ParsePattern()) change
+	// at most once per second.
+	const char RUN_KEYS[] = "wWbBdefmnoyYHhaAMSzZE";
+
+	// The key of the action that stands for a run. PatternActions
+	// for runs store the index of the run in the length member.
+	const char RUN_KEY = 1;
+
+	const std::string EMPTY;
+
+	inline void append2(std::string& text, int value)
+	{
+		char buffer[2];
+		buffer[0] = static_cast<char>('0' + value/10);
+		buffer[1] = static_cast<char>('0' + value % 10);
+		text.append(buffer, 2);
+	}
+
+	inline void append3(std::string& text, int value)
+	{
+		char buffer[3];
+		buffer[0] = static_cast<char>('0' + value/100);
+		buffer[1] = static_cast<char>('0' + (value/10) % 10);
+		buffer[2] = static_cast<char>('0' + value % 10);
+		text.append(buffer, 3);
+	}
+}
+
+
 const std::string PatternFormatter::PROP_PATTERN = "pattern";
 const std::string PatternFormatter::PROP_TIMES   = "times";
 
@@ -81,68 +114,133 @@ void PatternFormatter::format(const Message& msg, std::string& text)
 	{
 		timestamp  += _localTimeOffset;
 	}
-	DateTime dateTime = timestamp;
-	for (std::vector<PatternAction>::iterator ip = _patternActions.begin(); ip != _patternActions.end(); ++ip)
+	Timestamp::TimeVal epochMicros = timestamp.epochMicroseconds();
+	Timestamp::TimeVal seconds = epochMicros/Timestamp::resolution();
+	int micros = static_cast<int>(epochMicros % Timestamp::resolution());
+	if (micros < 0)
+	{
+		micros += static_cast<int>(Timestamp::resolution());
+		--seconds;
+	}
+
+	Cache& cache = _caches[cacheIndex()];
+	bool cached = cache.mutex.tryLock();
+	try
+	{
+		if (cached)
+		{
+			if (!cache.valid || cache.seconds != seconds)
+			{
+				DateTime dateTime(timestamp);
+				cache.runs.resize(_runs.size());
+				for (std::size_t i = 0; i < _runs.size(); ++i)
+				{
+					cache.runs[i].clear();
+					formatRun(_runs[i], msg, dateTime, cache.runs[i]);
+				}
+				cache.seconds = seconds;
+				cache.valid = true;
+			}
+			text.reserve(text.size() + cache.sizeHint);
+		}
+		std::string::size_type size = text.size();
+		for (ActionVec::const_iterator ip = _patternActions.begin(); ip != _patternActions.end(); ++ip)
+		{
+			text.append(ip->prepend);
+			if (ip->key == RUN_KEY)
+			{
+				if (cached)
+				{
+					text.append(cache.runs[ip->length]);
+				}
+				else
+				{
+					DateTime dateTime(timestamp);
+					formatRun(_runs[ip->length], msg, dateTime, text);
+				}
+			}
+			else formatAction(*ip, msg, micros, text);
+		}
+		if (cached)
+		{
+			cache.sizeHint = text.size() - size;
+			cache.mutex.unlock();
+		}
+	}
+	catch (...)
+	{
+		if (cached) cache.mutex.unlock();
+		throw;
+	}
+}
+
+
+void PatternFormatter::formatRun(const ActionVec& run, const Message& msg, const DateTime& dateTime, std::string& text) const
+{
+	for (ActionVec::const_iterator ip = run.begin(); ip != run.end(); ++ip)
 	{
 		text.append(ip->prepend);
 		switch (ip->key)
 		{
-		case 's': text.append(msg.getSource()); break;
-		case 't': text.append(msg.getText()); break;
-		case 'l': NumberFormatter::append(text, (int) msg.getPriority()); break;
-		case 'p': text.append(getPriorityName((int) msg.getPriority())); break;
-		case 'q': text += getPriorityName((int) msg.getPriority()).at(0); break;
-		case 'P': NumberFormatter::append(text, msg.getPid()); break;
-		case 'T': text.append(msg.getThread()); break;
-		case 'I': NumberFormatter::append(text, msg.getTid()); break;
-		case 'N': text.append(Environment::nodeName()); break;
-		case 'U': text.append(msg.getSourceFile() ? msg.getSourceFile() : ""); break;
-		case 'u': NumberFormatter::append(text, msg.getSourceLine()); break;
 		case 'w': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()], 0, 3); break;
 		case 'W': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()]); break;
 		case 'b': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1], 0, 3); break;
 		case 'B': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1]); break;
-		case 'd': NumberFormatter::append0(text, dateTime.day(), 2); break;
+		case 'd': append2(text, dateTime.day()); break;
 		case 'e': NumberFormatter::append(text, dateTime.day()); break;
 		case 'f': NumberFormatter::append(text, dateTime.day(), 2); break;
-		case 'm': NumberFormatter::append0(text, dateTime.month(), 2); break;
+		case 'm': append2(text, dateTime.month()); break;
 		case 'n': NumberFormatter::append(text, dateTime.month()); break;
 		case 'o': NumberFormatter::append(text, dateTime.month(), 2); break;
-		case 'y': NumberFormatter::append0(text, dateTime.year() % 100, 2); break;
+		case 'y': append2(text, dateTime.year() % 100); break;
 		case 'Y': NumberFormatter::append0(text, dateTime.year(), 4); break;
-		case 'H': NumberFormatter::append0(text, dateTime.hour(), 2); break;
-		case 'h': NumberFormatter::append0(text, dateTime.hourAMPM(), 2); break;
+		case 'H': append2(text, dateTime.hour()); break;
+		case 'h': append2(text, dateTime.hourAMPM()); break;
 		case 'a': text.append(dateTime.isAM() ? "am" : "pm"); break;
 		case 'A': text.append(dateTime.isAM() ? "AM" : "PM"); break;
-		case 'M': NumberFormatter::append0(text, dateTime.minute(), 2); break;
-		case 'S': NumberFormatter::append0(text, dateTime.second(), 2); break;
-		case 'i': NumberFormatter::append0(text, dateTime.millisecond(), 3); break;
-		case 'c': NumberFormatter::append(text, dateTime.millisecond()/100); break;
-		case 'F': NumberFormatter::append0(text, dateTime.millisecond()*1000 + dateTime.microsecond(), 6); break;
+		case 'M': append2(text, dateTime.minute()); break;
+		case 'S': append2(text, dateTime.second()); break;
 		case 'z': text.append(DateTimeFormatter::tzdISO(_localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
 		case 'Z': text.append(DateTimeFormatter::tzdRFC(_localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
 		case 'E': NumberFormatter::append(text, msg.getTime().epochTime()); break;
-		case 'v':
-			if (ip->length > msg.getSource().length())	//append spaces
-				text.append(msg.getSource()).append(ip->length - msg.getSource().length(), ' ');
-			else if (ip->length && ip->length < msg.getSource().length()) // crop
-				text.append(msg.getSource(), msg.getSource().length()-ip->length, ip->length);
-			else
-				text.append(msg.getSource());
-			break;
-		case 'x':
-			try
-			{
-				text.append(msg[ip->property]);
-			}
-			catch (...)
-			{
-			}
-			break;
 		}
 	}
 }
 
+
+void PatternFormatter::formatAction(const PatternAction& action, const Message& msg, int micros, std::string& text) const
+{
+	switch (action.key)
+	{
+	case 's': text.append(msg.getSource()); break;
+	case 't': text.append(msg.getText()); break;
+	case 'l': NumberFormatter::append(text, (int) msg.getPriority()); break;
+	case 'p': text.append(getPriorityName((int) msg.getPriority())); break;
+	case 'q': text += getPriorityName((int) msg.getPriority()).at(0); break;
+	case 'P': NumberFormatter::append(text, msg.getPid()); break;
+	case 'T': text.append(msg.getThread()); break;
+	case 'I': NumberFormatter::append(text, msg.getTid()); break;
+	case 'N': text.append(Environment::nodeName()); break;
+	case 'U': if (msg.getSourceFile()) text.append(msg.getSourceFile()); break;
+	case 'u': NumberFormatter::append(text, msg.getSourceLine()); break;
+	case 'i': append3(text, micros/1000); break;
+	case 'c': text += static_cast<char>('0' + micros/100000); break;
+	case 'F': append3(text, micros/1000); append3(text, micros % 1000); break;
+	case 'v':
+		if (action.length > msg.getSource().length())	//append spaces
+			text.append(msg.getSource()).append(action.length - msg.getSource().length(), ' ');
+		else if (action.length && action.length < msg.getSource().length()) // crop
+			text.append(msg.getSource(), msg.getSource().length()-action.length, action.length);
+		else
+			text.append(msg.getSource());
+		break;
+	case 'x':
+		text.append(msg.get(action.property, EMPTY));
+		break;
+	}
+}
+
+
 void PatternFormatter::ParsePattern()
 {
 	_patternActions.clear();
@@ -197,6 +295,47 @@ void PatternFormatter::ParsePattern()
 	}
 	if( end_act.prepend.size())
 		_patternActions.push_back(end_act);
+
+	ActionVec actions;
+	_runs.clear();
+	bool inRun = false;
+	for (ActionVec::const_iterator ia = _patternActions.begin(); ia != _patternActions.end(); ++ia)
+	{
+		if (ia->key && std::strchr(RUN_KEYS, ia->key))
+		{
+			if (!inRun)
+			{
+				PatternAction run;
+				run.key = RUN_KEY;
+				run.length = static_cast<int>(_runs.size());
+				run.prepend = ia->prepend;
+				actions.push_back(run);
+				_runs.push_back(ActionVec());
+				_runs.back().push_back(*ia);
+				_runs.back().back().prepend.clear();
+				inRun = true;
+			}
+			else _runs.back().push_back(*ia);
+		}
+		else
+		{
+			actions.push_back(*ia);
+			inRun = false;
+		}
+	}
+	_patternActions.swap(actions);
+	invalidateCaches();
+}
+
+
+void PatternFormatter::invalidateCaches()
+{
+	for (int i = 0; i < CACHE_COUNT; ++i)
+	{
+		FastMutex::ScopedLock lock(_caches[i].mutex);
+
+		_caches[i].valid = false;
+	}
 }
 
 	
@@ -211,6 +350,7 @@ void PatternFormatter::setProperty(const std::string& name, const std::string& v
 	{
 		_localTime = (value == "local");
 		_localTimeOffset = Timestamp::resolution()*( Timezone::utcOffset() + Timezone::dst() );
+		invalidateCaches();
 	}
 	else 
 		Formatter::setProperty(name, value);
@@ -252,4 +392,23 @@ const std::string& PatternFormatter::getPriorityName(int prio)
 }
 
 
+int PatternFormatter::cacheIndex()
+{
+	Thread* pThread = Thread::current();
+	if (pThread)
+	{
+		return pThread->id() % CACHE_COUNT;
+	}
+	else
+	{
+		// The low bits of a POSIX thread id are usually zero, as
+		// pthread_t is the (aligned) address of the thread's control
+		// block, so the id is hashed (Fibonacci hashing) and the
+		// index is taken from the high bits.
+		UInt32 tid = static_cast<UInt32>(static_cast<unsigned long>(Thread::currentTid()) >> 4);
+		return static_cast<int>(((tid*0x9E3779B9U) >> 24) % CACHE_COUNT);
+	}
+}
+
+
 } // namespace Poco
@@ -36,6 +36,7 @@
 
 #include "Poco/StreamConverter.h"
 #include "Poco/TextEncoding.h"
+#include "Poco/UTF8Encoding.h"
 
 
 namespace Poco {
@@ -49,7 +50,9 @@ StreamConverterBuf::StreamConverterBuf(std::istream& istr, const TextEncoding& i
 	_defaultChar(defaultChar),
 	_sequenceLength(0),
 	_pos(0),
-	_errors(0)
+	_errors(0),
+	_ascii(inEncoding.isAsciiCompatible() && outEncoding.isAsciiCompatible()),
+	_utf8(dynamic_cast<const UTF8Encoding*>(&inEncoding) != 0 && dynamic_cast<const UTF8Encoding*>(&outEncoding) != 0)
 {
 }
 
@@ -62,7 +65,9 @@ StreamConverterBuf::StreamConverterBuf(std::ostream& ostr, const TextEncoding& i
 	_defaultChar(defaultChar),
 	_sequenceLength(0),
 	_pos(0),
-	_errors(0)
+	_errors(0),
+	_ascii(inEncoding.isAsciiCompatible() && outEncoding.isAsciiCompatible()),
+	_utf8(dynamic_cast<const UTF8Encoding*>(&inEncoding) != 0 && dynamic_cast<const UTF8Encoding*>(&outEncoding) != 0)
 {
 }
 
@@ -150,6 +155,58 @@ int StreamConverterBuf::writeToDevice(char c)
 }
 
 
+std::streamsize StreamConverterBuf::readBlockFromDevice(char* buffer, std::streamsize length)
+{
+	poco_assert_dbg (_pIstr);
+
+	std::streamsize n = 0;
+	while (n < length)
+	{
+		if (_ascii && _pos == _sequenceLength && _pIstr->good())
+		{
+			std::streambuf* pBuf = _pIstr->rdbuf();
+			int c = pBuf->sgetc();
+			while (c != std::char_traits<char>::eof() && c < 0x80 && n < length)
+			{
+				buffer[n++] = (char) c;
+				c = pBuf->snextc();
+			}
+			if (n == length) break;
+		}
+		int c = readFromDevice();
+		if (c == -1) break;
+		buffer[n++] = (char) c;
+	}
+	return n;
+}
+
+
+std::streamsize StreamConverterBuf::writeBlockToDevice(const char* buffer, std::streamsize length)
+{
+	poco_assert_dbg (_pOstr);
+
+	std::streamsize n = 0;
+	while (n < length)
+	{
+		if (_ascii && _pos == 0)
+		{
+			std::size_t run = _utf8
+				? UTF8Encoding::legalLength(buffer + n, static_cast<std::size_t>(length - n))
+				: UTF8Encoding::asciiLength(buffer + n, static_cast<std::size_t>(length - n));
+			if (run > 0)
+			{
+				_pOstr->write(buffer + n, static_cast<std::streamsize>(run));
+				n += run;
+				if (n == length) break;
+			}
+		}
+		if (writeToDevice(buffer[n]) == -1) break;
+		++n;
+	}
+	return n;
+}
+
+
 int StreamConverterBuf::errors() const
 {
 	return _errors;
@@ -70,7 +70,7 @@ int icompare(const std::string& str, std::string::size_type pos, std::string::si
 
 int icompare(const std::string& str1, const std::string& str2)
 {
-	return icompare(str1, 0, str1.size(), str2.begin(), str2.end());
+	return Impl::icompare(str1.data(), str1.size(), str2.data(), str2.size());
 }
 
 
@@ -117,24 +117,8 @@ int icompare(const std::string& str, std::string::size_type pos, std::string::si
 	poco_check_ptr (ptr);
 	std::string::size_type sz = str.size();
 	if (pos > sz) pos = sz;
-	if (pos + n > sz) n = sz - pos;
-	std::string::const_iterator it  = str.begin() + pos; 
-	std::string::const_iterator end = str.begin() + pos + n;
-	while (it != end && *ptr)
-	{
-	std::string::value_type c1 = Ascii::toLower(*it);
-	std::string::value_type c2 = Ascii::toLower(*ptr);
-	if (c1 < c2)
-		return -1;
-	else if (c1 > c2)
-		return 1;
-	++it; ++ptr;
-	}
-
-	if (it == end)
-		return *ptr == 0 ? 0 : -1;
-	else
-	return 1;
+	if (n > sz - pos) n = sz - pos;
+	return Impl::icompare(str.data() + pos, n, ptr, std::strlen(ptr));
 }
 
 
@@ -37,6 +37,8 @@
 #include "Poco/TaskManager.h"
 #include "Poco/TaskNotification.h"
 #include "Poco/ThreadPool.h"
+#include "Poco/WorkStealingThreadPool.h"
+#include "Poco/ThreadPoolAdapter.h"
 
 
 namespace Poco {
@@ -46,19 +48,26 @@ const int TaskManager::MIN_PROGRESS_NOTIFICATION_INTERVAL = 100000; // 100 milli
 
 
 TaskManager::TaskManager():
-	_threadPool(ThreadPool::defaultPool())
+	_pThreadPool(new ThreadPoolAdapter<ThreadPool>(ThreadPool::defaultPool()))
 {
 }
 
 
 TaskManager::TaskManager(ThreadPool& pool):
-	_threadPool(pool)
+	_pThreadPool(new ThreadPoolAdapter<ThreadPool>(pool))
+{
+}
+
+
+TaskManager::TaskManager(WorkStealingThreadPool& pool):
+	_pThreadPool(new ThreadPoolAdapter<WorkStealingThreadPool>(pool))
 {
 }
 
 
 TaskManager::~TaskManager()
 {
+	delete _pThreadPool;
 }
 
 
@@ -72,7 +81,7 @@ void TaskManager::start(Task* pTask)
 	_taskList.push_back(pAutoTask);
 	try
 	{
-		_threadPool.start(*pAutoTask, pAutoTask->name());
+		_pThreadPool->start(*pAutoTask, pAutoTask->name());
 	}
 	catch (...)
 	{
@@ -98,7 +107,7 @@ void TaskManager::cancelAll()
 
 void TaskManager::joinAll()
 {
-	_threadPool.joinAll();
+	_pThreadPool->joinAll();
 }
 
 
@@ -37,6 +37,7 @@
 #include "Poco/TextConverter.h"
 #include "Poco/TextIterator.h"
 #include "Poco/TextEncoding.h"
+#include "Poco/UTF8Encoding.h"
 
 
 namespace {
@@ -53,7 +54,10 @@ namespace Poco {
 TextConverter::TextConverter(const TextEncoding& inEncoding, const TextEncoding& outEncoding, int defaultChar):
 	_inEncoding(inEncoding),
 	_outEncoding(outEncoding),
-	_defaultChar(defaultChar)
+	_defaultChar(defaultChar),
+	_ascii(inEncoding.isAsciiCompatible() && outEncoding.isAsciiCompatible()),
+	_utf8In(dynamic_cast<const UTF8Encoding*>(&inEncoding) != 0),
+	_utf8(_utf8In && dynamic_cast<const UTF8Encoding*>(&outEncoding) != 0)
 {
 }
 
@@ -66,7 +70,41 @@ TextConverter::~TextConverter()
 int TextConverter::convert(const std::string& source, std::string& destination, Transform trans)
 {
 	int errors = 0;
-	TextIterator it(source, _inEncoding);
+	std::string::const_iterator start = source.begin();
+	if (_ascii)
+	{
+		// Handle all single byte characters and legal UTF-8
+		// sequences here. Other multibyte sequences are left
+		// to the TextIterator.
+		const unsigned char* begin = (const unsigned char*) source.data();
+		const unsigned char* it    = begin;
+		const unsigned char* end   = begin + source.size();
+		while (it < end)
+		{
+			convertFast(it, end, destination, trans);
+			if (it == end) break;
+
+			int read = 1;
+			int c = _inEncoding.queryConvert(it, 1);
+			if (c < -1 && _utf8In)
+			{
+				std::size_t length    = static_cast<std::size_t>(-c);
+				std::size_t available = static_cast<std::size_t>(end - it);
+				if (UTF8Encoding::legalLength((const char*) it, available < length ? available : length) == length)
+				{
+					read = -c;
+					c = _inEncoding.queryConvert(it, read);
+				}
+			}
+			if (c < -1) break;
+			if (c == -1) { ++errors; c = _defaultChar; }
+			append(trans(c), destination);
+			it += read;
+		}
+		start += it - begin;
+	}
+
+	TextIterator it(start, source.end(), _inEncoding);
 	TextIterator end(source);
 	unsigned char buffer[TextEncoding::MAX_SEQUENCE_LENGTH];
 
@@ -96,6 +134,12 @@ int TextConverter::convert(const void* source, int length, std::string& destinat
 	
 	while (it < end)
 	{
+		if (_ascii)
+		{
+			convertFast(it, end, destination, trans);
+			if (it == end) break;
+		}
+
 		int n = _inEncoding.queryConvert(it, 1);
 		int uc;
 		int read = 1;
@@ -147,4 +191,37 @@ int TextConverter::convert(const void* source, int length, std::string& destinat
 }
 
 
+void TextConverter::convertFast(const unsigned char*& it, const unsigned char* end, std::string& destination, Transform trans)
+{
+	if (trans == nullTransform)
+	{
+		std::size_t n = _utf8 ? UTF8Encoding::legalLength((const char*) it, end - it) : UTF8Encoding::asciiLength((const char*) it, end - it);
+		destination.append((const char*) it, n);
+		it += n;
+	}
+	else
+	{
+		const unsigned char* ascii = it + UTF8Encoding::asciiLength((const char*) it, end - it);
+		while (it < ascii) append(trans(*it++), destination);
+	}
+}
+
+
+void TextConverter::append(int ch, std::string& destination)
+{
+	if (_ascii && ch >= 0 && ch < 0x80)
+	{
+		destination += (char) ch;
+	}
+	else
+	{
+		unsigned char buffer[TextEncoding::MAX_SEQUENCE_LENGTH];
+		int n = _outEncoding.convert(ch, buffer, sizeof(buffer));
+		if (n == 0) n = _outEncoding.convert(_defaultChar, buffer, sizeof(buffer));
+		poco_assert (n <= static_cast<int>(sizeof(buffer)));
+		destination.append((const char*) buffer, n);
+	}
+}
+
+
 } // namespace Poco
@@ -163,6 +163,17 @@ int TextEncoding::convert(int ch, unsigned char* bytes, int length) const
 }
 
 
+bool TextEncoding::isAsciiCompatible() const
+{
+	const CharacterMap& map = characterMap();
+	for (int i = 0; i < 128; ++i)
+	{
+		if (map[i] != i) return false;
+	}
+	return true;
+}
+
+
 int TextEncoding::queryConvert(const unsigned char* bytes, int length) const
 {
 	return (int) *bytes;
@@ -0,0 +1,482 @@
+//
+// TimingWheel.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  TimingWheel
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/TimingWheel.h"
+#include <limits>
+
+
+namespace Poco {
+
+
+TimingWheel::Entry::Entry(Notification::Ptr pNotification):
+	_pNotification(pNotification),
+	_expires(0),
+	_pPrev(0),
+	_pNext(0),
+	_slot(-1),
+	_pWheel(0)
+{
+}
+
+
+TimingWheel::Entry::~Entry()
+{
+}
+
+
+Notification::Ptr TimingWheel::Entry::notification() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _pNotification;
+}
+
+
+bool TimingWheel::Entry::cancel()
+{
+	TimingWheel* pWheel;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		pWheel = _pWheel;
+	}
+	// TimingWheel::cancel() checks again, with the
+	// wheel's mutex held, whether the entry is still
+	// in the wheel.
+	if (pWheel)
+		return pWheel->cancel(Ptr(this, true));
+	else
+		return false;
+}
+
+
+Notification::Ptr TimingWheel::Entry::detach()
+{
+	// The wheel's mutex protects the entry against concurrent
+	// changes; the entry's own mutex protects readers that
+	// only hold a reference to the entry.
+	FastMutex::ScopedLock lock(_mutex);
+
+	Notification::Ptr pNotification;
+	pNotification.swap(_pNotification);
+	_pPrev  = 0;
+	_pNext  = 0;
+	_slot   = -1;
+	_pWheel = 0;
+	return pNotification;
+}
+
+
+TimingWheel::TimingWheel():
+	_resolution(10000),
+	_currentTick(0),
+	_scheduled(0),
+	_rootScheduled(0),
+	_slots(SLOT_COUNT),
+	_waiting(0),
+	_wakeUpTick(std::numeric_limits<UInt64>::max())
+{
+}
+
+
+TimingWheel::TimingWheel(const Timespan& resolution):
+	_resolution(resolution.totalMicroseconds()),
+	_currentTick(0),
+	_scheduled(0),
+	_rootScheduled(0),
+	_slots(SLOT_COUNT),
+	_waiting(0),
+	_wakeUpTick(std::numeric_limits<UInt64>::max())
+{
+	poco_assert (_resolution > 0);
+}
+
+
+TimingWheel::~TimingWheel()
+{
+	clear();
+}
+
+
+TimingWheel::Entry::Ptr TimingWheel::schedule(Notification::Ptr pNotification, const Timestamp& time)
+{
+	poco_check_ptr (pNotification);
+
+	Entry::Ptr pEntry = new Entry(pNotification);
+	
+	FastMutex::ScopedLock lock(_mutex);
+
+	pEntry->_expires = time > Timestamp() ? tickOf(time, true) : 0;
+	pEntry->_pWheel  = this;
+	pEntry->duplicate(); // released when the entry leaves the wheel
+	insert(pEntry);
+	if (_waiting > 0 && pEntry->_expires < _wakeUpTick)
+	{
+		// the new notification expires before any waiting thread wakes up
+		_wakeUpTick = std::numeric_limits<UInt64>::max();
+		_nfAvailable.broadcast();
+	}
+	return pEntry;
+}
+
+
+void TimingWheel::enqueueNotification(Notification::Ptr pNotification, const Timestamp& time)
+{
+	schedule(pNotification, time);
+}
+
+
+void TimingWheel::enqueueUrgentNotification(Notification::Ptr pNotification)
+{
+	poco_check_ptr (pNotification);
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	_expired.push_front(pNotification);
+	if (_waiting > 0)
+	{
+		_wakeUpTick = std::numeric_limits<UInt64>::max();
+		_nfAvailable.broadcast();
+	}
+}
+
+
+bool TimingWheel::cancel(Entry::Ptr pEntry)
+{
+	poco_check_ptr (pEntry);
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (pEntry->_pWheel != this) return false;
+	unlink(pEntry);
+	pEntry->release();
+	return true;
+}
+
+
+std::size_t TimingWheel::expire(std::vector<Notification::Ptr>& expired)
+{
+	return expire(Timestamp(), expired);
+}
+
+
+std::size_t TimingWheel::expire(const Timestamp& now, std::vector<Notification::Ptr>& expired)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	advance(now);
+	std::size_t n = _expired.size();
+	expired.insert(expired.end(), _expired.begin(), _expired.end());
+	_expired.clear();
+	return n;
+}
+
+
+Notification* TimingWheel::dequeueNotification()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	advance(Timestamp());
+	return dequeueOne();
+}
+
+
+Notification* TimingWheel::waitDequeueNotification()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	for (;;)
+	{
+		Timestamp now;
+		advance(now);
+		Notification* pNf = dequeueOne();
+		if (pNf) return pNf;
+
+		++_waiting;
+		UInt64 tick;
+		if (nextTick(tick))
+		{
+			if (tick < _wakeUpTick) _wakeUpTick = tick;
+			Timestamp::TimeDiff diff = timeOf(tick) - now;
+			_nfAvailable.tryWait(_mutex, diff > 0 ? static_cast<long>((diff + 999)/1000) : 1);
+		}
+		else
+		{
+			_nfAvailable.wait(_mutex);
+		}
+		--_waiting;
+		// threads still waiting register their wake-up tick again
+		// after the next broadcast
+		_wakeUpTick = std::numeric_limits<UInt64>::max();
+	}
+}
+
+
+Notification* TimingWheel::waitDequeueNotification(long milliseconds)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	Timestamp start;
+	for (;;)
+	{
+		Timestamp now;
+		advance(now);
+		Notification* pNf = dequeueOne();
+		if (pNf) return pNf;
+
+		Timestamp::TimeDiff remaining = static_cast<Timestamp::TimeDiff>(milliseconds)*1000 - (now - start);
+		if (remaining <= 0) return 0;
+		++_waiting;
+		UInt64 tick;
+		if (nextTick(tick))
+		{
+			if (tick < _wakeUpTick) _wakeUpTick = tick;
+			Timestamp::TimeDiff diff = timeOf(tick) - now;
+			if (diff < remaining) remaining = diff > 0 ? diff : 1;
+		}
+		_nfAvailable.tryWait(_mutex, static_cast<long>((remaining + 999)/1000));
+		--_waiting;
+		_wakeUpTick = std::numeric_limits<UInt64>::max();
+	}
+}
+
+
+bool TimingWheel::empty() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _scheduled == 0 && _expired.empty();
+}
+
+
+int TimingWheel::size() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _scheduled + static_cast<int>(_expired.size());
+}
+
+
+void TimingWheel::clear()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	for (std::vector<Entry*>::iterator it = _slots.begin(); it != _slots.end(); ++it)
+	{
+		while (*it)
+		{
+			Entry* pEntry = *it;
+			unlink(pEntry);
+			pEntry->release();
+		}
+	}
+	_expired.clear();
+	poco_assert_dbg (_scheduled == 0 && _rootScheduled == 0);
+}
+
+
+UInt64 TimingWheel::tickOf(const Timestamp& time, bool roundUp) const
+{
+	Timestamp::TimeDiff diff = time - _base;
+	if (diff <= 0) return 0;
+	UInt64 tick = static_cast<UInt64>(diff/_resolution);
+	if (roundUp && diff % _resolution != 0) ++tick;
+	return tick;
+}
+
+
+Timestamp TimingWheel::timeOf(UInt64 tick) const
+{
+	return _base + static_cast<Timestamp::TimeDiff>(tick)*_resolution;
+}
+
+
+void TimingWheel::insert(Entry* pEntry)
+{
+	UInt64 expires = pEntry->_expires;
+	if (expires <= _currentTick)
+	{
+		_expired.push_back(pEntry->detach());
+		pEntry->release();
+		return;
+	}
+
+	UInt64 delta = expires - _currentTick;
+	int slot;
+	if (delta < ROOT_SLOTS)
+	{
+		slot = static_cast<int>(expires & (ROOT_SLOTS - 1));
+	}
+	else
+	{
+		// beyond the horizon, the entry waits in the last wheel
+		// and is inserted again when its slot is cascaded
+		if (delta >= (UInt64(1) << HORIZON_BITS))
+			expires = _currentTick + (UInt64(1) << HORIZON_BITS) - 1;
+		int wheel = 1;
+		int shift = ROOT_BITS;
+		while (wheel < WHEELS - 1 && delta >= (UInt64(1) << (shift + LEVEL_BITS)))
+		{
+			shift += LEVEL_BITS;
+			++wheel;
+		}
+		slot = ROOT_SLOTS + (wheel - 1)*LEVEL_SLOTS + static_cast<int>((expires >> shift) & (LEVEL_SLOTS - 1));
+	}
+
+	Entry* pHead = _slots[slot];
+	pEntry->_pPrev  = 0;
+	pEntry->_pNext  = pHead;
+	pEntry->_slot   = slot;
+	if (pHead) pHead->_pPrev = pEntry;
+	_slots[slot] = pEntry;
+	++_scheduled;
+	if (slot < ROOT_SLOTS) ++_rootScheduled;
+}
+
+
+void TimingWheel::unlink(Entry* pEntry)
+{
+	if (pEntry->_pPrev)
+		pEntry->_pPrev->_pNext = pEntry->_pNext;
+	else
+		_slots[pEntry->_slot] = pEntry->_pNext;
+	if (pEntry->_pNext)
+		pEntry->_pNext->_pPrev = pEntry->_pPrev;
+	if (pEntry->_slot < ROOT_SLOTS) --_rootScheduled;
+	--_scheduled;
+	pEntry->detach();
+}
+
+
+void TimingWheel::advance(const Timestamp& now)
+{
+	UInt64 target = tickOf(now, false);
+	while (_currentTick < target)
+	{
+		if (_scheduled == 0)
+		{
+			_currentTick = target;
+			break;
+		}
+		if (_rootScheduled == 0)
+		{
+			// nothing can expire before the next cascade
+			UInt64 next = _currentTick | (ROOT_SLOTS - 1);
+			if (next >= target)
+			{
+				_currentTick = target;
+				break;
+			}
+			_currentTick = next;
+		}
+		++_currentTick;
+		int index = static_cast<int>(_currentTick & (ROOT_SLOTS - 1));
+		if (index == 0)
+		{
+			int shift = ROOT_BITS;
+			for (int wheel = 1; wheel < WHEELS; ++wheel)
+			{
+				int wheelIndex = static_cast<int>((_currentTick >> shift) & (LEVEL_SLOTS - 1));
+				cascade(ROOT_SLOTS + (wheel - 1)*LEVEL_SLOTS + wheelIndex);
+				if (wheelIndex != 0) break;
+				shift += LEVEL_BITS;
+			}
+		}
+		expireSlot(index);
+	}
+}
+
+
+void TimingWheel::cascade(int slot)
+{
+	Entry* pEntry = _slots[slot];
+	_slots[slot] = 0;
+	while (pEntry)
+	{
+		Entry* pNext = pEntry->_pNext;
+		--_scheduled;
+		insert(pEntry);
+		pEntry = pNext;
+	}
+}
+
+
+void TimingWheel::expireSlot(int slot)
+{
+	Entry* pEntry = _slots[slot];
+	_slots[slot] = 0;
+	while (pEntry)
+	{
+		Entry* pNext = pEntry->_pNext;
+		--_scheduled;
+		--_rootScheduled;
+		_expired.push_back(pEntry->detach());
+		pEntry->release();
+		pEntry = pNext;
+	}
+}
+
+
+bool TimingWheel::nextTick(UInt64& tick) const
+{
+	if (!_expired.empty())
+	{
+		tick = _currentTick;
+		return true;
+	}
+	if (_scheduled == 0) return false;
+
+	// The next tick with a non-empty slot in the first wheel,
+	// or the next tick at which entries are cascaded.
+	tick = _currentTick + 1;
+	while ((tick & (ROOT_SLOTS - 1)) != 0 && !_slots[static_cast<int>(tick & (ROOT_SLOTS - 1))])
+	{
+		++tick;
+	}
+	return true;
+}
+
+
+Notification* TimingWheel::dequeueOne()
+{
+	if (_expired.empty()) return 0;
+
+	Notification::Ptr pNf = _expired.front();
+	_expired.pop_front();
+	return pNf.duplicate();
+}
+
+
+} // namespace Poco
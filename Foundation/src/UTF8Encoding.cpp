@@ -36,11 +36,49 @@
 
 #include "Poco/UTF8Encoding.h"
 #include "Poco/String.h"
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define POCO_HAVE_UTF8_SSE2
+#endif
 
 
 namespace Poco {
 
 
+namespace
+{
+	inline int legalSequenceLength(const unsigned char* bytes, std::size_t length)
+		/// Returns the length of the legal UTF-8 sequence at the
+		/// beginning of bytes, or 0 if the sequence is illegal or
+		/// incomplete. Gives the same results as isLegal().
+	{
+		unsigned char c = bytes[0];
+		if (c < 0x80) return 1;
+		if (c < 0xC2) return 0;
+		if (c < 0xE0)
+		{
+			return length >= 2 && (bytes[1] & 0xC0) == 0x80 ? 2 : 0;
+		}
+		if (c < 0xF0)
+		{
+			if (length < 3) return 0;
+			unsigned char lo = c == 0xE0 ? 0xA0 : 0x80;
+			unsigned char hi = c == 0xED ? 0x9F : 0xBF;
+			return bytes[1] >= lo && bytes[1] <= hi && (bytes[2] & 0xC0) == 0x80 ? 3 : 0;
+		}
+		if (c < 0xF5)
+		{
+			if (length < 4) return 0;
+			unsigned char lo = c == 0xF0 ? 0x90 : 0x80;
+			unsigned char hi = c == 0xF4 ? 0x8F : 0xBF;
+			return bytes[1] >= lo && bytes[1] <= hi && (bytes[2] & 0xC0) == 0x80 && (bytes[3] & 0xC0) == 0x80 ? 4 : 0;
+		}
+		return 0;
+	}
+}
+
+
 const char* UTF8Encoding::_names[] =
 {
 	"UTF-8",
@@ -269,4 +307,44 @@ bool UTF8Encoding::isLegal(const unsigned char *bytes, int length)
 }
 
 
+std::size_t UTF8Encoding::asciiLength(const char* bytes, std::size_t length)
+{
+	std::size_t i = 0;
+#if defined(POCO_HAVE_UTF8_SSE2)
+	for (; i + 16 <= length; i += 16)
+	{
+		if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i))) != 0) break;
+	}
+#endif
+	for (; i + 8 <= length; i += 8)
+	{
+		UInt64 v;
+		std::memcpy(&v, bytes + i, sizeof(v));
+		if (v & 0x8080808080808080ULL) break;
+	}
+	while (i < length && static_cast<unsigned char>(bytes[i]) < 0x80) ++i;
+	return i;
+}
+
+
+std::size_t UTF8Encoding::legalLength(const char* bytes, std::size_t length)
+{
+	std::size_t i = 0;
+	while (i < length)
+	{
+		if (static_cast<unsigned char>(bytes[i]) < 0x80)
+		{
+			i += asciiLength(bytes + i, length - i);
+		}
+		else
+		{
+			int n = legalSequenceLength(reinterpret_cast<const unsigned char*>(bytes + i), length - i);
+			if (n == 0) break;
+			i += n;
+		}
+	}
+	return i;
+}
+
+
 } // namespace Poco
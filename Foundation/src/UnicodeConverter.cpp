@@ -49,18 +49,116 @@
 namespace Poco {
 
 
-void UnicodeConverter::convert(const std::string& utf8String, UTF32String& utf32String)
+namespace
 {
-	utf32String.clear();
-	UTF8Encoding utf8Encoding;
-	TextIterator it(utf8String, utf8Encoding);
-	TextIterator end(utf8String);
+	inline int decodeLegal(const unsigned char*& bytes)
+		/// Decodes a legal UTF-8 sequence (see UTF8Encoding::legalLength())
+		/// and advances bytes past it.
+	{
+		int cc = *bytes++;
+		if (cc < 0x80)
+		{
+			return cc;
+		}
+		else if (cc < 0xE0)
+		{
+			return ((cc & 0x1F) << 6) | (*bytes++ & 0x3F);
+		}
+		else if (cc < 0xF0)
+		{
+			cc = ((cc & 0x0F) << 12) | ((bytes[0] & 0x3F) << 6) | (bytes[1] & 0x3F);
+			bytes += 2;
+			return cc;
+		}
+		else
+		{
+			cc = ((cc & 0x07) << 18) | ((bytes[0] & 0x3F) << 12) | ((bytes[1] & 0x3F) << 6) | (bytes[2] & 0x3F);
+			bytes += 3;
+			return cc;
+		}
+	}
+
+	inline void append(UTF16String& utf16String, int cc)
+	{
+		if (cc <= 0xffff)
+		{
+			utf16String += (UTF16Char) cc;
+		}
+		else
+		{
+			cc -= 0x10000;
+			utf16String += (UTF16Char) ((cc >> 10) & 0x3ff) | 0xd800;
+			utf16String += (UTF16Char) (cc & 0x3ff) | 0xdc00;
+		}
+	}
 
-	while (it != end)
+	inline void append(UTF32String& utf32String, int cc)
 	{
-		int cc = *it++;
 		utf32String += (UTF32Char) cc;
 	}
+
+	inline void appendUTF8(std::string& utf8String, UInt32 cc)
+		/// Appends the UTF-8 sequence for cc, which must
+		/// not be greater than 0x10FFFF.
+	{
+		char buffer[4];
+		int n;
+		if (cc < 0x800)
+		{
+			buffer[0] = (char) (0xC0 | (cc >> 6));
+			buffer[1] = (char) (0x80 | (cc & 0x3F));
+			n = 2;
+		}
+		else if (cc < 0x10000)
+		{
+			buffer[0] = (char) (0xE0 | (cc >> 12));
+			buffer[1] = (char) (0x80 | ((cc >> 6) & 0x3F));
+			buffer[2] = (char) (0x80 | (cc & 0x3F));
+			n = 3;
+		}
+		else
+		{
+			buffer[0] = (char) (0xF0 | (cc >> 18));
+			buffer[1] = (char) (0x80 | ((cc >> 12) & 0x3F));
+			buffer[2] = (char) (0x80 | ((cc >> 6) & 0x3F));
+			buffer[3] = (char) (0x80 | (cc & 0x3F));
+			n = 4;
+		}
+		utf8String.append(buffer, n);
+	}
+
+	template <class S>
+	void fromUTF8(const std::string& utf8String, S& result)
+		/// Converts the legal part of utf8String directly, skipping
+		/// runs of ASCII characters. The rest, starting with the first
+		/// illegal sequence, is converted using a TextIterator.
+	{
+		result.clear();
+		result.reserve(utf8String.size());
+		const unsigned char* begin = (const unsigned char*) utf8String.data();
+		const unsigned char* it    = begin;
+		const unsigned char* end   = begin + UTF8Encoding::legalLength(utf8String.data(), utf8String.size());
+		while (it < end)
+		{
+			const unsigned char* ascii = it + UTF8Encoding::asciiLength((const char*) it, end - it);
+			result.append(it, ascii);
+			it = ascii;
+			if (it < end) append(result, decodeLegal(it));
+		}
+		if (static_cast<std::size_t>(end - begin) < utf8String.size())
+		{
+			UTF8Encoding utf8Encoding;
+			TextIterator tit(utf8String.begin() + (end - begin), utf8String.end(), utf8Encoding);
+			TextIterator tend(utf8String);
+			while (tit != tend) append(result, *tit++);
+		}
+	}
+}
+
+
+void UnicodeConverter::convert(const std::string& utf8String, UTF32String& utf32String)
+{
+	fromUTF8(utf8String, utf32String);
 }
 
 
@@ -90,24 +188,7 @@ void UnicodeConverter::convert(const char* utf8String, UTF32String& utf32String)
 
 void UnicodeConverter::convert(const std::string& utf8String, UTF16String& utf16String)
 {
-	utf16String.clear();
-	UTF8Encoding utf8Encoding;
-	TextIterator it(utf8String, utf8Encoding);
-	TextIterator end(utf8String);
-	while (it != end) 
-	{
-		int cc = *it++;
-		if (cc <= 0xffff)
-		{
-			utf16String += (UTF16Char) cc;
-		}
-		else
-		{
-			cc -= 0x10000;
-			utf16String += (UTF16Char) ((cc >> 10) & 0x3ff) | 0xd800;
-			utf16String += (UTF16Char) (cc & 0x3ff) | 0xdc00;
-		}
-	}
+	fromUTF8(utf8String, utf16String);
 }
 
 
@@ -137,37 +218,86 @@ void UnicodeConverter::convert(const char* utf8String, UTF16String& utf16String)
 
 void UnicodeConverter::convert(const UTF16String& utf16String, std::string& utf8String)
 {
-	utf8String.clear();
-	UTF8Encoding utf8Encoding;
-	UTF16Encoding utf16Encoding;
-	TextConverter converter(utf16Encoding, utf8Encoding);
-	converter.convert(utf16String.data(), (int) utf16String.length() * sizeof(UTF16Char), utf8String);
+	convert(utf16String.data(), utf16String.length(), utf8String);
 }
 
 
 void UnicodeConverter::convert(const UTF32String& utf32String, std::string& utf8String)
 {
-	utf8String.clear();
-	UTF8Encoding utf8Encoding;
-	UTF32Encoding utf32Encoding;
-	TextConverter converter(utf32Encoding, utf8Encoding);
-	converter.convert(utf32String.data(), (int) utf32String.length() * sizeof(UTF32Char), utf8String);
+	convert(utf32String.data(), utf32String.length(), utf8String);
 }
 
 
 void UnicodeConverter::convert(const UTF16Char* utf16String,  std::size_t length, std::string& utf8String)
 {
 	utf8String.clear();
-	UTF8Encoding utf8Encoding;
-	UTF16Encoding utf16Encoding;
-	TextConverter converter(utf16Encoding, utf8Encoding);
-	converter.convert(utf16String, (int) length * sizeof(UTF16Char), utf8String);
+	utf8String.reserve(length);
+	const UTF16Char* it  = utf16String;
+	const UTF16Char* end = utf16String + length;
+	while (it < end)
+	{
+		UInt32 cc = (UInt16) *it;
+		if (cc < 0x80)
+		{
+			const UTF16Char* ascii = it + 1;
+			while (ascii < end && (UInt16) *ascii < 0x80) ++ascii;
+			utf8String.append(it, ascii);
+			it = ascii;
+		}
+		else if (cc < 0xd800 || cc >= 0xe000)
+		{
+			appendUTF8(utf8String, cc);
+			++it;
+		}
+		else if (cc < 0xdc00 && end - it >= 2 && (UInt16) it[1] >= 0xdc00 && (UInt16) it[1] < 0xe000)
+		{
+			appendUTF8(utf8String, ((cc & 0x3ff) << 10) + ((UInt16) it[1] & 0x3ff) + 0x10000);
+			it += 2;
+		}
+		else break;
+	}
+	if (it < end)
+	{
+		// unpaired surrogates are handled by UTF16Encoding
+		UTF8Encoding utf8Encoding;
+		UTF16Encoding utf16Encoding;
+		TextConverter converter(utf16Encoding, utf8Encoding);
+		converter.convert(it, (int) (end - it) * sizeof(UTF16Char), utf8String);
+	}
 }
 
 
 void UnicodeConverter::convert(const UTF32Char* utf32String,  std::size_t length, std::string& utf8String)
 {
-	toUTF8(UTF32String(utf32String, length), utf8String);
+	utf8String.clear();
+	utf8String.reserve(length);
+	const UTF32Char* it  = utf32String;
+	const UTF32Char* end = utf32String + length;
+	while (it < end)
+	{
+		UInt32 cc = (UInt32) *it;
+		if (cc < 0x80)
+		{
+			const UTF32Char* ascii = it + 1;
+			while (ascii < end && (UInt32) *ascii < 0x80) ++ascii;
+			utf8String.append(it, ascii);
+			it = ascii;
+		}
+		else if (cc <= 0x10FFFF)
+		{
+			appendUTF8(utf8String, cc);
+			++it;
+		}
+		else break;
+	}
+	if (it < end)
+	{
+		// invalid characters are handled by UTF32Encoding
+		UTF8Encoding utf8Encoding;
+		UTF32Encoding utf32Encoding;
+		TextConverter converter(utf32Encoding, utf8Encoding);
+		converter.convert(it, (int) (end - it) * sizeof(UTF32Char), utf8String);
+	}
 }
 
 
@@ -0,0 +1,527 @@
+//
+// WorkStealingThreadPool.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  WorkStealingThreadPool
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/WorkStealingThreadPool.h"
+#include "Poco/Runnable.h"
+#include "Poco/Random.h"
+#include "Poco/Environment.h"
+#include "Poco/ThreadLocal.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Exception.h"
+#include <deque>
+#include <sstream>
+
+
+namespace Poco {
+
+
+struct WorkStealingTask
+{
+	Runnable*        pTarget;
+	TaskGroup*       pGroup;
+	Thread::Priority priority;
+	std::string      name;
+};
+
+
+class WorkStealingWorker: public Runnable
+{
+public:
+	WorkStealingWorker(WorkStealingThreadPool& pool, const std::string& name, int stackSize);
+	~WorkStealingWorker();
+
+	void start();
+	void join();
+	void push(const WorkStealingTask& task);
+	bool pop(WorkStealingTask& task);
+	bool steal(WorkStealingTask& task);
+	int random(int n);
+	Thread& thread();
+	const std::string& name() const;
+	void run();
+
+private:
+	typedef std::deque<WorkStealingTask> TaskDeque;
+
+	WorkStealingThreadPool& _pool;
+	std::string             _name;
+	TaskDeque               _tasks;
+	Random                  _random;
+	Thread                  _thread;
+	FastMutex               _mutex;
+};
+
+
+WorkStealingWorker::WorkStealingWorker(WorkStealingThreadPool& pool, const std::string& name, int stackSize):
+	_pool(pool),
+	_name(name),
+	_thread(name)
+{
+	poco_assert_dbg (stackSize >= 0);
+	_thread.setStackSize(stackSize);
+}
+
+
+WorkStealingWorker::~WorkStealingWorker()
+{
+}
+
+
+void WorkStealingWorker::start()
+{
+	_thread.start(*this);
+}
+
+
+void WorkStealingWorker::join()
+{
+	_thread.join();
+}
+
+
+void WorkStealingWorker::push(const WorkStealingTask& task)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_tasks.push_back(task);
+}
+
+
+bool WorkStealingWorker::pop(WorkStealingTask& task)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (_tasks.empty()) return false;
+	task = _tasks.back();
+	_tasks.pop_back();
+	return true;
+}
+
+
+bool WorkStealingWorker::steal(WorkStealingTask& task)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (_tasks.empty()) return false;
+	task = _tasks.front();
+	_tasks.pop_front();
+	return true;
+}
+
+
+inline int WorkStealingWorker::random(int n)
+{
+	// only called from the worker's own thread
+	return static_cast<int>(_random.next(static_cast<UInt32>(n)));
+}
+
+
+inline Thread& WorkStealingWorker::thread()
+{
+	return _thread;
+}
+
+
+inline const std::string& WorkStealingWorker::name() const
+{
+	return _name;
+}
+
+
+void WorkStealingWorker::run()
+{
+	for (;;)
+	{
+		WorkStealingTask task;
+		if (_pool.takeTask(this, task))
+		{
+			_pool.runTask(*this, task);
+			ThreadLocalStorage::clear();
+		}
+		else if (!_pool.waitForTask())
+		{
+			break;
+		}
+	}
+}
+
+
+WorkStealingThreadPool::WorkStealingThreadPool(int threads, int stackSize):
+	_stopped(false)
+{
+	init(threads, stackSize);
+}
+
+
+WorkStealingThreadPool::WorkStealingThreadPool(const std::string& name, int threads, int stackSize):
+	_name(name),
+	_stopped(false)
+{
+	init(threads, stackSize);
+}
+
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		_stopped = true;
+		_taskAvailable.broadcast();
+	}
+	for (WorkerVec::iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		(*it)->join();
+		delete *it;
+	}
+}
+
+
+void WorkStealingThreadPool::init(int threads, int stackSize)
+{
+	poco_assert (threads >= 0);
+
+	if (threads == 0) threads = static_cast<int>(Environment::processorCount());
+	if (threads == 0) threads = 1;
+
+	_workers.reserve(threads);
+	for (int i = 0; i < threads; ++i)
+	{
+		std::ostringstream name;
+		name << _name << "[#" << i + 1 << "]";
+		_workers.push_back(new WorkStealingWorker(*this, name.str(), stackSize));
+	}
+	for (WorkerVec::iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		(*it)->start();
+	}
+}
+
+
+void WorkStealingThreadPool::start(Runnable& target)
+{
+	enqueue(target, 0, Thread::PRIO_NORMAL, std::string());
+}
+
+
+void WorkStealingThreadPool::start(Runnable& target, const std::string& name)
+{
+	enqueue(target, 0, Thread::PRIO_NORMAL, name);
+}
+
+
+void WorkStealingThreadPool::startWithPriority(Thread::Priority priority, Runnable& target)
+{
+	enqueue(target, 0, priority, std::string());
+}
+
+
+void WorkStealingThreadPool::startWithPriority(Thread::Priority priority, Runnable& target, const std::string& name)
+{
+	enqueue(target, 0, priority, name);
+}
+
+
+void WorkStealingThreadPool::joinAll()
+{
+	poco_assert (!currentWorker());
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	while (_pending.value() > 0)
+	{
+		_allDone.wait(_mutex);
+	}
+}
+
+
+void WorkStealingThreadPool::enqueue(Runnable& target, TaskGroup* pGroup, Thread::Priority priority, const std::string& name)
+{
+	WorkStealingTask task;
+	task.pTarget  = &target;
+	task.pGroup   = pGroup;
+	task.priority = priority;
+	task.name     = name;
+
+	if (pGroup) ++pGroup->_pending;
+	++_pending;
+
+	WorkStealingWorker* pWorker = currentWorker();
+	if (!pWorker)
+	{
+		UInt32 next = static_cast<UInt32>(++_next);
+		pWorker = _workers[next % _workers.size()];
+	}
+	pWorker->push(task);
+	++_queued;
+
+	// A worker going to sleep increments _idle before it
+	// checks _queued, so at least one of us sees the other.
+	if (_idle.value() > 0)
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		_taskAvailable.signal();
+	}
+}
+
+
+WorkStealingWorker* WorkStealingThreadPool::currentWorker() const
+{
+	Thread* pThread = Thread::current();
+	if (pThread)
+	{
+		for (WorkerVec::const_iterator it = _workers.begin(); it != _workers.end(); ++it)
+		{
+			if (&(*it)->thread() == pThread) return *it;
+		}
+	}
+	return 0;
+}
+
+
+bool WorkStealingThreadPool::takeTask(WorkStealingWorker* pWorker, WorkStealingTask& task)
+{
+	if (pWorker && pWorker->pop(task))
+	{
+		--_queued;
+		return true;
+	}
+	if (_queued.value() == 0) return false;
+
+	int n = static_cast<int>(_workers.size());
+	int victim = pWorker ? pWorker->random(n) : 0;
+	for (int i = 0; i < n; ++i, ++victim)
+	{
+		WorkStealingWorker* pVictim = _workers[victim % n];
+		if (pVictim != pWorker && pVictim->steal(task))
+		{
+			--_queued;
+			return true;
+		}
+	}
+	return false;
+}
+
+
+void WorkStealingThreadPool::runTask(WorkStealingWorker& worker, WorkStealingTask& task)
+{
+	++_busy;
+
+	Thread& thread = worker.thread();
+	std::string prevName;
+	Thread::Priority prevPriority = thread.getPriority();
+	if (!task.name.empty())
+	{
+		prevName = thread.getName();
+		std::string fullName(task.name);
+		fullName.append(" (");
+		fullName.append(worker.name());
+		fullName.append(")");
+		thread.setName(fullName);
+	}
+	if (task.priority != prevPriority)
+	{
+		thread.setPriority(task.priority);
+	}
+	try
+	{
+		task.pTarget->run();
+	}
+	catch (Exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+	catch (std::exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+	catch (...)
+	{
+		ErrorHandler::handle();
+	}
+	if (!task.name.empty())
+	{
+		thread.setName(prevName);
+	}
+	if (task.priority != prevPriority)
+	{
+		thread.setPriority(prevPriority);
+	}
+
+	--_busy;
+	if (task.pGroup) task.pGroup->taskDone();
+	if (--_pending == 0)
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		_allDone.broadcast();
+	}
+}
+
+
+bool WorkStealingThreadPool::waitForTask()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	++_idle;
+	while (_queued.value() == 0 && !_stopped)
+	{
+		_taskAvailable.wait(_mutex);
+	}
+	--_idle;
+	return _queued.value() > 0 || !_stopped;
+}
+
+
+void WorkStealingThreadPool::waitForTask(TaskGroup& group)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	// Woken up by enqueue(), or by TaskGroup::taskDone()
+	// when the last runnable of the group has completed.
+	++_idle;
+	++group._helpers;
+	while (_queued.value() == 0 && group._pending.value() > 0 && !_stopped)
+	{
+		_taskAvailable.wait(_mutex);
+	}
+	--group._helpers;
+	--_idle;
+}
+
+
+TaskGroup::TaskGroup(WorkStealingThreadPool& pool):
+	_pool(pool),
+	_helpers(0)
+{
+}
+
+
+TaskGroup::~TaskGroup()
+{
+	wait();
+}
+
+
+void TaskGroup::start(Runnable& target)
+{
+	_pool.enqueue(target, this, Thread::PRIO_NORMAL, std::string());
+}
+
+
+void TaskGroup::wait()
+{
+	WorkStealingWorker* pWorker = _pool.currentWorker();
+	if (pWorker)
+	{
+		// Do not block a worker thread, but help
+		// running queued tasks instead.
+		while (_pending.value() > 0)
+		{
+			WorkStealingTask task;
+			if (_pool.takeTask(pWorker, task))
+			{
+				_pool.runTask(*pWorker, task);
+			}
+			else
+			{
+				_pool.waitForTask(*this);
+			}
+		}
+	}
+	// Locking the mutex synchronizes with taskDone(), so the
+	// group cannot be destroyed while taskDone() still uses it.
+	FastMutex::ScopedLock lock(_mutex);
+	while (_pending.value() > 0)
+	{
+		_done.wait(_mutex);
+	}
+}
+
+
+void TaskGroup::taskDone()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (--_pending == 0)
+	{
+		_done.broadcast();
+
+		FastMutex::ScopedLock poolLock(_pool._mutex);
+		if (_helpers > 0) _pool._taskAvailable.broadcast();
+	}
+}
+
+
+class WorkStealingThreadPoolSingletonHolder
+{
+public:
+	WorkStealingThreadPoolSingletonHolder()
+	{
+		_pPool = 0;
+	}
+	~WorkStealingThreadPoolSingletonHolder()
+	{
+		delete _pPool;
+	}
+	WorkStealingThreadPool* pool()
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		if (!_pPool)
+		{
+			_pPool = new WorkStealingThreadPool("default");
+		}
+		return _pPool;
+	}
+
+private:
+	WorkStealingThreadPool* _pPool;
+	FastMutex               _mutex;
+};
+
+
+namespace
+{
+	static WorkStealingThreadPoolSingletonHolder sh;
+}
+
+
+WorkStealingThreadPool& WorkStealingThreadPool::defaultPool()
+{
+	return *sh.pool();
+}
+
+
+} // namespace Poco
@@ -74,6 +74,15 @@ namespace
 			testVoidIn(this, &ActiveObject::testVoidInImpl)
 		{
 		}
+
+		ActiveObject(std::size_t queueCapacity):
+			ActiveDispatcher(Thread::PRIO_NORMAL, queueCapacity),
+			testMethod(this, &ActiveObject::testMethodImpl),
+			testVoid(this, &ActiveObject::testVoidImpl),
+			testVoidInOut(this, &ActiveObject::testVoidInOutImpl),
+			testVoidIn(this, &ActiveObject::testVoidInImpl)
+		{
+		}
 		
 		~ActiveObject()
 		{
@@ -230,6 +239,27 @@ void ActiveDispatcherTest::testVoidIn()
 }
 
 
+void ActiveDispatcherTest::testLockFreeQueue()
+{
+	ActiveObject activeObj(4);
+	ActiveResult<int> result1 = activeObj.testMethod(1);
+	ActiveResult<int> result2 = activeObj.testMethod(2);
+	ActiveResult<int> result3 = activeObj.testMethod(100);
+	assert (!result1.available());
+	assert (!result2.available());
+	activeObj.cont();
+	result1.wait();
+	assert (result1.available());
+	assert (result1.data() == 1);
+	activeObj.cont();
+	result2.wait();
+	assert (result2.data() == 2);
+	result3.wait();
+	assert (result3.failed());
+	assert (result3.error() == "n == 100");
+}
+
+
 void ActiveDispatcherTest::setUp()
 {
 }
@@ -251,6 +281,7 @@ CppUnit::Test* ActiveDispatcherTest::suite()
 	CppUnit_addTest(pSuite, ActiveDispatcherTest, testVoid);
 	CppUnit_addTest(pSuite, ActiveDispatcherTest, testVoidIn);
 	CppUnit_addTest(pSuite, ActiveDispatcherTest, testVoidInOut);
+	CppUnit_addTest(pSuite, ActiveDispatcherTest, testLockFreeQueue);
 
 	return pSuite;
 }
@@ -66,6 +66,7 @@ public:
 	void testVoid();
 	void testVoidIn();
 	void testVoidInOut();
+	void testLockFreeQueue();
 
 	void setUp();
 	void tearDown();
@@ -177,6 +177,92 @@ void Base64Test::testEncodeDecode()
 }
 
 
+void Base64Test::testBuffer()
+{
+	std::string src;
+	for (int i = 0; i < 300; ++i) src += char(i*7);
+	for (std::size_t n = 0; n < src.size(); ++n)
+	{
+		std::string data(src, 0, n);
+		std::ostringstream str;
+		Base64Encoder encoder(str);
+		encoder.rdbuf()->setLineLength(0);
+		for (std::size_t i = 0; i < n; ++i) encoder.put(data[i]);
+		encoder.close();
+		std::string encoded = Base64Encoder::encode(data);
+		assert (encoded == str.str());
+		assert (encoded.size() == Base64Encoder::encodedLength(n));
+		assert (Base64Decoder::decode(encoded) == data);
+	}
+	assert (Base64Decoder::decode("QUJ\r\nDRE\r\n VG") == "ABCDEF");
+	assert (Base64Decoder::decode("AAECAw==AAE=") == std::string("\00\01\02\03\00\01", 6));
+	assert (Base64Decoder::decode("") == "");
+	try
+	{
+		Base64Decoder::decode("QUJD#REVG");
+		fail("invalid character - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+	try
+	{
+		Base64Decoder::decode("QUJDREV");
+		fail("incomplete group - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+}
+
+
+void Base64Test::testStreamBlocks()
+{
+	std::string src;
+	for (int i = 0; i < 10000; ++i) src += char(i*13 + i/256);
+	int lineLengths[] = {0, 4, 7, 72, 76};
+	for (int l = 0; l < 5; ++l)
+	{
+		std::ostringstream expected;
+		Base64Encoder encoder1(expected);
+		encoder1.rdbuf()->setLineLength(lineLengths[l]);
+		for (std::size_t i = 0; i < src.size(); ++i) encoder1.put(src[i]);
+		encoder1.close();
+
+		std::stringstream str;
+		Base64Encoder encoder2(str);
+		encoder2.rdbuf()->setLineLength(lineLengths[l]);
+		std::size_t pos = 0;
+		for (std::size_t chunk = 1; pos < src.size(); chunk = chunk*3 + 1)
+		{
+			std::size_t n = chunk < src.size() - pos ? chunk : src.size() - pos;
+			encoder2.write(src.data() + pos, n);
+			pos += n;
+		}
+		encoder2.close();
+		assert (str.str() == expected.str());
+
+		Base64Decoder decoder(str);
+		std::string result;
+		char buffer[5000];
+		for (std::streamsize chunk = 1; decoder.read(buffer, chunk) || decoder.gcount() > 0; chunk = chunk*2 + 1)
+		{
+			result.append(buffer, decoder.gcount());
+			if (chunk > 1000) chunk = 1;
+		}
+		assert (result == src);
+	}
+
+	// reading must not consume more of the underlying stream than needed
+	std::istringstream istr("QUJD\r\nREVG!");
+	Base64Decoder decoder(istr);
+	char buffer[6];
+	decoder.read(buffer, 6);
+	assert (std::string(buffer, 6) == "ABCDEF");
+	assert (istr.get() == '!');
+}
+
+
 void Base64Test::setUp()
 {
 }
@@ -194,6 +280,8 @@ CppUnit::Test* Base64Test::suite()
 	CppUnit_addTest(pSuite, Base64Test, testEncoder);
 	CppUnit_addTest(pSuite, Base64Test, testDecoder);
 	CppUnit_addTest(pSuite, Base64Test, testEncodeDecode);
+	CppUnit_addTest(pSuite, Base64Test, testBuffer);
+	CppUnit_addTest(pSuite, Base64Test, testStreamBlocks);
 
 	return pSuite;
 }
@@ -39,6 +39,8 @@
 #include "Poco/FunctionDelegate.h"
 #include "Poco/Thread.h"
 #include "Poco/Exception.h"
+#include "Poco/Runnable.h"
+#include "Poco/AtomicCounter.h"
 
 
 using namespace Poco;
@@ -47,6 +49,121 @@ using namespace Poco;
 #define LARGEINC 100
 
 
+namespace
+{
+	class Notifier: public Runnable
+	{
+	public:
+		Notifier(BasicEvent<int>& event): _event(event)
+		{
+		}
+
+		void run()
+		{
+			int tmp = 0;
+			for (int i = 0; i < 20000; ++i)
+			{
+				_event.notify(this, tmp);
+			}
+		}
+
+	private:
+		BasicEvent<int>& _event;
+	};
+
+	class Counter
+	{
+	public:
+		void onEvent(const void* pSender, int& i)
+		{
+			++_count;
+		}
+
+		int count() const
+		{
+			return _count.value();
+		}
+
+	private:
+		AtomicCounter _count;
+	};
+
+	class SelfRemover
+	{
+	public:
+		SelfRemover(BasicEvent<int>& event, Counter& other): _event(event), _other(other), _count(0)
+		{
+		}
+
+		void onEvent(const void* pSender, int& i)
+		{
+			++_count;
+			_event -= delegate(this, &SelfRemover::onEvent);
+			_event += delegate(&_other, &Counter::onEvent);
+		}
+
+		int count() const
+		{
+			return _count;
+		}
+
+	private:
+		BasicEvent<int>& _event;
+		Counter& _other;
+		int _count;
+	};
+
+	class CountingStrategy: public DefaultStrategy<int, AbstractDelegate<int> >
+		/// Counts the existing strategy objects.
+	{
+	public:
+		CountingStrategy()
+		{
+			++_instances;
+		}
+
+		CountingStrategy(const CountingStrategy& strategy): DefaultStrategy<int, AbstractDelegate<int> >(strategy)
+		{
+			++_instances;
+		}
+
+		~CountingStrategy()
+		{
+			--_instances;
+		}
+
+		static int instances()
+		{
+			return _instances;
+		}
+
+	private:
+		static int _instances;
+	};
+
+	int CountingStrategy::_instances = 0;
+
+	typedef AbstractEvent<int, CountingStrategy, AbstractDelegate<int> > CountingEvent;
+
+	class Resubscriber
+	{
+	public:
+		Resubscriber(CountingEvent& event): _event(event)
+		{
+		}
+
+		void onEvent(const void* pSender, int& i)
+		{
+			_event -= delegate(this, &Resubscriber::onEvent);
+			_event += delegate(this, &Resubscriber::onEvent);
+		}
+
+	private:
+		CountingEvent& _event;
+	};
+}
+
+
 BasicEventTest::BasicEventTest(const std::string& name): CppUnit::TestCase(name)
 {
 }
@@ -337,6 +454,68 @@ void BasicEventTest::testAsyncNotify()
 	assert (_count == LARGEINC);
 }
 
+void BasicEventTest::testChangeInNotify()
+{
+	BasicEvent<int> event;
+	Counter counter;
+	SelfRemover remover(event, counter);
+	event += delegate(&remover, &SelfRemover::onEvent);
+	int tmp = 0;
+	event.notify(this, tmp);
+	// changes become effective with the next notify()
+	assert (remover.count() == 1);
+	assert (counter.count() == 0);
+	event.notify(this, tmp);
+	assert (remover.count() == 1);
+	assert (counter.count() == 1);
+}
+
+
+void BasicEventTest::testConcurrentNotify()
+{
+	BasicEvent<int> event;
+	Counter counter;
+	event += delegate(&counter, &Counter::onEvent);
+
+	Notifier n1(event);
+	Notifier n2(event);
+	Thread t1;
+	Thread t2;
+	t1.start(n1);
+	t2.start(n2);
+	Counter other;
+	for (int i = 0; i < 1000; ++i)
+	{
+		event += delegate(&other, &Counter::onEvent);
+		event -= delegate(&other, &Counter::onEvent);
+	}
+	t1.join();
+	t2.join();
+	assert (counter.count() == 40000);
+	event.clear();
+	assert (event.empty());
+}
+
+
+void BasicEventTest::testRetiredStrategies()
+{
+	{
+		CountingEvent event;
+		Resubscriber subscriber(event);
+		event += delegate(&subscriber, &Resubscriber::onEvent);
+		int tmp = 0;
+		for (int i = 0; i < 1000; ++i)
+		{
+			event.notify(this, tmp);
+			// the strategies replaced during notify() have been
+			// deleted when the notification was complete
+			assert (CountingStrategy::instances() == 1);
+		}
+	}
+	assert (CountingStrategy::instances() == 0);
+}
+
+
 void BasicEventTest::onStaticVoid(const void* pSender)
 {
 	BasicEventTest* p = const_cast<BasicEventTest*>(reinterpret_cast<const BasicEventTest*>(pSender));
@@ -456,5 +635,8 @@ CppUnit::Test* BasicEventTest::suite()
 	CppUnit_addTest(pSuite, BasicEventTest, testOverwriteDelegate);
 	CppUnit_addTest(pSuite, BasicEventTest, testAsyncNotify);
 	CppUnit_addTest(pSuite, BasicEventTest, testNullMutex);
+	CppUnit_addTest(pSuite, BasicEventTest, testChangeInNotify);
+	CppUnit_addTest(pSuite, BasicEventTest, testConcurrentNotify);
+	CppUnit_addTest(pSuite, BasicEventTest, testRetiredStrategies);
 	return pSuite;
 }
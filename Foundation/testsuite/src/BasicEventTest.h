@@ -66,6 +66,9 @@ public:
 	void testOverwriteDelegate();
 	void testAsyncNotify();
 	void testNullMutex();
+	void testChangeInNotify();
+	void testConcurrentNotify();
+	void testRetiredStrategies();
 	
 	void setUp();
 	void tearDown();
@@ -0,0 +1,546 @@
+//
+// BinaryFileChannelTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "BinaryFileChannelTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/BinaryFileChannel.h"
+#include "Poco/BinaryLogReader.h"
+#include "Poco/FileChannel.h"
+#include "Poco/FormattingChannel.h"
+#include "Poco/PatternFormatter.h"
+#include "Poco/Message.h"
+#include "Poco/Path.h"
+#include "Poco/File.h"
+#include "Poco/FileStream.h"
+#include "Poco/DirectoryIterator.h"
+#include "Poco/Timestamp.h"
+#include "Poco/DateTimeFormatter.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Exception.h"
+#include <sstream>
+#include <iostream>
+#include <cstring>
+
+
+using Poco::BinaryFileChannel;
+using Poco::BinaryLogReader;
+using Poco::FileChannel;
+using Poco::Message;
+using Poco::Path;
+using Poco::File;
+using Poco::FileInputStream;
+using Poco::DirectoryIterator;
+using Poco::Timestamp;
+using Poco::DateTimeFormatter;
+using Poco::AutoPtr;
+
+
+namespace
+{
+	std::string readFile(const std::string& path)
+	{
+		FileInputStream istr(path);
+		std::ostringstream ostr;
+		ostr << istr.rdbuf();
+		return ostr.str();
+	}
+
+	int countRecords(const std::string& data, unsigned char type)
+		/// Counts the records of the given type in a binary log
+		/// file without rotation header lines.
+	{
+		int n = 0;
+		std::string::size_type pos = 0;
+		while (pos < data.size())
+		{
+			unsigned char marker = static_cast<unsigned char>(data[pos++]);
+			Poco::UInt64 size = 0;
+			int shift = 0;
+			unsigned char c;
+			do
+			{
+				c = static_cast<unsigned char>(data[pos++]);
+				size |= static_cast<Poco::UInt64>(c & 0x7F) << shift;
+				shift += 7;
+			}
+			while (c & 0x80);
+			if (marker == type) ++n;
+			pos += static_cast<std::string::size_type>(size);
+			while (pos < data.size() && (data[pos] == '\r' || data[pos] == '\n')) ++pos;
+		}
+		return n;
+	}
+}
+
+
+BinaryFileChannelTest::BinaryFileChannelTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+BinaryFileChannelTest::~BinaryFileChannelTest()
+{
+}
+
+
+void BinaryFileChannelTest::testEncode()
+{
+	Message msg1("Source", "Text", Message::PRIO_WARNING, "File.cpp", 42);
+	msg1.setThread("Thread");
+	msg1.setTid(12);
+	msg1.setPid(12345);
+	Message msg2("", std::string(300, 'x'), Message::PRIO_TRACE);
+	msg2.setTime(Timestamp(0));
+
+	std::string name = filename();
+	try
+	{
+		AutoPtr<BinaryFileChannel> pChannel = new BinaryFileChannel(name);
+		pChannel->open();
+		pChannel->log(msg1);
+		pChannel->log(msg2);
+		pChannel->close();
+
+		std::string data = readFile(name);
+		assert (static_cast<unsigned char>(data[0]) == BinaryFileChannel::STRING_RECORD);
+		assert (countRecords(data, BinaryFileChannel::STRING_RECORD) == 3);
+		assert (countRecords(data, BinaryFileChannel::MESSAGE_RECORD) == 2);
+
+		FileInputStream istr(name);
+		BinaryLogReader reader(istr);
+		Message msg;
+		assert (reader.read(msg));
+		assert (msg.getSource() == "Source");
+		assert (msg.getText() == "Text");
+		assert (msg.getPriority() == Message::PRIO_WARNING);
+		assert (msg.getTime() == msg1.getTime());
+		assert (msg.getThread() == "Thread");
+		assert (msg.getTid() == 12);
+		assert (msg.getPid() == 12345);
+		assert (std::strcmp(msg.getSourceFile(), "File.cpp") == 0);
+		assert (msg.getSourceLine() == 42);
+
+		assert (reader.read(msg));
+		assert (msg.getSource().empty());
+		assert (msg.getText() == std::string(300, 'x'));
+		assert (msg.getPriority() == Message::PRIO_TRACE);
+		assert (msg.getTime() == Timestamp(0));
+		assert (msg.getSourceFile() == 0);
+		assert (msg.getSourceLine() == 0);
+
+		assert (!reader.read(msg));
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void BinaryFileChannelTest::testLog()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<BinaryFileChannel> pChannel = new BinaryFileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_FLUSH, "false");
+		pChannel->open();
+		Message msg("source", "This is a log file entry\nwith two lines", Message::PRIO_INFORMATION);
+		for (int i = 0; i < 100; ++i)
+		{
+			pChannel->log(msg);
+		}
+		pChannel->close();
+
+		FileInputStream istr(name);
+		BinaryLogReader reader(istr);
+		Message msg2;
+		int n = 0;
+		while (reader.read(msg2))
+		{
+			assert (msg2.getText() == msg.getText());
+			assert (msg2.getSource() == "source");
+			++n;
+		}
+		assert (n == 100);
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void BinaryFileChannelTest::testStrings()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<BinaryFileChannel> pChannel = new BinaryFileChannel(name);
+		pChannel->open();
+		Message msg1("source1", "text", Message::PRIO_INFORMATION, __FILE__, 1);
+		msg1.setThread("thread1");
+		Message msg2("source2", "text", Message::PRIO_INFORMATION, __FILE__, 2);
+		msg2.setThread("thread1");
+		for (int i = 0; i < 100; ++i)
+		{
+			pChannel->log(msg1);
+			pChannel->log(msg2);
+		}
+		pChannel->log(Message("", "text", Message::PRIO_INFORMATION));
+		pChannel->close();
+
+		// source, thread and file names are written only once
+		std::string data = readFile(name);
+		assert (countRecords(data, BinaryFileChannel::STRING_RECORD) == 4);
+		assert (countRecords(data, BinaryFileChannel::MESSAGE_RECORD) == 201);
+
+		FileInputStream istr(name);
+		BinaryLogReader reader(istr);
+		Message msg;
+		for (int i = 0; i < 100; ++i)
+		{
+			assert (reader.read(msg));
+			assert (msg.getSource() == "source1");
+			assert (msg.getThread() == "thread1");
+			assert (std::strcmp(msg.getSourceFile(), __FILE__) == 0);
+			assert (msg.getSourceLine() == 1);
+			assert (reader.read(msg));
+			assert (msg.getSource() == "source2");
+			assert (msg.getThread() == "thread1");
+			assert (std::strcmp(msg.getSourceFile(), __FILE__) == 0);
+			assert (msg.getSourceLine() == 2);
+		}
+		assert (reader.read(msg));
+		assert (msg.getSource().empty());
+		assert (msg.getThread().empty());
+		assert (msg.getSourceFile() == 0);
+		assert (!reader.read(msg));
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void BinaryFileChannelTest::testLogBatch()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<BinaryFileChannel> pChannel = new BinaryFileChannel(name);
+		pChannel->open();
+		Message msgs[3];
+		msgs[0] = Message("source", "one", Message::PRIO_INFORMATION);
+		msgs[1] = Message("source", "two", Message::PRIO_WARNING);
+		msgs[2] = Message("source", "three", Message::PRIO_ERROR);
+		pChannel->logBatch(msgs, 3);
+		pChannel->log(Message("source", "four", Message::PRIO_INFORMATION));
+		pChannel->close();
+
+		FileInputStream istr(name);
+		BinaryLogReader reader(istr);
+		Message msg;
+		assert (reader.read(msg) && msg.getText() == "one");
+		assert (reader.read(msg) && msg.getText() == "two" && msg.getPriority() == Message::PRIO_WARNING);
+		assert (reader.read(msg) && msg.getText() == "three");
+		assert (reader.read(msg) && msg.getText() == "four");
+		assert (!reader.read(msg));
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void BinaryFileChannelTest::testRotate()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<BinaryFileChannel> pChannel = new BinaryFileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_ROTATION, "2 K");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		for (int i = 0; i < 200; ++i)
+		{
+			pChannel->log(msg);
+		}
+		pChannel->close();
+
+		int n = 0;
+		int i = 0;
+		File f(name + ".0");
+		assert (f.exists());
+		assert (f.getSize() >= 2048);
+		while (f.exists())
+		{
+			// every file must be readable on its own
+			FileInputStream istr(f.path());
+			BinaryLogReader reader(istr);
+			Message msg2;
+			while (reader.read(msg2))
+			{
+				assert (msg2.getText() == msg.getText());
+				assert (msg2.getSource() == "source");
+				++n;
+			}
+			f = name + "." + Poco::NumberFormatter::format(++i);
+		}
+		FileInputStream istr(name);
+		BinaryLogReader reader(istr);
+		Message msg2;
+		while (reader.read(msg2))
+		{
+			assert (msg2.getSource() == "source");
+			++n;
+		}
+		assert (n == 200);
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void BinaryFileChannelTest::testRotateInterval()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<BinaryFileChannel> pChannel = new BinaryFileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_ROTATION, "daily");
+		pChannel->open();
+		pChannel->log(Message("source", "one", Message::PRIO_INFORMATION));
+		pChannel->log(Message("source", "two", Message::PRIO_INFORMATION));
+		pChannel->close();
+
+		FileInputStream istr(name);
+		std::string line;
+		std::getline(istr, line);
+		assert (line.compare(0, 1, "#") == 0);
+		istr.seekg(0);
+		BinaryLogReader reader(istr);
+		Message msg;
+		assert (reader.read(msg) && msg.getText() == "one");
+		assert (reader.read(msg) && msg.getText() == "two");
+		assert (!reader.read(msg));
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void BinaryFileChannelTest::testInvalid()
+{
+	Message msg("source", "text", Message::PRIO_INFORMATION);
+	Message msg2;
+
+	std::istringstream istr1("This is a text log file\n");
+	BinaryLogReader reader1(istr1);
+	try
+	{
+		reader1.read(msg2);
+		fail("not a binary log file - must throw");
+	}
+	catch (Poco::DataFormatException&)
+	{
+	}
+
+	std::string name = filename();
+	try
+	{
+		AutoPtr<BinaryFileChannel> pChannel = new BinaryFileChannel(name);
+		pChannel->open();
+		pChannel->log(msg);
+		pChannel->close();
+		std::string data = readFile(name);
+		remove(name);
+
+		// cut off the line ending and the last two bytes of the message record
+		std::istringstream istr2(data.substr(0, data.size() - 3));
+		BinaryLogReader reader2(istr2);
+		reader2.read(msg2);
+		fail("truncated record - must throw");
+	}
+	catch (Poco::DataFormatException&)
+	{
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+
+	// a message record referring to string #0 without a string record
+	std::string record("\xB1\x09\x00\x06\x00\x00\x01\x00\x00\x00\x00", 11);
+	std::istringstream istr3(record);
+	BinaryLogReader reader3(istr3);
+	try
+	{
+		reader3.read(msg2);
+		fail("undefined string - must throw");
+	}
+	catch (Poco::DataFormatException&)
+	{
+	}
+}
+
+
+void BinaryFileChannelTest::benchmarkLog()
+{
+	const int N = 1000000;
+
+	std::string name = filename();
+	try
+	{
+		Message msg("HTTPServer.RequestHandler", "Request from 192.168.1.17:51234 for /index.html completed", Message::PRIO_INFORMATION, __FILE__, __LINE__);
+
+		AutoPtr<FileChannel> pFileChannel = new FileChannel(name);
+		pFileChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "64 K");
+		AutoPtr<Poco::PatternFormatter> pFormatter = new Poco::PatternFormatter("%Y-%m-%d %H:%M:%S.%i [%p] %s <%T:%I>: %t");
+		AutoPtr<Poco::FormattingChannel> pTextChannel = new Poco::FormattingChannel(pFormatter, pFileChannel);
+		pTextChannel->open();
+		Poco::Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < N; ++i)
+		{
+			pTextChannel->log(msg);
+		}
+		pTextChannel->close();
+		sw.stop();
+		std::cout << N << " text messages: " << sw.elapsed()*1000/N << " ns/message, " << File(name).getSize()/N << " bytes/message" << std::endl;
+		remove(name);
+
+		AutoPtr<BinaryFileChannel> pBinaryChannel = new BinaryFileChannel(name);
+		pBinaryChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "64 K");
+		pBinaryChannel->open();
+		sw.restart();
+		for (int i = 0; i < N; ++i)
+		{
+			pBinaryChannel->log(msg);
+		}
+		pBinaryChannel->close();
+		sw.stop();
+		std::cout << N << " binary messages: " << sw.elapsed()*1000/N << " ns/message, " << File(name).getSize()/N << " bytes/message" << std::endl;
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void BinaryFileChannelTest::setUp()
+{
+}
+
+
+void BinaryFileChannelTest::tearDown()
+{
+}
+
+
+void BinaryFileChannelTest::remove(const std::string& baseName)
+{
+	DirectoryIterator it(Path::current());
+	DirectoryIterator end;
+	std::vector<std::string> files;
+	while (it != end)
+	{
+		if (it.name().find(baseName) == 0)
+		{
+			files.push_back(it.name());
+		}
+		++it;
+	}
+	for (std::vector<std::string>::iterator it = files.begin(); it != files.end(); ++it)
+	{
+		try
+		{
+			File f(*it);
+			f.remove();
+		}
+		catch (...)
+		{
+		}
+	}
+}
+
+
+std::string BinaryFileChannelTest::filename() const
+{
+	std::string name = "log_";
+	name.append(DateTimeFormatter::format(Timestamp(), "%Y%m%d%H%M%S"));
+	name.append(".blog");
+	return name;
+}
+
+
+CppUnit::Test* BinaryFileChannelTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("BinaryFileChannelTest");
+
+	CppUnit_addTest(pSuite, BinaryFileChannelTest, testEncode);
+	CppUnit_addTest(pSuite, BinaryFileChannelTest, testLog);
+	CppUnit_addTest(pSuite, BinaryFileChannelTest, testStrings);
+	CppUnit_addTest(pSuite, BinaryFileChannelTest, testLogBatch);
+	CppUnit_addTest(pSuite, BinaryFileChannelTest, testRotate);
+	CppUnit_addTest(pSuite, BinaryFileChannelTest, testRotateInterval);
+	CppUnit_addTest(pSuite, BinaryFileChannelTest, testInvalid);
+//	CppUnit_addTest(pSuite, BinaryFileChannelTest, benchmarkLog);
+
+	return pSuite;
+}
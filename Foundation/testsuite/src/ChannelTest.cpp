@@ -35,24 +35,37 @@
 #include "CppUnit/TestSuite.h"
 #include "Poco/SplitterChannel.h"
 #include "Poco/AsyncChannel.h"
+#include "Poco/AsyncRingChannel.h"
 #include "Poco/AutoPtr.h"
 #include "Poco/Message.h"
 #include "Poco/Formatter.h"
 #include "Poco/FormattingChannel.h"
 #include "Poco/ConsoleChannel.h"
 #include "Poco/StreamChannel.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Event.h"
+#include "Poco/Mutex.h"
+#include "Poco/Exception.h"
 #include "TestChannel.h"
 #include <sstream>
+#include <vector>
 
 
 using Poco::SplitterChannel;
 using Poco::AsyncChannel;
+using Poco::AsyncRingChannel;
 using Poco::FormattingChannel;
 using Poco::ConsoleChannel;
 using Poco::StreamChannel;
 using Poco::Formatter;
 using Poco::Message;
 using Poco::AutoPtr;
+using Poco::Channel;
+using Poco::Thread;
+using Poco::Runnable;
+using Poco::Event;
+using Poco::FastMutex;
 
 
 class SimpleFormatter: public Formatter
@@ -67,6 +80,83 @@ public:
 };
 
 
+class BatchChannel: public Channel
+	/// Records the size of every batch. Blocks
+	/// in logBatch() until the gate is opened.
+{
+public:
+	BatchChannel(): _gate(false)
+	{
+	}
+
+	void log(const Message& msg)
+	{
+		logBatch(&msg, 1);
+	}
+
+	void logBatch(const Message* pMessages, std::size_t count)
+	{
+		_gate.wait();
+		FastMutex::ScopedLock lock(_mutex);
+		_batches.push_back(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			_texts.push_back(pMessages[i].getText());
+		}
+	}
+
+	void open()
+	{
+		_gate.set();
+	}
+
+	const std::vector<std::size_t>& batches() const
+	{
+		return _batches;
+	}
+
+	const std::vector<std::string>& texts() const
+	{
+		return _texts;
+	}
+
+	std::size_t messages() const
+	{
+		return _texts.size();
+	}
+
+private:
+	Event _gate;
+	FastMutex _mutex;
+	std::vector<std::size_t> _batches;
+	std::vector<std::string> _texts;
+};
+
+
+class RingLogger: public Runnable
+{
+public:
+	RingLogger(Channel& channel, int count):
+		_channel(channel),
+		_count(count)
+	{
+	}
+
+	void run()
+	{
+		Message msg("RingLogger", "message", Message::PRIO_INFORMATION);
+		for (int i = 0; i < _count; ++i)
+		{
+			_channel.log(msg);
+		}
+	}
+
+private:
+	Channel& _channel;
+	int _count;
+};
+
+
 ChannelTest::ChannelTest(const std::string& name): CppUnit::TestCase(name)
 {
 }
@@ -102,6 +192,196 @@ void ChannelTest::testAsync()
 }
 
 
+void ChannelTest::testAsyncLockFree()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	AutoPtr<AsyncChannel> pAsync = new AsyncChannel(pChannel.get());
+	pAsync->setProperty("lockFreeQueue", "true");
+	pAsync->open();
+	Message msg;
+	pAsync->log(msg);
+	pAsync->log(msg);
+	pAsync->close();
+	assert (pChannel->list().size() == 2);
+	pAsync->log(msg);
+	try
+	{
+		pAsync->setProperty("lockFreeQueue", "false");
+		fail("open channel - must throw");
+	}
+	catch (Poco::IllegalStateException&)
+	{
+	}
+	pAsync->close();
+	assert (pChannel->list().size() == 3);
+	pAsync->setProperty("lockFreeQueue", "false");
+	pAsync->log(msg);
+	pAsync->close();
+	assert (pChannel->list().size() == 4);
+}
+
+
+void ChannelTest::testAsyncRing()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	AutoPtr<AsyncRingChannel> pAsync = new AsyncRingChannel(pChannel.get(), 100);
+	assert (pAsync->capacity() == 128);
+	assert (pAsync->getProperty("capacity") == "128");
+	assert (pAsync->getProperty("overflow") == "block");
+	assert (pAsync->getProperty("batchSize") == "64");
+	pAsync->open();
+	Message msg;
+	pAsync->log(msg);
+	pAsync->log(msg);
+	pAsync->close();
+	assert (pChannel->list().size() == 2);
+	pAsync->log(msg);
+	try
+	{
+		pAsync->setProperty("capacity", "16");
+		fail("open channel - must throw");
+	}
+	catch (Poco::IllegalStateException&)
+	{
+	}
+	pAsync->close();
+	assert (pChannel->list().size() == 3);
+	assert (pAsync->dropped() == 0);
+	pAsync->setProperty("capacity", "16");
+	assert (pAsync->capacity() == 16);
+}
+
+
+void ChannelTest::testAsyncRingBatch()
+{
+	AutoPtr<BatchChannel> pChannel = new BatchChannel;
+	AutoPtr<AsyncRingChannel> pAsync = new AsyncRingChannel(pChannel.get(), 16);
+	pAsync->setProperty("batchSize", "3");
+	assert (pAsync->getProperty("batchSize") == "3");
+	for (int i = 0; i < 8; ++i)
+	{
+		pAsync->log(Message("Test", std::string(1, char('0' + i)), Message::PRIO_INFORMATION));
+	}
+	pChannel->open();
+	pAsync->close();
+	assert (pChannel->messages() == 8);
+	for (int i = 0; i < 8; ++i)
+	{
+		assert (pChannel->texts()[i] == std::string(1, char('0' + i)));
+	}
+	assert (pChannel->batches().size() >= 3);
+	for (std::size_t i = 0; i < pChannel->batches().size(); ++i)
+	{
+		assert (pChannel->batches()[i] <= 3);
+	}
+
+	AutoPtr<BatchChannel> pChannel2 = new BatchChannel;
+	pAsync->setChannel(pChannel2.get());
+	pAsync->setProperty("batchSize", "64");
+	for (int i = 0; i < 8; ++i)
+	{
+		pAsync->log(Message("Test", "text", Message::PRIO_INFORMATION));
+	}
+	pChannel2->open();
+	pAsync->close();
+	// the first batch blocks until the gate is opened,
+	// all other messages are written with the second batch
+	assert (pChannel2->messages() == 8);
+	assert (pChannel2->batches().size() <= 2);
+}
+
+
+void ChannelTest::testAsyncRingOverflow()
+{
+	AutoPtr<BatchChannel> pChannel = new BatchChannel;
+	AutoPtr<AsyncRingChannel> pAsync = new AsyncRingChannel(pChannel.get(), 4);
+	pAsync->setProperty("overflow", "drop");
+	assert (pAsync->getProperty("overflow") == "drop");
+	Message msg("Test", "text", Message::PRIO_FATAL);
+	for (int i = 0; i < 10; ++i)
+	{
+		pAsync->log(msg);
+	}
+	assert (pAsync->dropped() >= 6);
+	pChannel->open();
+	pAsync->close();
+	assert (pChannel->messages() + pAsync->dropped() == 10);
+
+	AutoPtr<BatchChannel> pChannel2 = new BatchChannel;
+	pAsync->setChannel(pChannel2.get());
+	pAsync->setProperty("capacity", "2");
+	pAsync->setProperty("overflow", "warning");
+	assert (pAsync->getProperty("overflow") == "warning");
+	Message info("Test", "info", Message::PRIO_INFORMATION);
+	Message warning("Test", "warning", Message::PRIO_WARNING);
+	int dropped = pAsync->dropped();
+	for (int i = 0; i < 3; ++i)
+	{
+		pAsync->log(info);
+	}
+	assert (pAsync->dropped() - dropped >= 1);
+	pChannel2->open();
+	pAsync->log(warning);
+	pAsync->close();
+	assert (pChannel2->texts().back() == "warning");
+	assert (pChannel2->messages() + pAsync->dropped() - dropped == 4);
+
+	try
+	{
+		pAsync->setProperty("overflow", "sometimes");
+		fail("invalid overflow policy - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void ChannelTest::testAsyncRingBlock()
+{
+	AutoPtr<BatchChannel> pChannel = new BatchChannel;
+	AutoPtr<AsyncRingChannel> pAsync = new AsyncRingChannel(pChannel.get(), 2);
+	RingLogger logger(*pAsync, 50);
+	Thread t1;
+	Thread t2;
+	t1.start(logger);
+	t2.start(logger);
+	// both loggers wait for room in the ring buffer
+	Thread::sleep(200);
+	assert (t1.isRunning());
+	assert (t2.isRunning());
+	pChannel->open();
+	t1.join();
+	t2.join();
+	pAsync->close();
+	assert (pChannel->messages() == 100);
+	assert (pAsync->dropped() == 0);
+}
+
+
+void ChannelTest::testAsyncRingMultiThread()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	AutoPtr<AsyncRingChannel> pAsync = new AsyncRingChannel(pChannel.get(), 64);
+	RingLogger logger(*pAsync, 2000);
+	Thread t1;
+	Thread t2;
+	Thread t3;
+	Thread t4;
+	t1.start(logger);
+	t2.start(logger);
+	t3.start(logger);
+	t4.start(logger);
+	t1.join();
+	t2.join();
+	t3.join();
+	t4.join();
+	pAsync->close();
+	assert (pChannel->list().size() == 8000);
+	assert (pAsync->dropped() == 0);
+}
+
+
 void ChannelTest::testFormatting()
 {
 	AutoPtr<TestChannel> pChannel = new TestChannel;
@@ -114,6 +394,25 @@ void ChannelTest::testFormatting()
 }
 
 
+void ChannelTest::testFormattingBatch()
+{
+	AutoPtr<BatchChannel> pChannel = new BatchChannel;
+	pChannel->open();
+	AutoPtr<SplitterChannel> pSplitter = new SplitterChannel;
+	pSplitter->addChannel(pChannel.get());
+	AutoPtr<Formatter> pFormatter = new SimpleFormatter;
+	AutoPtr<FormattingChannel> pFormatterChannel = new FormattingChannel(pFormatter, pSplitter.get());
+	std::vector<Message> msgs;
+	msgs.push_back(Message("Source", "Text1", Message::PRIO_INFORMATION));
+	msgs.push_back(Message("Source", "Text2", Message::PRIO_INFORMATION));
+	pFormatterChannel->logBatch(&msgs[0], msgs.size());
+	assert (pChannel->batches().size() == 1);
+	assert (pChannel->batches()[0] == 2);
+	assert (pChannel->texts()[0] == "Source: Text1");
+	assert (pChannel->texts()[1] == "Source: Text2");
+}
+
+
 void ChannelTest::testConsole()
 {
 	AutoPtr<ConsoleChannel> pChannel = new ConsoleChannel;
@@ -152,7 +451,14 @@ CppUnit::Test* ChannelTest::suite()
 
 	CppUnit_addTest(pSuite, ChannelTest, testSplitter);
 	CppUnit_addTest(pSuite, ChannelTest, testAsync);
+	CppUnit_addTest(pSuite, ChannelTest, testAsyncLockFree);
+	CppUnit_addTest(pSuite, ChannelTest, testAsyncRing);
+	CppUnit_addTest(pSuite, ChannelTest, testAsyncRingBatch);
+	CppUnit_addTest(pSuite, ChannelTest, testAsyncRingOverflow);
+	CppUnit_addTest(pSuite, ChannelTest, testAsyncRingBlock);
+	CppUnit_addTest(pSuite, ChannelTest, testAsyncRingMultiThread);
 	CppUnit_addTest(pSuite, ChannelTest, testFormatting);
+	CppUnit_addTest(pSuite, ChannelTest, testFormattingBatch);
 	CppUnit_addTest(pSuite, ChannelTest, testConsole);
 	CppUnit_addTest(pSuite, ChannelTest, testStream);
 
@@ -48,6 +48,13 @@ public:
 
 	void testSplitter();
 	void testAsync();
+	void testAsyncLockFree();
+	void testAsyncRing();
+	void testAsyncRingBatch();
+	void testAsyncRingOverflow();
+	void testAsyncRingBlock();
+	void testAsyncRingMultiThread();
+	void testFormattingBatch();
 	void testFormatting();
 	void testConsole();
 	void testStream();
@@ -0,0 +1,200 @@
+//
+// ChecksumTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "ChecksumTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Checksum.h"
+#include "Poco/ChecksumStream.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/Stopwatch.h"
+#include <sstream>
+#include <iostream>
+
+
+using Poco::Checksum;
+using Poco::ChecksumInputStream;
+using Poco::ChecksumOutputStream;
+using Poco::StreamCopier;
+using Poco::Stopwatch;
+using Poco::UInt32;
+
+
+ChecksumTest::ChecksumTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+ChecksumTest::~ChecksumTest()
+{
+}
+
+
+void ChecksumTest::testCRC32()
+{
+	Checksum crc;
+	assert (crc.type() == Checksum::TYPE_CRC32);
+	assert (crc.checksum() == 0);
+	crc.update("123456789");
+	assert (crc.checksum() == 0xCBF43926);
+}
+
+
+void ChecksumTest::testAdler32()
+{
+	Checksum adler(Checksum::TYPE_ADLER32);
+	assert (adler.checksum() == 1);
+	adler.update("Wikipedia");
+	assert (adler.checksum() == 0x11E60398);
+}
+
+
+void ChecksumTest::testCRC32C()
+{
+	Checksum crc(Checksum::TYPE_CRC32C);
+	assert (crc.type() == Checksum::TYPE_CRC32C);
+	assert (crc.checksum() == 0);
+	crc.update("123456789");
+	assert (crc.checksum() == 0xE3069283);
+
+	// RFC 3720, B.4: 32 bytes of zeroes
+	Checksum zeroes(Checksum::TYPE_CRC32C);
+	zeroes.update(std::string(32, '\0'));
+	assert (zeroes.checksum() == 0x8A9136AA);
+
+	// incremental updates of any size and alignment must
+	// give the same result as a single update
+	std::string data;
+	for (int i = 0; i < 1000; ++i) data += char(i*31 + i/7);
+	Checksum all(Checksum::TYPE_CRC32C);
+	all.update(data);
+	for (std::size_t step = 1; step < 20; ++step)
+	{
+		Checksum parts(Checksum::TYPE_CRC32C);
+		for (std::size_t pos = 0; pos < data.size(); pos += step)
+		{
+			std::size_t n = step < data.size() - pos ? step : data.size() - pos;
+			parts.update(data.data() + pos, static_cast<unsigned>(n));
+		}
+		assert (parts.checksum() == all.checksum());
+	}
+}
+
+
+void ChecksumTest::testInputStream()
+{
+	std::string data;
+	for (int i = 0; i < 10000; ++i) data += char(i);
+	std::istringstream istr(data);
+	Checksum checksum(Checksum::TYPE_CRC32C);
+	ChecksumInputStream cis(checksum, istr);
+	std::ostringstream ostr;
+	StreamCopier::copyStream(cis, ostr);
+	assert (ostr.str() == data);
+
+	Checksum expected(Checksum::TYPE_CRC32C);
+	expected.update(data);
+	assert (checksum.checksum() == expected.checksum());
+}
+
+
+void ChecksumTest::testOutputStream()
+{
+	std::string data;
+	for (int i = 0; i < 10000; ++i) data += char(i);
+	std::ostringstream ostr;
+	Checksum checksum;
+	ChecksumOutputStream cos(checksum, ostr);
+	cos << data;
+	cos.close();
+	assert (ostr.str() == data);
+
+	Checksum expected;
+	expected.update(data);
+	assert (checksum.checksum() == expected.checksum());
+
+	Checksum checksum2(Checksum::TYPE_ADLER32);
+	ChecksumOutputStream cos2(checksum2);
+	cos2 << data;
+	cos2.close();
+	Checksum expected2(Checksum::TYPE_ADLER32);
+	expected2.update(data);
+	assert (checksum2.checksum() == expected2.checksum());
+}
+
+
+void ChecksumTest::benchmarkChecksum()
+{
+	std::string data(64*1024, 'x');
+	for (std::size_t i = 0; i < data.size(); ++i) data[i] = char(i*7 + i/256);
+	const int rounds = 2000;
+	const char* names[] = {"Adler-32", "CRC-32", "CRC-32C"};
+	Checksum::Type types[] = {Checksum::TYPE_ADLER32, Checksum::TYPE_CRC32, Checksum::TYPE_CRC32C};
+	for (int t = 0; t < 3; ++t)
+	{
+		Checksum checksum(types[t]);
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < rounds; ++i)
+		{
+			checksum.update(data);
+		}
+		sw.stop();
+		double mb = double(data.size())*rounds/(1024*1024);
+		std::cout << names[t] << ": " << mb/(sw.elapsed()/1000000.0) << " MB/s (" << checksum.checksum() << ")" << std::endl;
+	}
+}
+
+
+void ChecksumTest::setUp()
+{
+}
+
+
+void ChecksumTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ChecksumTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ChecksumTest");
+
+	CppUnit_addTest(pSuite, ChecksumTest, testCRC32);
+	CppUnit_addTest(pSuite, ChecksumTest, testAdler32);
+	CppUnit_addTest(pSuite, ChecksumTest, testCRC32C);
+	CppUnit_addTest(pSuite, ChecksumTest, testInputStream);
+	CppUnit_addTest(pSuite, ChecksumTest, testOutputStream);
+//	CppUnit_addTest(pSuite, ChecksumTest, benchmarkChecksum);
+
+	return pSuite;
+}
@@ -0,0 +1,436 @@
+//
+// ConcurrentCacheTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "ConcurrentCacheTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Exception.h"
+#include "Poco/ConcurrentLRUCache.h"
+#include "Poco/ConcurrentExpireLRUCache.h"
+#include "Poco/ConcurrentAccessExpireLRUCache.h"
+#include "Poco/LRUCache.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Delegate.h"
+#include <iostream>
+
+
+using namespace Poco;
+
+
+namespace
+{
+	template <class C>
+	class CacheRunnable: public Runnable
+	{
+	public:
+		CacheRunnable(C& cache, int keys, int n):
+			_cache(cache),
+			_keys(keys),
+			_n(n),
+			_misses(0)
+		{
+		}
+
+		void run()
+		{
+			UInt32 key = static_cast<UInt32>(reinterpret_cast<std::size_t>(this));
+			for (int i = 0; i < _n; ++i)
+			{
+				key = key*1103515245 + 12345;
+				int k = static_cast<int>((key >> 8) % _keys);
+				SharedPtr<int> pValue = _cache.get(k);
+				if (pValue.isNull())
+				{
+					++_misses;
+					_cache.add(k, k*2);
+				}
+				else if (*pValue != k*2)
+				{
+					_misses = -_n;
+					break;
+				}
+			}
+		}
+
+		int misses() const
+		{
+			return _misses;
+		}
+
+	private:
+		C&  _cache;
+		int _keys;
+		int _n;
+		int _misses;
+	};
+
+	template <class C>
+	Timestamp::TimeDiff runThreads(C& cache, int threads, int keys, int n, int& misses)
+	{
+		std::vector<Thread*> pThreads;
+		std::vector<CacheRunnable<C>*> pRunnables;
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < threads; ++i)
+		{
+			pRunnables.push_back(new CacheRunnable<C>(cache, keys, n));
+			pThreads.push_back(new Thread);
+			pThreads.back()->start(*pRunnables.back());
+		}
+		misses = 0;
+		for (int i = 0; i < threads; ++i)
+		{
+			pThreads[i]->join();
+			misses += pRunnables[i]->misses();
+			delete pThreads[i];
+			delete pRunnables[i];
+		}
+		sw.stop();
+		return sw.elapsed();
+	}
+}
+
+
+ConcurrentCacheTest::ConcurrentCacheTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+ConcurrentCacheTest::~ConcurrentCacheTest()
+{
+}
+
+
+void ConcurrentCacheTest::testClear()
+{
+	ConcurrentLRUCache<int, int> aCache(3);
+	assert (aCache.size() == 0);
+	assert (aCache.getAllKeys().size() == 0);
+	aCache.add(1, 2);
+	aCache.add(3, 4);
+	aCache.add(5, 6);
+	assert (aCache.size() == 3);
+	assert (aCache.getAllKeys().size() == 3);
+	assert (aCache.has(1));
+	assert (aCache.has(3));
+	assert (aCache.has(5));
+	assert (*aCache.get(1) == 2);
+	assert (*aCache.get(3) == 4);
+	assert (*aCache.get(5) == 6);
+	aCache.clear();
+	assert (!aCache.has(1));
+	assert (!aCache.has(3));
+	assert (!aCache.has(5));
+	assert (aCache.size() == 0);
+	aCache.add(1, 2);
+	assert (*aCache.get(1) == 2);
+}
+
+
+void ConcurrentCacheTest::testCacheSize0()
+{
+	// cache size 0 is illegal
+	try
+	{
+		ConcurrentLRUCache<int, int> aCache(0);
+		failmsg ("cache size of 0 is illegal, test should fail");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void ConcurrentCacheTest::testCacheSize1()
+{
+	ConcurrentLRUCache<int, int> aCache(1);
+	aCache.add(1, 2);
+	assert (aCache.has(1));
+	assert (*aCache.get(1) == 2);
+
+	aCache.add(3, 4); // replaces 1
+	assert (!aCache.has(1));
+	assert (aCache.has(3));
+	assert (*aCache.get(3) == 4);
+
+	aCache.add(5, 6);
+	assert (!aCache.has(1));
+	assert (!aCache.has(3));
+	assert (aCache.has(5));
+	assert (*aCache.get(5) == 6);
+
+	aCache.remove(5);
+	assert (!aCache.has(5));
+
+	// removing illegal entries should work too
+	aCache.remove(666);
+}
+
+
+void ConcurrentCacheTest::testSecondChance()
+{
+	ConcurrentLRUCache<int, int> aCache(3);
+	assert (aCache.shards() == 1);
+	aCache.add(1, 2);
+	aCache.add(3, 4);
+	aCache.add(5, 6);
+	assert (*aCache.get(1) == 2);
+
+	aCache.add(7, 8); // 1 has been used, replaces 3
+	assert (aCache.has(1));
+	assert (!aCache.has(3));
+	assert (aCache.has(5));
+	assert (aCache.has(7));
+
+	aCache.add(9, 10); // replaces 5
+	assert (aCache.has(1));
+	assert (!aCache.has(5));
+	assert (aCache.has(7));
+	assert (aCache.has(9));
+	assert (aCache.size() == 3);
+}
+
+
+void ConcurrentCacheTest::testCacheSizeN()
+{
+	const int N = 10000;
+
+	ConcurrentLRUCache<int, int> aCache(1000);
+	assert (aCache.shards() == 16);
+	assert (aCache.capacity() >= 1000);
+	assert (aCache.capacity() < 1016);
+	for (int i = 0; i < N; ++i)
+	{
+		aCache.add(i, i*2);
+		assert (*aCache.get(i) == i*2);
+		assert (aCache.has(i));
+		if (i >= 100) assert (aCache.get(100)); // frequently used
+	}
+	assert (aCache.size() <= aCache.capacity());
+	assert (aCache.size() > 900);
+	std::set<int> keys = aCache.getAllKeys();
+	assert (keys.size() == aCache.size());
+	for (std::set<int>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+	{
+		assert (*aCache.get(*it) == *it*2);
+	}
+}
+
+
+void ConcurrentCacheTest::testDuplicateAdd()
+{
+	ConcurrentLRUCache<int, int> aCache(3);
+	aCache.add(1, 2); // 1
+	assert (aCache.has(1));
+	assert (*aCache.get(1) == 2);
+	aCache.add(1, 3);
+	assert (aCache.has(1));
+	assert (*aCache.get(1) == 3);
+	assert (aCache.size() == 1);
+}
+
+
+void ConcurrentCacheTest::testUpdate()
+{
+	addCnt = 0;
+	updateCnt = 0;
+	removeCnt = 0;
+	ConcurrentLRUCache<int, int> aCache(3);
+	aCache.Add += delegate(this, &ConcurrentCacheTest::onAdd);
+	aCache.Remove += delegate(this, &ConcurrentCacheTest::onRemove);
+	aCache.Update += delegate(this, &ConcurrentCacheTest::onUpdate);
+	aCache.add(1, 2); // events are disabled
+	assert (addCnt == 0);
+
+	aCache.enableEvents();
+	aCache.add(3, 4); // 1 ,one add event
+	assert (addCnt == 1);
+	assert (updateCnt == 0);
+	assert (removeCnt == 0);
+
+	assert (aCache.has(3));
+	assert (*aCache.get(3) == 4);
+	aCache.update(3, 5); // one update event only!
+	assert (addCnt == 1);
+	assert (updateCnt == 1);
+	assert (removeCnt == 0);
+	assert (aCache.has(3));
+	assert (*aCache.get(3) == 5);
+
+	aCache.add(3, 6); // remove and add
+	assert (addCnt == 2);
+	assert (updateCnt == 1);
+	assert (removeCnt == 1);
+
+	aCache.remove(1);
+	assert (removeCnt == 2);
+	aCache.add(5, 6);
+	aCache.add(7, 8);
+	aCache.add(9, 10); // replaces an entry
+	assert (addCnt == 5);
+	assert (removeCnt == 3);
+}
+
+
+void ConcurrentCacheTest::testExpire()
+{
+	ConcurrentExpireLRUCache<int, int> aCache(3, 100);
+	aCache.add(1, 2);
+	aCache.add(3, 4);
+	assert (aCache.has(1));
+	assert (*aCache.get(1) == 2);
+	Thread::sleep(75);
+	aCache.add(5, 6);
+	assert (*aCache.get(1) == 2); // accessing does not extend the time
+	Thread::sleep(75);
+	assert (!aCache.has(1));
+	assert (aCache.get(1).isNull());
+	assert (!aCache.has(3));
+	assert (aCache.has(5));
+	assert (aCache.size() == 1);
+	Thread::sleep(75);
+	assert (aCache.size() == 0);
+
+	try
+	{
+		ConcurrentExpireLRUCache<int, int> aCache2(3, 10);
+		failmsg ("expire time of 10 ms is illegal, test should fail");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void ConcurrentCacheTest::testAccessExpire()
+{
+	ConcurrentAccessExpireLRUCache<int, int> aCache(3, 100);
+	aCache.add(1, 2);
+	aCache.add(3, 4);
+	Thread::sleep(75);
+	assert (*aCache.get(1) == 2); // extends the time
+	Thread::sleep(75);
+	assert (aCache.has(1));
+	assert (!aCache.has(3));
+	assert (aCache.getAllKeys().size() == 1);
+	Thread::sleep(125);
+	assert (aCache.get(1).isNull());
+	assert (aCache.size() == 0);
+}
+
+
+void ConcurrentCacheTest::testConcurrent()
+{
+	const int THREADS = 8;
+	const int N = 20000;
+
+	ConcurrentLRUCache<int, int> aCache(500);
+	int misses;
+	runThreads(aCache, THREADS, 1000, N, misses);
+	assert (misses >= 0);
+	assert (misses < THREADS*N);
+	assert (aCache.size() <= aCache.capacity());
+
+	ConcurrentAccessExpireLRUCache<int, int> aCache2(500, 1000);
+	runThreads(aCache2, THREADS, 400, N, misses);
+	assert (misses >= 400);
+	assert (misses < THREADS*N/2);
+}
+
+
+void ConcurrentCacheTest::benchmarkConcurrent()
+{
+	const int THREADS = 32;
+	const int N = 200000;
+
+	for (int keys = 1000; keys <= 2000; keys += 1000)
+	{
+		int misses;
+		LRUCache<int, int> lruCache(1024);
+		Timestamp::TimeDiff t = runThreads(lruCache, THREADS, keys, N, misses);
+		std::cout << THREADS << " threads, " << keys << " keys, LRUCache: " << t*1000/(THREADS*N) << " ns/get, " << misses << " misses" << std::endl;
+
+		ConcurrentLRUCache<int, int> concurrentCache(1024);
+		t = runThreads(concurrentCache, THREADS, keys, N, misses);
+		std::cout << THREADS << " threads, " << keys << " keys, ConcurrentLRUCache: " << t*1000/(THREADS*N) << " ns/get, " << misses << " misses" << std::endl;
+	}
+}
+
+
+void ConcurrentCacheTest::onUpdate(const void* pSender, const Poco::KeyValueArgs<int, int>& args)
+{
+	++updateCnt;
+}
+
+
+void ConcurrentCacheTest::onAdd(const void* pSender, const Poco::KeyValueArgs<int, int>& args)
+{
+	++addCnt;
+}
+
+
+void ConcurrentCacheTest::onRemove(const void* pSender, const int& args)
+{
+	++removeCnt;
+}
+
+
+void ConcurrentCacheTest::setUp()
+{
+}
+
+
+void ConcurrentCacheTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ConcurrentCacheTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ConcurrentCacheTest");
+
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testClear);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testCacheSize0);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testCacheSize1);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testSecondChance);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testCacheSizeN);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testDuplicateAdd);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testUpdate);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testExpire);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testAccessExpire);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testConcurrent);
+//	CppUnit_addTest(pSuite, ConcurrentCacheTest, benchmarkConcurrent);
+
+	return pSuite;
+}
@@ -36,8 +36,12 @@
 #include "Poco/Exception.h"
 #include "Poco/ExpireCache.h"
 #include "Poco/AccessExpireCache.h"
+#include "Poco/CachePurger.h"
+#include "Poco/Delegate.h"
 #include "Poco/Bugcheck.h"
 #include "Poco/Thread.h"
+#include "Poco/Timespan.h"
+#include <vector>
 
 
 using namespace Poco;
@@ -48,6 +52,51 @@ using namespace Poco;
 #define DURWAIT  300
 
 
+namespace
+{
+	struct RemoveCounter
+	{
+		RemoveCounter(): removed(0)
+		{
+		}
+
+		void onRemove(const void*, const int&)
+		{
+			++removed;
+		}
+
+		int removed;
+	};
+
+	class TestExpireStrategy: public ExpireStrategy<int, int>
+	{
+	public:
+		TestExpireStrategy(): ExpireStrategy<int, int>(DURSLEEP)
+		{
+		}
+
+		void addAt(int key, const Timestamp& time)
+			/// Adds an entry with the given time, as if it had been
+			/// added before the system time has been set back.
+		{
+			IndexIterator it = _keyIndex.insert(_keyIndex.end(), TimeIndex::value_type(time, key));
+			_keys.insert(Keys::value_type(key, it));
+		}
+
+		std::vector<int> keys() const
+			/// Returns the keys, ordered by time.
+		{
+			std::vector<int> result;
+			for (ConstIndexIterator it = _keyIndex.begin(); it != _keyIndex.end(); ++it)
+			{
+				result.push_back(it->second);
+			}
+			return result;
+		}
+	};
+}
+
+
 ExpireCacheTest::ExpireCacheTest(const std::string& name): CppUnit::TestCase(name)
 {
 }
@@ -209,6 +258,95 @@ void ExpireCacheTest::testExpireWithHas()
 }
 
 
+void ExpireCacheTest::testAccessOrder()
+{
+	AccessExpireCache<int, int> aCache(DURSLEEP);
+	aCache.add(1, 2);
+	aCache.add(2, 3);
+	aCache.add(3, 4);
+	Thread::sleep(DURHALFSLEEP);
+	// 1 becomes the most recently accessed entry
+	assert (*aCache.get(1) == 2);
+	aCache.add(2, 5);
+	Thread::sleep(DURHALFSLEEP + 50);
+	// 3 has expired, 1 and 2 have been touched
+	assert (!aCache.has(3));
+	assert (aCache.has(1));
+	assert (aCache.has(2));
+	assert (aCache.size() == 2);
+	assert (*aCache.get(2) == 5);
+	Thread::sleep(DURWAIT);
+	assert (aCache.size() == 0);
+}
+
+
+void ExpireCacheTest::testMaxPurge()
+{
+	ExpireCache<int, int> aCache(DURSLEEP, 2);
+	for (int i = 0; i < 5; ++i)
+	{
+		aCache.add(i, i);
+	}
+	Thread::sleep(DURWAIT);
+	// at most two expired entries are removed at a time,
+	// but all expired entries are invalid
+	aCache.forceReplace();
+	assert (aCache.getAllKeys().size() == 1);
+	assert (!aCache.has(0));
+	assert (!aCache.has(4));
+	assert (!aCache.get(4));
+	aCache.forceReplace();
+	assert (aCache.size() == 0);
+}
+
+
+void ExpireCacheTest::testPurger()
+{
+	ExpireCache<int, int> aCache(DURSLEEP);
+	RemoveCounter counter;
+	aCache.Remove += Delegate<RemoveCounter, const int>(&counter, &RemoveCounter::onRemove);
+	aCache.add(1, 2);
+	aCache.add(2, 3);
+	{
+		CachePurger<ExpireCache<int, int> > purger(aCache, 50);
+		Thread::sleep(DURWAIT + 100);
+	}
+	// entries have been removed without accessing the cache
+	assert (counter.removed == 2);
+	assert (aCache.getAllKeys().empty());
+}
+
+
+void ExpireCacheTest::testClockBackwards()
+{
+	TestExpireStrategy strategy;
+	Timestamp later;
+	later += Timespan(1, 0, 0, 0, 0).totalMicroseconds();
+	strategy.addAt(1, later);
+	strategy.addAt(2, later);
+	strategy.onAdd(0, KeyValueArgs<int, int>(3, 0));
+	std::vector<int> keys = strategy.keys();
+	assert (keys.size() == 3);
+	assert (keys[0] == 3 && keys[1] == 1 && keys[2] == 2);
+
+	strategy.onAdd(0, KeyValueArgs<int, int>(2, 0));
+	keys = strategy.keys();
+	assert (keys[0] == 3 && keys[1] == 2 && keys[2] == 1);
+
+	strategy.onAdd(0, KeyValueArgs<int, int>(4, 0));
+	keys = strategy.keys();
+	assert (keys.size() == 4);
+	assert (keys[0] == 3 && keys[1] == 2 && keys[2] == 4 && keys[3] == 1);
+
+	// entries are still found in time order when they expire
+	Thread::sleep(DURWAIT);
+	std::set<int> expired;
+	strategy.onReplace(0, expired);
+	assert (expired.size() == 3);
+	assert (expired.find(1) == expired.end());
+}
+
+
 void ExpireCacheTest::setUp()
 {
 }
@@ -229,6 +367,10 @@ CppUnit::Test* ExpireCacheTest::suite()
 	CppUnit_addTest(pSuite, ExpireCacheTest, testDuplicateAdd);
 	CppUnit_addTest(pSuite, ExpireCacheTest, testAccessExpireN);
 	CppUnit_addTest(pSuite, ExpireCacheTest, testExpireWithHas);
+	CppUnit_addTest(pSuite, ExpireCacheTest, testAccessOrder);
+	CppUnit_addTest(pSuite, ExpireCacheTest, testMaxPurge);
+	CppUnit_addTest(pSuite, ExpireCacheTest, testPurger);
+	CppUnit_addTest(pSuite, ExpireCacheTest, testClockBackwards);
 
 	return pSuite;
 }
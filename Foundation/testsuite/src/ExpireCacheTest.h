@@ -51,6 +51,10 @@ public:
 	void testExpireN();
 	void testAccessExpireN();
 	void testExpireWithHas();
+	void testAccessOrder();
+	void testMaxPurge();
+	void testPurger();
+	void testClockBackwards();
 
 	
 	void setUp();
@@ -47,6 +47,7 @@
 #include "Poco/DateTimeFormat.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/DirectoryIterator.h"
+#include "Poco/FileStream.h"
 #include "Poco/Exception.h"
 #include <vector>
 
@@ -66,6 +67,7 @@ using Poco::DateTimeFormatter;
 using Poco::DateTimeFormat;
 using Poco::DirectoryIterator;
 using Poco::InvalidArgumentException;
+using Poco::FileInputStream;
 
 
 FileChannelTest::FileChannelTest(const std::string& name): CppUnit::TestCase(name)
@@ -107,6 +109,174 @@ void FileChannelTest::testRotateBySize()
 }
 
 
+void FileChannelTest::testLogBatch()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->open();
+		std::vector<Message> msgs;
+		msgs.push_back(Message("source", "first", Message::PRIO_INFORMATION));
+		msgs.push_back(Message("source", "second", Message::PRIO_INFORMATION));
+		msgs.push_back(Message("source", "third", Message::PRIO_INFORMATION));
+		pChannel->logBatch(&msgs[0], msgs.size());
+		pChannel->log(Message("source", "fourth", Message::PRIO_INFORMATION));
+		pChannel->close();
+
+		FileInputStream istr(name);
+		std::string line;
+		std::vector<std::string> lines;
+		while (std::getline(istr, line))
+		{
+			if (!line.empty() && line[line.size() - 1] == '\r') line.resize(line.size() - 1);
+			lines.push_back(line);
+		}
+		assert (lines.size() == 4);
+		assert (lines[0] == "first");
+		assert (lines[1] == "second");
+		assert (lines[2] == "third");
+		assert (lines[3] == "fourth");
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void FileChannelTest::testBuffered()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "1 K");
+		pChannel->setProperty(FileChannel::PROP_FLUSHINTERVAL, "0");
+		pChannel->setProperty(FileChannel::PROP_FLUSH, "false");
+		assert (pChannel->getProperty(FileChannel::PROP_BUFFERSIZE) == "1 K");
+		assert (pChannel->getProperty(FileChannel::PROP_FLUSHINTERVAL) == "0");
+		assert (pChannel->getProperty(FileChannel::PROP_FLUSHPRIORITY) == "error");
+		assert (pChannel->getProperty(FileChannel::PROP_FLUSH) == "false");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		for (int i = 0; i < 10; ++i)
+		{
+			pChannel->log(msg);
+		}
+		File f(name);
+		assert (f.getSize() == 0);
+		assert (pChannel->size() > 0);
+
+		Message error("source", "This is an error", Message::PRIO_ERROR);
+		pChannel->log(error);
+		assert (f.getSize() == pChannel->size());
+		assert (countLines(name) == 11);
+
+		for (int i = 0; i < 100; ++i)
+		{
+			pChannel->log(msg);
+		}
+		// the buffer has been written at least once
+		assert (countLines(name) > 11);
+		pChannel->close();
+		assert (countLines(name) == 111);
+
+		try
+		{
+			pChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "1 G");
+			fail("invalid buffer size - must throw");
+		}
+		catch (InvalidArgumentException&)
+		{
+		}
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void FileChannelTest::testBufferedRotate()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_ROTATION, "2 K");
+		pChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "1 K");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		for (int i = 0; i < 200; ++i)
+		{
+			pChannel->log(msg);
+		}
+		pChannel->close();
+		File f(name + ".0");
+		assert (f.exists());
+		assert (f.getSize() <= 2048 + 1024 + 64);
+		f = name + ".1";
+		assert (f.exists());
+		f = name + ".2";
+		assert (!f.exists());
+		assert (countLines(name) + countLines(name + ".0") + countLines(name + ".1") == 200);
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void FileChannelTest::testFlushInterval()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "64 K");
+		pChannel->setProperty(FileChannel::PROP_FLUSHINTERVAL, "100");
+		pChannel->setProperty(FileChannel::PROP_SYNCINTERVAL, "200");
+		assert (pChannel->getProperty(FileChannel::PROP_SYNCINTERVAL) == "200");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		pChannel->log(msg);
+		pChannel->log(msg);
+		File f(name);
+		assert (f.getSize() == 0);
+		Thread::sleep(1000);
+		assert (countLines(name) == 2);
+		pChannel->log(msg);
+		Thread::sleep(1000);
+		assert (countLines(name) == 3);
+
+		// changes take effect while the channel is open
+		pChannel->setProperty(FileChannel::PROP_SYNCINTERVAL, "0");
+		pChannel->setProperty(FileChannel::PROP_FLUSHINTERVAL, "0");
+		pChannel->log(msg);
+		Thread::sleep(500);
+		assert (countLines(name) == 3);
+		pChannel->setProperty(FileChannel::PROP_FLUSHINTERVAL, "50");
+		Thread::sleep(500);
+		assert (countLines(name) == 4);
+		pChannel->close();
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
 void FileChannelTest::testRotateByAge()
 {
 	std::string name = filename();
@@ -583,6 +753,16 @@ std::string FileChannelTest::filename() const
 }
 
 
+int FileChannelTest::countLines(const std::string& path)
+{
+	FileInputStream istr(path);
+	std::string line;
+	int n = 0;
+	while (std::getline(istr, line)) ++n;
+	return n;
+}
+
+
 template <class DT>
 std::string FileChannelTest::rotation(TimeRotation rtype) const
 {
@@ -629,6 +809,10 @@ CppUnit::Test* FileChannelTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("FileChannelTest");
 
 	CppUnit_addTest(pSuite, FileChannelTest, testRotateBySize);
+	CppUnit_addTest(pSuite, FileChannelTest, testLogBatch);
+	CppUnit_addTest(pSuite, FileChannelTest, testBuffered);
+	CppUnit_addTest(pSuite, FileChannelTest, testBufferedRotate);
+	CppUnit_addTest(pSuite, FileChannelTest, testFlushInterval);
 	CppUnit_addTest(pSuite, FileChannelTest, testRotateByAge);
 	CppUnit_addTest(pSuite, FileChannelTest, testRotateAtTimeDayUTC);
 	CppUnit_addTest(pSuite, FileChannelTest, testRotateAtTimeDayLocal);
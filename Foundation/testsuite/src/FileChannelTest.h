@@ -54,6 +54,10 @@ public:
 	~FileChannelTest();
 
 	void testRotateBySize();
+	void testLogBatch();
+	void testBuffered();
+	void testBufferedRotate();
+	void testFlushInterval();
 	void testRotateByAge();
 	void testRotateAtTimeDayUTC();
 	void testRotateAtTimeDayLocal();
@@ -75,6 +79,7 @@ private:
 		template <class D> std::string rotation(TimeRotation rtype) const;
 		void remove(const std::string& baseName);
 		std::string filename() const;
+		static int countLines(const std::string& path);
 
 		void purgeAge(const std::string& purgeAge);
 		void noPurgeAge(const std::string& purgeAge);
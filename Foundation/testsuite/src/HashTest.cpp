@@ -0,0 +1,329 @@
+//
+// HashTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "HashTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Hash.h"
+#include "Poco/HashTable.h"
+#include "Poco/HashStatistic.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Random.h"
+#include "Poco/Stopwatch.h"
+#include <set>
+#include <vector>
+#include <iostream>
+
+
+using Poco::Hash;
+using Poco::SeededHash;
+using Poco::HashTable;
+using Poco::HashStatistic;
+using Poco::NumberFormatter;
+using Poco::Random;
+using Poco::Stopwatch;
+using Poco::UInt32;
+using Poco::UInt64;
+
+
+namespace
+{
+	struct PreviousHash
+		/// The string hash function used by previous
+		/// releases, for comparison.
+	{
+		std::size_t operator () (const std::string& key) const
+		{
+			std::size_t h = 0;
+			const char* str = key.data();
+			const char* end = str + key.size();
+			while (str != end)
+			{
+				h = h * 0xf4243 ^ *str++;
+			}
+			return h;
+		}
+	};
+
+	template <class H>
+	struct TableHashFunction
+	{
+		UInt32 operator () (const std::string& key, UInt32 maxValue) const
+		{
+			return static_cast<UInt32>(H()(key)) % maxValue;
+		}
+	};
+
+	int bitCount(UInt64 n)
+	{
+		int count = 0;
+		while (n)
+		{
+			n &= n - 1;
+			++count;
+		}
+		return count;
+	}
+
+	std::vector<std::string> makeKeys(const std::string& prefix, const std::string& suffix, int count)
+	{
+		std::vector<std::string> keys;
+		for (int i = 0; i < count; ++i)
+		{
+			keys.push_back(prefix + NumberFormatter::format(i) + suffix);
+		}
+		return keys;
+	}
+
+	template <class H>
+	HashStatistic statistic(const std::vector<std::string>& keys, UInt32 tableSize)
+	{
+		HashTable<std::string, int, TableHashFunction<H> > table(tableSize);
+		for (std::vector<std::string>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+		{
+			table.insert(*it, 0);
+		}
+		return table.currentState();
+	}
+}
+
+
+HashTest::HashTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+HashTest::~HashTest()
+{
+}
+
+
+void HashTest::testString()
+{
+	std::string str("/index.html");
+	Hash<std::string> h;
+	assert (h(str) == h("/index.html"));
+	assert (h(str) == Poco::hash(str));
+	assert (h(str) == Poco::hash(str.data(), str.size()));
+	assert (h(str) == static_cast<std::size_t>(Poco::hash64(str.data(), str.size())));
+	assert (h(str) != h("/index.htm"));
+	assert (h(str) != h("/index.htmL"));
+	assert (h("") == Poco::hash(""));
+}
+
+
+void HashTest::testKnownValues()
+{
+	// The values must be the same on all platforms.
+	assert (Poco::hash64("", 0) == 0x0409638ee2bde459ULL);
+	assert (Poco::hash64("a", 1) == 0x28d2053309d28531ULL);
+	assert (Poco::hash64("abcd", 4) == 0x48dfe2b09ab52113ULL);
+	assert (Poco::hash64("Content-Type", 12) == 0x6a30cb56aa15828bULL);
+	assert (Poco::hash64("/api/v1/users/12345/profile", 27) == 0x981af31334ff353eULL);
+	assert (Poco::hash64("The quick brown fox jumps over the lazy dog", 43) == 0x6303b3bade45a571ULL);
+	assert (Poco::hash64("The quick brown fox jumps over the lazy dog", 43, 1) == 0xe9759017046e0ca3ULL);
+}
+
+
+void HashTest::testLengths()
+{
+	std::string data(256, 'x');
+	std::set<UInt64> hashes;
+	for (std::size_t length = 0; length <= data.size(); ++length)
+	{
+		hashes.insert(Poco::hash64(data.data(), length));
+	}
+	assert (hashes.size() == data.size() + 1);
+
+	std::string zeros(64, '\0');
+	hashes.clear();
+	for (std::size_t length = 0; length <= zeros.size(); ++length)
+	{
+		hashes.insert(Poco::hash64(zeros.data(), length));
+	}
+	assert (hashes.size() == zeros.size() + 1);
+}
+
+
+void HashTest::testAvalanche()
+{
+	Random rnd;
+	rnd.seed(42);
+	static const std::size_t lengths[] = {3, 8, 16, 31, 64, 100};
+	for (std::size_t l = 0; l < sizeof(lengths)/sizeof(lengths[0]); ++l)
+	{
+		std::string data;
+		for (std::size_t i = 0; i < lengths[l]; ++i)
+		{
+			data += rnd.nextChar();
+		}
+		UInt64 h = Poco::hash64(data.data(), data.size());
+		int total = 0;
+		int flips = 0;
+		for (std::size_t i = 0; i < data.size(); ++i)
+		{
+			for (int bit = 0; bit < 8; ++bit)
+			{
+				std::string flipped(data);
+				flipped[i] ^= static_cast<char>(1 << bit);
+				int changed = bitCount(h ^ Poco::hash64(flipped.data(), flipped.size()));
+				assert (changed >= 8 && changed <= 56);
+				total += changed;
+				++flips;
+			}
+		}
+		double avg = static_cast<double>(total)/flips;
+		assert (avg > 28 && avg < 36);
+	}
+}
+
+
+void HashTest::testSeed()
+{
+	std::string str("Content-Length");
+	UInt64 h0 = Poco::hash64(str.data(), str.size(), 0);
+	UInt64 h1 = Poco::hash64(str.data(), str.size(), 1);
+	UInt64 h2 = Poco::hash64(str.data(), str.size(), 2);
+	assert (h0 != h1);
+	assert (h0 != h2);
+	assert (h1 != h2);
+	assert (h1 == Poco::hash64(str.data(), str.size(), 1));
+
+	assert (Poco::hashSeed() == Poco::hashSeed());
+}
+
+
+void HashTest::testSeededHash()
+{
+	std::string str("/index.html");
+	SeededHash h1(1);
+	SeededHash h2(2);
+	assert (h1.seed() == 1);
+	assert (h1(str) == h1("/index.html"));
+	assert (h1(str) == static_cast<std::size_t>(Poco::hash64(str.data(), str.size(), 1)));
+	assert (h1(str) != h2(str));
+
+	SeededHash hd;
+	assert (hd.seed() == Poco::hashSeed());
+	assert (hd(str) == SeededHash()(str));
+}
+
+
+void HashTest::testDistribution()
+{
+	std::vector<std::string> keys = makeKeys("/api/v1/users/", "/profile", 20000);
+	HashStatistic stat = statistic<Hash<std::string> >(keys, 4096);
+	assert (stat.numberOfEntries() == 20000);
+	assert (stat.numberOfZeroPositions() < 100);
+	assert (stat.maxEntriesPerHash() < 20);
+
+	keys = makeKeys("X-Header-", "", 20000);
+	stat = statistic<Hash<std::string> >(keys, 4096);
+	assert (stat.numberOfZeroPositions() < 100);
+	assert (stat.maxEntriesPerHash() < 20);
+}
+
+
+void HashTest::benchmarkHash()
+{
+	static const UInt32 tableSizes[] = {4093, 4096};
+	std::vector<std::vector<std::string> > keySets;
+	keySets.push_back(makeKeys("/api/v1/users/", "/profile", 20000));
+	keySets.push_back(makeKeys("X-Header-", "", 20000));
+	keySets.push_back(makeKeys("", "", 20000));
+	for (std::size_t k = 0; k < keySets.size(); ++k)
+	{
+		for (std::size_t t = 0; t < sizeof(tableSizes)/sizeof(tableSizes[0]); ++t)
+		{
+			std::cout << "\nKeys " << keySets[k][1] << ", table size " << tableSizes[t] << std::endl;
+			HashStatistic prev = statistic<PreviousHash>(keySets[k], tableSizes[t]);
+			std::cout << "Previous: " << prev.numberOfZeroPositions() << " empty, max " << prev.maxEntriesPerHash() << std::endl;
+			HashStatistic curr = statistic<Hash<std::string> >(keySets[k], tableSizes[t]);
+			std::cout << "Current:  " << curr.numberOfZeroPositions() << " empty, max " << curr.maxEntriesPerHash() << std::endl;
+		}
+	}
+
+	static const std::size_t lengths[] = {8, 16, 32, 64, 256, 4096};
+	for (std::size_t l = 0; l < sizeof(lengths)/sizeof(lengths[0]); ++l)
+	{
+		std::string data(lengths[l], 'x');
+		const int iterations = static_cast<int>(256*1024*1024/lengths[l]/8);
+		std::size_t result = 0;
+		Stopwatch sw;
+		sw.start();
+		PreviousHash prev;
+		for (int i = 0; i < iterations; ++i)
+		{
+			data[0] = static_cast<char>(i);
+			result += prev(data);
+		}
+		sw.stop();
+		double prevMBs = (static_cast<double>(iterations)*lengths[l])/sw.elapsed();
+		sw.restart();
+		Hash<std::string> curr;
+		for (int i = 0; i < iterations; ++i)
+		{
+			data[0] = static_cast<char>(i);
+			result += curr(data);
+		}
+		sw.stop();
+		double currMBs = (static_cast<double>(iterations)*lengths[l])/sw.elapsed();
+		std::cout << "\nLength " << lengths[l] << ": previous " << prevMBs << " MB/s, current " << currMBs << " MB/s (" << (result & 1) << ")" << std::endl;
+	}
+}
+
+
+void HashTest::setUp()
+{
+}
+
+
+void HashTest::tearDown()
+{
+}
+
+
+CppUnit::Test* HashTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("HashTest");
+
+	CppUnit_addTest(pSuite, HashTest, testString);
+	CppUnit_addTest(pSuite, HashTest, testKnownValues);
+	CppUnit_addTest(pSuite, HashTest, testLengths);
+	CppUnit_addTest(pSuite, HashTest, testAvalanche);
+	CppUnit_addTest(pSuite, HashTest, testSeed);
+	CppUnit_addTest(pSuite, HashTest, testSeededHash);
+	CppUnit_addTest(pSuite, HashTest, testDistribution);
+//	CppUnit_addTest(pSuite, HashTest, benchmarkHash);
+
+	return pSuite;
+}
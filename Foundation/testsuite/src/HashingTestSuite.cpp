@@ -36,6 +36,8 @@
 #include "LinearHashTableTest.h"
 #include "HashSetTest.h"
 #include "HashMapTest.h"
+#include "OpenHashTableTest.h"
+#include "HashTest.h"
 
 
 CppUnit::Test* HashingTestSuite::suite()
@@ -47,6 +49,8 @@ CppUnit::Test* HashingTestSuite::suite()
 	pSuite->addTest(LinearHashTableTest::suite());
 	pSuite->addTest(HashSetTest::suite());
 	pSuite->addTest(HashMapTest::suite());
+	pSuite->addTest(OpenHashTableTest::suite());
+	pSuite->addTest(HashTest::suite());
 
 	return pSuite;
 }
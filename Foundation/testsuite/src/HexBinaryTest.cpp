@@ -205,6 +205,87 @@ void HexBinaryTest::testEncodeDecode()
 }
 
 
+void HexBinaryTest::testBuffer()
+{
+	std::string src;
+	for (int i = 0; i < 256; ++i) src += char(i);
+	std::ostringstream str;
+	HexBinaryEncoder encoder(str);
+	encoder.rdbuf()->setLineLength(0);
+	for (std::size_t i = 0; i < src.size(); ++i) encoder.put(src[i]);
+	encoder.close();
+	std::string encoded = HexBinaryEncoder::encode(src);
+	assert (encoded == str.str());
+	assert (HexBinaryDecoder::decode(encoded) == src);
+	assert (HexBinaryEncoder::encode("\x0a\xbc", true) == "0ABC");
+	assert (HexBinaryDecoder::decode("0a B\r\nc") == "\x0a\xbc");
+	assert (HexBinaryDecoder::decode("") == "");
+	try
+	{
+		HexBinaryDecoder::decode("0a#b");
+		fail("invalid character - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+	try
+	{
+		HexBinaryDecoder::decode("0ab");
+		fail("odd number of digits - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+}
+
+
+void HexBinaryTest::testStreamBlocks()
+{
+	std::string src;
+	for (int i = 0; i < 10000; ++i) src += char(i*13 + i/256);
+	int lineLengths[] = {0, 3, 72};
+	for (int l = 0; l < 3; ++l)
+	{
+		std::ostringstream expected;
+		HexBinaryEncoder encoder1(expected);
+		encoder1.rdbuf()->setLineLength(lineLengths[l]);
+		for (std::size_t i = 0; i < src.size(); ++i) encoder1.put(src[i]);
+		encoder1.close();
+
+		std::stringstream str;
+		HexBinaryEncoder encoder2(str);
+		encoder2.rdbuf()->setLineLength(lineLengths[l]);
+		std::size_t pos = 0;
+		for (std::size_t chunk = 1; pos < src.size(); chunk = chunk*3 + 1)
+		{
+			std::size_t n = chunk < src.size() - pos ? chunk : src.size() - pos;
+			encoder2.write(src.data() + pos, n);
+			pos += n;
+		}
+		encoder2.close();
+		assert (str.str() == expected.str());
+
+		HexBinaryDecoder decoder(str);
+		std::string result;
+		char buffer[5000];
+		for (std::streamsize chunk = 1; decoder.read(buffer, chunk) || decoder.gcount() > 0; chunk = chunk*2 + 1)
+		{
+			result.append(buffer, decoder.gcount());
+			if (chunk > 1000) chunk = 1;
+		}
+		assert (result == src);
+	}
+
+	// reading must not consume more of the underlying stream than needed
+	std::istringstream istr("0a\nbc!");
+	HexBinaryDecoder decoder(istr);
+	char buffer[2];
+	decoder.read(buffer, 2);
+	assert (std::string(buffer, 2) == "\x0a\xbc");
+	assert (istr.get() == '!');
+}
+
+
 void HexBinaryTest::setUp()
 {
 }
@@ -222,6 +303,8 @@ CppUnit::Test* HexBinaryTest::suite()
 	CppUnit_addTest(pSuite, HexBinaryTest, testEncoder);
 	CppUnit_addTest(pSuite, HexBinaryTest, testDecoder);
 	CppUnit_addTest(pSuite, HexBinaryTest, testEncodeDecode);
+	CppUnit_addTest(pSuite, HexBinaryTest, testBuffer);
+	CppUnit_addTest(pSuite, HexBinaryTest, testStreamBlocks);
 
 	return pSuite;
 }
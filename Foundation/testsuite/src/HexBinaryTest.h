@@ -49,6 +49,8 @@ public:
 	void testEncoder();
 	void testDecoder();
 	void testEncodeDecode();
+	void testBuffer();
+	void testStreamBlocks();
 
 	void setUp();
 	void tearDown();
@@ -0,0 +1,342 @@
+//
+// LockFreeNotificationQueueTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "LockFreeNotificationQueueTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/LockFreeNotificationQueue.h"
+#include "Poco/Notification.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/RunnableAdapter.h"
+
+
+using Poco::LockFreeNotificationQueue;
+using Poco::Notification;
+using Poco::Thread;
+using Poco::RunnableAdapter;
+
+
+namespace
+{
+	class QTestNotification: public Notification
+	{
+	public:
+		QTestNotification(const std::string& data): _data(data)
+		{
+		}
+		~QTestNotification()
+		{
+		}
+		const std::string& data() const
+		{
+			return _data;
+		}
+
+	private:
+		std::string _data;
+	};
+	
+	const int NOTIFICATION_COUNT = 5000;
+
+	class Producer: public Poco::Runnable
+	{
+	public:
+		Producer(LockFreeNotificationQueue& queue, int count):
+			_queue(queue),
+			_count(count),
+			_done(false)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < _count; ++i)
+			{
+				_queue.enqueueNotification(new Notification);
+			}
+			_done = true;
+		}
+
+		bool done() const
+		{
+			return _done;
+		}
+
+	private:
+		LockFreeNotificationQueue& _queue;
+		int _count;
+		volatile bool _done;
+	};
+}
+
+
+LockFreeNotificationQueueTest::LockFreeNotificationQueueTest(const std::string& name): 
+	CppUnit::TestCase(name),
+	_queue(64)
+{
+}
+
+
+LockFreeNotificationQueueTest::~LockFreeNotificationQueueTest()
+{
+}
+
+
+void LockFreeNotificationQueueTest::testQueueDequeue()
+{
+	LockFreeNotificationQueue queue;
+	assert (queue.empty());
+	assert (queue.size() == 0);
+	Notification* pNf = queue.dequeueNotification();
+	assertNullPtr(pNf);
+	queue.enqueueNotification(new Notification);
+	assert (!queue.empty());
+	assert (queue.size() == 1);
+	pNf = queue.dequeueNotification();
+	assertNotNullPtr(pNf);
+	assert (queue.empty());
+	assert (queue.size() == 0);
+	pNf->release();
+	
+	queue.enqueueNotification(new QTestNotification("first"));
+	queue.enqueueNotification(new QTestNotification("second"));
+	assert (!queue.empty());
+	assert (queue.size() == 2);
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "first");
+	pTNf->release();
+	assert (!queue.empty());
+	assert (queue.size() == 1);
+	pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "second");
+	pTNf->release();
+	assert (queue.empty());
+	assert (queue.size() == 0);
+
+	pNf = queue.dequeueNotification();
+	assertNullPtr(pNf);
+}
+
+
+void LockFreeNotificationQueueTest::testCapacity()
+{
+	LockFreeNotificationQueue queue(5);
+	assert (queue.capacity() == 8);
+	
+	Notification::Ptr pNf = new Notification;
+	for (int i = 0; i < 8; ++i)
+	{
+		assert (queue.tryEnqueueNotification(pNf));
+	}
+	assert (queue.size() == 8);
+	assert (!queue.tryEnqueueNotification(pNf));
+	assert (pNf->referenceCount() == 9);
+	
+	Notification* pDeq = queue.dequeueNotification();
+	assert (pDeq == pNf.get());
+	pDeq->release();
+	assert (queue.tryEnqueueNotification(pNf));
+	assert (queue.size() == 8);
+	
+	queue.clear();
+	assert (queue.empty());
+	assert (pNf->referenceCount() == 1);
+	
+	// wrap around the ring buffer several times
+	for (int i = 0; i < 100; ++i)
+	{
+		queue.enqueueNotification(new QTestNotification("first"));
+		queue.enqueueNotification(new QTestNotification("second"));
+		QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+		assertNotNullPtr(pTNf);
+		assert (pTNf->data() == "first");
+		pTNf->release();
+		pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+		assertNotNullPtr(pTNf);
+		assert (pTNf->data() == "second");
+		pTNf->release();
+	}
+	assert (queue.empty());
+}
+
+
+void LockFreeNotificationQueueTest::testBlockingEnqueue()
+{
+	LockFreeNotificationQueue queue(2);
+	queue.enqueueNotification(new Notification);
+	queue.enqueueNotification(new Notification);
+
+	Producer producer(queue, 4);
+	Thread t;
+	t.start(producer);
+	Thread::sleep(200);
+	assert (!producer.done());
+	assert (queue.size() == 2);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		Notification* pNf = queue.waitDequeueNotification(1000);
+		assertNotNullPtr(pNf);
+		pNf->release();
+	}
+	t.join();
+	assert (producer.done());
+	assert (queue.size() == 2);
+	queue.clear();
+}
+
+
+void LockFreeNotificationQueueTest::testWaitDequeue()
+{
+	LockFreeNotificationQueue queue;
+	queue.enqueueNotification(new QTestNotification("third"));
+	queue.enqueueNotification(new QTestNotification("fourth"));
+	assert (!queue.empty());
+	assert (queue.size() == 2);
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification(10));
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "third");
+	pTNf->release();
+	assert (!queue.empty());
+	assert (queue.size() == 1);
+	pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification(10));
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "fourth");
+	pTNf->release();
+	assert (queue.empty());
+	assert (queue.size() == 0);
+
+	Notification* pNf = queue.waitDequeueNotification(10);
+	assertNullPtr(pNf);
+	assert (!queue.hasIdleThreads());
+}
+
+
+void LockFreeNotificationQueueTest::testWakeUpAll()
+{
+	Thread t1("thread1");
+	Thread t2("thread2");
+	
+	RunnableAdapter<LockFreeNotificationQueueTest> ra(*this, &LockFreeNotificationQueueTest::work);
+	t1.start(ra);
+	t2.start(ra);
+	
+	int n = 0;
+	while (n++ < 100 && !_queue.hasIdleThreads()) Thread::sleep(10);
+	_queue.enqueueNotification(new Notification);
+	Thread::sleep(100);
+	_queue.wakeUpAll();
+	t1.join();
+	t2.join();
+	assert (_handled.size() == 1);
+	assert (_queue.empty());
+	assert (!_queue.hasIdleThreads());
+}
+
+
+void LockFreeNotificationQueueTest::testThreads()
+{
+	Thread t1("thread1");
+	Thread t2("thread2");
+	Thread t3("thread3");
+	Thread p1("producer1");
+	Thread p2("producer2");
+	
+	RunnableAdapter<LockFreeNotificationQueueTest> ra(*this, &LockFreeNotificationQueueTest::work);
+	RunnableAdapter<LockFreeNotificationQueueTest> pa(*this, &LockFreeNotificationQueueTest::produce);
+	t1.start(ra);
+	t2.start(ra);
+	t3.start(ra);
+	p1.start(pa);
+	p2.start(pa);
+	p1.join();
+	p2.join();
+	while (!_queue.empty()) Thread::sleep(50);
+	Thread::sleep(20);
+	_queue.wakeUpAll();
+	t1.join();
+	t2.join();
+	t3.join();
+	assert (_handled.size() == 2*NOTIFICATION_COUNT);
+}
+
+
+void LockFreeNotificationQueueTest::setUp()
+{
+	_handled.clear();
+}
+
+
+void LockFreeNotificationQueueTest::tearDown()
+{
+}
+
+
+void LockFreeNotificationQueueTest::work()
+{
+	Notification* pNf = _queue.waitDequeueNotification();
+	while (pNf)
+	{
+		pNf->release();
+		_mutex.lock();
+		_handled.insert(Thread::current()->name());
+		_mutex.unlock();
+		pNf = _queue.waitDequeueNotification();
+	}
+}
+
+
+void LockFreeNotificationQueueTest::produce()
+{
+	for (int i = 0; i < NOTIFICATION_COUNT; ++i)
+	{
+		_queue.enqueueNotification(new Notification);
+	}
+}
+
+
+CppUnit::Test* LockFreeNotificationQueueTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("LockFreeNotificationQueueTest");
+
+	CppUnit_addTest(pSuite, LockFreeNotificationQueueTest, testQueueDequeue);
+	CppUnit_addTest(pSuite, LockFreeNotificationQueueTest, testCapacity);
+	CppUnit_addTest(pSuite, LockFreeNotificationQueueTest, testBlockingEnqueue);
+	CppUnit_addTest(pSuite, LockFreeNotificationQueueTest, testWaitDequeue);
+	CppUnit_addTest(pSuite, LockFreeNotificationQueueTest, testWakeUpAll);
+	CppUnit_addTest(pSuite, LockFreeNotificationQueueTest, testThreads);
+
+	return pSuite;
+}
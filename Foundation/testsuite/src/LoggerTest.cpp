@@ -35,13 +35,181 @@
 #include "CppUnit/TestSuite.h"
 #include "Poco/Logger.h"
 #include "Poco/AutoPtr.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/NullChannel.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/NumberFormatter.h"
 #include "TestChannel.h"
+#include <iostream>
 
 
 using Poco::Logger;
 using Poco::Channel;
 using Poco::Message;
 using Poco::AutoPtr;
+using Poco::Thread;
+using Poco::Runnable;
+using Poco::LoggerHandle;
+
+
+namespace
+{
+	class NestedChannel: public TestChannel
+		/// Logs every message to a second logger before storing it.
+	{
+	public:
+		NestedChannel(Logger& logger): _logger(logger)
+		{
+		}
+
+		void log(const Message& msg)
+		{
+			_logger.information("nested: " + msg.getText());
+			TestChannel::log(msg);
+		}
+
+	private:
+		Logger& _logger;
+	};
+
+	class LoggingRunnable: public Runnable
+	{
+	public:
+		LoggingRunnable(Logger& logger): _logger(logger)
+		{
+		}
+
+		void run()
+		{
+			_logger.information("one");
+			poco_information(_logger, "two");
+			_logger.information("%s", std::string("three"));
+			_logger.debug("%s", std::string("disabled"));
+			Thread::current()->setName("renamed");
+			_logger.warning("four");
+		}
+
+	private:
+		Logger& _logger;
+	};
+
+	class BenchmarkRunnable: public Runnable
+	{
+	public:
+		BenchmarkRunnable(Logger& logger): _logger(logger)
+		{
+		}
+
+		void run()
+		{
+			const int N = 1000000;
+
+			Poco::Stopwatch sw;
+			sw.start();
+			for (int i = 0; i < N; ++i)
+			{
+				_logger.information("Test message text for the logging benchmark");
+			}
+			sw.stop();
+			std::cout << N << " messages: " << sw.elapsed()*1000/N << " ns/message" << std::endl;
+
+			sw.restart();
+			for (int i = 0; i < N; ++i)
+			{
+				_logger.information("Test message %d for %s", i, std::string("the logging benchmark"));
+			}
+			sw.stop();
+			std::cout << N << " formatted messages: " << sw.elapsed()*1000/N << " ns/message" << std::endl;
+
+			sw.restart();
+			for (int i = 0; i < N; ++i)
+			{
+				_logger.debug("Test message %d for %s", i, std::string("the logging benchmark"));
+			}
+			sw.stop();
+			std::cout << N << " disabled messages: " << sw.elapsed()*1000/N << " ns/message" << std::endl;
+		}
+
+	private:
+		Logger& _logger;
+	};
+
+	class GetRunnable: public Runnable
+	{
+	public:
+		GetRunnable(): _ok(true)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < 1000; ++i)
+			{
+				std::string name("Concurrent.");
+				name += Poco::NumberFormatter::format(i % 200);
+				Logger& logger = Logger::get(name);
+				if (logger.name() != name || Logger::has(name) != &logger) _ok = false;
+			}
+		}
+
+		bool ok() const
+		{
+			return _ok;
+		}
+
+	private:
+		bool _ok;
+	};
+
+	class HasRunnable: public Runnable
+	{
+	public:
+		HasRunnable(): _stop(false)
+		{
+		}
+
+		void run()
+		{
+			while (!_stop)
+			{
+				for (int i = 0; i < 50; ++i)
+				{
+					std::string name("Shutdown.");
+					name += Poco::NumberFormatter::format(i);
+					Logger::has(name);
+				}
+			}
+		}
+
+		void stop()
+		{
+			_stop = true;
+		}
+
+	private:
+		volatile bool _stop;
+	};
+
+	class LookupRunnable: public Runnable
+	{
+	public:
+		void run()
+		{
+			const int N = 1000000;
+			const std::string name("Benchmark.Lookup");
+
+			Poco::Stopwatch sw;
+			sw.start();
+			for (int i = 0; i < N; ++i)
+			{
+				Logger::get(name);
+			}
+			sw.stop();
+			std::cout << N << " lookups: " << sw.elapsed()*1000/N << " ns/lookup" << std::endl;
+		}
+	};
+}
 
 
 LoggerTest::LoggerTest(const std::string& name): CppUnit::TestCase(name)
@@ -219,6 +387,194 @@ void LoggerTest::testFormatAny()
 
 	root.error("%d%d%d%d%d%d", 1, 2, 3, 4, 5, 6);
 	assert (pChannel->getLastMessage().getText() == "123456");
+
+	pChannel->clear();
+	root.setLevel(Message::PRIO_ERROR);
+	root.warning("%d", 1);
+	root.warning("%d%d%d%d%d%d", 1, 2, 3, 4, 5, 6);
+	assert (pChannel->list().empty());
+}
+
+
+void LoggerTest::testThreadMessages()
+{
+	AutoPtr<TestChannel> pInner = new TestChannel;
+	Logger& inner = Logger::get("Inner");
+	inner.setChannel(pInner.get());
+	inner.setLevel(Message::PRIO_INFORMATION);
+
+	AutoPtr<NestedChannel> pChannel = new NestedChannel(inner);
+	Logger& logger = Logger::get("Outer");
+	logger.setChannel(pChannel.get());
+	logger.setLevel(Message::PRIO_INFORMATION);
+
+	LoggingRunnable runnable(logger);
+	Thread thread("worker");
+	thread.start(runnable);
+	thread.join();
+
+	assert (pChannel->list().size() == 4);
+	TestChannel::MsgList::const_iterator it = pChannel->list().begin();
+	assert (it->getText() == "one");
+	assert (it->getSource() == "Outer");
+	assert (it->getPriority() == Message::PRIO_INFORMATION);
+	assert (it->getThread() == "worker");
+	assert (it->getTid() == thread.id());
+	assert (it->getSourceFile() == 0);
+	assert (it->getSourceLine() == 0);
+	++it;
+	assert (it->getText() == "two");
+	assert (it->getSourceFile() != 0);
+	assert (it->getSourceLine() != 0);
+	++it;
+	assert (it->getText() == "three");
+	assert (it->getSourceFile() == 0);
+	assert (it->getSourceLine() == 0);
+	++it;
+	assert (it->getText() == "four");
+	assert (it->getPriority() == Message::PRIO_WARNING);
+	assert (it->getThread() == "renamed");
+
+	assert (pInner->list().size() == 4);
+	it = pInner->list().begin();
+	assert (it->getText() == "nested: one");
+	assert (it->getSource() == "Inner");
+	++it;
+	assert (it->getText() == "nested: two");
+	++it;
+	assert (it->getText() == "nested: three");
+	++it;
+	assert (it->getText() == "nested: four");
+	assert (it->getThread() == "renamed");
+}
+
+
+void LoggerTest::testConcurrentGet()
+{
+	GetRunnable r1;
+	GetRunnable r2;
+	GetRunnable r3;
+	GetRunnable r4;
+	Thread t1;
+	Thread t2;
+	Thread t3;
+	Thread t4;
+	t1.start(r1);
+	t2.start(r2);
+	t3.start(r3);
+	t4.start(r4);
+	t1.join();
+	t2.join();
+	t3.join();
+	t4.join();
+	assert (r1.ok() && r2.ok() && r3.ok() && r4.ok());
+
+	std::vector<std::string> names;
+	Logger::names(names);
+	assert (names.size() == 201); // root and Concurrent.0 .. Concurrent.199
+
+	Logger::destroy("Concurrent.1");
+	assert (Logger::has("Concurrent.1") == 0);
+	assert (Logger::has("Concurrent.2") != 0);
+	Logger& logger = Logger::get("Concurrent.1");
+	assert (Logger::has("Concurrent.1") == &logger);
+}
+
+
+void LoggerTest::testConcurrentShutdown()
+{
+	HasRunnable r1;
+	HasRunnable r2;
+	Thread t1;
+	Thread t2;
+	t1.start(r1);
+	t2.start(r2);
+	for (int n = 0; n < 100; ++n)
+	{
+		// make the index grow, then shut down while
+		// the other threads are searching it
+		for (int i = 0; i < 50; ++i)
+		{
+			std::string name("Shutdown.");
+			name += Poco::NumberFormatter::format(i);
+			Logger::get(name);
+		}
+		Logger::shutdown();
+		assert (Logger::has("Shutdown.1") == 0);
+	}
+	r1.stop();
+	r2.stop();
+	t1.join();
+	t2.join();
+	Logger& logger = Logger::get("Shutdown.1");
+	assert (Logger::has("Shutdown.1") == &logger);
+}
+
+
+void LoggerTest::testHandle()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	Logger::root().setChannel(pChannel.get());
+
+	LoggerHandle handle("Handle");
+	assert (handle.name() == "Handle");
+	Logger& logger = handle.logger();
+	assert (&logger == Logger::has("Handle"));
+	assert (&*handle == &logger);
+	assert (handle->name() == "Handle");
+
+	handle->setLevel(Message::PRIO_DEBUG);
+	poco_notice(*handle, "notice");
+	assert (pChannel->list().size() == 1);
+	assert (pChannel->getLastMessage().getSource() == "Handle");
+
+	Logger::destroy("Handle");
+	assert (Logger::has("Handle") == 0);
+	handle->information("information");
+	assert (Logger::has("Handle") != 0);
+	assert (handle->getLevel() == Message::PRIO_INFORMATION);
+	assert (pChannel->list().size() == 2);
+
+	Logger::shutdown();
+	assert (Logger::has("Handle") == 0);
+	assert (handle->name() == "Handle");
+	assert (handle->getChannel() == 0);
+	assert (&handle.logger() == Logger::has("Handle"));
+}
+
+
+void LoggerTest::benchmarkGet()
+{
+	LookupRunnable r1;
+	LookupRunnable r2;
+	LookupRunnable r3;
+	LookupRunnable r4;
+	Thread t1;
+	Thread t2;
+	Thread t3;
+	Thread t4;
+	t1.start(r1);
+	t2.start(r2);
+	t3.start(r3);
+	t4.start(r4);
+	t1.join();
+	t2.join();
+	t3.join();
+	t4.join();
+}
+
+
+void LoggerTest::benchmarkLog()
+{
+	AutoPtr<Poco::NullChannel> pChannel = new Poco::NullChannel;
+	Logger& logger = Logger::get("Benchmark");
+	logger.setChannel(pChannel.get());
+	logger.setLevel(Message::PRIO_INFORMATION);
+
+	BenchmarkRunnable runnable(logger);
+	Thread thread("benchmark");
+	thread.start(runnable);
+	thread.join();
 }
 
 
@@ -281,6 +637,12 @@ CppUnit::Test* LoggerTest::suite()
 	CppUnit_addTest(pSuite, LoggerTest, testFormat);
 	CppUnit_addTest(pSuite, LoggerTest, testFormatAny);
 	CppUnit_addTest(pSuite, LoggerTest, testDump);
+	CppUnit_addTest(pSuite, LoggerTest, testThreadMessages);
+	CppUnit_addTest(pSuite, LoggerTest, testConcurrentGet);
+	CppUnit_addTest(pSuite, LoggerTest, testConcurrentShutdown);
+	CppUnit_addTest(pSuite, LoggerTest, testHandle);
+//	CppUnit_addTest(pSuite, LoggerTest, benchmarkGet);
+//	CppUnit_addTest(pSuite, LoggerTest, benchmarkLog);
 
 	return pSuite;
 }
@@ -50,6 +50,12 @@ public:
 	void testFormat();
 	void testFormatAny();
 	void testDump();
+	void testThreadMessages();
+	void testConcurrentGet();
+	void testConcurrentShutdown();
+	void testHandle();
+	void benchmarkLog();
+	void benchmarkGet();
 
 	void setUp();
 	void tearDown();
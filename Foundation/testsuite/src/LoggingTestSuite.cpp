@@ -36,6 +36,7 @@
 #include "PatternFormatterTest.h"
 #include "FileChannelTest.h"
 #include "SimpleFileChannelTest.h"
+#include "BinaryFileChannelTest.h"
 #include "LoggingFactoryTest.h"
 #include "LoggingRegistryTest.h"
 #include "LogStreamTest.h"
@@ -50,6 +51,7 @@ CppUnit::Test* LoggingTestSuite::suite()
 	pSuite->addTest(PatternFormatterTest::suite());
 	pSuite->addTest(FileChannelTest::suite());
 	pSuite->addTest(SimpleFileChannelTest::suite());
+	pSuite->addTest(BinaryFileChannelTest::suite());
 	pSuite->addTest(LoggingFactoryTest::suite());
 	pSuite->addTest(LoggingRegistryTest::suite());
 	pSuite->addTest(LogStreamTest::suite());
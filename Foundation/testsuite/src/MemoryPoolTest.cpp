@@ -34,10 +34,62 @@
 #include "CppUnit/TestCaller.h"
 #include "CppUnit/TestSuite.h"
 #include "Poco/MemoryPool.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
 #include <vector>
+#include <cstring>
 
 
 using Poco::MemoryPool;
+using Poco::Thread;
+
+
+namespace
+{
+	class PoolUser: public Poco::Runnable
+	{
+	public:
+		PoolUser(MemoryPool& pool, int blocks, int rounds):
+			_pool(pool),
+			_blocks(blocks),
+			_rounds(rounds),
+			_gets(0)
+		{
+		}
+
+		void run()
+		{
+			std::vector<void*> ptrs;
+			for (int r = 0; r < _rounds; ++r)
+			{
+				int n = 1 + (r % _blocks);
+				for (int i = 0; i < n; ++i)
+				{
+					void* ptr = _pool.get();
+					std::memset(ptr, r & 0xFF, _pool.blockSize());
+					ptrs.push_back(ptr);
+					++_gets;
+				}
+				for (std::vector<void*>::iterator it = ptrs.begin(); it != ptrs.end(); ++it)
+				{
+					_pool.release(*it);
+				}
+				ptrs.clear();
+			}
+		}
+
+		int gets() const
+		{
+			return _gets;
+		}
+
+	private:
+		MemoryPool& _pool;
+		int _blocks;
+		int _rounds;
+		int _gets;
+	};
+}
 
 
 MemoryPoolTest::MemoryPoolTest(const std::string& name): CppUnit::TestCase(name)
@@ -90,6 +142,94 @@ void MemoryPoolTest::testMemoryPool()
 }
 
 
+void MemoryPoolTest::testThreadCache()
+{
+	MemoryPool pool(64, 0, 0, 8);
+	assert (pool.threadCacheSize() == 8);
+
+	PoolUser user(pool, 4, 8);
+	{
+		Thread thread;
+		thread.start(user);
+		thread.join();
+	}
+	// the first get() allocates a batch of 4 blocks, all
+	// other blocks needed by rounds 0-7 come from the cache
+	assert (user.gets() == 20);
+	assert (pool.allocated() == 4);
+	assert (pool.available() == 4);
+	assert (pool.cacheMisses() == 1);
+	assert (pool.cacheHits() == 19);
+
+	// threads not created by Poco::Thread use the shared list of blocks
+	void* ptr = pool.get();
+	assert (pool.available() == 3);
+	pool.release(ptr);
+	assert (pool.available() == 4);
+	assert (pool.cacheMisses() == 1);
+	assert (pool.cacheHits() == 19);
+
+	// a batch never exceeds maxAlloc
+	MemoryPool pool2(64, 0, 2, 8);
+	PoolUser user2(pool2, 2, 2);
+	{
+		Thread thread;
+		thread.start(user2);
+		thread.join();
+	}
+	assert (pool2.allocated() == 2);
+	assert (pool2.available() == 2);
+	assert (pool2.cacheMisses() == 1);
+	assert (pool2.cacheHits() == 2);
+}
+
+
+void MemoryPoolTest::testThreadCacheMultiThread()
+{
+	MemoryPool pool(128, 0, 0, 16);
+
+	std::vector<PoolUser*> users;
+	std::vector<Thread*> threads;
+	for (int i = 0; i < 4; ++i)
+	{
+		users.push_back(new PoolUser(pool, 24, 2000));
+		threads.push_back(new Thread);
+	}
+	for (int i = 0; i < 4; ++i)
+	{
+		threads[i]->start(*users[i]);
+	}
+	int gets = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		threads[i]->join();
+		delete threads[i];
+		gets += users[i]->gets();
+		delete users[i];
+	}
+	assert (pool.allocated() == pool.available());
+	assert (pool.allocated() <= 4*24);
+	assert (pool.cacheHits() + pool.cacheMisses() == static_cast<Poco::UInt64>(gets));
+	assert (pool.cacheHits() > pool.cacheMisses());
+}
+
+
+void MemoryPoolTest::testThreadCacheOutlivesPool()
+{
+	MemoryPool* pPool = new MemoryPool(64, 0, 0, 8);
+	PoolUser user(*pPool, 4, 4);
+	Thread thread;
+	thread.start(user);
+	thread.join();
+
+	// the thread's cache still holds blocks, which will be
+	// freed when the thread object is destroyed
+	assert (pPool->allocated() == 4);
+	assert (pPool->available() == 0);
+	delete pPool;
+}
+
+
 void MemoryPoolTest::setUp()
 {
 }
@@ -105,6 +245,9 @@ CppUnit::Test* MemoryPoolTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("MemoryPoolTest");
 
 	CppUnit_addTest(pSuite, MemoryPoolTest, testMemoryPool);
+	CppUnit_addTest(pSuite, MemoryPoolTest, testThreadCache);
+	CppUnit_addTest(pSuite, MemoryPoolTest, testThreadCacheMultiThread);
+	CppUnit_addTest(pSuite, MemoryPoolTest, testThreadCacheOutlivesPool);
 
 	return pSuite;
 }
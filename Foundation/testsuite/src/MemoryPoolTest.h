@@ -47,6 +47,9 @@ public:
 	~MemoryPoolTest();
 
 	void testMemoryPool();
+	void testThreadCache();
+	void testThreadCacheMultiThread();
+	void testThreadCacheOutlivesPool();
 
 	void setUp();
 	void tearDown();
@@ -0,0 +1,686 @@
+//
+// OpenHashTableTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "OpenHashTableTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/OpenHashTable.h"
+#include "Poco/OpenHashMap.h"
+#include "Poco/OpenHashSet.h"
+#include "Poco/LinearHashTable.h"
+#include "Poco/Random.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Exception.h"
+#include <set>
+#include <iostream>
+
+
+using Poco::OpenHashTable;
+using Poco::OpenHashMap;
+using Poco::OpenHashSet;
+using Poco::LinearHashTable;
+using Poco::Hash;
+using Poco::SeededHash;
+using Poco::Stopwatch;
+using Poco::NumberFormatter;
+
+
+namespace
+{
+	struct BadHash
+		/// Maps all values to a few hash values.
+	{
+		std::size_t operator () (int value) const
+		{
+			return value % 4;
+		}
+	};
+
+	struct ConstHash
+		/// Maps all values to the same hash value.
+	{
+		std::size_t operator () (int) const
+		{
+			return 0;
+		}
+	};
+}
+
+
+OpenHashTableTest::OpenHashTableTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+OpenHashTableTest::~OpenHashTableTest()
+{
+}
+
+
+void OpenHashTableTest::testInsert()
+{
+	const int N = 1000;
+
+	OpenHashTable<int, Hash<int> > ht;
+	
+	assert (ht.empty());
+	
+	for (int i = 0; i < N; ++i)
+	{
+		std::pair<OpenHashTable<int, Hash<int> >::Iterator, bool> res = ht.insert(i);
+		assert (*res.first == i);
+		assert (res.second);
+		OpenHashTable<int, Hash<int> >::Iterator it = ht.find(i);
+		assert (it != ht.end());
+		assert (*it == i);
+		assert (ht.size() == std::size_t(i + 1));
+	}		
+	assert (ht.buckets() >= N);
+	assert (ht.buckets() <= 4*N);
+	
+	assert (!ht.empty());
+	
+	for (int i = 0; i < N; ++i)
+	{
+		OpenHashTable<int, Hash<int> >::Iterator it = ht.find(i);
+		assert (it != ht.end());
+		assert (*it == i);
+	}
+	
+	for (int i = 0; i < N; ++i)
+	{
+		std::pair<OpenHashTable<int, Hash<int> >::Iterator, bool> res = ht.insert(i);
+		assert (*res.first == i);
+		assert (!res.second);
+		assert (ht.size() == N);
+	}		
+}
+
+
+void OpenHashTableTest::testErase()
+{
+	const int N = 1000;
+
+	OpenHashTable<int, Hash<int> > ht;
+
+	for (int i = 0; i < N; ++i)
+	{
+		ht.insert(i);
+	}
+	assert (ht.size() == N);
+	
+	for (int i = 0; i < N; i += 2)
+	{
+		ht.erase(i);
+		OpenHashTable<int, Hash<int> >::Iterator it = ht.find(i);
+		assert (it == ht.end());
+	}
+	assert (ht.size() == N/2);
+	
+	for (int i = 0; i < N; i += 2)
+	{
+		OpenHashTable<int, Hash<int> >::Iterator it = ht.find(i);
+		assert (it == ht.end());
+	}
+	
+	for (int i = 1; i < N; i += 2)
+	{
+		OpenHashTable<int, Hash<int> >::Iterator it = ht.find(i);
+		assert (it != ht.end());
+		assert (*it == i);
+	}
+
+	for (int i = 0; i < N; i += 2)
+	{
+		ht.insert(i);
+	}
+	
+	for (int i = 0; i < N; ++i)
+	{
+		OpenHashTable<int, Hash<int> >::Iterator it = ht.find(i);
+		assert (it != ht.end());
+		assert (*it == i);
+	}
+
+	OpenHashTable<int, Hash<int> >::Iterator it = ht.find(7);
+	ht.erase(it);
+	assert (ht.count(7) == 0);
+	assert (ht.size() == N - 1);
+	ht.erase(7);
+	assert (ht.size() == N - 1);
+}
+
+
+void OpenHashTableTest::testRandom()
+{
+	const int N = 10000;
+
+	OpenHashTable<int, Hash<int> > ht(8);
+	std::set<int> values;
+	Poco::Random rnd;
+	rnd.seed(42);
+	for (int i = 0; i < 20*N; ++i)
+	{
+		int value = static_cast<int>(rnd.next(N));
+		if (rnd.next(3) == 0)
+		{
+			ht.erase(value);
+			values.erase(value);
+		}
+		else
+		{
+			std::pair<OpenHashTable<int, Hash<int> >::Iterator, bool> res = ht.insert(value);
+			assert (*res.first == value);
+			assert (res.second == values.insert(value).second);
+		}
+		assert (ht.size() == values.size());
+	}
+	for (int i = 0; i < N; ++i)
+	{
+		assert (ht.count(i) == values.count(i));
+	}
+	std::set<int> found;
+	for (OpenHashTable<int, Hash<int> >::ConstIterator it = ht.begin(); it != ht.end(); ++it)
+	{
+		assert (found.insert(*it).second);
+	}
+	assert (found == values);
+}
+
+
+void OpenHashTableTest::testCollisions()
+{
+	const int N = 200;
+
+	OpenHashTable<int, BadHash> ht;
+	for (int i = 0; i < N; ++i)
+	{
+		assert (ht.insert(i).second);
+	}
+	assert (ht.size() == N);
+	for (int i = 0; i < N; ++i)
+	{
+		assert (ht.count(i) == 1);
+	}
+	for (int i = 0; i < N; i += 3)
+	{
+		ht.erase(i);
+	}
+	for (int i = 0; i < N; ++i)
+	{
+		assert (ht.count(i) == (i % 3 == 0 ? 0 : 1));
+	}
+}
+
+
+void OpenHashTableTest::testSameHash()
+{
+	OpenHashTable<int, ConstHash> ht;
+	int n = 0;
+	try
+	{
+		for (;;)
+		{
+			ht.insert(n);
+			++n;
+		}
+	}
+	catch (Poco::RangeException&)
+	{
+	}
+	assert (n == 254);
+	assert (ht.size() == std::size_t(n));
+	assert (ht.buckets() <= 1024);
+	for (int i = 0; i < n; ++i)
+	{
+		assert (ht.count(i) == 1);
+	}
+	assert (ht.count(n) == 0);
+	assert (!ht.insert(0).second);
+
+	ht.erase(0);
+	assert (ht.insert(n).second);
+	assert (ht.count(n) == 1);
+}
+
+
+void OpenHashTableTest::testClear()
+{
+	const int N = 1000;
+
+	OpenHashTable<std::string> ht;
+	for (int i = 0; i < N; ++i)
+	{
+		ht.insert(NumberFormatter::format(i));
+	}
+	std::size_t buckets = ht.buckets();
+	ht.clear();
+	assert (ht.empty());
+	assert (ht.buckets() == buckets);
+	assert (ht.begin() == ht.end());
+	assert (ht.count("1") == 0);
+
+	ht.reserve(4*N);
+	buckets = ht.buckets();
+	assert (buckets >= 4*N);
+	for (int i = 0; i < 4*N; ++i)
+	{
+		ht.insert(NumberFormatter::format(i));
+	}
+	assert (ht.buckets() == buckets);
+	assert (ht.size() == 4*N);
+}
+
+
+void OpenHashTableTest::testIterator()
+{
+	const int N = 1000;
+
+	OpenHashTable<int, Hash<int> > ht;
+
+	for (int i = 0; i < N; ++i)
+	{
+		ht.insert(i);
+	}
+	
+	std::set<int> values;
+	OpenHashTable<int, Hash<int> >::Iterator it = ht.begin();
+	while (it != ht.end())
+	{
+		assert (values.find(*it) == values.end());
+		values.insert(*it);
+		++it;
+	}
+	
+	assert (values.size() == N);
+}
+
+
+void OpenHashTableTest::testConstIterator()
+{
+	const int N = 1000;
+
+	OpenHashTable<int, Hash<int> > ht;
+
+	for (int i = 0; i < N; ++i)
+	{
+		ht.insert(i);
+	}
+
+	std::set<int> values;
+	OpenHashTable<int, Hash<int> >::ConstIterator it = ht.begin();
+	while (it != ht.end())
+	{
+		assert (values.find(*it) == values.end());
+		values.insert(*it);
+		++it;
+	}
+	
+	assert (values.size() == N);
+	
+	values.clear();
+	const OpenHashTable<int, Hash<int> > cht(ht);
+
+	OpenHashTable<int, Hash<int> >::ConstIterator cit = cht.begin();
+	while (cit != cht.end())
+	{
+		assert (values.find(*cit) == values.end());
+		values.insert(*cit);
+		++cit;
+	}
+	
+	assert (values.size() == N);	
+}
+
+
+void OpenHashTableTest::testStringKeys()
+{
+	OpenHashSet<std::string> set;
+	set.insert("one");
+	set.insert(std::string("two"));
+	assert (set.count("one") == 1);
+	assert (set.count("three") == 0);
+	const char* two = "two";
+	OpenHashSet<std::string>::Iterator it = set.find(two);
+	assert (it != set.end());
+	assert (*it == "two");
+	set.erase("one");
+	assert (set.size() == 1);
+	assert (set.find("one") == set.end());
+
+	OpenHashMap<std::string, int> map;
+	map["one"] = 1;
+	map[std::string("two")] = 2;
+	assert (map.count("one") == 1);
+	assert (map.find("two")->second == 2);
+	assert (map.find(std::string("one"))->second == 1);
+	assert (map.find("three") == map.end());
+	map.erase("two");
+	assert (map.size() == 1);
+
+	assert (Hash<std::string>()("hello") == Hash<std::string>()(std::string("hello")));
+	assert (Hash<std::string>()("hello") == Poco::hash(std::string("hello")));
+}
+
+
+void OpenHashTableTest::testMap()
+{
+	const int N = 1000;
+
+	typedef OpenHashMap<int, int> IntMap;
+	IntMap hm;
+	for (int i = 0; i < N; ++i)
+	{
+		std::pair<IntMap::Iterator, bool> res = hm.insert(IntMap::ValueType(i, i*2));
+		assert (res.first->first == i);
+		assert (res.first->second == i*2);
+		assert (res.second);
+	}
+	for (int i = 0; i < N; ++i)
+	{
+		std::pair<IntMap::Iterator, bool> res = hm.insert(IntMap::PairType(i, 0));
+		assert (res.first->second == i*2);
+		assert (!res.second);
+	}
+	for (int i = 0; i < N; ++i)
+	{
+		assert (hm[i] == i*2);
+		hm[i] = i*3;
+	}
+	const IntMap& chm = hm;
+	for (int i = 0; i < N; ++i)
+	{
+		assert (chm[i] == i*3);
+	}
+	try
+	{
+		chm[N];
+		fail("no such key - must throw");
+	}
+	catch (Poco::NotFoundException&)
+	{
+	}
+	assert (hm.size() == N);
+
+	IntMap hm2(hm);
+	hm.clear();
+	assert (hm.empty());
+	assert (hm2.size() == N);
+	hm.swap(hm2);
+	assert (hm.size() == N);
+	assert (hm2.empty());
+}
+
+
+void OpenHashTableTest::testCopyHash()
+{
+	typedef OpenHashTable<std::string, SeededHash> SeededTable;
+	const int N = 100;
+
+	SeededTable ht1(64, SeededHash(1));
+	for (int i = 0; i < N; ++i)
+	{
+		ht1.insert(NumberFormatter::format(i));
+	}
+
+	// the copy must use the same seed to find the keys
+	SeededTable ht2(ht1);
+	assert (ht2.size() == N);
+	for (int i = 0; i < N; ++i)
+	{
+		assert (ht2.find(NumberFormatter::format(i)) != ht2.end());
+	}
+
+	SeededTable ht3(64, SeededHash(2));
+	ht3.swap(ht2);
+	assert (ht2.empty());
+	assert (ht3.size() == N);
+	for (int i = 0; i < N; ++i)
+	{
+		assert (ht3.find(NumberFormatter::format(i)) != ht3.end());
+	}
+	ht2.insert("x");
+	assert (ht2.find("x") != ht2.end());
+
+	SeededTable ht4;
+	ht4 = ht1;
+	for (int i = 0; i < N; ++i)
+	{
+		assert (ht4.find(NumberFormatter::format(i)) != ht4.end());
+	}
+}
+
+
+void OpenHashTableTest::testSet()
+{
+	const int N = 1000;
+
+	typedef OpenHashSet<int> IntSet;
+	IntSet hs;
+	for (int i = 0; i < N; ++i)
+	{
+		assert (hs.insert(i).second);
+	}
+	for (int i = 0; i < N; ++i)
+	{
+		assert (!hs.insert(i).second);
+		assert (hs.count(i) == 1);
+	}
+	for (int i = 0; i < N; i += 2)
+	{
+		hs.erase(i);
+	}
+	assert (hs.size() == N/2);
+	std::set<int> values;
+	for (IntSet::Iterator it = hs.begin(); it != hs.end(); ++it)
+	{
+		assert (*it % 2 == 1);
+		values.insert(*it);
+	}
+	assert (values.size() == N/2);
+}
+
+
+void OpenHashTableTest::benchmarkInt()
+{
+	const int N = 5000000;
+	Stopwatch sw;
+	int found = 0;
+
+	{
+		LinearHashTable<int, Hash<int> > lht;
+		sw.start();
+		for (int i = 0; i < N; ++i)
+		{
+			lht.insert(i);
+		}
+		sw.stop();
+		std::cout << "Insert LHT: " << sw.elapsed()/1000 << " ms" << std::endl;
+		sw.reset();
+
+		sw.start();
+		for (int i = 0; i < N; ++i)
+		{
+			if (lht.find(i) != lht.end()) ++found;
+		}
+		sw.stop();
+		std::cout << "Find LHT: " << sw.elapsed()/1000 << " ms (" << found << ")" << std::endl;
+		found = 0;
+		sw.reset();
+
+		sw.start();
+		for (int i = N; i < 2*N; ++i)
+		{
+			if (lht.find(i) != lht.end()) ++found;
+		}
+		sw.stop();
+		std::cout << "Find (missing) LHT: " << sw.elapsed()/1000 << " ms (" << found << ")" << std::endl;
+		found = 0;
+		sw.reset();
+	}
+
+	{
+		OpenHashTable<int, Hash<int> > oht;
+		sw.start();
+		for (int i = 0; i < N; ++i)
+		{
+			oht.insert(i);
+		}
+		sw.stop();
+		std::cout << "Insert OHT: " << sw.elapsed()/1000 << " ms" << std::endl;
+		sw.reset();
+
+		sw.start();
+		for (int i = 0; i < N; ++i)
+		{
+			if (oht.find(i) != oht.end()) ++found;
+		}
+		sw.stop();
+		std::cout << "Find OHT: " << sw.elapsed()/1000 << " ms (" << found << ")" << std::endl;
+		found = 0;
+		sw.reset();
+
+		sw.start();
+		for (int i = N; i < 2*N; ++i)
+		{
+			if (oht.find(i) != oht.end()) ++found;
+		}
+		sw.stop();
+		std::cout << "Find (missing) OHT: " << sw.elapsed()/1000 << " ms (" << found << ")" << std::endl;
+		found = 0;
+		sw.reset();
+	}
+}
+
+
+void OpenHashTableTest::benchmarkStr()
+{
+	const int N = 5000000;
+	Stopwatch sw;
+	int found = 0;
+
+	std::vector<std::string> values;
+	for (int i = 0; i < N; ++i)
+	{
+		values.push_back(NumberFormatter::format0(i, 8));
+	}
+
+	{
+		LinearHashTable<std::string, Hash<std::string> > lht;
+		sw.start();
+		for (int i = 0; i < N; ++i)
+		{
+			lht.insert(values[i]);
+		}
+		sw.stop();
+		std::cout << "Insert LHT: " << sw.elapsed()/1000 << " ms" << std::endl;
+		sw.reset();
+
+		sw.start();
+		for (int i = 0; i < N; ++i)
+		{
+			if (lht.find(values[i]) != lht.end()) ++found;
+		}
+		sw.stop();
+		std::cout << "Find LHT: " << sw.elapsed()/1000 << " ms (" << found << ")" << std::endl;
+		found = 0;
+		sw.reset();
+	}
+
+	{
+		OpenHashTable<std::string, Hash<std::string> > oht;
+		sw.start();
+		for (int i = 0; i < N; ++i)
+		{
+			oht.insert(values[i]);
+		}
+		sw.stop();
+		std::cout << "Insert OHT: " << sw.elapsed()/1000 << " ms" << std::endl;
+		sw.reset();
+
+		sw.start();
+		for (int i = 0; i < N; ++i)
+		{
+			if (oht.find(values[i]) != oht.end()) ++found;
+		}
+		sw.stop();
+		std::cout << "Find OHT: " << sw.elapsed()/1000 << " ms (" << found << ")" << std::endl;
+		found = 0;
+		sw.reset();
+
+		sw.start();
+		for (int i = 0; i < N; ++i)
+		{
+			if (oht.find(values[i].c_str()) != oht.end()) ++found;
+		}
+		sw.stop();
+		std::cout << "Find OHT (const char*): " << sw.elapsed()/1000 << " ms (" << found << ")" << std::endl;
+		found = 0;
+		sw.reset();
+	}
+}
+
+
+void OpenHashTableTest::setUp()
+{
+}
+
+
+void OpenHashTableTest::tearDown()
+{
+}
+
+
+CppUnit::Test* OpenHashTableTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("OpenHashTableTest");
+
+	CppUnit_addTest(pSuite, OpenHashTableTest, testInsert);
+	CppUnit_addTest(pSuite, OpenHashTableTest, testErase);
+	CppUnit_addTest(pSuite, OpenHashTableTest, testRandom);
+	CppUnit_addTest(pSuite, OpenHashTableTest, testCollisions);
+	CppUnit_addTest(pSuite, OpenHashTableTest, testSameHash);
+	CppUnit_addTest(pSuite, OpenHashTableTest, testClear);
+	CppUnit_addTest(pSuite, OpenHashTableTest, testIterator);
+	CppUnit_addTest(pSuite, OpenHashTableTest, testConstIterator);
+	CppUnit_addTest(pSuite, OpenHashTableTest, testStringKeys);
+	CppUnit_addTest(pSuite, OpenHashTableTest, testMap);
+	CppUnit_addTest(pSuite, OpenHashTableTest, testCopyHash);
+	CppUnit_addTest(pSuite, OpenHashTableTest, testSet);
+//	CppUnit_addTest(pSuite, OpenHashTableTest, benchmarkInt);
+//	CppUnit_addTest(pSuite, OpenHashTableTest, benchmarkStr);
+
+	return pSuite;
+}
+
+
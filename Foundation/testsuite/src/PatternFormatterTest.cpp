@@ -36,11 +36,80 @@
 #include "Poco/PatternFormatter.h"
 #include "Poco/Message.h"
 #include "Poco/DateTime.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Event.h"
+#include "Poco/Mutex.h"
+#include <iostream>
+#include <set>
+#if defined(POCO_OS_FAMILY_UNIX)
+#include <pthread.h>
+#endif
 
 
 using Poco::PatternFormatter;
 using Poco::Message;
 using Poco::DateTime;
+using Poco::Timestamp;
+using Poco::Thread;
+using Poco::Event;
+using Poco::FastMutex;
+
+
+namespace
+{
+	class CacheIndexFormatter: public PatternFormatter
+	{
+	public:
+		static int index()
+		{
+			return cacheIndex();
+		}
+	};
+
+	class CacheIndexRecorder: public Poco::Runnable
+	{
+	public:
+		CacheIndexRecorder(): _ready(false)
+		{
+		}
+
+		void run()
+		{
+			{
+				FastMutex::ScopedLock lock(_mutex);
+				_indexes.insert(CacheIndexFormatter::index());
+			}
+			// keep the thread alive until all threads have
+			// been created, so that thread ids are not reused
+			_ready.wait();
+		}
+
+		void release()
+		{
+			_ready.set();
+		}
+
+		const std::set<int>& indexes() const
+		{
+			return _indexes;
+		}
+
+	private:
+		std::set<int> _indexes;
+		FastMutex _mutex;
+		Event _ready;
+	};
+
+#if defined(POCO_OS_FAMILY_UNIX)
+	extern "C" void* runRecorder(void* pRecorder)
+	{
+		static_cast<CacheIndexRecorder*>(pRecorder)->run();
+		return 0;
+	}
+#endif
+}
 
 
 PatternFormatterTest::PatternFormatterTest(const std::string& name): CppUnit::TestCase(name)
@@ -116,6 +185,97 @@ void PatternFormatterTest::testPatternFormatter()
 }
 
 
+void PatternFormatterTest::testCachedRuns()
+{
+	Message msg("TestSource", "Test message text", Message::PRIO_WARNING);
+	PatternFormatter fmt("%Y-%m-%d %H:%M:%S.%i %c %F [%q] %s: %t");
+
+	std::string result;
+	msg.setTime(DateTime(2013, 3, 1, 23, 59, 59, 250, 125).timestamp());
+	fmt.format(msg, result);
+	assert (result == "2013-03-01 23:59:59.250 2 250125 [W] TestSource: Test message text");
+
+	result.clear();
+	msg.setTime(DateTime(2013, 3, 1, 23, 59, 59, 999, 999).timestamp());
+	fmt.format(msg, result);
+	assert (result == "2013-03-01 23:59:59.999 9 999999 [W] TestSource: Test message text");
+
+	result.clear();
+	msg.setTime(DateTime(2013, 3, 2, 0, 0, 0, 1).timestamp());
+	fmt.format(msg, result);
+	assert (result == "2013-03-02 00:00:00.001 0 001000 [W] TestSource: Test message text");
+
+	result.clear();
+	msg.setTime(DateTime(1969, 12, 31, 23, 59, 59, 750).timestamp());
+	fmt.format(msg, result);
+	assert (result == "1969-12-31 23:59:59.750 7 750000 [W] TestSource: Test message text");
+
+	result.clear();
+	fmt.setProperty("pattern", "%w %b %e %H:%M:%S %E|%[missing]|%t");
+	fmt.format(msg, result);
+	assert (result == "Wed Dec 31 23:59:59 0||Test message text");
+
+	result.clear();
+	msg.setTime(DateTime(2013, 3, 2, 0, 0, 0, 1).timestamp());
+	fmt.format(msg, result);
+	assert (result == "Sat Mar 2 00:00:00 1362182400||Test message text");
+}
+
+
+void PatternFormatterTest::testCacheIndex()
+{
+	int index = CacheIndexFormatter::index();
+	assert (index >= 0 && index < 16);
+
+	CacheIndexRecorder recorder;
+	Thread threads[4];
+	for (int i = 0; i < 4; ++i) threads[i].start(recorder);
+	recorder.release();
+	for (int i = 0; i < 4; ++i) threads[i].join();
+	assert (recorder.indexes().size() > 1);
+
+#if defined(POCO_OS_FAMILY_UNIX)
+	// threads not created by Poco::Thread
+	CacheIndexRecorder nativeRecorder;
+	pthread_t nativeThreads[8];
+	for (int i = 0; i < 8; ++i)
+	{
+		assert (pthread_create(&nativeThreads[i], 0, runRecorder, &nativeRecorder) == 0);
+	}
+	nativeRecorder.release();
+	for (int i = 0; i < 8; ++i) pthread_join(nativeThreads[i], 0);
+	assert (nativeRecorder.indexes().size() > 1);
+	for (std::set<int>::const_iterator it = nativeRecorder.indexes().begin(); it != nativeRecorder.indexes().end(); ++it)
+	{
+		assert (*it >= 0 && *it < 16);
+	}
+#endif
+}
+
+
+void PatternFormatterTest::benchmarkFormat()
+{
+	const int N = 1000000;
+
+	Message msg("TestSource", "Test message text", Message::PRIO_INFORMATION);
+	Timestamp time = DateTime(2013, 3, 1, 14, 30, 15, 500).timestamp();
+	PatternFormatter fmt("%Y-%m-%d %H:%M:%S.%i [%p] %s: %t");
+	std::string result;
+	Poco::Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < N; ++i)
+	{
+		// 10000 messages per second
+		msg.setTime(time + Timestamp::TimeDiff(i)*100);
+		result.clear();
+		fmt.format(msg, result);
+	}
+	sw.stop();
+	std::cout << result << std::endl;
+	std::cout << N << " messages: " << sw.elapsed()*1000/N << " ns/message" << std::endl;
+}
+
+
 void PatternFormatterTest::setUp()
 {
 }
@@ -131,6 +291,9 @@ CppUnit::Test* PatternFormatterTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("PatternFormatterTest");
 
 	CppUnit_addTest(pSuite, PatternFormatterTest, testPatternFormatter);
+	CppUnit_addTest(pSuite, PatternFormatterTest, testCachedRuns);
+	CppUnit_addTest(pSuite, PatternFormatterTest, testCacheIndex);
+//	CppUnit_addTest(pSuite, PatternFormatterTest, benchmarkFormat);
 
 	return pSuite;
 }
@@ -47,6 +47,9 @@ public:
 	~PatternFormatterTest();
 
 	void testPatternFormatter();
+	void testCachedRuns();
+	void testCacheIndex();
+	void benchmarkFormat();
 
 	void setUp();
 	void tearDown();
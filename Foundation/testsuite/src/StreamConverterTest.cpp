@@ -306,6 +306,64 @@ void StreamConverterTest::testErrorsOut()
 }
 
 
+void StreamConverterTest::testMixedIn()
+{
+	UTF8Encoding utf8Encoding;
+	Latin1Encoding latin1Encoding;
+
+	std::string utf8Text;
+	std::string latin1Text;
+	for (int i = 0; i < 50; ++i)
+	{
+		utf8Text   += "The quick brown fox \xC3\xA4\xE2\x82\xAC";
+		latin1Text += "The quick brown fox \xE4?";
+	}
+
+	std::istringstream istr1(utf8Text + "\xFF" "abc");
+	std::ostringstream ostr1;
+	InputStreamConverter converter1(istr1, utf8Encoding, utf8Encoding);
+	StreamCopier::copyStream(converter1, ostr1);
+	assert (ostr1.str() == utf8Text + "?abc");
+	assert (converter1.errors() == 1);
+
+	std::istringstream istr2(utf8Text);
+	std::ostringstream ostr2;
+	InputStreamConverter converter2(istr2, utf8Encoding, latin1Encoding);
+	StreamCopier::copyStream(converter2, ostr2);
+	assert (ostr2.str() == latin1Text);
+	assert (converter2.errors() == 0);
+}
+
+
+void StreamConverterTest::testMixedOut()
+{
+	UTF8Encoding utf8Encoding;
+	Latin1Encoding latin1Encoding;
+
+	std::string utf8Text;
+	std::string latin1Text;
+	for (int i = 0; i < 50; ++i)
+	{
+		utf8Text   += "The quick brown fox \xC3\xA4\xE2\x82\xAC";
+		latin1Text += "The quick brown fox \xE4?";
+	}
+
+	std::ostringstream ostr1;
+	OutputStreamConverter converter1(ostr1, utf8Encoding, utf8Encoding);
+	converter1 << utf8Text;
+	converter1.write(utf8Text.data(), 21);
+	converter1.write(utf8Text.data() + 21, utf8Text.size() - 21);
+	assert (ostr1.str() == utf8Text + utf8Text);
+	assert (converter1.errors() == 0);
+
+	std::ostringstream ostr2;
+	OutputStreamConverter converter2(ostr2, utf8Encoding, latin1Encoding);
+	converter2 << utf8Text;
+	assert (ostr2.str() == latin1Text);
+	assert (converter2.errors() == 0);
+}
+
+
 void StreamConverterTest::setUp()
 {
 }
@@ -330,6 +388,8 @@ CppUnit::Test* StreamConverterTest::suite()
 	CppUnit_addTest(pSuite, StreamConverterTest, testLatin1toUTF8Out);
 	CppUnit_addTest(pSuite, StreamConverterTest, testErrorsIn);
 	CppUnit_addTest(pSuite, StreamConverterTest, testErrorsOut);
+	CppUnit_addTest(pSuite, StreamConverterTest, testMixedIn);
+	CppUnit_addTest(pSuite, StreamConverterTest, testMixedOut);
 
 	return pSuite;
 }
@@ -56,6 +56,8 @@ public:
 	void testLatin1toUTF8Out();
 	void testErrorsIn();
 	void testErrorsOut();
+	void testMixedIn();
+	void testMixedOut();
 
 	void setUp();
 	void tearDown();
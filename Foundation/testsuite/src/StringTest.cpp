@@ -41,6 +41,7 @@
 #include <iostream>
 #include <iomanip>
 #include <cstdio>
+#include <vector>
 
 
 using Poco::trimLeft;
@@ -305,6 +306,131 @@ void StringTest::testIcompare()
 }
 
 
+namespace
+{
+	int refIcompare(const std::string& s1, const std::string& s2)
+	{
+		std::string::size_type n = s1.size() < s2.size() ? s1.size() : s2.size();
+		for (std::string::size_type i = 0; i < n; ++i)
+		{
+			char c1 = static_cast<char>(Poco::Ascii::toLower(s1[i]));
+			char c2 = static_cast<char>(Poco::Ascii::toLower(s2[i]));
+			if (c1 < c2) return -1;
+			if (c1 > c2) return 1;
+		}
+		return s1.size() < s2.size() ? -1 : (s1.size() > s2.size() ? 1 : 0);
+	}
+}
+
+
+void StringTest::testCaseBlocks()
+{
+	// all byte values, at all block offsets
+	std::string all;
+	for (int i = 0; i < 256; ++i) all += static_cast<char>(i);
+	for (std::string::size_type offset = 0; offset < 40; ++offset)
+	{
+		std::string s(all.substr(offset) + all.substr(0, offset));
+		std::string lower(toLower(s));
+		std::string upper(toUpper(s));
+		assert (lower.size() == s.size() && upper.size() == s.size());
+		for (std::string::size_type i = 0; i < s.size(); ++i)
+		{
+			assert (lower[i] == static_cast<char>(Poco::Ascii::toLower(s[i])));
+			assert (upper[i] == static_cast<char>(Poco::Ascii::toUpper(s[i])));
+		}
+		assert (toLowerInPlace(s) == lower);
+		assert (toUpperInPlace(s) == upper);
+	}
+
+	std::string mixed("Content-Type: Text/HTML; Charset=UTF-8\xC4\xD6");
+	assert (toLower(mixed) == "content-type: text/html; charset=utf-8\xC4\xD6");
+	assert (toUpper(mixed) == "CONTENT-TYPE: TEXT/HTML; CHARSET=UTF-8\xC4\xD6");
+
+	std::wstring wide(L"Content-Type");
+	assert (toLower(wide) == L"content-type");
+	assert (toUpper(wide) == L"CONTENT-TYPE");
+}
+
+
+void StringTest::testIcompareBlocks()
+{
+	std::string base("x-forwarded-for: AbcDefGhiJklMnoPqrStuVwxYz0123456789@[`{\x80\xC1\xE1\xFF");
+	for (std::string::size_type length = 0; length <= base.size(); ++length)
+	{
+		std::string s1(base.substr(0, length));
+		std::string s2(toUpper(s1));
+		assert (icompare(s1, s2) == 0);
+		assert (icompare(s2, s1) == 0);
+		assert (icompare(s1, s2.c_str()) == 0);
+		for (std::string::size_type i = 0; i < length; ++i)
+		{
+			for (int delta = -1; delta <= 1; delta += 2)
+			{
+				std::string s3(s2);
+				s3[i] = static_cast<char>(s3[i] + delta);
+				assert (icompare(s1, s3) == refIcompare(s1, s3));
+				assert (icompare(s3, s1) == refIcompare(s3, s1));
+				assert (icompare(s1, s3.c_str()) == refIcompare(s1, std::string(s3.c_str())));
+			}
+		}
+		assert (icompare(s1, s2 + "a") < 0);
+		assert (icompare(s1 + "a", s2) > 0);
+	}
+
+	std::wstring w1(L"Accept-Encoding");
+	std::wstring w2(L"ACCEPT-ENCODING");
+	std::wstring w3(L"ACCEPT-ENCODINGS");
+	assert (icompare(w1, w2) == 0);
+	assert (icompare(w1, w3) < 0);
+	assert (icompare(w1, 0, 6, w3, 0, 6) == 0);
+	assert (icompare(w1, L"accept-encoding") == 0);
+}
+
+
+void StringTest::benchmarkIcompare()
+{
+	static const char* names[] = {"Accept", "Accept-Encoding", "Content-Type", "Content-Length", "X-Forwarded-For", "Transfer-Encoding", "Cache-Control", "If-Modified-Since"};
+	const int count = sizeof(names)/sizeof(names[0]);
+	std::vector<std::string> upper;
+	std::vector<std::string> lower;
+	for (int i = 0; i < count; ++i)
+	{
+		upper.push_back(names[i]);
+		lower.push_back(toLower(upper.back()));
+	}
+	const int iterations = 2000000;
+	int result = 0;
+	Poco::Stopwatch sw;
+	sw.start();
+	for (int k = 0; k < iterations; ++k)
+	{
+		for (int i = 0; i < count; ++i) result += refIcompare(upper[i], lower[(i + k) % count]);
+	}
+	sw.stop();
+	std::cout << "\nCharacter loop: " << sw.elapsed()/1000 << " ms (" << result << ")" << std::endl;
+	result = 0;
+	sw.restart();
+	for (int k = 0; k < iterations; ++k)
+	{
+		for (int i = 0; i < count; ++i) result += icompare(upper[i], lower[(i + k) % count]);
+	}
+	sw.stop();
+	std::cout << "icompare: " << sw.elapsed()/1000 << " ms (" << result << ")" << std::endl;
+
+	std::string text(4096, 'X');
+	sw.restart();
+	for (int k = 0; k < iterations/100; ++k)
+	{
+		text[k % 16] = 'X';
+		toLowerInPlace(text);
+		toUpperInPlace(text);
+	}
+	sw.stop();
+	std::cout << "toLowerInPlace/toUpperInPlace (4 KB): " << sw.elapsed()/1000 << " ms" << std::endl;
+}
+
+
 void StringTest::testTranslate()
 {
 	std::string s = "aabbccdd";
@@ -1081,6 +1207,9 @@ CppUnit::Test* StringTest::suite()
 	CppUnit_addTest(pSuite, StringTest, testToLower);
 	CppUnit_addTest(pSuite, StringTest, testIstring);
 	CppUnit_addTest(pSuite, StringTest, testIcompare);
+	CppUnit_addTest(pSuite, StringTest, testCaseBlocks);
+	CppUnit_addTest(pSuite, StringTest, testIcompareBlocks);
+	//CppUnit_addTest(pSuite, StringTest, benchmarkIcompare);
 	CppUnit_addTest(pSuite, StringTest, testTranslate);
 	CppUnit_addTest(pSuite, StringTest, testTranslateInPlace);
 	CppUnit_addTest(pSuite, StringTest, testReplace);
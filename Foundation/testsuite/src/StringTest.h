@@ -58,6 +58,9 @@ public:
 	void testToLower();
 	void testIstring();
 	void testIcompare();
+	void testCaseBlocks();
+	void testIcompareBlocks();
+	void benchmarkIcompare();
 	void testTranslate();
 	void testTranslateInPlace();
 	void testReplace();
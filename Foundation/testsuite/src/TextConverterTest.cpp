@@ -42,6 +42,10 @@
 #include "Poco/Windows1251Encoding.h"
 #include "Poco/Windows1252Encoding.h"
 #include "Poco/UTF8Encoding.h"
+#include "Poco/Unicode.h"
+#include "Poco/UnicodeConverter.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
 
 
 using namespace Poco;
@@ -348,6 +352,143 @@ void TextConverterTest::testErrors()
 }
 
 
+void TextConverterTest::testLegalLength()
+{
+	std::string ascii(40, 'a');
+	assert (UTF8Encoding::asciiLength(ascii.data(), 0) == 0);
+	assert (UTF8Encoding::asciiLength(ascii.data(), ascii.size()) == 40);
+	assert (UTF8Encoding::legalLength(ascii.data(), ascii.size()) == 40);
+	for (std::size_t i = 0; i < ascii.size(); ++i)
+	{
+		std::string text(ascii);
+		text[i] = (char) 0xC3;
+		assert (UTF8Encoding::asciiLength(text.data(), text.size()) == i);
+		assert (UTF8Encoding::legalLength(text.data(), text.size()) == i);
+		if (i + 1 < text.size())
+		{
+			text[i + 1] = (char) 0xA4;
+			assert (UTF8Encoding::legalLength(text.data(), text.size()) == text.size());
+		}
+	}
+
+	std::string text("abc\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80\xED\x9F\xBF\xF4\x8F\xBF\xBF");
+	assert (UTF8Encoding::asciiLength(text.data(), text.size()) == 3);
+	assert (UTF8Encoding::legalLength(text.data(), text.size()) == text.size());
+	assert (UTF8Encoding::legalLength((text + "\xC0\x80").data(), text.size() + 2) == text.size());
+	assert (UTF8Encoding::legalLength((text + "\xE0\x9F\xBF").data(), text.size() + 3) == text.size());
+	assert (UTF8Encoding::legalLength((text + "\xED\xA0\x80").data(), text.size() + 3) == text.size());
+	assert (UTF8Encoding::legalLength((text + "\xF0\x8F\xBF\xBF").data(), text.size() + 4) == text.size());
+	assert (UTF8Encoding::legalLength((text + "\xF4\x90\x80\x80").data(), text.size() + 4) == text.size());
+	assert (UTF8Encoding::legalLength((text + "\xF5").data(), text.size() + 1) == text.size());
+	assert (UTF8Encoding::legalLength((text + "\xE2\x82").data(), text.size() + 2) == text.size());
+	assert (UTF8Encoding::legalLength((text + "\x80").data(), text.size() + 1) == text.size());
+
+	UTF8Encoding utf8Encoding;
+	Latin1Encoding latin1Encoding;
+	Windows1251Encoding cp1251Encoding;
+	assert (utf8Encoding.isAsciiCompatible());
+	assert (latin1Encoding.isAsciiCompatible());
+	assert (cp1251Encoding.isAsciiCompatible());
+}
+
+
+void TextConverterTest::testMixedUTF8()
+{
+	UTF8Encoding utf8Encoding;
+	Latin1Encoding latin1Encoding;
+
+	std::string utf8Text;
+	std::string utf8Upper;
+	std::string latin1Text;
+	for (int i = 0; i < 50; ++i)
+	{
+		utf8Text   += "The quick brown fox \xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80";
+		utf8Upper  += "THE QUICK BROWN FOX \xC3\x84\xE2\x82\xAC\xF0\x9F\x98\x80";
+		latin1Text += "The quick brown fox \xE4??";
+	}
+
+	TextConverter identity(utf8Encoding, utf8Encoding);
+	std::string result;
+	int errors = identity.convert(utf8Text, result);
+	assert (result == utf8Text);
+	assert (errors == 0);
+	result.clear();
+	errors = identity.convert(utf8Text.data(), (int) utf8Text.size(), result);
+	assert (result == utf8Text);
+	assert (errors == 0);
+	result.clear();
+	errors = identity.convert(utf8Text, result, Unicode::toUpper);
+	assert (result == utf8Upper);
+	assert (errors == 0);
+
+	TextConverter toLatin1(utf8Encoding, latin1Encoding);
+	result.clear();
+	errors = toLatin1.convert(utf8Text, result);
+	assert (result == latin1Text);
+	assert (errors == 0);
+	result.clear();
+	errors = toLatin1.convert(utf8Text.data(), (int) utf8Text.size(), result);
+	assert (result == latin1Text);
+	assert (errors == 0);
+
+	TextConverter fromLatin1(latin1Encoding, utf8Encoding);
+	result.clear();
+	errors = fromLatin1.convert(std::string(100, '\xE4') + "abc", result);
+	assert (result.size() == 203);
+	assert (result.compare(0, 2, "\xC3\xA4") == 0 && result.compare(198, 5, "\xC3\xA4" "abc") == 0);
+	assert (errors == 0);
+
+	std::string badText = utf8Text + "\xFF" "abc" "\xC0\x80" "def";
+	result.clear();
+	errors = identity.convert(badText, result);
+	assert (result == utf8Text + "?abc?def");
+	assert (errors == 2);
+	result.clear();
+	errors = identity.convert(badText.data(), (int) badText.size(), result);
+	assert (result == utf8Text + "?abc?def");
+	assert (errors == 2);
+}
+
+
+void TextConverterTest::benchmarkUTF8()
+{
+	std::string utf8Text;
+	while (utf8Text.size() < 64*1024)
+	{
+		utf8Text += "The quick brown fox jumps over the lazy dog. ";
+		if (utf8Text.size() % 3 == 0) utf8Text += "\xC3\xA4\xE2\x82\xAC ";
+	}
+	UTF8Encoding utf8Encoding;
+	Latin1Encoding latin1Encoding;
+	TextConverter identity(utf8Encoding, utf8Encoding);
+	TextConverter toLatin1(utf8Encoding, latin1Encoding);
+	const int rounds = 200;
+	const char* names[] = {"UTF-8 to UTF-8", "UTF-8 to Latin-1", "UTF-8 to UTF-16", "UTF-16 to UTF-8"};
+	UTF16String utf16Text;
+	UnicodeConverter::toUTF16(utf8Text, utf16Text);
+	for (int t = 0; t < 4; ++t)
+	{
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < rounds; ++i)
+		{
+			std::string result;
+			UTF16String utf16Result;
+			switch (t)
+			{
+			case 0: identity.convert(utf8Text, result); break;
+			case 1: toLatin1.convert(utf8Text, result); break;
+			case 2: UnicodeConverter::toUTF16(utf8Text, utf16Result); break;
+			case 3: UnicodeConverter::toUTF8(utf16Text, result); break;
+			}
+		}
+		sw.stop();
+		double mb = double(utf8Text.size())*rounds/(1024*1024);
+		std::cout << names[t] << ": " << mb/(sw.elapsed()/1000000.0) << " MB/s" << std::endl;
+	}
+}
+
+
 void TextConverterTest::setUp()
 {
 }
@@ -372,6 +513,9 @@ CppUnit::Test* TextConverterTest::suite()
 	CppUnit_addTest(pSuite, TextConverterTest, testCP1251toUTF8);
 	CppUnit_addTest(pSuite, TextConverterTest, testCP1252toUTF8);
 	CppUnit_addTest(pSuite, TextConverterTest, testErrors);
+	CppUnit_addTest(pSuite, TextConverterTest, testLegalLength);
+	CppUnit_addTest(pSuite, TextConverterTest, testMixedUTF8);
+//	CppUnit_addTest(pSuite, TextConverterTest, benchmarkUTF8);
 
 	return pSuite;
 }
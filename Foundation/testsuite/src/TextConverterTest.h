@@ -56,6 +56,9 @@ public:
 	void testCP1251toUTF8();
 	void testCP1252toUTF8();
 	void testErrors();
+	void testLegalLength();
+	void testMixedUTF8();
+	void benchmarkUTF8();
 
 	void setUp();
 	void tearDown();
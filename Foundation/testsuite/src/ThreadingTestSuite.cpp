@@ -35,6 +35,7 @@
 #include "SemaphoreTest.h"
 #include "RWLockTest.h"
 #include "ThreadPoolTest.h"
+#include "WorkStealingThreadPoolTest.h"
 #include "TimerTest.h"
 #include "ThreadLocalTest.h"
 #include "ActivityTest.h"
@@ -51,6 +52,7 @@ CppUnit::Test* ThreadingTestSuite::suite()
 	pSuite->addTest(SemaphoreTest::suite());
 	pSuite->addTest(RWLockTest::suite());
 	pSuite->addTest(ThreadPoolTest::suite());
+	pSuite->addTest(WorkStealingThreadPoolTest::suite());
 	pSuite->addTest(TimerTest::suite());
 	pSuite->addTest(ThreadLocalTest::suite());
 	pSuite->addTest(ActivityTest::suite());
@@ -0,0 +1,359 @@
+//
+// TimingWheelTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "TimingWheelTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/TimingWheel.h"
+#include "Poco/Notification.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Timespan.h"
+#include "Poco/Thread.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/Stopwatch.h"
+#include <algorithm>
+#include <iostream>
+
+
+using Poco::TimingWheel;
+using Poco::Notification;
+using Poco::Timestamp;
+using Poco::Timespan;
+using Poco::Thread;
+using Poco::RunnableAdapter;
+
+
+namespace 
+{
+	class WTestNotification: public Notification
+	{
+	public:
+		WTestNotification(const std::string& data): _data(data)
+		{
+		}
+		~WTestNotification()
+		{
+		}
+		const std::string& data() const
+		{
+			return _data;
+		}
+
+	private:
+		std::string _data;
+	};
+
+	std::string data(const Notification::Ptr& pNf)
+	{
+		return pNf.cast<WTestNotification>()->data();
+	}
+
+	const Timestamp::TimeDiff MS = 1000;
+}
+
+
+TimingWheelTest::TimingWheelTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+TimingWheelTest::~TimingWheelTest()
+{
+}
+
+
+void TimingWheelTest::testExpire()
+{
+	TimingWheel wheel(Timespan(0, 10000));
+	assert (wheel.resolution() == Timespan(0, 10000));
+	assert (wheel.empty());
+
+	Timestamp now;
+	wheel.schedule(new WTestNotification("past"), now - 1000*MS);
+	wheel.schedule(new WTestNotification("50ms"), now + 50*MS);
+	wheel.schedule(new WTestNotification("100ms"), now + 100*MS);
+	wheel.schedule(new WTestNotification("5s"), now + 5000*MS);
+	wheel.schedule(new WTestNotification("3h"), now + MS*1000*3600*3);
+	assert (wheel.size() == 5);
+
+	std::vector<Notification::Ptr> expired;
+	assert (wheel.expire(now, expired) == 1);
+	assert (data(expired[0]) == "past");
+	assert (wheel.size() == 4);
+
+	expired.clear();
+	assert (wheel.expire(now + 40*MS, expired) == 0);
+	assert (wheel.expire(now + 70*MS, expired) == 1);
+	assert (data(expired[0]) == "50ms");
+	assert (wheel.expire(now + 120*MS, expired) == 1);
+	assert (data(expired[1]) == "100ms");
+	assert (wheel.expire(now + 4990*MS, expired) == 0);
+	assert (wheel.expire(now + 5020*MS, expired) == 1);
+	assert (data(expired[2]) == "5s");
+	assert (wheel.expire(now + MS*1000*3600*3 - 1000*MS, expired) == 0);
+	assert (wheel.expire(now + MS*1000*3600*3 + 20*MS, expired) == 1);
+	assert (data(expired[3]) == "3h");
+	assert (wheel.empty());
+
+	// the wheel does not move backwards
+	wheel.schedule(new WTestNotification("again"), now + 100*MS);
+	assert (wheel.expire(now, expired) == 1);
+}
+
+
+void TimingWheelTest::testCancel()
+{
+	TimingWheel wheel(Timespan(0, 1000));
+
+	Timestamp now;
+	std::vector<TimingWheel::Entry::Ptr> entries;
+	for (int i = 0; i < 1000; ++i)
+	{
+		entries.push_back(wheel.schedule(new WTestNotification("nf"), now + (i + 1)*37*MS));
+	}
+	assert (wheel.size() == 1000);
+	for (int i = 0; i < 1000; i += 2)
+	{
+		assert (wheel.cancel(entries[i]));
+		assert (!wheel.cancel(entries[i]));
+	}
+	assert (wheel.size() == 500);
+
+	std::vector<Notification::Ptr> expired;
+	assert (wheel.expire(now + 1000*37*MS + 10*MS, expired) == 500);
+	assert (wheel.empty());
+	assert (!wheel.cancel(entries[1]));
+	assert (entries[1]->notification().isNull());
+	assert (!entries[1]->cancel());
+	assert (entries[0]->notification().isNull());
+
+	// cancelled entries do not hold on to the wheel
+	TimingWheel::Entry::Ptr pEntry;
+	{
+		TimingWheel other;
+		pEntry = other.schedule(new WTestNotification("other"), now + 1000*MS);
+		assert (!wheel.cancel(pEntry));
+	}
+	assert (!wheel.cancel(pEntry));
+}
+
+
+void TimingWheelTest::testCascade()
+{
+	TimingWheel wheel(Timespan(0, 1000));
+
+	// expiry times in all wheels, in random order
+	Timestamp now;
+	std::vector<Timestamp::TimeDiff> delays;
+	Timestamp::TimeDiff delay = 1;
+	for (int i = 0; i < 200; ++i)
+	{
+		delays.push_back(delay*MS);
+		delay = (delay*7919) % 10000000 + 1;
+	}
+	for (std::vector<Timestamp::TimeDiff>::const_iterator it = delays.begin(); it != delays.end(); ++it)
+	{
+		wheel.schedule(new WTestNotification("nf"), now + *it);
+	}
+
+	// step through time and check that nothing expires early or late
+	std::vector<Timestamp::TimeDiff> sorted(delays);
+	std::sort(sorted.begin(), sorted.end());
+	std::vector<Notification::Ptr> expired;
+	std::size_t count = 0;
+	for (std::vector<Timestamp::TimeDiff>::const_iterator it = sorted.begin(); it != sorted.end(); ++it)
+	{
+		Timestamp::TimeDiff first = *it;
+		wheel.expire(now + first - 2*MS, expired);
+		assert (expired.size() == count);
+		wheel.expire(now + first + 2*MS, expired);
+		assert (expired.size() > count);
+		count = expired.size();
+		while (it + 1 != sorted.end() && *(it + 1) <= first + 2*MS) ++it;
+	}
+	assert (count == delays.size());
+	assert (wheel.empty());
+}
+
+
+void TimingWheelTest::testBeyondHorizon()
+{
+	TimingWheel wheel(Timespan(0, 1000));
+
+	Timestamp now;
+	wheel.schedule(new WTestNotification("24h"), now + MS*1000*3600*24);
+	wheel.schedule(new WTestNotification("30d"), now + MS*1000*3600*24*30);
+
+	std::vector<Notification::Ptr> expired;
+	assert (wheel.expire(now + MS*1000*3600*23, expired) == 0);
+	assert (wheel.expire(now + MS*1000*3600*24 - 10*MS, expired) == 0);
+	assert (wheel.expire(now + MS*1000*3600*24 + 10*MS, expired) == 1);
+	assert (data(expired[0]) == "24h");
+	assert (wheel.expire(now + MS*1000*3600*24*29, expired) == 0);
+	assert (wheel.expire(now + MS*1000*3600*24*30 + 10*MS, expired) == 1);
+	assert (data(expired[1]) == "30d");
+	assert (wheel.empty());
+}
+
+
+void TimingWheelTest::testDequeue()
+{
+	TimingWheel wheel;
+	assert (wheel.dequeueNotification() == 0);
+
+	Timestamp now;
+	wheel.enqueueNotification(new WTestNotification("first"), now);
+	wheel.enqueueNotification(new WTestNotification("later"), now + 100*MS);
+	Notification::Ptr pNf = wheel.dequeueNotification();
+	assert (!pNf.isNull());
+	assert (data(pNf) == "first");
+	assert (wheel.dequeueNotification() == 0);
+	assert (wheel.size() == 1);
+
+	Thread::sleep(150);
+	pNf = wheel.dequeueNotification();
+	assert (!pNf.isNull());
+	assert (data(pNf) == "later");
+	assert (wheel.empty());
+
+	wheel.enqueueNotification(new WTestNotification("cleared"), now);
+	wheel.enqueueNotification(new WTestNotification("cleared"), now + 1000*MS);
+	wheel.clear();
+	assert (wheel.empty());
+	assert (wheel.dequeueNotification() == 0);
+}
+
+
+void TimingWheelTest::testWaitDequeue()
+{
+	Timestamp start;
+	_wheel.schedule(new WTestNotification("200ms"), start + 200*MS);
+	Notification::Ptr pNf = _wheel.waitDequeueNotification();
+	assert (!pNf.isNull());
+	assert (data(pNf) == "200ms");
+	assert (start.elapsed() >= 200*MS);
+
+	// a notification scheduled by another thread while waiting
+	start.update();
+	_wheel.schedule(new WTestNotification("5s"), start + 5000*MS);
+	RunnableAdapter<TimingWheelTest> ra(*this, &TimingWheelTest::work);
+	Thread thread;
+	thread.start(ra);
+	pNf = _wheel.waitDequeueNotification();
+	thread.join();
+	assert (!pNf.isNull());
+	assert (data(pNf) == "work");
+	assert (start.elapsed() < 4000*MS);
+	assert (_wheel.size() == 1);
+
+	// the same, with an empty wheel
+	_wheel.clear();
+	Thread thread2;
+	thread2.start(ra);
+	pNf = _wheel.waitDequeueNotification();
+	thread2.join();
+	assert (!pNf.isNull());
+	assert (data(pNf) == "work");
+	assert (_wheel.empty());
+}
+
+
+void TimingWheelTest::testWaitDequeueTimeout()
+{
+	Timestamp start;
+	_wheel.schedule(new WTestNotification("500ms"), start + 500*MS);
+	Notification::Ptr pNf = _wheel.waitDequeueNotification(100);
+	assert (pNf.isNull());
+	assert (start.elapsed() >= 100*MS);
+	pNf = _wheel.waitDequeueNotification(1000);
+	assert (!pNf.isNull());
+	assert (data(pNf) == "500ms");
+	assert (start.elapsed() >= 500*MS);
+}
+
+
+void TimingWheelTest::benchmarkScheduleCancel()
+{
+	const int N = 1000000;
+
+	TimingWheel wheel(Timespan(0, 1000));
+	std::vector<TimingWheel::Entry::Ptr> entries;
+	entries.reserve(N);
+	Timestamp now;
+	Poco::Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < N; ++i)
+	{
+		entries.push_back(wheel.schedule(new WTestNotification("nf"), now + (i % 60000)*MS + 1000*MS));
+	}
+	for (int i = 0; i < N; ++i)
+	{
+		wheel.cancel(entries[i]);
+	}
+	sw.stop();
+	std::cout << N << " schedule/cancel: " << sw.elapsed()/1000 << " ms" << std::endl;
+}
+
+
+void TimingWheelTest::work()
+{
+	Thread::sleep(100);
+	_wheel.schedule(new WTestNotification("work"), Timestamp() + 50*MS);
+}
+
+
+void TimingWheelTest::setUp()
+{
+	_wheel.clear();
+}
+
+
+void TimingWheelTest::tearDown()
+{
+}
+
+
+CppUnit::Test* TimingWheelTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("TimingWheelTest");
+
+	CppUnit_addTest(pSuite, TimingWheelTest, testExpire);
+	CppUnit_addTest(pSuite, TimingWheelTest, testCancel);
+	CppUnit_addTest(pSuite, TimingWheelTest, testCascade);
+	CppUnit_addTest(pSuite, TimingWheelTest, testBeyondHorizon);
+	CppUnit_addTest(pSuite, TimingWheelTest, testDequeue);
+	CppUnit_addTest(pSuite, TimingWheelTest, testWaitDequeue);
+	CppUnit_addTest(pSuite, TimingWheelTest, testWaitDequeueTimeout);
+//	CppUnit_addTest(pSuite, TimingWheelTest, benchmarkScheduleCancel);
+
+	return pSuite;
+}
@@ -70,6 +70,45 @@ void UnicodeConverterTest::testUTF32()
 }
 
 
+void UnicodeConverterTest::testMixed()
+{
+	std::string text;
+	for (int i = 0; i < 50; ++i)
+	{
+		text += "The quick brown fox \xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80";
+	}
+
+	UTF16String utf16Text;
+	UnicodeConverter::toUTF16(text, utf16Text);
+	assert (utf16Text.size() == 50*24);
+	assert (utf16Text[20] == 0xE4 && utf16Text[21] == 0x20AC && utf16Text[22] == 0xD83D && utf16Text[23] == 0xDE00);
+	std::string text2;
+	UnicodeConverter::toUTF8(utf16Text, text2);
+	assert (text2 == text);
+
+	UTF32String utf32Text;
+	UnicodeConverter::toUTF32(text, utf32Text);
+	assert (utf32Text.size() == 50*23);
+	assert (utf32Text[20] == 0xE4 && utf32Text[21] == 0x20AC && utf32Text[22] == 0x1F600);
+	std::string text3;
+	UnicodeConverter::toUTF8(utf32Text, text3);
+	assert (text3 == text);
+
+	UTF16String badUTF16;
+	UnicodeConverter::toUTF16(text + "a\xFF" "b", badUTF16);
+	assert (badUTF16.size() == 50*24 + 3);
+	assert (badUTF16[50*24 + 1] == 0xFFFF);
+
+	UTF32String badUTF32(utf32Text);
+	badUTF32 += 'a';
+	badUTF32 += (UTF32Char) 0x110000;
+	badUTF32 += 'b';
+	std::string text4;
+	UnicodeConverter::toUTF8(badUTF32, text4);
+	assert (text4 == text + "a?b");
+}
+
+
 void UnicodeConverterTest::setUp()
 {
 }
@@ -86,6 +125,7 @@ CppUnit::Test* UnicodeConverterTest::suite()
 
 	CppUnit_addTest(pSuite, UnicodeConverterTest, testUTF16);
 	CppUnit_addTest(pSuite, UnicodeConverterTest, testUTF32);
+	CppUnit_addTest(pSuite, UnicodeConverterTest, testMixed);
 
 	return pSuite;
 }
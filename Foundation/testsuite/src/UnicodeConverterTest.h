@@ -50,6 +50,7 @@ public:
 
 	void testUTF16();
 	void testUTF32();
+	void testMixed();
 
 	void setUp();
 	void tearDown();
@@ -0,0 +1,335 @@
+//
+// WorkStealingThreadPoolTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+//
+
+
+#include "WorkStealingThreadPoolTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/WorkStealingThreadPool.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/TaskManager.h"
+#include "Poco/Task.h"
+#include "Poco/ActiveMethod.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Environment.h"
+#include "Poco/Thread.h"
+#include <vector>
+#include <iostream>
+
+
+using Poco::WorkStealingThreadPool;
+using Poco::WorkStealingActiveStarter;
+using Poco::TaskGroup;
+using Poco::TaskManager;
+using Poco::ActiveMethod;
+using Poco::ActiveResult;
+using Poco::RunnableAdapter;
+using Poco::Thread;
+
+
+namespace
+{
+	class SumTask: public Poco::Runnable
+	{
+	public:
+		SumTask(WorkStealingThreadPool& pool, const std::vector<int>& data, std::size_t begin, std::size_t end):
+			_pool(pool),
+			_data(data),
+			_begin(begin),
+			_end(end),
+			_sum(0)
+		{
+		}
+		
+		void run()
+		{
+			if (_end - _begin <= 1000)
+			{
+				for (std::size_t i = _begin; i < _end; ++i)
+				{
+					_sum += _data[i];
+				}
+			}
+			else
+			{
+				std::size_t mid = _begin + (_end - _begin)/2;
+				SumTask left(_pool, _data, _begin, mid);
+				SumTask right(_pool, _data, mid, _end);
+				TaskGroup group(_pool);
+				group.start(left);
+				group.start(right);
+				group.wait();
+				_sum = left.sum() + right.sum();
+			}
+		}
+		
+		Poco::Int64 sum() const
+		{
+			return _sum;
+		}
+		
+	private:
+		WorkStealingThreadPool&  _pool;
+		const std::vector<int>& _data;
+		std::size_t _begin;
+		std::size_t _end;
+		Poco::Int64 _sum;
+	};
+	
+	class SimpleTask: public Poco::Task
+	{
+	public:
+		SimpleTask(): Poco::Task("SimpleTask")
+		{
+		}
+		
+		void runTask()
+		{
+			setProgress(1.0f);
+		}
+	};
+	
+	class ActiveObject
+	{
+	public:
+		ActiveObject():
+			square(this, &ActiveObject::squareImpl)
+		{
+		}
+		
+		ActiveMethod<int, int, ActiveObject, WorkStealingActiveStarter<ActiveObject> > square;
+		
+	protected:
+		int squareImpl(const int& n)
+		{
+			return n*n;
+		}
+	};
+	
+	class SpinTask: public Poco::Runnable
+	{
+	public:
+		SpinTask(): _result(0)
+		{
+		}
+		
+		void run()
+		{
+			unsigned x = 1;
+			for (int i = 0; i < 100000; ++i)
+			{
+				x = x*1103515245 + 12345;
+			}
+			_result = x;
+		}
+		
+	private:
+		volatile unsigned _result;
+	};
+}
+
+
+WorkStealingThreadPoolTest::WorkStealingThreadPoolTest(const std::string& name): CppUnit::TestCase(name), _event(false)
+{
+}
+
+
+WorkStealingThreadPoolTest::~WorkStealingThreadPoolTest()
+{
+}
+
+
+void WorkStealingThreadPoolTest::testStart()
+{
+	WorkStealingThreadPool pool(2);
+	assert (pool.capacity() == 2);
+	assert (pool.allocated() == 2);
+	assert (pool.used() == 0);
+	assert (pool.available() == 2);
+
+	RunnableAdapter<WorkStealingThreadPoolTest> ra(*this, &WorkStealingThreadPoolTest::count);
+	for (int i = 0; i < 100; ++i)
+	{
+		pool.start(ra);
+	}
+	pool.joinAll();
+	assert (_count == 100*1000);
+	assert (pool.used() == 0);
+	assert (pool.queued() == 0);
+	
+	pool.start(ra, "counter");
+	pool.startWithPriority(Thread::PRIO_NORMAL, ra);
+	pool.joinAll();
+	assert (_count == 102*1000);
+}
+
+
+void WorkStealingThreadPoolTest::testQueue()
+{
+	WorkStealingThreadPool pool(2);
+
+	RunnableAdapter<WorkStealingThreadPoolTest> ra(*this, &WorkStealingThreadPoolTest::waitAndCount);
+	for (int i = 0; i < 5; ++i)
+	{
+		pool.start(ra); // must not throw
+	}
+	int n = 0;
+	while (pool.used() < 2 && n++ < 100) Thread::sleep(10);
+	assert (pool.used() == 2);
+	assert (pool.available() == 0);
+	assert (pool.queued() == 3);
+	
+	_event.set(); // go!!!
+	pool.joinAll();
+	assert (_count == 5*1000);
+	assert (pool.used() == 0);
+	assert (pool.queued() == 0);
+}
+
+
+void WorkStealingThreadPoolTest::testTaskGroup()
+{
+	std::vector<int> data(100000);
+	Poco::Int64 expected = 0;
+	for (std::size_t i = 0; i < data.size(); ++i)
+	{
+		data[i] = static_cast<int>(i % 1000);
+		expected += data[i];
+	}
+
+	// Nested groups need many more levels than there are
+	// threads in the pool, so waiting must not block.
+	WorkStealingThreadPool pool(2);
+	SumTask task(pool, data, 0, data.size());
+	TaskGroup group(pool);
+	group.start(task);
+	group.wait();
+	assert (group.pending() == 0);
+	assert (task.sum() == expected);
+	
+	SumTask task2(pool, data, 0, data.size());
+	task2.run(); // from a non-worker thread
+	assert (task2.sum() == expected);
+}
+
+
+void WorkStealingThreadPoolTest::testTaskManager()
+{
+	WorkStealingThreadPool pool(2);
+	TaskManager tm(pool);
+	for (int i = 0; i < 10; ++i)
+	{
+		tm.start(new SimpleTask);
+	}
+	tm.joinAll();
+	assert (tm.count() == 0);
+}
+
+
+void WorkStealingThreadPoolTest::testActiveMethod()
+{
+	ActiveObject activeObj;
+	ActiveResult<int> result1 = activeObj.square(3);
+	ActiveResult<int> result2 = activeObj.square(4);
+	result1.wait();
+	result2.wait();
+	assert (result1.data() == 9);
+	assert (result2.data() == 16);
+}
+
+
+void WorkStealingThreadPoolTest::benchmarkScaling()
+{
+	const int TASKS = 2000;
+	std::vector<SpinTask> tasks(TASKS);
+	int threads = static_cast<int>(Poco::Environment::processorCount());
+
+	for (int n = 1; n <= threads; n *= 2)
+	{
+		WorkStealingThreadPool pool(n);
+		Poco::Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < TASKS; ++i)
+		{
+			pool.start(tasks[i]);
+		}
+		pool.joinAll();
+		sw.stop();
+		std::cout << "WorkStealingThreadPool, " << n << " threads: " << sw.elapsed()/1000 << " ms" << std::endl;
+	}
+}
+
+
+void WorkStealingThreadPoolTest::setUp()
+{
+	_event.reset();
+	_count = 0;
+}
+
+
+void WorkStealingThreadPoolTest::tearDown()
+{
+}
+
+
+void WorkStealingThreadPoolTest::count()
+{
+	for (int i = 0; i < 1000; ++i)
+	{
+		_mutex.lock();
+		++_count;
+		_mutex.unlock();
+	}
+}
+
+
+void WorkStealingThreadPoolTest::waitAndCount()
+{
+	_event.wait();
+	count();
+}
+
+
+CppUnit::Test* WorkStealingThreadPoolTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("WorkStealingThreadPoolTest");
+
+	CppUnit_addTest(pSuite, WorkStealingThreadPoolTest, testStart);
+	CppUnit_addTest(pSuite, WorkStealingThreadPoolTest, testQueue);
+	CppUnit_addTest(pSuite, WorkStealingThreadPoolTest, testTaskGroup);
+	CppUnit_addTest(pSuite, WorkStealingThreadPoolTest, testTaskManager);
+	CppUnit_addTest(pSuite, WorkStealingThreadPoolTest, testActiveMethod);
+	//CppUnit_addTest(pSuite, WorkStealingThreadPoolTest, benchmarkScaling);
+
+	return pSuite;
+}
@@ -51,14 +51,22 @@ namespace Net {
 
 class Net_API HTTPBufferAllocator
 	/// A BufferAllocator for HTTP streams.
+	///
+	/// Buffers are taken from a MemoryPool that keeps
+	/// up to THREAD_CACHE_SIZE buffers per thread.
 {
 public:
 	static char* allocate(std::streamsize size);
 	static void deallocate(char* ptr, std::streamsize size);
 
+	static const Poco::MemoryPool& pool();
+		/// Returns the MemoryPool used by the allocator,
+		/// e.g. to obtain its cache statistics.
+
 	enum
 	{
-		BUFFER_SIZE = 4096
+		BUFFER_SIZE = 4096,
+		THREAD_CACHE_SIZE = 16
 	};
 
 private:
@@ -66,6 +74,15 @@ private:
 };
 
 
+//
+// inlines
+//
+inline const Poco::MemoryPool& HTTPBufferAllocator::pool()
+{
+	return _pool;
+}
+
+
 } } // namespace Poco::Net
 
 
@@ -91,6 +91,16 @@ public:
 		/// Sends the response header to the client, followed
 		/// by the content of the given file.
 		///
+		/// If the request contains a Range header field specifying
+		/// a single byte range, and the response status has not been
+		/// changed from 200 (OK), only the requested part of the file 
+		/// is sent, with status 206 (Partial Content), or status 416
+		/// (Requested Range Not Satisfiable) if the range is outside
+		/// of the file.
+		///
+		/// Where supported, the file content is sent directly by the
+		/// kernel (see StreamSocket::sendFile()).
+		///
 		/// Must not be called after send(), sendBuffer() 
 		/// or redirect() has been called.
 		///
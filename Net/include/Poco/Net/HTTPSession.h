@@ -162,6 +162,10 @@ protected:
 	virtual int write(const char* buffer, std::streamsize length);
 		/// Writes data to the socket.
 
+	virtual int write(const SocketBufVec& buffers);
+		/// Writes the data in all buffers to the socket,
+		/// using a single scatter/gather system call, if possible.
+
 	int receive(char* buffer, int length);
 		/// Reads up to length bytes.
 		
@@ -207,6 +211,7 @@ private:
 	friend class HTTPHeaderStreamBuf;
 	friend class HTTPFixedLengthStreamBuf;
 	friend class HTTPChunkedStreamBuf;
+	friend class HTTPServerResponseImpl;
 };
 
 
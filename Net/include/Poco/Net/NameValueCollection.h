@@ -42,6 +42,7 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/String.h"
+#include <vector>
 #include <map>
 
 
@@ -57,19 +58,57 @@ class Net_API NameValueCollection
 	///
 	/// There can be more than one name-value pair with the 
 	/// same name.
+	///
+	/// The name-value pairs are kept in a flat, contiguous
+	/// array, ordered by name. For the small number of entries
+	/// typically found in a message header, this is considerably
+	/// faster and needs far fewer memory allocations than a
+	/// tree-based map. Iteration order is the same as for a
+	/// multimap: pairs are ordered by name, and pairs with
+	/// the same name are kept in the order they were added.
+	///
+	/// Note that, unlike with a map, adding or removing
+	/// name-value pairs invalidates all iterators, as well as
+	/// all references to names and values obtained from the
+	/// collection.
 {
 public:
 	struct ILT
 	{
+		typedef std::pair<std::string, std::string> Pair;
+
 		bool operator() (const std::string& s1, const std::string& s2) const
 		{
 			return Poco::icompare(s1, s2) < 0;
 		}
+
+		bool operator() (const Pair& p1, const std::string& s2) const
+		{
+			return Poco::icompare(p1.first, s2) < 0;
+		}
+
+		bool operator() (const std::string& s1, const Pair& p2) const
+		{
+			return Poco::icompare(s1, p2.first) < 0;
+		}
+
+		bool operator() (const Pair& p1, const Pair& p2) const
+		{
+			return Poco::icompare(p1.first, p2.first) < 0;
+		}
 	};
 	
+private:
+	typedef std::vector<std::pair<std::string, std::string> > PairVec;
+
+public:
 	typedef std::multimap<std::string, std::string, ILT> HeaderMap;
-	typedef HeaderMap::iterator Iterator;
-	typedef HeaderMap::const_iterator ConstIterator;
+		/// The type formerly used to store the name-value pairs.
+		/// No longer used by NameValueCollection, and only
+		/// kept for source compatibility.
+
+	typedef PairVec::iterator Iterator;
+	typedef PairVec::const_iterator ConstIterator;
 	
 	NameValueCollection();
 		/// Creates an empty NameValueCollection.
@@ -136,7 +175,7 @@ public:
 		/// Removes all name-value pairs and their values.
 
 private:
-	HeaderMap _map;
+	PairVec _map;
 };
 
 
@@ -0,0 +1,138 @@
+//
+// PollSet.h
+//
+// $Id$
+//
+// Library: Net
+// Package: Sockets
+// Module:  PollSet
+//
+// Definition of the PollSet class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Net_PollSet_INCLUDED
+#define Net_PollSet_INCLUDED
+
+
+#include "Poco/Net/Socket.h"
+#include <map>
+
+
+namespace Poco {
+namespace Net {
+
+
+class PollSetImpl;
+
+
+class Net_API PollSet
+	/// A set of sockets that can be efficiently polled as a whole.
+	///
+	/// Unlike Socket::select(), which has to pass the complete
+	/// set of sockets to the operating system on every call,
+	/// a PollSet keeps its state between calls to poll().
+	/// Sockets are added, updated and removed incrementally,
+	/// and poll() only reports the sockets that are actually ready.
+	///
+	/// If available, PollSet is implemented using a single,
+	/// long-lived epoll instance (Linux, if POCO_HAVE_FD_EPOLL
+	/// is defined). On all other platforms, PollSet falls
+	/// back to Socket::select().
+	///
+	/// All member functions can be safely called from
+	/// different threads, including calling add(), update()
+	/// or remove() while another thread is blocked in poll().
+	/// However, only one thread should call poll() at a time.
+{
+public:
+	enum Mode
+	{
+		POLL_READ  = Socket::SELECT_READ,
+		POLL_WRITE = Socket::SELECT_WRITE,
+		POLL_ERROR = Socket::SELECT_ERROR
+	};
+
+	typedef std::map<Socket, int> SocketModeMap;
+
+	PollSet();
+		/// Creates an empty PollSet.
+
+	~PollSet();
+		/// Destroys the PollSet.
+
+	void add(const Socket& socket, int mode);
+		/// Adds the given socket to the set, for polling with
+		/// the given mode, which is a combination of the
+		/// values of the Mode enumeration.
+		///
+		/// If the socket is already in the set, its mode
+		/// is updated.
+		///
+		/// As with Socket::select(), a socket that is not
+		/// open can be added, but is never reported as ready.
+
+	void remove(const Socket& socket);
+		/// Removes the given socket from the set.
+		/// Does nothing if the socket is not in the set.
+
+	void update(const Socket& socket, int mode);
+		/// Updates the mode of the given socket.
+
+	bool has(const Socket& socket) const;
+		/// Returns true if the given socket is in the set.
+
+	bool empty() const;
+		/// Returns true if the set is empty.
+
+	void clear();
+		/// Removes all sockets from the set.
+
+	SocketModeMap poll(const Poco::Timespan& timeout);
+		/// Waits until the state of at least one of the sockets
+		/// in the set changes accordingly to its mode, or
+		/// the timeout expires.
+		///
+		/// Returns a map containing the ready sockets and
+		/// their state, which is a combination of the values
+		/// of the Mode enumeration. Only the modes a socket
+		/// has been added with are reported. The map is empty
+		/// if the timeout expired.
+
+private:
+	PollSetImpl* _pImpl;
+
+	PollSet(const PollSet&);
+	PollSet& operator = (const PollSet&);
+};
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_PollSet_INCLUDED
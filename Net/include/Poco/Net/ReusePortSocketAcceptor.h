@@ -0,0 +1,169 @@
+//
+// ReusePortSocketAcceptor.h
+//
+// $Id$
+//
+// Library: Net
+// Package: Reactor
+// Module:  ReusePortSocketAcceptor
+//
+// Definition of the ReusePortSocketAcceptor class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Net_ReusePortSocketAcceptor_INCLUDED
+#define Net_ReusePortSocketAcceptor_INCLUDED
+
+
+#include "Poco/Net/ParallelSocketReactor.h"
+#include "Poco/Net/SocketAcceptor.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Environment.h"
+#include "Poco/SharedPtr.h"
+#include <vector>
+
+
+namespace Poco {
+namespace Net {
+
+
+template <class ServiceHandler, class SR = SocketReactor>
+class ReusePortSocketAcceptor
+	/// This class implements a multi-threaded variant of the Acceptor
+	/// part of the Acceptor-Connector design pattern, where every
+	/// reactor thread owns its own listening socket.
+	///
+	/// Unlike ParallelSocketAcceptor, which accepts all connections
+	/// on a single ServerSocket and then hands them over to one of
+	/// its reactor threads, ReusePortSocketAcceptor creates one
+	/// ServerSocket per reactor thread. All sockets are bound to the
+	/// same address, using the SO_REUSEPORT socket option, and the
+	/// Linux kernel distributes incoming connections among them.
+	/// Every connection is accepted by the reactor thread that
+	/// also services it for its whole lifetime, so there is no
+	/// handoff between threads and no single listening socket that
+	/// all connections must go through.
+	///
+	/// The number of reactor threads defaults to the number of processors.
+	///
+	/// The ServiceHandler class must provide a constructor that
+	/// takes a StreamSocket and a SocketReactor as arguments, see
+	/// the SocketAcceptor class for details.
+	///
+	/// Connections are only distributed among the listening sockets
+	/// on Linux 3.9 or newer. Other systems, like FreeBSD and Mac OS X,
+	/// also accept SO_REUSEPORT, but deliver all connections to one
+	/// of the sockets, so only one reactor thread will be used.
+	/// On systems without SO_REUSEPORT, or older Linux versions,
+	/// binding the second socket fails and the constructor throws
+	/// an exception.
+{
+public:
+	typedef Poco::Net::ParallelSocketReactor<SR> ParallelReactor;
+	typedef Poco::Net::SocketAcceptor<ServiceHandler> Acceptor;
+
+	explicit ReusePortSocketAcceptor(const SocketAddress& address,
+		unsigned threads = Poco::Environment::processorCount(),
+		int backlog = 64)
+		/// Creates the ReusePortSocketAcceptor, using the given
+		/// number of threads, and binds all listening sockets
+		/// to the given address.
+		///
+		/// If the port number in the given address is zero, the
+		/// first socket is bound to a port chosen by the operating
+		/// system, and all other sockets are bound to the same port.
+	{
+		poco_assert (threads > 0);
+
+		SocketAddress bindAddress(address);
+		for (unsigned i = 0; i < threads; ++i)
+		{
+			ServerSocket socket;
+			socket.bind(bindAddress, true);
+			socket.listen(backlog);
+			if (i == 0) bindAddress = socket.address();
+
+			typename ParallelReactor::Ptr pReactor = new ParallelReactor;
+			_reactors.push_back(pReactor);
+			_sockets.push_back(socket);
+			_acceptors.push_back(new Acceptor(socket, *pReactor));
+		}
+		_address = bindAddress;
+	}
+
+	virtual ~ReusePortSocketAcceptor()
+		/// Destroys the ReusePortSocketAcceptor, closes all
+		/// listening sockets and stops all reactor threads.
+	{
+		_acceptors.clear();
+		for (SocketVec::iterator it = _sockets.begin(); it != _sockets.end(); ++it)
+			it->close();
+		_reactors.clear();
+	}
+
+	const SocketAddress& address() const
+		/// Returns the address all listening sockets are bound to.
+	{
+		return _address;
+	}
+
+	std::size_t threads() const
+		/// Returns the number of reactor threads.
+	{
+		return _reactors.size();
+	}
+
+	SocketReactor& reactor(std::size_t index)
+		/// Returns the reactor with the given index.
+	{
+		poco_assert (index < _reactors.size());
+
+		return *_reactors[index];
+	}
+
+private:
+	typedef std::vector<typename ParallelReactor::Ptr> ReactorVec;
+	typedef std::vector<Poco::SharedPtr<Acceptor> >    AcceptorVec;
+	typedef std::vector<ServerSocket>                  SocketVec;
+
+	ReusePortSocketAcceptor();
+	ReusePortSocketAcceptor(const ReusePortSocketAcceptor&);
+	ReusePortSocketAcceptor& operator = (const ReusePortSocketAcceptor&);
+
+	SocketAddress _address;
+	ReactorVec    _reactors;
+	SocketVec     _sockets;
+	AcceptorVec   _acceptors;
+};
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_ReusePortSocketAcceptor_INCLUDED
@@ -306,6 +306,19 @@ public:
 	static bool supportsIPv6();
 		/// Returns true if the system supports IPv6.
 
+	static SocketBuf makeBuffer(const void* buffer, std::size_t length);
+		/// Creates a SocketBuf referring to the given buffer,
+		/// for use with StreamSocket::sendBytes(const SocketBufVec&, int).
+		///
+		/// The SocketBuf does not copy the data, so the buffer
+		/// must stay valid as long as the SocketBuf is in use.
+
+	static const void* bufferData(const SocketBuf& buffer);
+		/// Returns the address of the data the SocketBuf refers to.
+
+	static int bufferLength(const SocketBuf& buffer);
+		/// Returns the length of the data the SocketBuf refers to.
+
 	void init(int af);
 		/// Creates the underlying system socket for the given
 		/// address family.
@@ -641,6 +654,40 @@ inline bool Socket::supportsIPv6()
 }
 
 
+inline SocketBuf Socket::makeBuffer(const void* buffer, std::size_t length)
+{
+	SocketBuf buf;
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	buf.buf = static_cast<char*>(const_cast<void*>(buffer));
+	buf.len = static_cast<ULONG>(length);
+#else
+	buf.iov_base = const_cast<void*>(buffer);
+	buf.iov_len  = length;
+#endif
+	return buf;
+}
+
+
+inline const void* Socket::bufferData(const SocketBuf& buffer)
+{
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	return buffer.buf;
+#else
+	return buffer.iov_base;
+#endif
+}
+
+
+inline int Socket::bufferLength(const SocketBuf& buffer)
+{
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	return static_cast<int>(buffer.len);
+#else
+	return static_cast<int>(buffer.iov_len);
+#endif
+}
+
+
 inline void Socket::init(int af)
 {
 	_pImpl->init(af);
@@ -40,6 +40,9 @@
 #define Net_SocketDefs_INCLUDED
 
 
+#include <vector>
+
+
 #define POCO_ENOERR 0
 
 
@@ -154,6 +157,7 @@
 	#include <errno.h>
 	#include <sys/types.h>
 	#include <sys/socket.h>
+	#include <sys/uio.h>
 	#include <fcntl.h>
 	#if POCO_OS != POCO_OS_HPUX
 		#include <sys/select.h>
@@ -267,6 +271,11 @@
 #endif
 
 
+#if (POCO_OS == POCO_OS_LINUX) && !defined(POCO_NET_NO_SENDFILE)
+	#define POCO_HAVE_SENDFILE 1
+#endif
+
+
 #if defined(POCO_HAVE_ADDRINFO)
 	#if !defined(AI_ADDRCONFIG)
 		#define AI_ADDRCONFIG 0
@@ -352,4 +361,26 @@
 #endif
 
 
+namespace Poco {
+namespace Net {
+
+
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	typedef WSABUF SocketBuf;
+#else
+	typedef struct iovec SocketBuf;
+#endif
+
+
+typedef std::vector<SocketBuf> SocketBufVec;
+	/// A sequence of buffers for scatter/gather I/O
+	/// (see StreamSocket::sendBytes(const SocketBufVec&, int)).
+	///
+	/// Use Socket::makeBuffer() to create a SocketBuf in a 
+	/// portable way.
+
+
+} } // namespace Poco::Net
+
+
 #endif // Net_SocketDefs_INCLUDED
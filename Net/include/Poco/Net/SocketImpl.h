@@ -156,6 +156,17 @@ public:
 		/// Certain socket implementations may also return a negative
 		/// value denoting a certain condition.
 	
+	virtual int sendBytes(const SocketBufVec& buffers, int flags = 0);
+		/// Sends the contents of the given buffers through
+		/// the socket, using a single scatter/gather system call
+		/// (sendmsg() or WSASend()).
+		///
+		/// Returns the number of bytes sent, which may be
+		/// less than the total number of bytes in the buffers.
+		///
+		/// Certain socket implementations may also return a negative
+		/// value denoting a certain condition.
+	
 	virtual int receiveBytes(void* buffer, int length, int flags = 0);
 		/// Receives data from the socket and stores it
 		/// in buffer. Up to length bytes are received.
@@ -449,6 +460,7 @@ private:
 	
 	friend class Socket;
 	friend class SecureSocketImpl;
+	friend class PollSetImpl;
 };
 
 
@@ -42,6 +42,7 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/Socket.h"
+#include "Poco/Net/PollSet.h"
 #include "Poco/Runnable.h"
 #include "Poco/Timespan.h"
 #include "Poco/Observer.h"
@@ -86,7 +87,13 @@ class Net_API SocketReactor: public Poco::Runnable
 	/// as argument.
 	///
 	/// Once started, the SocketReactor waits for events
-	/// on the registered sockets, using Socket::select().
+	/// on the registered sockets, using a PollSet.
+	/// On Linux (with POCO_HAVE_FD_EPOLL defined), the PollSet
+	/// is backed by a single, persistent epoll instance that is
+	/// updated incrementally as event handlers are added and removed,
+	/// so the cost of waiting for events does not depend on the
+	/// number of idle sockets. On other platforms, the PollSet
+	/// uses Socket::select().
 	/// If an event is detected, the corresponding event handler
 	/// is invoked. There are five event types (and corresponding
 	/// notification classes) defined: ReadableNotification, WritableNotification,
@@ -104,8 +111,8 @@ class Net_API SocketReactor: public Poco::Runnable
 	/// which can be overridden by subclasses to perform custom
 	/// timeout processing.
 	///
-	/// If there are no sockets for the SocketReactor to pass to
-	/// Socket::select(), an IdleNotification will be dispatched to
+	/// If there are no sockets for the SocketReactor to wait
+	/// for, an IdleNotification will be dispatched to
 	/// all event handlers registered for it. This is done in the
 	/// onIdle() method which can be overridden by subclasses
 	/// to perform custom idle processing. Since onIdle() will be
@@ -156,7 +163,7 @@ public:
 		///
 		/// The default timeout is 250 milliseconds;
 		///
-		/// The timeout is passed to the Socket::select()
+		/// The timeout is passed to the PollSet::poll()
 		/// method.
 		
 	const Poco::Timespan& getTimeout() const;
@@ -221,6 +228,7 @@ private:
 	typedef std::map<Socket, NotifierPtr>     EventHandlerMap;
 
 	void dispatch(NotifierPtr& pNotifier, SocketNotification* pNotification);
+	void updatePollSet(const Socket& socket);
 
 	enum
 	{
@@ -230,6 +238,7 @@ private:
 	bool            _stop;
 	Poco::Timespan  _timeout;
 	EventHandlerMap _handlers;
+	PollSet         _pollSet;
 	NotificationPtr _pReadableNotification;
 	NotificationPtr _pWritableNotification;
 	NotificationPtr _pErrorNotification;
@@ -43,6 +43,7 @@
 #include "Poco/Net/Net.h"
 #include "Poco/Net/StreamSocket.h"
 #include "Poco/BufferedBidirectionalStreamBuf.h"
+#include "Poco/PooledBufferAllocator.h"
 #include <istream>
 #include <ostream>
 
@@ -54,7 +55,19 @@ namespace Net {
 class StreamSocketImpl;
 
 
-class Net_API SocketStreamBuf: public Poco::BufferedBidirectionalStreamBuf
+enum
+{
+	SOCKET_STREAM_BUFFER_SIZE = 1024
+		/// The size of the stream buffers of SocketStreamBuf.
+};
+
+
+typedef Poco::BasicBufferedBidirectionalStreamBuf<char, std::char_traits<char>, Poco::PooledBufferAllocator<char, SOCKET_STREAM_BUFFER_SIZE> > SocketBufferedStreamBuf;
+	/// The stream buffers of SocketStreamBuf are taken
+	/// from a MemoryPool with thread caches.
+
+
+class Net_API SocketStreamBuf: public SocketBufferedStreamBuf
 	/// This is the streambuf class used for reading from and writing to a socket.
 {
 public:
@@ -75,11 +88,6 @@ protected:
 	int writeToDevice(const char* buffer, std::streamsize length);
 
 private:
-	enum 
-	{
-		STREAM_BUFFER_SIZE = 1024
-	};
-
 	StreamSocketImpl* _pImpl;
 };
 
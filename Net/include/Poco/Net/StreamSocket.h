@@ -43,6 +43,7 @@
 #include "Poco/Net/Net.h"
 #include "Poco/Net/Socket.h"
 #include "Poco/FIFOBuffer.h"
+#include "Poco/FileStream.h"
 
 
 namespace Poco {
@@ -129,6 +130,22 @@ public:
 		/// Certain socket implementations may also return a negative
 		/// value denoting a certain condition.
 
+	int sendBytes(const SocketBufVec& buffers, int flags = 0);
+		/// Sends the contents of the given buffers through
+		/// the socket, using scatter/gather I/O (writev()-like 
+		/// sendmsg() or WSASend()). This allows sending data from
+		/// several separate buffers, e.g., a message header
+		/// and body, with a single system call and without
+		/// copying them into a contiguous buffer first.
+		///
+		/// Use Socket::makeBuffer() to create the buffers.
+		///
+		/// Returns the number of bytes sent, which may be
+		/// less than the total number of bytes in the buffers.
+		///
+		/// Certain socket implementations may also return a negative
+		/// value denoting a certain condition.
+
 	int sendBytes(Poco::FIFOBuffer& buffer);
 		/// Sends the contents of the given buffer through
 		/// the socket. FIFOBuffer has writable/readable transiton
@@ -169,6 +186,23 @@ public:
 		/// been set and nothing is received within that interval.
 		/// Throws a NetException (or a subclass) in case of other errors.
 
+	Poco::Int64 sendFile(Poco::FileInputStream& istr, Poco::UInt64 offset, Poco::UInt64 count);
+		/// Sends up to count bytes of the file given by istr, 
+		/// starting at the given file offset, through the socket.
+		///
+		/// If supported by the platform (currently Linux), the 
+		/// data is transferred directly by the kernel using
+		/// sendfile(), without being copied into user space. 
+		/// Otherwise, the data is read from the file and sent
+		/// using sendBytes().
+		///
+		/// Ensures that all data is sent if the socket is blocking.
+		/// In case of a non-blocking socket, sends as many bytes
+		/// as possible.
+		///
+		/// Returns the number of bytes sent, which is less than
+		/// count if the end of the file has been reached.
+
 	void sendUrgent(unsigned char data);
 		/// Sends one byte of urgent data through
 		/// the socket.
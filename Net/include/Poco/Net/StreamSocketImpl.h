@@ -42,6 +42,7 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/SocketImpl.h"
+#include "Poco/FileStream.h"
 
 
 namespace Poco {
@@ -70,8 +71,61 @@ public:
 		/// Returns the number of bytes sent. The return value may also be
 		/// negative to denote some special condition.
 
+	virtual int sendBytes(const SocketBufVec& buffers, int flags = 0);
+		/// Sends the contents of all buffers, using as few 
+		/// scatter/gather system calls as possible.
+		///
+		/// Ensures that all data in the buffers is sent if the socket
+		/// is blocking. In case of a non-blocking socket, sends as
+		/// many bytes as possible.
+		///
+		/// If supportsZeroCopy() returns false (e.g., for secure
+		/// sockets that transform the data), every buffer is passed
+		/// to sendBytes(const void*, int, int) instead.
+		///
+		/// Returns the number of bytes sent. The return value may also be
+		/// negative to denote some special condition.
+
+	Poco::Int64 sendFile(Poco::FileInputStream& istr, Poco::UInt64 offset, Poco::UInt64 count);
+		/// Sends up to count bytes of the file given by istr, 
+		/// starting at the given file offset, through the socket.
+		///
+		/// On platforms supporting it (currently Linux), and if
+		/// supportsZeroCopy() returns true, the data is transferred
+		/// by the kernel using sendfile(), without being copied into
+		/// user space. Otherwise, the data is read from istr and
+		/// sent using sendBytes().
+		///
+		/// Ensures that all data is sent if the socket is blocking.
+		/// In case of a non-blocking socket, sends as many bytes
+		/// as possible.
+		///
+		/// Returns the number of bytes sent, which is less than
+		/// count if the end of the file has been reached.
+
 protected:
 	virtual ~StreamSocketImpl();
+
+	virtual bool supportsZeroCopy() const;
+		/// Returns true if data can be passed directly to the
+		/// native socket, using sendmsg() in
+		/// sendBytes(const SocketBufVec&, int) and sendfile()
+		/// in sendFile().
+		///
+		/// The default implementation returns true. Subclasses
+		/// that transform the data in sendBytes(const void*, int, int)
+		/// (e.g., secure sockets or WebSockets) must override this
+		/// and return false.
+
+	Poco::Int64 copyFile(Poco::FileInputStream& istr, Poco::UInt64 offset, Poco::UInt64 count);
+		/// Implements sendFile() by reading the file into a
+		/// buffer and sending it with sendBytes().
+
+private:
+	enum
+	{
+		FILE_BUFFER_SIZE = 8192
+	};
 };
 
 
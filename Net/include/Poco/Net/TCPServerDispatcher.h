@@ -46,7 +46,10 @@
 #include "Poco/Net/TCPServerParams.h"
 #include "Poco/Runnable.h"
 #include "Poco/NotificationQueue.h"
+#include "Poco/AbstractNotificationQueue.h"
 #include "Poco/ThreadPool.h"
+#include "Poco/WorkStealingThreadPool.h"
+#include "Poco/AbstractThreadPool.h"
 #include "Poco/Mutex.h"
 
 
@@ -65,6 +68,18 @@ public:
 		/// The dispatcher takes ownership of the TCPServerParams object.
 		/// If no TCPServerParams object is supplied, the TCPServerDispatcher
 		/// creates one.
+		///
+		/// If TCPServerParams::getLockFreeQueue() returns true, connections
+		/// are queued in a Poco::LockFreeNotificationQueue, which can hold
+		/// at least the maximum number of queued connections.
+
+	TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactory, Poco::WorkStealingThreadPool& threadPool, TCPServerParams::Ptr pParams);
+		/// Creates the TCPServerDispatcher, using the given
+		/// WorkStealingThreadPool.
+		///
+		/// The dispatcher takes ownership of the TCPServerParams object.
+		/// If no TCPServerParams object is supplied, the TCPServerDispatcher
+		/// creates one.
 
 	void duplicate();
 		/// Increments the object's reference count.
@@ -114,6 +129,15 @@ protected:
 	void endConnection();
 		/// Updates the performance counters.
 
+	void startThread();
+		/// Starts a new connection thread, unless the maximum
+		/// number of threads has been reached.
+		///
+		/// The caller must hold the dispatcher's mutex.
+
+	void init();
+		/// Initializes the parameters and the queue.
+
 private:
 	TCPServerDispatcher();
 	TCPServerDispatcher(const TCPServerDispatcher&);
@@ -127,10 +151,10 @@ private:
 	int  _maxConcurrentConnections;
 	int  _refusedConnections;
 	bool _stopped;
-	Poco::NotificationQueue         _queue;
-	TCPServerConnectionFactory::Ptr _pConnectionFactory;
-	Poco::ThreadPool&               _threadPool;
-	mutable Poco::FastMutex         _mutex;
+	Poco::AbstractNotificationQueue* _pQueue;
+	TCPServerConnectionFactory::Ptr  _pConnectionFactory;
+	Poco::AbstractThreadPool*        _pThreadPool;
+	mutable Poco::FastMutex          _mutex;
 };
 
 
@@ -67,6 +67,7 @@ public:
 		///   - threadIdleTime:       10 seconds
 		///   - maxThreads:           0
 		///   - maxQueued:            64
+		///   - lockFreeQueue:        false
 
 	void setThreadIdleTime(const Poco::Timespan& idleTime);
 		/// Sets the maximum idle time for a thread before
@@ -114,6 +115,22 @@ public:
 		/// Returns the priority of TCP server threads
 		/// created by TCPServer. 
 
+	void setLockFreeQueue(bool flag);
+		/// Specifies whether the TCPServerDispatcher uses a
+		/// Poco::LockFreeNotificationQueue instead of a
+		/// Poco::NotificationQueue for passing accepted
+		/// connections to the server connection threads.
+		///
+		/// Enabling this reduces lock contention between the
+		/// acceptor thread and the connection threads if
+		/// many connections are accepted in a short time.
+		///
+		/// The default is false.
+
+	bool getLockFreeQueue() const;
+		/// Returns true iff the TCPServerDispatcher uses
+		/// a Poco::LockFreeNotificationQueue.
+
 protected:
 	virtual ~TCPServerParams();
 		/// Destroys the TCPServerParams.
@@ -123,6 +140,7 @@ private:
 	int _maxThreads;
 	int _maxQueued;
 	Poco::Thread::Priority _threadPriority;
+	bool _lockFreeQueue;
 };
 
 
@@ -153,6 +171,12 @@ inline Poco::Thread::Priority TCPServerParams::getThreadPriority() const
 }
 
 
+inline bool TCPServerParams::getLockFreeQueue() const
+{
+	return _lockFreeQueue;
+}
+
+
 } } // namespace Poco::Net
 
 
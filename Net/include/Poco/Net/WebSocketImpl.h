@@ -59,6 +59,10 @@ public:
 	// StreamSocketImpl
 	virtual int sendBytes(const void* buffer, int length, int flags);
 		/// Sends a WebSocket protocol frame.
+
+	virtual int sendBytes(const SocketBufVec& buffers, int flags);
+		/// Sends the contents of all buffers in a single
+		/// WebSocket protocol frame.
 		
 	virtual int receiveBytes(void* buffer, int length, int flags);
 		/// Receives a WebSocket protocol frame.
@@ -99,6 +103,8 @@ protected:
 	
 	int receiveNBytes(void* buffer, int bytes);
 	virtual ~WebSocketImpl();
+	virtual bool supportsZeroCopy() const;
+		/// Returns false, since all data must be sent in frames.
 
 private:
 	WebSocketImpl();
@@ -39,8 +39,8 @@
 #include "Poco/Net/NetException.h"
 #include "Poco/Base64Encoder.h"
 #include "Poco/Base64Decoder.h"
+#include "Poco/Exception.h"
 #include "Poco/String.h"
-#include <sstream>
 
 
 using Poco::Base64Decoder;
@@ -105,44 +105,31 @@ void HTTPBasicCredentials::setPassword(const std::string& password)
 	
 void HTTPBasicCredentials::authenticate(HTTPRequest& request) const
 {
-	std::ostringstream ostr;
-	Base64Encoder encoder(ostr);
-	encoder.rdbuf()->setLineLength(0);
-	encoder << _username << ":" << _password;
-	encoder.close();
-	request.setCredentials(SCHEME, ostr.str());
+	request.setCredentials(SCHEME, Base64Encoder::encode(_username + ":" + _password));
 }
 
 
 void HTTPBasicCredentials::proxyAuthenticate(HTTPRequest& request) const
 {
-	std::ostringstream ostr;
-	Base64Encoder encoder(ostr);
-	encoder.rdbuf()->setLineLength(0);
-	encoder << _username << ":" << _password;
-	encoder.close();
-	request.setProxyCredentials(SCHEME, ostr.str());
+	request.setProxyCredentials(SCHEME, Base64Encoder::encode(_username + ":" + _password));
 }
 
 
 void HTTPBasicCredentials::parseAuthInfo(const std::string& authInfo)
 {
-	static const int eof = std::char_traits<char>::eof();
-
-	std::istringstream istr(authInfo);
-	Base64Decoder decoder(istr);
-	int ch = decoder.get();
-	while (ch != eof && ch != ':')
+	std::string credentials;
+	try
 	{
-		_username += (char) ch;
-		ch = decoder.get();
+		credentials = Base64Decoder::decode(authInfo);
 	}
-	if (ch == ':') ch = decoder.get();
-	while (ch != eof)
+	catch (Poco::DataFormatException&)
 	{
-		_password += (char) ch;
-		ch = decoder.get();
+		throw NotAuthenticatedException("Invalid Basic credentials");
 	}
+	std::string::size_type pos = credentials.find(':');
+	_username.assign(credentials, 0, pos);
+	if (pos != std::string::npos)
+		_password.assign(credentials, pos + 1, std::string::npos);
 }
 
 
@@ -44,7 +44,7 @@ namespace Poco {
 namespace Net {
 
 
-MemoryPool HTTPBufferAllocator::_pool(HTTPBufferAllocator::BUFFER_SIZE, 16);
+MemoryPool HTTPBufferAllocator::_pool(HTTPBufferAllocator::BUFFER_SIZE, 16, 0, HTTPBufferAllocator::THREAD_CACHE_SIZE);
 
 
 char* HTTPBufferAllocator::allocate(std::streamsize size)
@@ -36,6 +36,7 @@
 
 #include "Poco/Net/HTTPChunkedStream.h"
 #include "Poco/Net/HTTPSession.h"
+#include "Poco/Net/Socket.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/NumberParser.h"
 #include "Poco/Ascii.h"
@@ -72,8 +73,22 @@ void HTTPChunkedStreamBuf::close()
 {
 	if (_mode & std::ios::out)
 	{
-		sync();
-		_session.write("0\r\n\r\n", 5);
+		// Send the last data chunk (if any) and the terminating
+		// zero-length chunk together.
+		int n = static_cast<int>(pptr() - pbase());
+		SocketBufVec buffers;
+		if (n > 0)
+		{
+			_chunkBuffer.clear();
+			NumberFormatter::appendHex(_chunkBuffer, n);
+			_chunkBuffer.append("\r\n", 2);
+			buffers.push_back(Socket::makeBuffer(_chunkBuffer.data(), _chunkBuffer.size()));
+			buffers.push_back(Socket::makeBuffer(pbase(), n));
+			buffers.push_back(Socket::makeBuffer("\r\n0\r\n\r\n", 7));
+			pbump(-n);
+		}
+		else buffers.push_back(Socket::makeBuffer("0\r\n\r\n", 5));
+		_session.write(buffers);
 	}
 }
 
@@ -116,9 +131,11 @@ int HTTPChunkedStreamBuf::writeToDevice(const char* buffer, std::streamsize leng
 	_chunkBuffer.clear();
 	NumberFormatter::appendHex(_chunkBuffer, length);
 	_chunkBuffer.append("\r\n", 2);
-	_chunkBuffer.append(buffer, static_cast<std::string::size_type>(length));
-	_chunkBuffer.append("\r\n", 2);
-	_session.write(_chunkBuffer.data(), static_cast<std::streamsize>(_chunkBuffer.size()));
+	SocketBufVec buffers(3);
+	buffers[0] = Socket::makeBuffer(_chunkBuffer.data(), _chunkBuffer.size());
+	buffers[1] = Socket::makeBuffer(buffer, static_cast<std::size_t>(length));
+	buffers[2] = Socket::makeBuffer("\r\n", 2);
+	_session.write(buffers);
 	return static_cast<int>(length);
 }
 
@@ -158,7 +175,7 @@ HTTPChunkedStreamBuf* HTTPChunkedIOS::rdbuf()
 //
 
 
-Poco::MemoryPool HTTPChunkedInputStream::_pool(sizeof(HTTPChunkedInputStream));
+Poco::MemoryPool HTTPChunkedInputStream::_pool(sizeof(HTTPChunkedInputStream), 0, 0, 8);
 
 
 HTTPChunkedInputStream::HTTPChunkedInputStream(HTTPSession& session):
@@ -190,7 +207,7 @@ void HTTPChunkedInputStream::operator delete(void* ptr)
 //
 
 
-Poco::MemoryPool HTTPChunkedOutputStream::_pool(sizeof(HTTPChunkedOutputStream));
+Poco::MemoryPool HTTPChunkedOutputStream::_pool(sizeof(HTTPChunkedOutputStream), 0, 0, 8);
 
 
 HTTPChunkedOutputStream::HTTPChunkedOutputStream(HTTPSession& session):
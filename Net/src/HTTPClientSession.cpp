@@ -340,6 +340,29 @@ int HTTPClientSession::write(const char* buffer, std::streamsize length)
 }
 
 
+int HTTPClientSession::write(const SocketBufVec& buffers)
+{
+	try
+	{
+		int rc = HTTPSession::write(buffers);
+		_reconnect = false;
+		return rc;
+	}
+	catch (NetException&)
+	{
+		if (_reconnect)
+		{
+			close();
+			reconnect();
+			int rc = HTTPSession::write(buffers);
+			_reconnect = false;
+			return rc;
+		}
+		else throw;
+	}
+}
+
+
 void HTTPClientSession::reconnect()
 {
 	if (_proxyHost.empty())
@@ -245,9 +245,9 @@ void HTTPDigestCredentials::createAuthParams(const HTTPRequest& request, const H
 void HTTPDigestCredentials::updateAuthParams(const HTTPRequest& request)
 {
 	MD5Engine engine;
-	const std::string& qop = _requestAuthParams.get(QOP_PARAM, DEFAULT_QOP);
-	const std::string& realm = _requestAuthParams.getRealm();
-	const std::string& nonce = _requestAuthParams.get(NONCE_PARAM);
+	const std::string qop = _requestAuthParams.get(QOP_PARAM, DEFAULT_QOP);
+	const std::string realm = _requestAuthParams.getRealm();
+	const std::string nonce = _requestAuthParams.get(NONCE_PARAM);
 
 	_requestAuthParams.set(URI_PARAM, request.getURI());
 
@@ -260,7 +260,7 @@ void HTTPDigestCredentials::updateAuthParams(const HTTPRequest& request)
 	}
 	else if (icompare(qop, AUTH_PARAM) == 0) 
 	{
-		const std::string& cnonce = _requestAuthParams.get(CNONCE_PARAM);
+		const std::string cnonce = _requestAuthParams.get(CNONCE_PARAM);
 
 		const std::string ha1 = digest(engine, _username, realm, _password);
 		const std::string ha2 = digest(engine, request.getMethod(), request.getURI());
@@ -36,6 +36,7 @@
 
 #include "Poco/Net/HTTPHeaderStream.h"
 #include "Poco/Net/HTTPSession.h"
+#include <cstring>
 
 
 namespace Poco {
@@ -63,22 +64,31 @@ HTTPHeaderStreamBuf::~HTTPHeaderStreamBuf()
 int HTTPHeaderStreamBuf::readFromDevice(char* buffer, std::streamsize length)
 {
 	// read line-by-line; an empty line denotes the end of the headers.
-	static const int eof = std::char_traits<char>::eof();
-
+	// The session buffer is scanned for the line delimiter in bulk.
 	if (_end) return 0;
 
 	int n = 0;
-	int ch = _session.get();
-	while (ch != eof && ch != '\n' && n < length - 1)
-	{
-		*buffer++ = (char) ch; ++n;
-		ch = _session.get();
-	}
-	if (ch != eof)
+	bool eol = false;
+	while (!eol && n < length)
 	{
-		*buffer++ = (char) ch; ++n;
-		if (n == 2) _end = true;
+		if (_session._pCurrent == _session._pEnd)
+		{
+			_session.refill();
+			if (_session._pCurrent == _session._pEnd) break;
+		}
+		std::size_t avail = static_cast<std::size_t>(_session._pEnd - _session._pCurrent);
+		if (avail > static_cast<std::size_t>(length - n)) avail = static_cast<std::size_t>(length - n);
+		const char* pEol = static_cast<const char*>(std::memchr(_session._pCurrent, '\n', avail));
+		if (pEol)
+		{
+			avail = pEol - _session._pCurrent + 1;
+			eol = true;
+		}
+		std::memcpy(buffer + n, _session._pCurrent, avail);
+		_session._pCurrent += avail;
+		n += static_cast<int>(avail);
 	}
+	if (eol && (n == 1 || (n == 2 && buffer[0] == '\r'))) _end = true;
 	return n;
 }
 
@@ -124,7 +134,7 @@ HTTPHeaderStreamBuf* HTTPHeaderIOS::rdbuf()
 //
 
 
-Poco::MemoryPool HTTPHeaderInputStream::_pool(sizeof(HTTPHeaderInputStream));
+Poco::MemoryPool HTTPHeaderInputStream::_pool(sizeof(HTTPHeaderInputStream), 0, 0, 8);
 
 
 HTTPHeaderInputStream::HTTPHeaderInputStream(HTTPSession& session):
@@ -156,7 +166,7 @@ void HTTPHeaderInputStream::operator delete(void* ptr)
 //
 
 
-Poco::MemoryPool HTTPHeaderOutputStream::_pool(sizeof(HTTPHeaderOutputStream));
+Poco::MemoryPool HTTPHeaderOutputStream::_pool(sizeof(HTTPHeaderOutputStream), 0, 0, 8);
 
 
 HTTPHeaderOutputStream::HTTPHeaderOutputStream(HTTPSession& session):
@@ -217,20 +217,24 @@ void HTTPRequest::read(std::istream& istr)
 	version.reserve(16);
 	int ch = istr.get();
 	if (ch == eof) throw NoMessageException();
-	while (Poco::Ascii::isSpace(ch)) ch = istr.get();
+	// Read the remainder of the request line directly from the
+	// stream buffer, avoiding the per-character sentry overhead
+	// of std::istream::get().
+	std::streambuf& buf = *istr.rdbuf();
+	while (Poco::Ascii::isSpace(ch)) ch = buf.sbumpc();
 	if (ch == eof) throw MessageException("No HTTP request header");
-	while (!Poco::Ascii::isSpace(ch) && ch != eof && method.length() < MAX_METHOD_LENGTH) { method += (char) ch; ch = istr.get(); }
+	while (!Poco::Ascii::isSpace(ch) && ch != eof && method.length() < MAX_METHOD_LENGTH) { method += (char) ch; ch = buf.sbumpc(); }
 	if (!Poco::Ascii::isSpace(ch)) throw MessageException("HTTP request method invalid or too long");
-	while (Poco::Ascii::isSpace(ch)) ch = istr.get();
-	while (!Poco::Ascii::isSpace(ch) && ch != eof && uri.length() < MAX_URI_LENGTH) { uri += (char) ch; ch = istr.get(); }
+	while (Poco::Ascii::isSpace(ch)) ch = buf.sbumpc();
+	while (!Poco::Ascii::isSpace(ch) && ch != eof && uri.length() < MAX_URI_LENGTH) { uri += (char) ch; ch = buf.sbumpc(); }
 	if (!Poco::Ascii::isSpace(ch)) throw MessageException("HTTP request URI invalid or too long");
-	while (Poco::Ascii::isSpace(ch)) ch = istr.get();
-	while (!Poco::Ascii::isSpace(ch) && ch != eof && version.length() < MAX_VERSION_LENGTH) { version += (char) ch; ch = istr.get(); }
+	while (Poco::Ascii::isSpace(ch)) ch = buf.sbumpc();
+	while (!Poco::Ascii::isSpace(ch) && ch != eof && version.length() < MAX_VERSION_LENGTH) { version += (char) ch; ch = buf.sbumpc(); }
 	if (!Poco::Ascii::isSpace(ch)) throw MessageException("Invalid HTTP version string");
-	while (ch != '\n' && ch != eof) { ch = istr.get(); }
+	while (ch != '\n' && ch != eof) { ch = buf.sbumpc(); }
 	HTTPMessage::read(istr);
-	ch = istr.get();
-	while (ch != '\n' && ch != eof) { ch = istr.get(); }
+	ch = buf.sbumpc();
+	while (ch != '\n' && ch != eof) { ch = buf.sbumpc(); }
 	setMethod(method);
 	setURI(uri);
 	setVersion(version);
@@ -50,6 +50,9 @@
 #include "Poco/FileStream.h"
 #include "Poco/DateTimeFormatter.h"
 #include "Poco/DateTimeFormat.h"
+#include "Poco/String.h"
+#include "Poco/Ascii.h"
+#include <sstream>
 
 
 using Poco::File;
@@ -65,6 +68,70 @@ namespace Poco {
 namespace Net {
 
 
+namespace
+{
+	enum RangeResult
+	{
+		RANGE_NONE,
+		RANGE_VALID,
+		RANGE_UNSATISFIABLE
+	};
+
+	bool parseBytePos(std::string::const_iterator& it, std::string::const_iterator end, Poco::UInt64& pos)
+	{
+		if (it == end || !Poco::Ascii::isDigit(*it)) return false;
+		pos = 0;
+		while (it != end && Poco::Ascii::isDigit(*it))
+		{
+			if (pos > (Poco::UInt64(-1) - 9)/10) return false;
+			pos = pos*10 + (*it++ - '0');
+		}
+		return true;
+	}
+
+	RangeResult parseRange(const std::string& header, Poco::UInt64 length, Poco::UInt64& offset, Poco::UInt64& count)
+		/// Parses a Range header field containing a single byte range.
+		/// Multiple ranges are not supported and, like syntactically 
+		/// invalid ranges, result in RANGE_NONE, causing the complete
+		/// file to be sent.
+	{
+		std::string range = Poco::trim(header);
+		if (range.size() < 6 || Poco::icompare(range, 0, 6, std::string("bytes=")) != 0) return RANGE_NONE;
+		std::string::const_iterator it  = range.begin() + 6;
+		std::string::const_iterator end = range.end();
+		Poco::UInt64 first = 0;
+		Poco::UInt64 last  = 0;
+		if (it != end && *it == '-')
+		{
+			++it;
+			Poco::UInt64 suffix;
+			if (!parseBytePos(it, end, suffix) || it != end) return RANGE_NONE;
+			if (suffix == 0 || length == 0) return RANGE_UNSATISFIABLE;
+			first = suffix < length ? length - suffix : 0;
+			last  = length - 1;
+		}
+		else
+		{
+			if (!parseBytePos(it, end, first) || it == end || *it != '-') return RANGE_NONE;
+			++it;
+			if (it == end)
+			{
+				last = length - 1;
+			}
+			else
+			{
+				if (!parseBytePos(it, end, last) || it != end || last < first) return RANGE_NONE;
+				if (last >= length) last = length - 1;
+			}
+			if (first >= length) return RANGE_UNSATISFIABLE;
+		}
+		offset = first;
+		count  = last - first + 1;
+		return RANGE_VALID;
+	}
+}
+
+
 HTTPServerResponseImpl::HTTPServerResponseImpl(HTTPServerSession& session):
 	_session(session),
 	_pRequest(0),
@@ -135,22 +202,61 @@ void HTTPServerResponseImpl::sendFile(const std::string& path, const std::string
 	Timestamp dateTime    = f.getLastModified();
 	File::FileSize length = f.getSize();
 	set("Last-Modified", DateTimeFormatter::format(dateTime, DateTimeFormat::HTTP_FORMAT));
+	set("Accept-Ranges", "bytes");
+	setContentType(mediaType);
+	setChunkedTransferEncoding(false);
+
+	File::FileSize offset = 0;
+	File::FileSize count  = length;
+	RangeResult range = RANGE_NONE;
+	if (_pRequest && getStatus() == HTTPResponse::HTTP_OK && _pRequest->has("Range"))
+	{
+		range = parseRange(_pRequest->get("Range"), length, offset, count);
+	}
+	if (range == RANGE_VALID)
+	{
+		setStatusAndReason(HTTPResponse::HTTP_PARTIAL_CONTENT);
+		std::string contentRange("bytes ");
+		NumberFormatter::append(contentRange, offset);
+		contentRange += '-';
+		NumberFormatter::append(contentRange, offset + count - 1);
+		contentRange += '/';
+		NumberFormatter::append(contentRange, length);
+		set("Content-Range", contentRange);
+	}
+	else if (range == RANGE_UNSATISFIABLE)
+	{
+		setStatusAndReason(HTTPResponse::HTTP_REQUESTED_RANGE_NOT_SATISFIABLE);
+		std::string contentRange("bytes */");
+		NumberFormatter::append(contentRange, length);
+		set("Content-Range", contentRange);
+		count = 0;
+	}
 #if defined(POCO_HAVE_INT64)	
-	setContentLength64(length);
+	setContentLength64(count);
 #else
-	setContentLength(static_cast<int>(length));
+	setContentLength(static_cast<int>(count));
 #endif
-	setContentType(mediaType);
-	setChunkedTransferEncoding(false);
 
 	Poco::FileInputStream istr(path);
 	if (istr.good())
 	{
 		_pStream = new HTTPHeaderOutputStream(_session);
 		write(*_pStream);
-		if (_pRequest && _pRequest->getMethod() != HTTPRequest::HTTP_HEAD)
+		if (_pRequest && _pRequest->getMethod() != HTTPRequest::HTTP_HEAD && count > 0)
 		{
-			StreamCopier::copyStream(istr, *_pStream);
+			// The header must be in the socket before the file content
+			// is sent directly through the socket.
+			_pStream->flush();
+			try
+			{
+				_session.socket().sendFile(istr, offset, count);
+			}
+			catch (Poco::Exception& exc)
+			{
+				_session.setException(exc);
+				throw;
+			}
 		}
 	}
 	else throw OpenFileException(path);
@@ -164,12 +270,18 @@ void HTTPServerResponseImpl::sendBuffer(const void* pBuffer, std::size_t length)
 	setContentLength(static_cast<int>(length));
 	setChunkedTransferEncoding(false);
 	
-	_pStream = new HTTPHeaderOutputStream(_session);
-	write(*_pStream);
-	if (_pRequest && _pRequest->getMethod() != HTTPRequest::HTTP_HEAD)
+	// Send header and content with a single scatter/gather write.
+	std::ostringstream header;
+	write(header);
+	std::string headerStr(header.str());
+	SocketBufVec buffers;
+	buffers.push_back(Socket::makeBuffer(headerStr.data(), headerStr.size()));
+	if (_pRequest && _pRequest->getMethod() != HTTPRequest::HTTP_HEAD && length > 0)
 	{
-		_pStream->write(static_cast<const char*>(pBuffer), static_cast<std::streamsize>(length));
+		buffers.push_back(Socket::makeBuffer(pBuffer, length));
 	}
+	_pStream = new HTTPHeaderOutputStream(_session);
+	_session.write(buffers);
 }
 
 
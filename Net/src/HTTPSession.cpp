@@ -160,6 +160,20 @@ int HTTPSession::write(const char* buffer, std::streamsize length)
 }
 
 
+int HTTPSession::write(const SocketBufVec& buffers)
+{
+	try
+	{
+		return _socket.sendBytes(buffers);
+	}
+	catch (Poco::Exception& exc)
+	{
+		setException(exc);
+		throw;
+	}
+}
+
+
 int HTTPSession::receive(char* buffer, int length)
 {
 	try
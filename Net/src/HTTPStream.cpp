@@ -118,7 +118,7 @@ HTTPStreamBuf* HTTPIOS::rdbuf()
 //
 
 
-Poco::MemoryPool HTTPInputStream::_pool(sizeof(HTTPInputStream));
+Poco::MemoryPool HTTPInputStream::_pool(sizeof(HTTPInputStream), 0, 0, 8);
 
 
 HTTPInputStream::HTTPInputStream(HTTPSession& session):
@@ -150,7 +150,7 @@ void HTTPInputStream::operator delete(void* ptr)
 //
 
 
-Poco::MemoryPool HTTPOutputStream::_pool(sizeof(HTTPOutputStream));
+Poco::MemoryPool HTTPOutputStream::_pool(sizeof(HTTPOutputStream), 0, 0, 8);
 
 
 HTTPOutputStream::HTTPOutputStream(HTTPSession& session):
@@ -38,6 +38,7 @@
 #include "Poco/Net/NetException.h"
 #include "Poco/String.h"
 #include "Poco/Ascii.h"
+#include <cstring>
 
 
 namespace Poco {
@@ -80,48 +81,130 @@ void MessageHeader::write(std::ostream& ostr) const
 }
 
 
+namespace
+{
+	class GetArea: public std::streambuf
+		/// Gives access to the get area of any stream buffer,
+		/// which std::streambuf only provides to subclasses.
+	{
+	public:
+		static const char* begin(std::streambuf& buf)
+		{
+			return (buf.*&GetArea::gptr)();
+		}
+
+		static const char* end(std::streambuf& buf)
+		{
+			return (buf.*&GetArea::egptr)();
+		}
+
+		static void consume(std::streambuf& buf, std::streamsize n)
+		{
+			(buf.*&GetArea::gbump)(static_cast<int>(n));
+		}
+	};
+
+
+	std::streamsize readLine(std::streambuf& buf, char* line, std::streamsize size, bool& eol)
+		/// Reads a line into the given buffer. Returns the length of
+		/// the line, excluding the line delimiter and a trailing CR.
+		/// Sets eol to false if the line is terminated by the end
+		/// of the stream instead of a line delimiter.
+		///
+		/// The line is read directly from the stream buffer, so
+		/// the state and exception mask of the stream are not
+		/// affected, and exceptions thrown by the stream buffer
+		/// (e.g., a socket timeout) are propagated unchanged.
+		/// The buffered characters are searched for the line
+		/// delimiter and copied at once; the stream buffer is only
+		/// read character by character when its get area is empty.
+	{
+		static const int eof = std::char_traits<char>::eof();
+
+		std::streamsize n = 0;
+		eol = false;
+		for (;;)
+		{
+			const char* pBegin = GetArea::begin(buf);
+			const char* pEnd   = GetArea::end(buf);
+			if (pBegin < pEnd)
+			{
+				const char* pEol = static_cast<const char*>(std::memchr(pBegin, '\n', static_cast<std::size_t>(pEnd - pBegin)));
+				std::streamsize length = (pEol ? pEol : pEnd) - pBegin;
+				if (length > size - n) throw MessageException("Field value too long/no CRLF found");
+				std::memcpy(line + n, pBegin, static_cast<std::size_t>(length));
+				n += length;
+				if (pEol)
+				{
+					GetArea::consume(buf, length + 1);
+					eol = true;
+					break;
+				}
+				GetArea::consume(buf, length);
+			}
+			else
+			{
+				// empty get area: let the stream buffer refill it
+				int ch = buf.sbumpc();
+				if (ch == eof) break;
+				if (ch == '\n')
+				{
+					eol = true;
+					break;
+				}
+				if (n == size) throw MessageException("Field value too long/no CRLF found");
+				line[n++] = static_cast<char>(ch);
+			}
+		}
+		if (n > 0 && line[n - 1] == '\r') --n;
+		if (std::memchr(line, '\r', static_cast<std::size_t>(n))) throw MessageException("Field value too long/no CRLF found");
+		return n;
+	}
+}
+
+
 void MessageHeader::read(std::istream& istr)
 {
 	static const int eof = std::char_traits<char>::eof();
 	std::streambuf& buf = *istr.rdbuf();
 
+	char line[MAX_NAME_LENGTH + MAX_VALUE_LENGTH + 8];
 	std::string name;
 	std::string value;
 	name.reserve(32);
 	value.reserve(64);
-	int ch = buf.sbumpc();
+	bool eol;
+	int ch = buf.sgetc();
 	int fields = 0;
 	while (ch != eof && ch != '\r' && ch != '\n')
 	{
 		if (_fieldLimit > 0 && fields == _fieldLimit)
 			throw MessageException("Too many header fields");
-		name.clear();
-		value.clear();
-		while (ch != eof && ch != ':' && ch != '\n' && name.length() < MAX_NAME_LENGTH) { name += ch; ch = buf.sbumpc(); }
-		if (ch == '\n') { ch = buf.sbumpc(); continue; } // ignore invalid header lines
-		if (ch != ':') throw MessageException("Field name too long/no colon found");
-		if (ch != eof) ch = buf.sbumpc(); // ':'
-		while (ch != eof && Poco::Ascii::isSpace(ch) && ch != '\r' && ch != '\n') ch = buf.sbumpc();
-		while (ch != eof && ch != '\r' && ch != '\n' && value.length() < MAX_VALUE_LENGTH) { value += ch; ch = buf.sbumpc(); }
-		if (ch == '\r') ch = buf.sbumpc();
-		if (ch == '\n')
-			ch = buf.sbumpc();
-		else if (ch != eof)
-			throw MessageException("Field value too long/no CRLF found");
-		while (ch == ' ' || ch == '\t') // folding
+		std::streamsize n = readLine(buf, line, sizeof(line), eol);
+		const char* pEnd = line + n;
+		const char* pColon = static_cast<const char*>(std::memchr(line, ':', static_cast<std::size_t>(n)));
+		if (!pColon || pColon - line > MAX_NAME_LENGTH)
+		{
+			if (eol && n <= MAX_NAME_LENGTH) { ch = buf.sgetc(); continue; } // ignore invalid header lines
+			throw MessageException("Field name too long/no colon found");
+		}
+		const char* pValue = pColon + 1;
+		while (pValue != pEnd && Poco::Ascii::isSpace(*pValue)) ++pValue;
+		if (pEnd - pValue > MAX_VALUE_LENGTH) throw MessageException("Field value too long/no CRLF found");
+		name.assign(line, static_cast<std::size_t>(pColon - line));
+		value.assign(pValue, pEnd);
+		ch = buf.sgetc();
+		while (eol && (ch == ' ' || ch == '\t')) // folding
 		{
-			while (ch != eof && ch != '\r' && ch != '\n' && value.length() < MAX_VALUE_LENGTH) { value += ch; ch = buf.sbumpc(); }
-			if (ch == '\r') ch = buf.sbumpc();
-			if (ch == '\n')
-				ch = buf.sbumpc();
-			else if (ch != eof)
-				throw MessageException("Folded field value too long/no CRLF found");
+			n = readLine(buf, line, sizeof(line), eol);
+			if (value.length() + n > MAX_VALUE_LENGTH) throw MessageException("Folded field value too long/no CRLF found");
+			value.append(line, static_cast<std::size_t>(n));
+			ch = buf.sgetc();
 		}
 		Poco::trimRightInPlace(value);
 		add(name, value);
 		++fields;
 	}
-	istr.putback(ch);
 }
 
 
@@ -80,7 +80,7 @@ void NameValueCollection::swap(NameValueCollection& nvc)
 	
 const std::string& NameValueCollection::operator [] (const std::string& name) const
 {
-	ConstIterator it = _map.find(name);
+	ConstIterator it = find(name);
 	if (it != _map.end())
 		return it->second;
 	else
@@ -90,23 +90,24 @@ const std::string& NameValueCollection::operator [] (const std::string& name) co
 	
 void NameValueCollection::set(const std::string& name, const std::string& value)	
 {
-	Iterator it = _map.find(name);
-	if (it != _map.end())
+	Iterator it = std::lower_bound(_map.begin(), _map.end(), name, ILT());
+	if (it != _map.end() && Poco::icompare(it->first, name) == 0)
 		it->second = value;
 	else
-		_map.insert(HeaderMap::value_type(name, value));
+		_map.insert(it, PairVec::value_type(name, value));
 }
 
 	
 void NameValueCollection::add(const std::string& name, const std::string& value)
 {
-	_map.insert(HeaderMap::value_type(name, value));
+	Iterator it = std::upper_bound(_map.begin(), _map.end(), name, ILT());
+	_map.insert(it, PairVec::value_type(name, value));
 }
 
 	
 const std::string& NameValueCollection::get(const std::string& name) const
 {
-	ConstIterator it = _map.find(name);
+	ConstIterator it = find(name);
 	if (it != _map.end())
 		return it->second;
 	else
@@ -116,7 +117,7 @@ const std::string& NameValueCollection::get(const std::string& name) const
 
 const std::string& NameValueCollection::get(const std::string& name, const std::string& defaultValue) const
 {
-	ConstIterator it = _map.find(name);
+	ConstIterator it = find(name);
 	if (it != _map.end())
 		return it->second;
 	else
@@ -126,13 +127,17 @@ const std::string& NameValueCollection::get(const std::string& name, const std::
 
 bool NameValueCollection::has(const std::string& name) const
 {
-	return _map.find(name) != _map.end();
+	return find(name) != _map.end();
 }
 
 
 NameValueCollection::ConstIterator NameValueCollection::find(const std::string& name) const
 {
-	return _map.find(name);
+	ConstIterator it = std::lower_bound(_map.begin(), _map.end(), name, ILT());
+	if (it != _map.end() && Poco::icompare(it->first, name) == 0)
+		return it;
+	else
+		return _map.end();
 }
 
 	
@@ -162,7 +167,8 @@ int NameValueCollection::size() const
 
 void NameValueCollection::erase(const std::string& name)
 {
-	_map.erase(name);
+	std::pair<Iterator, Iterator> range = std::equal_range(_map.begin(), _map.end(), name, ILT());
+	_map.erase(range.first, range.second);
 }
 
 
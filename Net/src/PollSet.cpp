@@ -0,0 +1,416 @@
+//
+// PollSet.cpp
+//
+// $Id$
+//
+// Library: Net
+// Package: Sockets
+// Module:  PollSet
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Net/PollSet.h"
+#include "Poco/Net/SocketImpl.h"
+#include "Poco/Mutex.h"
+#include "Poco/Timestamp.h"
+#include <vector>
+#if defined(POCO_HAVE_FD_EPOLL)
+#include <sys/epoll.h>
+#endif
+
+
+namespace Poco {
+namespace Net {
+
+
+#if defined(POCO_HAVE_FD_EPOLL)
+
+
+//
+// Linux implementation using a persistent epoll instance
+//
+class PollSetImpl
+{
+public:
+	PollSetImpl():
+		_epollfd(epoll_create(1))
+	{
+		if (_epollfd < 0) SocketImpl::error();
+	}
+
+	~PollSetImpl()
+	{
+		::close(_epollfd);
+	}
+
+	void add(const Socket& socket, int mode)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		SocketImpl* pImpl = socket.impl();
+		SocketMap::iterator it = _socketMap.find(pImpl);
+		// Like Socket::select(), skip sockets that are not (or no
+		// longer) open. They stay in the set until removed, but
+		// are never reported as ready.
+		if (pImpl->sockfd() != POCO_INVALID_SOCKET)
+		{
+			struct epoll_event ev;
+			ev.events  = epollEvents(mode);
+			ev.data.ptr = pImpl;
+			int rc;
+			if (it == _socketMap.end())
+			{
+				rc = epoll_ctl(_epollfd, EPOLL_CTL_ADD, pImpl->sockfd(), &ev);
+			}
+			else
+			{
+				rc = epoll_ctl(_epollfd, EPOLL_CTL_MOD, pImpl->sockfd(), &ev);
+				if (rc < 0 && errno == ENOENT)
+					rc = epoll_ctl(_epollfd, EPOLL_CTL_ADD, pImpl->sockfd(), &ev);
+			}
+			if (rc < 0) SocketImpl::error();
+		}
+		if (it == _socketMap.end())
+			_socketMap.insert(SocketMap::value_type(pImpl, Entry(socket, mode)));
+		else
+			it->second.mode = mode;
+	}
+
+	void remove(const Socket& socket)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		SocketImpl* pImpl = socket.impl();
+		SocketMap::iterator it = _socketMap.find(pImpl);
+		if (it != _socketMap.end())
+		{
+			// The socket may already have been closed, in which case
+			// the kernel has removed it from the epoll set anyway.
+			if (pImpl->sockfd() != POCO_INVALID_SOCKET)
+			{
+				struct epoll_event ev;
+				ev.events  = 0;
+				ev.data.ptr = 0;
+				epoll_ctl(_epollfd, EPOLL_CTL_DEL, pImpl->sockfd(), &ev);
+			}
+			_socketMap.erase(it);
+		}
+	}
+
+	void update(const Socket& socket, int mode)
+	{
+		add(socket, mode);
+	}
+
+	bool has(const Socket& socket) const
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		return _socketMap.find(socket.impl()) != _socketMap.end();
+	}
+
+	bool empty() const
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		return _socketMap.empty();
+	}
+
+	void clear()
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		for (SocketMap::iterator it = _socketMap.begin(); it != _socketMap.end(); ++it)
+		{
+			poco_socket_t fd = it->second.socket.impl()->sockfd();
+			if (fd != POCO_INVALID_SOCKET)
+			{
+				struct epoll_event ev;
+				ev.events  = 0;
+				ev.data.ptr = 0;
+				epoll_ctl(_epollfd, EPOLL_CTL_DEL, fd, &ev);
+			}
+		}
+		_socketMap.clear();
+	}
+
+	PollSet::SocketModeMap poll(const Poco::Timespan& timeout)
+	{
+		PollSet::SocketModeMap result;
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			if (_socketMap.empty()) return result;
+			if (_events.size() < _socketMap.size()) _events.resize(_socketMap.size());
+		}
+
+		Poco::Timespan remainingTime(timeout);
+		int rc;
+		do
+		{
+			Poco::Timestamp start;
+			rc = epoll_wait(_epollfd, &_events[0], static_cast<int>(_events.size()), static_cast<int>(remainingTime.totalMilliseconds()));
+			if (rc < 0 && SocketImpl::lastError() != POCO_EINTR) SocketImpl::error();
+			if (rc > 0) collect(rc, result);
+			if (rc != 0 && result.empty())
+			{
+				// interrupted, or only events nobody waits for
+				Poco::Timestamp end;
+				Poco::Timespan waited = end - start;
+				if (waited < remainingTime)
+					remainingTime -= waited;
+				else
+					remainingTime = 0;
+			}
+		}
+		while (rc != 0 && result.empty() && remainingTime > 0);
+		return result;
+	}
+
+private:
+	struct Entry
+	{
+		Entry(const Socket& s, int m):
+			socket(s),
+			mode(m)
+		{
+		}
+
+		Socket socket;
+		int    mode;
+	};
+
+	typedef std::map<void*, Entry> SocketMap;
+
+	static int epollEvents(int mode)
+	{
+		int events = 0;
+		if (mode & PollSet::POLL_READ)
+			events |= EPOLLIN;
+		if (mode & PollSet::POLL_WRITE)
+			events |= EPOLLOUT;
+		if (mode & PollSet::POLL_ERROR)
+			events |= EPOLLERR;
+		return events;
+	}
+
+	void collect(int n, PollSet::SocketModeMap& result)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		for (int i = 0; i < n; i++)
+		{
+			SocketMap::iterator it = _socketMap.find(_events[i].data.ptr);
+			if (it != _socketMap.end())
+			{
+				// Same mapping as select(): a hung up socket is
+				// readable, a socket with a pending error is
+				// readable and writable.
+				int mode = 0;
+				if (_events[i].events & (EPOLLIN | EPOLLHUP))
+					mode |= PollSet::POLL_READ;
+				if (_events[i].events & EPOLLOUT)
+					mode |= PollSet::POLL_WRITE;
+				if (_events[i].events & EPOLLERR)
+					mode |= PollSet::POLL_READ | PollSet::POLL_WRITE | PollSet::POLL_ERROR;
+				mode &= it->second.mode;
+				if (mode)
+				{
+					result[it->second.socket] = mode;
+				}
+				else
+				{
+					// EPOLLHUP and EPOLLERR are always reported, even if
+					// nobody waits for them. Take the socket out of the
+					// epoll set until its mode is updated, so that it
+					// does not wake up every call to poll().
+					struct epoll_event ev;
+					ev.events  = 0;
+					ev.data.ptr = 0;
+					epoll_ctl(_epollfd, EPOLL_CTL_DEL, it->second.socket.impl()->sockfd(), &ev);
+				}
+			}
+		}
+	}
+
+	mutable Poco::FastMutex         _mutex;
+	int                             _epollfd;
+	SocketMap                       _socketMap;
+	std::vector<struct epoll_event> _events;
+};
+
+
+#else
+
+
+//
+// Generic implementation using Socket::select()
+//
+class PollSetImpl
+{
+public:
+	void add(const Socket& socket, int mode)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		_map[socket] = mode;
+	}
+
+	void remove(const Socket& socket)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		_map.erase(socket);
+	}
+
+	void update(const Socket& socket, int mode)
+	{
+		add(socket, mode);
+	}
+
+	bool has(const Socket& socket) const
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		return _map.find(socket) != _map.end();
+	}
+
+	bool empty() const
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		return _map.empty();
+	}
+
+	void clear()
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		_map.clear();
+	}
+
+	PollSet::SocketModeMap poll(const Poco::Timespan& timeout)
+	{
+		PollSet::SocketModeMap result;
+		Socket::SocketList readList;
+		Socket::SocketList writeList;
+		Socket::SocketList exceptList;
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			for (PollSet::SocketModeMap::const_iterator it = _map.begin(); it != _map.end(); ++it)
+			{
+				if (it->second & PollSet::POLL_READ)
+					readList.push_back(it->first);
+				if (it->second & PollSet::POLL_WRITE)
+					writeList.push_back(it->first);
+				if (it->second & PollSet::POLL_ERROR)
+					exceptList.push_back(it->first);
+			}
+		}
+		if (readList.empty() && writeList.empty() && exceptList.empty()) return result;
+
+		if (Socket::select(readList, writeList, exceptList, timeout))
+		{
+			for (Socket::SocketList::const_iterator it = readList.begin(); it != readList.end(); ++it)
+				result[*it] |= PollSet::POLL_READ;
+			for (Socket::SocketList::const_iterator it = writeList.begin(); it != writeList.end(); ++it)
+				result[*it] |= PollSet::POLL_WRITE;
+			for (Socket::SocketList::const_iterator it = exceptList.begin(); it != exceptList.end(); ++it)
+				result[*it] |= PollSet::POLL_ERROR;
+		}
+		return result;
+	}
+
+private:
+	mutable Poco::FastMutex _mutex;
+	PollSet::SocketModeMap  _map;
+};
+
+
+#endif // POCO_HAVE_FD_EPOLL
+
+
+//
+// PollSet
+//
+PollSet::PollSet():
+	_pImpl(new PollSetImpl)
+{
+}
+
+
+PollSet::~PollSet()
+{
+	delete _pImpl;
+}
+
+
+void PollSet::add(const Socket& socket, int mode)
+{
+	_pImpl->add(socket, mode);
+}
+
+
+void PollSet::remove(const Socket& socket)
+{
+	_pImpl->remove(socket);
+}
+
+
+void PollSet::update(const Socket& socket, int mode)
+{
+	_pImpl->update(socket, mode);
+}
+
+
+bool PollSet::has(const Socket& socket) const
+{
+	return _pImpl->has(socket);
+}
+
+
+bool PollSet::empty() const
+{
+	return _pImpl->empty();
+}
+
+
+void PollSet::clear()
+{
+	_pImpl->clear();
+}
+
+
+PollSet::SocketModeMap PollSet::poll(const Poco::Timespan& timeout)
+{
+	return _pImpl->poll(timeout);
+}
+
+
+} } // namespace Poco::Net
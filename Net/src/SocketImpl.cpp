@@ -301,6 +301,40 @@ int SocketImpl::sendBytes(const void* buffer, int length, int flags)
 }
 
 
+int SocketImpl::sendBytes(const SocketBufVec& buffers, int flags)
+{
+	if (buffers.empty()) return 0;
+
+#if defined(POCO_BROKEN_TIMEOUTS)
+	if (_sndTimeout.totalMicroseconds() != 0)
+	{
+		if (!poll(_sndTimeout, SELECT_WRITE))
+			throw TimeoutException();
+	}
+#endif
+
+	int rc;
+	do
+	{
+		if (_sockfd == POCO_INVALID_SOCKET) throw InvalidSocketException();
+#if defined(POCO_OS_FAMILY_WINDOWS)
+		DWORD sent = 0;
+		rc = WSASend(_sockfd, const_cast<LPWSABUF>(&buffers[0]), static_cast<DWORD>(buffers.size()), &sent, static_cast<DWORD>(flags), 0, 0);
+		if (rc == 0) rc = static_cast<int>(sent);
+#else
+		struct msghdr msg;
+		std::memset(&msg, 0, sizeof(msg));
+		msg.msg_iov    = const_cast<struct iovec*>(&buffers[0]);
+		msg.msg_iovlen = buffers.size();
+		rc = ::sendmsg(_sockfd, &msg, flags);
+#endif
+	}
+	while (_blocking && rc < 0 && lastError() == POCO_EINTR);
+	if (rc < 0) error();
+	return rc;
+}
+
+
 int SocketImpl::receiveBytes(void* buffer, int length, int flags)
 {
 #if defined(POCO_BROKEN_TIMEOUTS)
@@ -84,55 +84,33 @@ SocketReactor::~SocketReactor()
 
 void SocketReactor::run()
 {
-	Socket::SocketList readable;
-	Socket::SocketList writable;
-	Socket::SocketList except;
-	
 	while (!_stop)
 	{
 		try
 		{
-			readable.clear();
-			writable.clear();
-			except.clear();
-			int nSockets = 0;
+			if (_pollSet.empty())
+			{
+				onIdle();
+			}
+			else
 			{
-				FastMutex::ScopedLock lock(_mutex);
-				for (EventHandlerMap::iterator it = _handlers.begin(); it != _handlers.end(); ++it)
+				PollSet::SocketModeMap sm = _pollSet.poll(_timeout);
+				if (!sm.empty())
 				{
-					if (it->second->accepts(_pReadableNotification))
-					{
-						readable.push_back(it->first);
-						nSockets++;
-					}
-					if (it->second->accepts(_pWritableNotification))
-					{
-						writable.push_back(it->first);
-						nSockets++;
-					}
-					if (it->second->accepts(_pErrorNotification))
+					onBusy();
+
+					for (PollSet::SocketModeMap::iterator it = sm.begin(); it != sm.end(); ++it)
 					{
-						except.push_back(it->first);
-						nSockets++;
+						if (it->second & PollSet::POLL_READ)
+							dispatch(it->first, _pReadableNotification);
+						if (it->second & PollSet::POLL_WRITE)
+							dispatch(it->first, _pWritableNotification);
+						if (it->second & PollSet::POLL_ERROR)
+							dispatch(it->first, _pErrorNotification);
 					}
 				}
+				else onTimeout();
 			}
-			if (nSockets == 0)
-			{
-				onIdle();
-			}
-			else if (Socket::select(readable, writable, except, _timeout))
-			{
-				onBusy();
-
-				for (Socket::SocketList::iterator it = readable.begin(); it != readable.end(); ++it)
-					dispatch(*it, _pReadableNotification);
-				for (Socket::SocketList::iterator it = writable.begin(); it != writable.end(); ++it)
-					dispatch(*it, _pWritableNotification);
-				for (Socket::SocketList::iterator it = except.begin(); it != except.end(); ++it)
-					dispatch(*it, _pErrorNotification);
-			}
-			else onTimeout();
 		}
 		catch (Exception& exc)
 		{
@@ -184,7 +162,10 @@ void SocketReactor::addEventHandler(const Socket& socket, const Poco::AbstractOb
 		else pNotifier = it->second;
 	}
 	if (!pNotifier->hasObserver(observer))
+	{
 		pNotifier->addObserver(this, observer);
+		updatePollSet(socket);
+	}
 }
 
 
@@ -225,8 +206,33 @@ void SocketReactor::removeEventHandler(const Socket& socket, const Poco::Abstrac
 	if (pNotifier && pNotifier->hasObserver(observer))
 	{
 		pNotifier->removeObserver(this, observer);
+		updatePollSet(socket);
 	}
+}
+
 
+void SocketReactor::updatePollSet(const Socket& socket)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	// Always use the notifier that is currently registered for the
+	// socket. Another thread may have replaced the notifier passed to
+	// add/removeEventHandler() in the meantime.
+	int mode = 0;
+	EventHandlerMap::iterator it = _handlers.find(socket);
+	if (it != _handlers.end())
+	{
+		if (it->second->accepts(_pReadableNotification))
+			mode |= PollSet::POLL_READ;
+		if (it->second->accepts(_pWritableNotification))
+			mode |= PollSet::POLL_WRITE;
+		if (it->second->accepts(_pErrorNotification))
+			mode |= PollSet::POLL_ERROR;
+	}
+	if (mode)
+		_pollSet.update(socket, mode);
+	else
+		_pollSet.remove(socket);
 }
 
 
@@ -39,7 +39,6 @@
 #include "Poco/Exception.h"
 
 
-using Poco::BufferedBidirectionalStreamBuf;
 using Poco::InvalidArgumentException;
 
 
@@ -53,7 +52,7 @@ namespace Net {
 
 
 SocketStreamBuf::SocketStreamBuf(const Socket& socket): 
-	BufferedBidirectionalStreamBuf(STREAM_BUFFER_SIZE, std::ios::in | std::ios::out),
+	SocketBufferedStreamBuf(SOCKET_STREAM_BUFFER_SIZE, std::ios::in | std::ios::out),
 	_pImpl(dynamic_cast<StreamSocketImpl*>(socket.impl()))
 {
 	if (_pImpl)
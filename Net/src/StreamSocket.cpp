@@ -134,6 +134,12 @@ int StreamSocket::sendBytes(const void* buffer, int length, int flags)
 }
 
 
+int StreamSocket::sendBytes(const SocketBufVec& buffers, int flags)
+{
+	return impl()->sendBytes(buffers, flags);
+}
+
+
 int StreamSocket::sendBytes(FIFOBuffer& fifoBuf)
 {
 	int ret = impl()->sendBytes(&fifoBuf.buffer()[0], (int) fifoBuf.used());
@@ -156,6 +162,12 @@ int StreamSocket::receiveBytes(FIFOBuffer& fifoBuf)
 }
 
 
+Poco::Int64 StreamSocket::sendFile(Poco::FileInputStream& istr, Poco::UInt64 offset, Poco::UInt64 count)
+{
+	return static_cast<StreamSocketImpl*>(impl())->sendFile(istr, offset, count);
+}
+
+
 void StreamSocket::sendUrgent(unsigned char data)
 {
 	impl()->sendUrgent(data);
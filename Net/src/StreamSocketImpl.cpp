@@ -35,8 +35,14 @@
 
 
 #include "Poco/Net/StreamSocketImpl.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/Net/Socket.h"
 #include "Poco/Exception.h"
 #include "Poco/Thread.h"
+#include "Poco/Buffer.h"
+#if defined(POCO_HAVE_SENDFILE)
+#include <sys/sendfile.h>
+#endif
 
 
 namespace Poco {
@@ -92,4 +98,110 @@ int StreamSocketImpl::sendBytes(const void* buffer, int length, int flags)
 }
 
 
+int StreamSocketImpl::sendBytes(const SocketBufVec& buffers, int flags)
+{
+	if (!supportsZeroCopy())
+	{
+		int sent = 0;
+		for (SocketBufVec::const_iterator it = buffers.begin(); it != buffers.end(); ++it)
+		{
+			int length = Socket::bufferLength(*it);
+			int n = sendBytes(Socket::bufferData(*it), length, flags);
+			if (n < 0) return sent > 0 ? sent : n;
+			sent += n;
+			if (n < length) break;
+		}
+		return sent;
+	}
+
+	int total = 0;
+	for (SocketBufVec::const_iterator it = buffers.begin(); it != buffers.end(); ++it)
+	{
+		total += Socket::bufferLength(*it);
+	}
+	int sent = SocketImpl::sendBytes(buffers, flags);
+	poco_assert_dbg (sent >= 0);
+	bool blocking = getBlocking();
+	while (blocking && sent < total)
+	{
+		// partial write - send the remaining data
+		Poco::Thread::yield();
+		SocketBufVec::const_iterator it = buffers.begin();
+		int skip = sent;
+		while (skip >= Socket::bufferLength(*it)) 
+		{
+			skip -= Socket::bufferLength(*it);
+			++it;
+		}
+		SocketBufVec remaining(it, buffers.end());
+		remaining[0] = Socket::makeBuffer(static_cast<const char*>(Socket::bufferData(remaining[0])) + skip, Socket::bufferLength(remaining[0]) - skip);
+		int n = SocketImpl::sendBytes(remaining, flags);
+		poco_assert_dbg (n >= 0);
+		sent += n;
+	}
+	return sent;
+}
+
+
+Poco::Int64 StreamSocketImpl::sendFile(Poco::FileInputStream& istr, Poco::UInt64 offset, Poco::UInt64 count)
+{
+#if defined(POCO_HAVE_SENDFILE)
+	if (supportsZeroCopy())
+	{
+		int fd = istr.nativeHandle();
+		if (fd == -1) throw Poco::InvalidArgumentException("File not open");
+		off_t pos = static_cast<off_t>(offset);
+		Poco::Int64 sent = 0;
+		bool blocking = getBlocking();
+		while (count > 0)
+		{
+			// Linux transfers at most 0x7ffff000 bytes per call.
+			std::size_t n = count < 0x40000000 ? static_cast<std::size_t>(count) : 0x40000000;
+			ssize_t rc;
+			do
+			{
+				if (sockfd() == POCO_INVALID_SOCKET) throw InvalidSocketException();
+				rc = ::sendfile(sockfd(), fd, &pos, n);
+			}
+			while (blocking && rc < 0 && lastError() == POCO_EINTR);
+			if (rc < 0) error();
+			if (rc == 0) break; // end of file
+			sent  += rc;
+			count -= rc;
+			if (!blocking) break;
+		}
+		return sent;
+	}
+#endif
+	return copyFile(istr, offset, count);
+}
+
+
+bool StreamSocketImpl::supportsZeroCopy() const
+{
+	return true;
+}
+
+
+Poco::Int64 StreamSocketImpl::copyFile(Poco::FileInputStream& istr, Poco::UInt64 offset, Poco::UInt64 count)
+{
+	istr.clear();
+	istr.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+	Poco::Buffer<char> buffer(FILE_BUFFER_SIZE);
+	Poco::Int64 sent = 0;
+	while (count > 0 && istr.good())
+	{
+		std::streamsize n = count < FILE_BUFFER_SIZE ? static_cast<std::streamsize>(count) : static_cast<std::streamsize>(FILE_BUFFER_SIZE);
+		istr.read(buffer.begin(), n);
+		n = istr.gcount();
+		if (n == 0) break;
+		int rc = sendBytes(buffer.begin(), static_cast<int>(n));
+		if (rc > 0) sent += rc;
+		if (rc < n) break;
+		count -= n;
+	}
+	return sent;
+}
+
+
 } } // namespace Poco::Net
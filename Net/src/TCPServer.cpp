@@ -68,6 +68,15 @@ TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::ThreadPool&
 }
 
 
+TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::WorkStealingThreadPool& threadPool, const ServerSocket& socket, TCPServerParams::Ptr pParams):
+	_socket(socket),
+	_pDispatcher(new TCPServerDispatcher(pFactory, threadPool, pParams)),
+	_thread(threadName(socket)),
+	_stopped(true)
+{
+}
+
+
 TCPServer::~TCPServer()
 {
 	stop();
@@ -38,6 +38,8 @@
 #include "Poco/Net/TCPServerConnectionFactory.h"
 #include "Poco/Notification.h"
 #include "Poco/AutoPtr.h"
+#include "Poco/NotificationQueueAdapter.h"
+#include "Poco/ThreadPoolAdapter.h"
 #include <memory>
 
 
@@ -81,21 +83,39 @@ TCPServerDispatcher::TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactor
 	_maxConcurrentConnections(0),
 	_refusedConnections(0),
 	_stopped(false),
+	_pQueue(0),
 	_pConnectionFactory(pFactory),
-	_threadPool(threadPool)
+	_pThreadPool(new Poco::ThreadPoolAdapter<Poco::ThreadPool>(threadPool))
 {
 	poco_check_ptr (pFactory);
 
-	if (!_pParams)
-		_pParams = new TCPServerParams;
-	
-	if (_pParams->getMaxThreads() == 0)
-		_pParams->setMaxThreads(threadPool.capacity());
+	init();
+}
+
+
+TCPServerDispatcher::TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactory, Poco::WorkStealingThreadPool& threadPool, TCPServerParams::Ptr pParams):
+	_rc(1),
+	_pParams(pParams),
+	_currentThreads(0),
+	_totalConnections(0),
+	_currentConnections(0),
+	_maxConcurrentConnections(0),
+	_refusedConnections(0),
+	_stopped(false),
+	_pQueue(0),
+	_pConnectionFactory(pFactory),
+	_pThreadPool(new Poco::ThreadPoolAdapter<Poco::WorkStealingThreadPool>(threadPool))
+{
+	poco_check_ptr (pFactory);
+
+	init();
 }
 
 
 TCPServerDispatcher::~TCPServerDispatcher()
 {
+	delete _pQueue;
+	delete _pThreadPool;
 }
 
 
@@ -124,7 +144,7 @@ void TCPServerDispatcher::run()
 
 	for (;;)
 	{
-		AutoPtr<Notification> pNf = _queue.waitDequeueNotification(idleTime);
+		AutoPtr<Notification> pNf = _pQueue->waitDequeueNotification(idleTime);
 		if (pNf)
 		{
 			TCPConnectionNotification* pCNf = dynamic_cast<TCPConnectionNotification*>(pNf.get());
@@ -137,9 +157,12 @@ void TCPServerDispatcher::run()
 				endConnection();
 			}
 		}
+
+		// avoid locking the mutex as long as there is work to do
+		if (!_stopped && !_pQueue->empty()) continue;
 	
 		FastMutex::ScopedLock lock(_mutex);
-		if (_stopped || (_currentThreads > 1 && _queue.empty()))
+		if (_stopped || (_currentThreads > 1 && _pQueue->empty()))
 		{
 			--_currentThreads;
 			break;
@@ -156,27 +179,19 @@ namespace
 	
 void TCPServerDispatcher::enqueue(const StreamSocket& socket)
 {
-	FastMutex::ScopedLock lock(_mutex);
-
-	if (_queue.size() < _pParams->getMaxQueued())
+	// The mutex is only needed if a new thread must be started,
+	// or if the connection must be refused.
+	if (_pQueue->size() < _pParams->getMaxQueued() && _pQueue->tryEnqueueNotification(new TCPConnectionNotification(socket)))
 	{
-		_queue.enqueueNotification(new TCPConnectionNotification(socket));
-		if (!_queue.hasIdleThreads() && _currentThreads < _pParams->getMaxThreads())
+		if (!_pQueue->hasIdleThreads())
 		{
-			try
-			{
-				_threadPool.startWithPriority(_pParams->getThreadPriority(), *this, threadName);
-				++_currentThreads;
-			}
-			catch (Poco::Exception&)
-			{
-				// no problem here, connection is already queued
-				// and a new thread might be available later.
-			}
+			FastMutex::ScopedLock lock(_mutex);
+			startThread();
 		}
 	}
 	else
 	{
+		FastMutex::ScopedLock lock(_mutex);
 		++_refusedConnections;
 	}
 }
@@ -185,8 +200,8 @@ void TCPServerDispatcher::enqueue(const StreamSocket& socket)
 void TCPServerDispatcher::stop()
 {
 	_stopped = true;
-	_queue.clear();
-	_queue.wakeUpAll();
+	_pQueue->clear();
+	_pQueue->wakeUpAll();
 }
 
 
@@ -224,7 +239,7 @@ int TCPServerDispatcher::maxConcurrentConnections() const
 
 int TCPServerDispatcher::queuedConnections() const
 {
-	return _queue.size();
+	return _pQueue->size();
 }
 
 
@@ -255,4 +270,37 @@ void TCPServerDispatcher::endConnection()
 }
 
 
+void TCPServerDispatcher::init()
+{
+	if (!_pParams)
+		_pParams = new TCPServerParams;
+	
+	if (_pParams->getMaxThreads() == 0)
+		_pParams->setMaxThreads(_pThreadPool->capacity());
+
+	if (_pParams->getLockFreeQueue())
+		_pQueue = new Poco::NotificationQueueAdapter<Poco::LockFreeNotificationQueue>(_pParams->getMaxQueued());
+	else
+		_pQueue = new Poco::NotificationQueueAdapter<Poco::NotificationQueue>;
+}
+
+
+void TCPServerDispatcher::startThread()
+{
+	if (_currentThreads < _pParams->getMaxThreads())
+	{
+		try
+		{
+			_pThreadPool->startWithPriority(_pParams->getThreadPriority(), *this, threadName);
+			++_currentThreads;
+		}
+		catch (Poco::Exception&)
+		{
+			// no problem here, connection is already queued
+			// and a new thread might be available later.
+		}
+	}
+}
+
+
 } } // namespace Poco::Net
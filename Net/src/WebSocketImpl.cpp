@@ -114,6 +114,24 @@ int WebSocketImpl::sendBytes(const void* buffer, int length, int flags)
 	return length;
 }
 
+
+int WebSocketImpl::sendBytes(const SocketBufVec& buffers, int flags)
+{
+	int length = 0;
+	for (SocketBufVec::const_iterator it = buffers.begin(); it != buffers.end(); ++it)
+	{
+		length += Socket::bufferLength(*it);
+	}
+	Poco::Buffer<char> payload(length);
+	char* p = payload.begin();
+	for (SocketBufVec::const_iterator it = buffers.begin(); it != buffers.end(); ++it)
+	{
+		std::memcpy(p, Socket::bufferData(*it), Socket::bufferLength(*it));
+		p += Socket::bufferLength(*it);
+	}
+	return sendBytes(payload.begin(), length, flags);
+}
+
 	
 int WebSocketImpl::receiveBytes(void* buffer, int length, int)
 {
@@ -292,6 +310,12 @@ void WebSocketImpl::sendUrgent(unsigned char data)
 }
 
 
+bool WebSocketImpl::supportsZeroCopy() const
+{
+	return false;
+}
+
+
 bool WebSocketImpl::secure() const
 {
 	return _pStreamSocketImpl->secure();
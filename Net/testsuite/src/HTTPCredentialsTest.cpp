@@ -126,6 +126,16 @@ void HTTPCredentialsTest::testBadCredentials()
 	catch (NotAuthenticatedException&)
 	{
 	}
+
+	request.setCredentials("Basic", "dXNlcjpzZWNyZXQ#");
+	try
+	{
+		HTTPBasicCredentials cred(request);
+		fail("invalid credentials - must throw");
+	}
+	catch (NotAuthenticatedException&)
+	{
+	}
 }
 
 
@@ -44,6 +44,8 @@
 #include "Poco/Net/HTTPServerResponse.h"
 #include "Poco/Net/ServerSocket.h"
 #include "Poco/StreamCopier.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/FileStream.h"
 #include <sstream>
 
 
@@ -60,6 +62,8 @@ using Poco::Net::HTTPServerResponse;
 using Poco::Net::HTTPMessage;
 using Poco::Net::ServerSocket;
 using Poco::StreamCopier;
+using Poco::TemporaryFile;
+using Poco::FileOutputStream;
 
 
 namespace
@@ -126,9 +130,35 @@ namespace
 		}
 	};
 	
+	class FileRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		FileRequestHandler(const std::string& path):
+			_path(path)
+		{
+		}
+		
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			response.sendFile(_path, "text/plain");
+		}
+		
+	private:
+		std::string _path;
+	};
+	
 	class RequestHandlerFactory: public HTTPRequestHandlerFactory
 	{
 	public:
+		RequestHandlerFactory()
+		{
+		}
+		
+		RequestHandlerFactory(const std::string& path):
+			_path(path)
+		{
+		}
+
 		HTTPRequestHandler* createRequestHandler(const HTTPServerRequest& request)
 		{
 			if (request.getURI() == "/echoBody")
@@ -141,9 +171,14 @@ namespace
 				return new AuthRequestHandler();
 			else if (request.getURI() == "/buffer")
 				return new BufferRequestHandler();
+			else if (request.getURI() == "/file")
+				return new FileRequestHandler(_path);
 			else
 				return 0;
 		}
+		
+	private:
+		std::string _path;
 	};
 }
 
@@ -547,6 +582,131 @@ void HTTPServerTest::testBuffer()
 }
 
 
+void HTTPServerTest::testFile()
+{
+	TemporaryFile file;
+	std::string data;
+	for (int i = 0; i < 10000; ++i) data += "0123456789abcdef";
+	{
+		FileOutputStream ostr(file.path());
+		ostr << data;
+	}
+	
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	HTTPServer srv(new RequestHandlerFactory(file.path()), svs, pParams);
+	srv.start();
+	
+	HTTPClientSession cs("localhost", svs.address().port());
+	cs.setKeepAlive(true);
+	for (int i = 0; i < 2; ++i)
+	{
+		HTTPRequest request("GET", "/file", HTTPMessage::HTTP_1_1);
+		cs.sendRequest(request);
+		HTTPResponse response;
+		std::string rbody;
+		std::istream& rs = cs.receiveResponse(response);
+		StreamCopier::copyToString(rs, rbody);
+		assert (response.getStatus() == HTTPResponse::HTTP_OK);
+		assert (response.getContentLength() == data.size());
+		assert (response.getContentType() == "text/plain");
+		assert (response.get("Accept-Ranges") == "bytes");
+		assert (rbody == data);
+	}
+	
+	HTTPRequest request("HEAD", "/file", HTTPMessage::HTTP_1_1);
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::string rbody;
+	cs.receiveResponse(response) >> rbody;
+	assert (response.getStatus() == HTTPResponse::HTTP_OK);
+	assert (response.getContentLength() == data.size());
+	assert (rbody.empty());
+}
+
+
+void HTTPServerTest::testFileRange()
+{
+	TemporaryFile file;
+	std::string data("0123456789abcdef");
+	{
+		FileOutputStream ostr(file.path());
+		ostr << data;
+	}
+	
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	HTTPServer srv(new RequestHandlerFactory(file.path()), svs, pParams);
+	srv.start();
+	
+	HTTPClientSession cs("localhost", svs.address().port());
+	cs.setKeepAlive(true);
+	
+	HTTPRequest request1("GET", "/file", HTTPMessage::HTTP_1_1);
+	request1.set("Range", "bytes=2-5");
+	cs.sendRequest(request1);
+	HTTPResponse response1;
+	std::string rbody;
+	StreamCopier::copyToString(cs.receiveResponse(response1), rbody);
+	assert (response1.getStatus() == HTTPResponse::HTTP_PARTIAL_CONTENT);
+	assert (response1.get("Content-Range") == "bytes 2-5/16");
+	assert (response1.getContentLength() == 4);
+	assert (rbody == "2345");
+	
+	HTTPRequest request2("GET", "/file", HTTPMessage::HTTP_1_1);
+	request2.set("Range", "bytes=10-");
+	cs.sendRequest(request2);
+	HTTPResponse response2;
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response2), rbody);
+	assert (response2.getStatus() == HTTPResponse::HTTP_PARTIAL_CONTENT);
+	assert (response2.get("Content-Range") == "bytes 10-15/16");
+	assert (rbody == "abcdef");
+
+	HTTPRequest request3("GET", "/file", HTTPMessage::HTTP_1_1);
+	request3.set("Range", "bytes=-3");
+	cs.sendRequest(request3);
+	HTTPResponse response3;
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response3), rbody);
+	assert (response3.getStatus() == HTTPResponse::HTTP_PARTIAL_CONTENT);
+	assert (response3.get("Content-Range") == "bytes 13-15/16");
+	assert (rbody == "def");
+
+	HTTPRequest request4("GET", "/file", HTTPMessage::HTTP_1_1);
+	request4.set("Range", "bytes=8-100");
+	cs.sendRequest(request4);
+	HTTPResponse response4;
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response4), rbody);
+	assert (response4.getStatus() == HTTPResponse::HTTP_PARTIAL_CONTENT);
+	assert (response4.get("Content-Range") == "bytes 8-15/16");
+	assert (rbody == "89abcdef");
+
+	HTTPRequest request5("GET", "/file", HTTPMessage::HTTP_1_1);
+	request5.set("Range", "bytes=16-20");
+	cs.sendRequest(request5);
+	HTTPResponse response5;
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response5), rbody);
+	assert (response5.getStatus() == HTTPResponse::HTTP_REQUESTED_RANGE_NOT_SATISFIABLE);
+	assert (response5.get("Content-Range") == "bytes */16");
+	assert (rbody.empty());
+
+	HTTPRequest request6("GET", "/file", HTTPMessage::HTTP_1_1);
+	request6.set("Range", "bytes=0-1,4-5");
+	cs.sendRequest(request6);
+	HTTPResponse response6;
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response6), rbody);
+	assert (response6.getStatus() == HTTPResponse::HTTP_OK);
+	assert (!response6.has("Content-Range"));
+	assert (rbody == data);
+}
+
+
 void HTTPServerTest::setUp()
 {
 }
@@ -575,6 +735,8 @@ CppUnit::Test* HTTPServerTest::suite()
 	CppUnit_addTest(pSuite, HTTPServerTest, testAuth);
 	CppUnit_addTest(pSuite, HTTPServerTest, testNotImpl);
 	CppUnit_addTest(pSuite, HTTPServerTest, testBuffer);
+	CppUnit_addTest(pSuite, HTTPServerTest, testFile);
+	CppUnit_addTest(pSuite, HTTPServerTest, testFileRange);
 
 	return pSuite;
 }
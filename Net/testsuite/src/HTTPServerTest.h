@@ -60,6 +60,8 @@ public:
 	void testAuth();
 	void testNotImpl();
 	void testBuffer();
+	void testFile();
+	void testFileRange();
 
 	void setUp();
 	void tearDown();
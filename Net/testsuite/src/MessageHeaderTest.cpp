@@ -35,12 +35,42 @@
 #include "CppUnit/TestSuite.h"
 #include "Poco/Net/MessageHeader.h"
 #include "Poco/Net/NetException.h"
+#include "Poco/Exception.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Stopwatch.h"
 #include <sstream>
+#include <iostream>
 
 
 using Poco::Net::MessageHeader;
 using Poco::Net::NameValueCollection;
 using Poco::Net::MessageException;
+using Poco::Stopwatch;
+
+
+namespace
+{
+	class TimeoutStreamBuf: public std::streambuf
+		/// A stream buffer that delivers the given data, then
+		/// throws a Poco::TimeoutException, like a socket would.
+	{
+	public:
+		TimeoutStreamBuf(const std::string& data):
+			_data(data)
+		{
+			setg(&_data[0], &_data[0], &_data[0] + _data.size());
+		}
+
+	protected:
+		int_type underflow()
+		{
+			throw Poco::TimeoutException();
+		}
+
+	private:
+		std::string _data;
+	};
+}
 
 
 MessageHeaderTest::MessageHeaderTest(const std::string& name): CppUnit::TestCase(name)
@@ -199,6 +229,19 @@ void MessageHeaderTest::testReadFolding5()
 }
 
 
+void MessageHeaderTest::testReadFolding6()
+{
+	std::string s("name1: value11\r\n\tvalue12\n  value13\r\nname2: value2\r\n\r\n");
+	std::istringstream istr(s);
+	MessageHeader mh;
+	mh.read(istr);
+	assert (mh.size() == 2);
+	assert (mh["name1"] == "value11\tvalue12  value13");
+	assert (mh["name2"] == "value2");
+	assert (istr.get() == '\r');
+}
+
+
 void MessageHeaderTest::testReadInvalid1()
 {
 	std::string s("name1: value1\r\nname2: value21\r\n value22\r\n value23\r\n");
@@ -233,6 +276,110 @@ void MessageHeaderTest::testReadInvalid2()
 }
 
 
+void MessageHeaderTest::testReadInvalid3()
+{
+	std::string s("name1: value1\r\n");
+	s.append(300, 'x');
+	s.append(": value2\r\n\r\n");
+	std::istringstream istr(s);
+	MessageHeader mh;
+	try
+	{
+		mh.read(istr);
+		fail("field name too long - must throw");
+	}
+	catch (MessageException&)
+	{
+	}
+}
+
+
+void MessageHeaderTest::testReadInvalid4()
+{
+	std::string s("name1: value1\r\nname2: ");
+	s.append(9000, 'x');
+	s.append("\r\n\r\n");
+	std::istringstream istr(s);
+	MessageHeader mh;
+	try
+	{
+		mh.read(istr);
+		fail("field value too long - must throw");
+	}
+	catch (MessageException&)
+	{
+	}
+}
+
+
+void MessageHeaderTest::testReadInvalid5()
+{
+	std::string s("name1: value1\r\nname2: value2\r\n");
+	for (int i = 0; i < 10; ++i)
+	{
+		s.append(" ");
+		s.append(1000, 'x');
+		s.append("\r\n");
+	}
+	s.append("\r\n");
+	std::istringstream istr(s);
+	MessageHeader mh;
+	try
+	{
+		mh.read(istr);
+		fail("folded field value too long - must throw");
+	}
+	catch (MessageException&)
+	{
+	}
+}
+
+
+void MessageHeaderTest::testReadNoCRLF()
+{
+	std::string s("name1: value1\r\nname2: value2");
+	std::istringstream istr(s);
+	MessageHeader mh;
+	mh.read(istr);
+	assert (mh.size() == 2);
+	assert (mh["name1"] == "value1");
+	assert (mh["name2"] == "value2");
+
+	std::string s2("name1: value1\r\nname2: value21\r\n value22");
+	std::istringstream istr2(s2);
+	MessageHeader mh2;
+	mh2.read(istr2);
+	assert (mh2.size() == 2);
+	assert (mh2["name2"] == "value21 value22");
+}
+
+
+void MessageHeaderTest::testReadStreamState()
+{
+	std::string s("name1: value1\r\nname2: value2");
+	std::istringstream istr(s);
+	istr.exceptions(std::ios::failbit | std::ios::eofbit);
+	MessageHeader mh;
+	mh.read(istr);
+	assert (mh.size() == 2);
+	assert (istr.exceptions() == (std::ios::failbit | std::ios::eofbit));
+	assert (istr.good());
+
+	TimeoutStreamBuf buf("name1: value1\r\nname2: val");
+	std::istream istr2(&buf);
+	MessageHeader mh2;
+	try
+	{
+		mh2.read(istr2);
+		fail("stream buffer exception must propagate");
+	}
+	catch (Poco::TimeoutException&)
+	{
+	}
+	assert (istr2.exceptions() == std::ios::goodbit);
+}
+
+
 void MessageHeaderTest::testSplitElements()
 {
 	std::string s;
@@ -382,6 +529,59 @@ void MessageHeaderTest::testFieldLimit()
 }
 
 
+void MessageHeaderTest::testDefaultFieldLimit()
+{
+	std::string s;
+	for (int i = 0; i < 100; ++i)
+	{
+		s.append("name");
+		s.append(Poco::NumberFormatter::format(i));
+		s.append(": value\r\n");
+	}
+	std::istringstream istr(s + "\r\n");
+	MessageHeader mh;
+	mh.read(istr);
+	assert (mh.size() == 100);
+
+	std::istringstream istr2(s + "name100: value\r\n\r\n");
+	MessageHeader mh2;
+	try
+	{
+		mh2.read(istr2);
+		fail("Field limit exceeded - must throw");
+	}
+	catch (MessageException&)
+	{
+	}
+}
+
+
+void MessageHeaderTest::benchmarkRead()
+{
+	std::string s(
+		"Host: www.appinf.com\r\n"
+		"User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:24.0) Gecko/20100101 Firefox/24.0\r\n"
+		"Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+		"Accept-Language: en-US,en;q=0.5\r\n"
+		"Accept-Encoding: gzip, deflate\r\n"
+		"Cookie: session=0123456789abcdef0123456789abcdef; theme=light\r\n"
+		"Connection: keep-alive\r\n"
+		"Cache-Control: max-age=0\r\n"
+		"\r\n");
+	const int iterations = 100000;
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < iterations; ++i)
+	{
+		std::istringstream istr(s);
+		MessageHeader mh;
+		mh.read(istr);
+	}
+	sw.stop();
+	std::cout << std::endl << "MessageHeader::read(): " << iterations << " headers in " << sw.elapsed()/1000 << " ms" << std::endl;
+}
+
+
 void MessageHeaderTest::setUp()
 {
 }
@@ -407,11 +607,19 @@ CppUnit::Test* MessageHeaderTest::suite()
 	CppUnit_addTest(pSuite, MessageHeaderTest, testReadFolding3);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testReadFolding4);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testReadFolding5);
+	CppUnit_addTest(pSuite, MessageHeaderTest, testReadFolding6);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testReadInvalid1);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testReadInvalid2);
+	CppUnit_addTest(pSuite, MessageHeaderTest, testReadInvalid3);
+	CppUnit_addTest(pSuite, MessageHeaderTest, testReadInvalid4);
+	CppUnit_addTest(pSuite, MessageHeaderTest, testReadInvalid5);
+	CppUnit_addTest(pSuite, MessageHeaderTest, testReadNoCRLF);
+	CppUnit_addTest(pSuite, MessageHeaderTest, testReadStreamState);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testSplitElements);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testSplitParameters);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testFieldLimit);
+	CppUnit_addTest(pSuite, MessageHeaderTest, testDefaultFieldLimit);
+	//CppUnit_addTest(pSuite, MessageHeaderTest, benchmarkRead);
 
 	return pSuite;
 }
@@ -57,11 +57,19 @@ public:
 	void testReadFolding3();
 	void testReadFolding4();
 	void testReadFolding5();
+	void testReadFolding6();
 	void testReadInvalid1();
 	void testReadInvalid2();
+	void testReadInvalid3();
+	void testReadInvalid4();
+	void testReadInvalid5();
+	void testReadNoCRLF();
+	void testReadStreamState();
 	void testSplitElements();
 	void testSplitParameters();
 	void testFieldLimit();
+	void testDefaultFieldLimit();
+	void benchmarkRead();
 
 	void setUp();
 	void tearDown();
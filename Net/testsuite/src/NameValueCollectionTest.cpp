@@ -128,6 +128,40 @@ void NameValueCollectionTest::testNameValueCollection()
 }
 
 
+void NameValueCollectionTest::testOrder()
+{
+	NameValueCollection nvc;
+	nvc.add("Name2", "value21");
+	nvc.add("name1", "value1");
+	nvc.add("NAME3", "value3");
+	nvc.add("name2", "value22");
+	nvc.set("NAME2", "value23");
+	
+	assert (nvc.size() == 4);
+	
+	NameValueCollection::ConstIterator it = nvc.begin();
+	assert (it->first == "name1" && it->second == "value1");
+	++it;
+	assert (it->first == "Name2" && it->second == "value23");
+	++it;
+	assert (it->first == "name2" && it->second == "value22");
+	++it;
+	assert (it->first == "NAME3" && it->second == "value3");
+	++it;
+	assert (it == nvc.end());
+	
+	it = nvc.find("name2");
+	assert (it != nvc.end() && it->second == "value23");
+	
+	nvc.erase("Name2");
+	assert (nvc.size() == 2);
+	assert (nvc.find("name1") == nvc.begin());
+	assert (nvc["name3"] == "value3");
+	assert (nvc.find("name0") == nvc.end());
+	assert (nvc.find("name4") == nvc.end());
+}
+
+
 void NameValueCollectionTest::setUp()
 {
 }
@@ -143,6 +177,7 @@ CppUnit::Test* NameValueCollectionTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("NameValueCollectionTest");
 
 	CppUnit_addTest(pSuite, NameValueCollectionTest, testNameValueCollection);
+	CppUnit_addTest(pSuite, NameValueCollectionTest, testOrder);
 
 	return pSuite;
 }
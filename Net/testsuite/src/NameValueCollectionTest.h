@@ -47,6 +47,7 @@ public:
 	~NameValueCollectionTest();
 
 	void testNameValueCollection();
+	void testOrder();
 
 	void setUp();
 	void tearDown();
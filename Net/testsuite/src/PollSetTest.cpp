@@ -0,0 +1,249 @@
+//
+// PollSetTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "PollSetTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "EchoServer.h"
+#include "Poco/Net/PollSet.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Timespan.h"
+#include "Poco/Stopwatch.h"
+
+
+using Poco::Net::Socket;
+using Poco::Net::StreamSocket;
+using Poco::Net::SocketAddress;
+using Poco::Net::PollSet;
+using Poco::Timespan;
+using Poco::Stopwatch;
+
+
+PollSetTest::PollSetTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+PollSetTest::~PollSetTest()
+{
+}
+
+
+void PollSetTest::testPoll()
+{
+	Timespan timeout(1000000);
+
+	EchoServer echoServer1;
+	EchoServer echoServer2;
+	StreamSocket ss1(SocketAddress("localhost", echoServer1.port()));
+	StreamSocket ss2(SocketAddress("localhost", echoServer2.port()));
+
+	PollSet ps;
+	assert (ps.empty());
+	ps.add(ss1, PollSet::POLL_READ);
+	assert (!ps.empty());
+	assert (ps.has(ss1));
+	assert (!ps.has(ss2));
+
+	// nothing readable
+	Stopwatch sw;
+	sw.start();
+	timeout = Timespan(100000);
+	PollSet::SocketModeMap sm = ps.poll(timeout);
+	assert (sm.empty());
+	assert (sw.elapsed() >= 90000);
+	sw.restart();
+
+	ps.add(ss2, PollSet::POLL_READ);
+	assert (ps.has(ss2));
+
+	// ss1 must be writable, if polled for
+	ps.update(ss1, PollSet::POLL_READ | PollSet::POLL_WRITE);
+	sm = ps.poll(timeout);
+	assert (sm.find(ss1) != sm.end());
+	assert (sm.find(ss2) == sm.end());
+	assert (sm.find(ss1)->second == PollSet::POLL_WRITE);
+	assert (sw.elapsed() < 100000);
+
+	ps.update(ss1, PollSet::POLL_READ);
+
+	ss1.sendBytes("hello", 5);
+	char buffer[256];
+	sw.restart();
+	sm = ps.poll(timeout);
+	assert (sm.find(ss1) != sm.end());
+	assert (sm.find(ss2) == sm.end());
+	assert (sm.find(ss1)->second == PollSet::POLL_READ);
+	assert (sw.elapsed() < 100000);
+
+	int n = ss1.receiveBytes(buffer, sizeof(buffer));
+	assert (n == 5);
+	assert (std::string(buffer, n) == "hello");
+
+	ss2.sendBytes("HELLO", 5);
+	sw.restart();
+	sm = ps.poll(timeout);
+	assert (sm.find(ss1) == sm.end());
+	assert (sm.find(ss2) != sm.end());
+	assert (sm.find(ss2)->second == PollSet::POLL_READ);
+	assert (sw.elapsed() < 100000);
+
+	n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assert (n == 5);
+	assert (std::string(buffer, n) == "HELLO");
+
+	ps.remove(ss2);
+	assert (!ps.has(ss2));
+
+	ss2.sendBytes("HELLO", 5);
+	sw.restart();
+	sm = ps.poll(timeout);
+	assert (sm.empty());
+
+	n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assert (n == 5);
+	assert (std::string(buffer, n) == "HELLO");
+
+	ss1.close();
+	ss2.close();
+}
+
+
+void PollSetTest::testPollEmpty()
+{
+	PollSet ps;
+	assert (ps.empty());
+
+	PollSet::SocketModeMap sm = ps.poll(Timespan(1000));
+	assert (sm.empty());
+}
+
+
+void PollSetTest::testPollUpdate()
+{
+	Timespan timeout(100000);
+
+	EchoServer echoServer;
+	StreamSocket ss(SocketAddress("localhost", echoServer.port()));
+
+	PollSet ps;
+	ps.add(ss, PollSet::POLL_WRITE);
+	PollSet::SocketModeMap sm = ps.poll(timeout);
+	assert (sm.size() == 1);
+	assert (sm.begin()->second == PollSet::POLL_WRITE);
+
+	ps.update(ss, PollSet::POLL_READ);
+	sm = ps.poll(timeout);
+	assert (sm.empty());
+
+	ps.clear();
+	assert (ps.empty());
+	assert (!ps.has(ss));
+
+	ss.close();
+}
+
+
+void PollSetTest::testPollClosed()
+{
+	Timespan timeout(100000);
+
+	EchoServer echoServer;
+	StreamSocket ss1(SocketAddress("localhost", echoServer.port()));
+	StreamSocket ss2;
+	ss1.close();
+
+	PollSet ps;
+	ps.add(ss1, PollSet::POLL_READ);
+	ps.add(ss2, PollSet::POLL_READ | PollSet::POLL_WRITE);
+	assert (ps.has(ss1));
+	assert (ps.has(ss2));
+	PollSet::SocketModeMap sm = ps.poll(timeout);
+	assert (sm.empty());
+
+	ps.remove(ss1);
+	ps.remove(ss2);
+	assert (ps.empty());
+}
+
+
+void PollSetTest::testPollHangup()
+{
+	Timespan timeout(100000);
+
+	// An unconnected socket is hung up, which must not be
+	// reported to a socket that only waits for errors.
+	StreamSocket ss(Poco::Net::IPAddress::IPv4);
+
+	PollSet ps;
+	ps.add(ss, PollSet::POLL_ERROR);
+	for (int i = 0; i < 2; ++i)
+	{
+		Stopwatch sw;
+		sw.start();
+		PollSet::SocketModeMap sm = ps.poll(timeout);
+		assert (sm.empty());
+		assert (sw.elapsed() >= 90000);
+	}
+
+	ps.update(ss, PollSet::POLL_READ);
+	PollSet::SocketModeMap sm = ps.poll(timeout);
+	assert (sm.size() == 1);
+	assert (sm.begin()->second == PollSet::POLL_READ);
+
+	ss.close();
+}
+
+
+void PollSetTest::setUp()
+{
+}
+
+
+void PollSetTest::tearDown()
+{
+}
+
+
+CppUnit::Test* PollSetTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("PollSetTest");
+
+	CppUnit_addTest(pSuite, PollSetTest, testPoll);
+	CppUnit_addTest(pSuite, PollSetTest, testPollEmpty);
+	CppUnit_addTest(pSuite, PollSetTest, testPollUpdate);
+	CppUnit_addTest(pSuite, PollSetTest, testPollClosed);
+	CppUnit_addTest(pSuite, PollSetTest, testPollHangup);
+
+	return pSuite;
+}
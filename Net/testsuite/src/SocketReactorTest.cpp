@@ -38,18 +38,24 @@
 #include "Poco/Net/SocketConnector.h"
 #include "Poco/Net/SocketAcceptor.h"
 #include "Poco/Net/ParallelSocketAcceptor.h"
+#include "Poco/Net/ReusePortSocketAcceptor.h"
 #include "Poco/Net/StreamSocket.h"
 #include "Poco/Net/ServerSocket.h"
 #include "Poco/Net/SocketAddress.h"
 #include "Poco/Observer.h"
 #include "Poco/Exception.h"
+#include "Poco/Mutex.h"
+#include "Poco/Thread.h"
 #include <sstream>
+#include <vector>
+#include <set>
 
 
 using Poco::Net::SocketReactor;
 using Poco::Net::SocketConnector;
 using Poco::Net::SocketAcceptor;
 using Poco::Net::ParallelSocketAcceptor;
+using Poco::Net::ReusePortSocketAcceptor;
 using Poco::Net::StreamSocket;
 using Poco::Net::ServerSocket;
 using Poco::Net::SocketAddress;
@@ -270,6 +276,65 @@ namespace
 	bool ClientServiceHandler::_once = false;
 	
 	
+	class CountingServiceHandler
+		/// Counts the connections and the reactors they have
+		/// been accepted by.
+	{
+	public:
+		CountingServiceHandler(StreamSocket& socket, SocketReactor& reactor):
+			_socket(socket),
+			_reactor(reactor)
+		{
+			{
+				Poco::FastMutex::ScopedLock lock(_mutex);
+				++_connections;
+				_reactors.insert(&reactor);
+			}
+			_reactor.addEventHandler(_socket, Observer<CountingServiceHandler, ReadableNotification>(*this, &CountingServiceHandler::onReadable));
+		}
+
+		~CountingServiceHandler()
+		{
+			_reactor.removeEventHandler(_socket, Observer<CountingServiceHandler, ReadableNotification>(*this, &CountingServiceHandler::onReadable));
+		}
+
+		void onReadable(ReadableNotification* pNf)
+		{
+			pNf->release();
+			char buffer[8];
+			if (_socket.receiveBytes(buffer, sizeof(buffer)) <= 0)
+			{
+				delete this;
+			}
+		}
+
+		static int connections()
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			return _connections;
+		}
+
+		static std::size_t reactors()
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			return _reactors.size();
+		}
+
+	private:
+		StreamSocket   _socket;
+		SocketReactor& _reactor;
+
+		static Poco::FastMutex            _mutex;
+		static int                        _connections;
+		static std::set<SocketReactor*>   _reactors;
+	};
+
+
+	Poco::FastMutex CountingServiceHandler::_mutex;
+	int CountingServiceHandler::_connections = 0;
+	std::set<SocketReactor*> CountingServiceHandler::_reactors;
+
+
 	class FailConnector: public SocketConnector<ClientServiceHandler>
 	{
 	public:
@@ -369,6 +434,58 @@ void SocketReactorTest::testParallelSocketReactor()
 }
 
 
+void SocketReactorTest::testReusePortSocketAcceptor()
+{
+	SocketAddress ssa;
+	ReusePortSocketAcceptor<EchoServiceHandler> acceptor(ssa, 2);
+	assert (acceptor.threads() == 2);
+	SocketReactor reactor;
+	SocketAddress sa("localhost", acceptor.address().port());
+	SocketConnector<ClientServiceHandler> connector1(sa, reactor);
+	SocketConnector<ClientServiceHandler> connector2(sa, reactor);
+	SocketConnector<ClientServiceHandler> connector3(sa, reactor);
+	SocketConnector<ClientServiceHandler> connector4(sa, reactor);
+	ClientServiceHandler::setOnce(false);
+	ClientServiceHandler::resetData();
+	reactor.run();
+	std::string data(ClientServiceHandler::data());
+	assert (data.size() == 4096);
+	assert (!ClientServiceHandler::readableError());
+	assert (!ClientServiceHandler::writableError());
+	assert (!ClientServiceHandler::timeoutError());
+}
+
+
+void SocketReactorTest::testReusePortDistribution()
+{
+	const int N = 32;
+
+	SocketAddress ssa;
+	ReusePortSocketAcceptor<CountingServiceHandler> acceptor(ssa, 4);
+	SocketAddress sa("localhost", acceptor.address().port());
+	std::vector<StreamSocket> sockets;
+	for (int i = 0; i < N; ++i)
+	{
+		sockets.push_back(StreamSocket(sa));
+	}
+	for (int i = 0; i < 100 && CountingServiceHandler::connections() < N; ++i)
+	{
+		Poco::Thread::sleep(50);
+	}
+	assert (CountingServiceHandler::connections() == N);
+#if POCO_OS == POCO_OS_LINUX
+	// the kernel distributes connections among the listening
+	// sockets; the chance that all N connections go to the same
+	// one of the four sockets is 4^(1 - N).
+	assert (CountingServiceHandler::reactors() > 1);
+#endif
+	for (std::vector<StreamSocket>::iterator it = sockets.begin(); it != sockets.end(); ++it)
+	{
+		it->close();
+	}
+}
+
+
 void SocketReactorTest::testSocketConnectorFail()
 {
 	SocketReactor reactor;
@@ -414,6 +531,8 @@ CppUnit::Test* SocketReactorTest::suite()
 
 	CppUnit_addTest(pSuite, SocketReactorTest, testSocketReactor);
 	CppUnit_addTest(pSuite, SocketReactorTest, testParallelSocketReactor);
+	CppUnit_addTest(pSuite, SocketReactorTest, testReusePortSocketAcceptor);
+	CppUnit_addTest(pSuite, SocketReactorTest, testReusePortDistribution);
 	CppUnit_addTest(pSuite, SocketReactorTest, testSocketConnectorFail);
 	CppUnit_addTest(pSuite, SocketReactorTest, testSocketConnectorTimeout);
 
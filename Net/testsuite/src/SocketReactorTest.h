@@ -48,6 +48,8 @@ public:
 
 	void testSocketReactor();
 	void testParallelSocketReactor();
+	void testReusePortSocketAcceptor();
+	void testReusePortDistribution();
 	void testSocketConnectorFail();
 	void testSocketConnectorTimeout();
 
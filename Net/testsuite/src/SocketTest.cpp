@@ -50,6 +50,7 @@ using Poco::Net::Socket;
 using Poco::Net::StreamSocket;
 using Poco::Net::ServerSocket;
 using Poco::Net::SocketAddress;
+using Poco::Net::SocketBufVec;
 using Poco::Net::ConnectionRefusedException;
 using Poco::Timespan;
 using Poco::Stopwatch;
@@ -85,6 +86,32 @@ void SocketTest::testEcho()
 }
 
 
+void SocketTest::testSendBufVec()
+{
+	EchoServer echoServer;
+	StreamSocket ss;
+	ss.connect(SocketAddress("localhost", echoServer.port()));
+	std::string header("HEADER ");
+	std::string body("hello, world");
+	SocketBufVec buffers;
+	buffers.push_back(Socket::makeBuffer(header.data(), header.size()));
+	buffers.push_back(Socket::makeBuffer(body.data(), 0));
+	buffers.push_back(Socket::makeBuffer(body.data(), body.size()));
+	int n = ss.sendBytes(buffers);
+	assert (n == 19);
+	char buffer[256];
+	int received = 0;
+	while (received < n)
+	{
+		int rc = ss.receiveBytes(buffer + received, sizeof(buffer) - received);
+		assert (rc > 0);
+		received += rc;
+	}
+	assert (std::string(buffer, received) == "HEADER hello, world");
+	ss.close();
+}
+
+
 void SocketTest::testPoll()
 {
 	EchoServer echoServer;
@@ -554,6 +581,7 @@ CppUnit::Test* SocketTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("SocketTest");
 
 	CppUnit_addTest(pSuite, SocketTest, testEcho);
+	CppUnit_addTest(pSuite, SocketTest, testSendBufVec);
 	CppUnit_addTest(pSuite, SocketTest, testPoll);
 	CppUnit_addTest(pSuite, SocketTest, testAvailable);
 	CppUnit_addTest(pSuite, SocketTest, testFIFOBuffer);
@@ -47,6 +47,7 @@ public:
 	~SocketTest();
 
 	void testEcho();
+	void testSendBufVec();
 	void testPoll();
 	void testAvailable();
 	void testFIFOBuffer();
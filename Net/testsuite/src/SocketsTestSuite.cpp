@@ -37,6 +37,7 @@
 #include "MulticastSocketTest.h"
 #include "DialogSocketTest.h"
 #include "RawSocketTest.h"
+#include "PollSetTest.h"
 
 
 CppUnit::Test* SocketsTestSuite::suite()
@@ -48,6 +49,7 @@ CppUnit::Test* SocketsTestSuite::suite()
 	pSuite->addTest(DatagramSocketTest::suite());
 	pSuite->addTest(DialogSocketTest::suite());
 	pSuite->addTest(RawSocketTest::suite());
+	pSuite->addTest(PollSetTest::suite());
 #ifdef POCO_NET_HAS_INTERFACE
 	pSuite->addTest(MulticastSocketTest::suite());
 #endif
@@ -40,6 +40,7 @@
 #include "Poco/Net/StreamSocket.h"
 #include "Poco/Net/ServerSocket.h"
 #include "Poco/Thread.h"
+#include "Poco/WorkStealingThreadPool.h"
 #include <iostream>
 
 
@@ -52,6 +53,7 @@ using Poco::Net::StreamSocket;
 using Poco::Net::ServerSocket;
 using Poco::Net::SocketAddress;
 using Poco::Thread;
+using Poco::WorkStealingThreadPool;
 
 
 namespace
@@ -255,6 +257,134 @@ void TCPServerTest::testMultiConnections()
 }
 
 
+void TCPServerTest::testLockFreeQueue()
+{
+	ServerSocket svs(0);
+	TCPServerParams* pParams = new TCPServerParams;
+	pParams->setMaxThreads(4);
+	pParams->setMaxQueued(4);
+	pParams->setThreadIdleTime(100);
+	pParams->setLockFreeQueue(true);
+	TCPServer srv(new TCPServerConnectionFactoryImpl<EchoConnection>(), svs, pParams);
+	srv.start();
+	assert (srv.currentConnections() == 0);
+	assert (srv.currentThreads() == 0);
+	assert (srv.queuedConnections() == 0);
+	assert (srv.totalConnections() == 0);
+	
+	SocketAddress sa("localhost", svs.address().port());
+	StreamSocket ss1(sa);
+	StreamSocket ss2(sa);
+	StreamSocket ss3(sa);
+	StreamSocket ss4(sa);
+	std::string data("hello, world");
+	ss1.sendBytes(data.data(), (int) data.size());
+	ss2.sendBytes(data.data(), (int) data.size());
+	ss3.sendBytes(data.data(), (int) data.size());
+	ss4.sendBytes(data.data(), (int) data.size());
+
+	char buffer[256];
+	int n = ss1.receiveBytes(buffer, sizeof(buffer));
+	assert (n > 0);
+	assert (std::string(buffer, n) == data);
+
+	n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assert (n > 0);
+	assert (std::string(buffer, n) == data);
+
+	n = ss3.receiveBytes(buffer, sizeof(buffer));
+	assert (n > 0);
+	assert (std::string(buffer, n) == data);
+
+	n = ss4.receiveBytes(buffer, sizeof(buffer));
+	assert (n > 0);
+	assert (std::string(buffer, n) == data);
+	
+	assert (srv.currentConnections() == 4);
+	assert (srv.currentThreads() == 4);
+	assert (srv.queuedConnections() == 0);
+	assert (srv.totalConnections() == 4);
+	
+	StreamSocket ss5(sa);
+	Thread::sleep(200);
+	assert (srv.queuedConnections() == 1);
+	StreamSocket ss6(sa);
+	Thread::sleep(200);
+	assert (srv.queuedConnections() == 2);
+	
+	ss1.close();
+	Thread::sleep(300);
+	assert (srv.currentConnections() == 4);
+	assert (srv.currentThreads() == 4);
+	assert (srv.queuedConnections() == 1);
+	assert (srv.totalConnections() == 5);
+
+	ss2.close();
+	Thread::sleep(300);
+	assert (srv.currentConnections() == 4);
+	assert (srv.currentThreads() == 4);
+	assert (srv.queuedConnections() == 0);
+	assert (srv.totalConnections() == 6);
+	
+	ss3.close();
+	Thread::sleep(300);
+	assert (srv.currentConnections() == 3);
+	assert (srv.currentThreads() == 3);
+	assert (srv.queuedConnections() == 0);
+	assert (srv.totalConnections() == 6);
+
+	ss4.close();
+	Thread::sleep(300);
+	assert (srv.currentConnections() == 2);
+	assert (srv.currentThreads() == 2);
+	assert (srv.queuedConnections() == 0);
+	assert (srv.totalConnections() == 6);
+
+	ss5.close();
+	ss6.close();
+	Thread::sleep(300);
+	assert (srv.currentConnections() == 0);
+}
+
+
+void TCPServerTest::testWorkStealingPool()
+{
+	WorkStealingThreadPool pool(2);
+	ServerSocket svs(0);
+	TCPServer srv(new TCPServerConnectionFactoryImpl<EchoConnection>(), pool, svs);
+	srv.start();
+	assert (srv.currentConnections() == 0);
+	assert (srv.currentThreads() == 0);
+	
+	SocketAddress sa("localhost", svs.address().port());
+	StreamSocket ss1(sa);
+	StreamSocket ss2(sa);
+	std::string data("hello, world");
+	ss1.sendBytes(data.data(), (int) data.size());
+	ss2.sendBytes(data.data(), (int) data.size());
+
+	char buffer[256];
+	int n = ss1.receiveBytes(buffer, sizeof(buffer));
+	assert (n > 0);
+	assert (std::string(buffer, n) == data);
+
+	n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assert (n > 0);
+	assert (std::string(buffer, n) == data);
+
+	assert (srv.currentConnections() == 2);
+	assert (srv.currentThreads() == 2);
+	assert (srv.totalConnections() == 2);
+	assert (pool.used() == 2);
+	
+	ss1.close();
+	ss2.close();
+	Thread::sleep(300);
+	assert (srv.currentConnections() == 0);
+	srv.stop();
+}
+
+
 void TCPServerTest::setUp()
 {
 }
@@ -272,6 +402,8 @@ CppUnit::Test* TCPServerTest::suite()
 	CppUnit_addTest(pSuite, TCPServerTest, testOneConnection);
 	CppUnit_addTest(pSuite, TCPServerTest, testTwoConnections);
 	CppUnit_addTest(pSuite, TCPServerTest, testMultiConnections);
+	CppUnit_addTest(pSuite, TCPServerTest, testLockFreeQueue);
+	CppUnit_addTest(pSuite, TCPServerTest, testWorkStealingPool);
 
 	return pSuite;
 }
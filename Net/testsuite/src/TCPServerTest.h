@@ -49,6 +49,8 @@ public:
 	void testOneConnection();
 	void testTwoConnections();
 	void testMultiConnections();
+	void testLockFreeQueue();
+	void testWorkStealingPool();
 
 	void setUp();
 	void tearDown();
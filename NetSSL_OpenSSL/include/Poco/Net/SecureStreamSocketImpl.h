@@ -228,6 +228,9 @@ protected:
 	~SecureStreamSocketImpl();
 		/// Destroys the SecureStreamSocketImpl.
 
+	bool supportsZeroCopy() const;
+		/// Returns false, since all data must be encrypted.
+
 	static int lastError();
 	static void error();
 	static void error(const std::string& arg);
@@ -43,6 +43,7 @@
 #include "Poco/Util/Util.h"
 #include "Poco/Util/TimerTask.h"
 #include "Poco/TimedNotificationQueue.h"
+#include "Poco/Timespan.h"
 #include "Poco/Thread.h"
 #include "Poco/Runnable.h"
 
@@ -51,6 +52,9 @@ namespace Poco {
 namespace Util {
 
 
+class TimerQueue;
+
+
 class Util_API Timer: protected Poco::Runnable
 	/// A Timer allows to schedule tasks (TimerTask objects) for future execution 
 	/// in a background thread. Tasks may be scheduled for one-time execution, 
@@ -63,6 +67,15 @@ class Util_API Timer: protected Poco::Runnable
 	/// Timer is save for multithreaded use - multiple threads can schedule
 	/// new tasks simultaneously.
 	///
+	/// By default, tasks are kept in a TimedNotificationQueue, and are
+	/// executed in order of their scheduled time. A Timer can also use
+	/// a TimingWheel with a given tick resolution instead. Scheduling a
+	/// task, and cancelling it with TimerTask::cancel(), then takes constant
+	/// time, which is preferable for large numbers of tasks (e.g., timeouts
+	/// that are mostly cancelled before they expire).
+	/// Tasks are then executed up to one tick late, and tasks scheduled for
+	/// the same tick may be executed in any order.
+	///
 	/// Acknowledgement: The interface of this class has been inspired by
 	/// the java.util.Timer class from Java 1.3.
 {
@@ -73,6 +86,10 @@ public:
 	explicit Timer(Poco::Thread::Priority priority);
 		/// Creates the Timer, using a timer thread with
 		/// the given priority.
+
+	explicit Timer(const Poco::Timespan& resolution, Poco::Thread::Priority priority = Poco::Thread::PRIO_NORMAL);
+		/// Creates the Timer, using a TimingWheel with the given
+		/// tick resolution and a timer thread with the given priority.
 	
 	~Timer();
 		/// Destroys the Timer, cancelling all pending tasks.
@@ -135,8 +152,10 @@ private:
 	Timer(const Timer&);
 	Timer& operator = (const Timer&);
 	
-	Poco::TimedNotificationQueue _queue;
+	TimerQueue* _pQueue;
 	Poco::Thread _thread;
+
+	friend class TimerNotification;
 };
 
 
@@ -45,6 +45,8 @@
 #include "Poco/RefCountedObject.h"
 #include "Poco/AutoPtr.h"
 #include "Poco/Timestamp.h"
+#include "Poco/TimingWheel.h"
+#include "Poco/Mutex.h"
 
 
 namespace Poco {
@@ -71,6 +73,9 @@ public:
 		/// If the task has been scheduled for repeated execution, it will never 
 		/// run again. If the task is running when this call occurs, the task 
 		/// will run to completion, but will never run again.	
+		///
+		/// If the task has been scheduled by a Timer using a TimingWheel,
+		/// it is also removed from the wheel.
 	
 	bool isCancelled() const;
 		/// Returns true iff the TimerTask has been cancelled by a call
@@ -89,10 +94,15 @@ private:
 	TimerTask(const TimerTask&);
 	TimerTask& operator = (const TimerTask&);
 	
+	void setEntry(Poco::TimingWheel::Entry::Ptr pEntry);
+	
 	Poco::Timestamp _lastExecution;
 	bool _isCancelled;
+	Poco::TimingWheel::Entry::Ptr _pEntry;
+	Poco::FastMutex _mutex;
 	
 	friend class TaskNotification;
+	friend class TimingWheelTimerQueue;
 };
 
 
@@ -36,6 +36,7 @@
 
 #include "Poco/Util/Timer.h"
 #include "Poco/Notification.h"
+#include "Poco/TimingWheel.h"
 #include "Poco/ErrorHandler.h"
 #include "Poco/Event.h"
 
@@ -47,11 +48,95 @@ namespace Poco {
 namespace Util {
 
 
+class TimerQueue
+	/// The queue holding the notifications of a Timer.
+{
+public:
+	virtual ~TimerQueue()
+	{
+	}
+
+	virtual void enqueue(Poco::Notification::Ptr pNotification, const Poco::Timestamp& time, TimerTask* pTask) = 0;
+		/// Enqueues a notification for the given time. If the
+		/// notification executes a task, pTask points to it.
+
+	virtual void enqueueUrgent(Poco::Notification::Ptr pNotification) = 0;
+		/// Enqueues a notification that must be executed
+		/// before all expired tasks.
+
+	virtual Poco::Notification* waitDequeue() = 0;
+	virtual void clear() = 0;
+};
+
+
+class TimedNotificationTimerQueue: public TimerQueue
+{
+public:
+	void enqueue(Poco::Notification::Ptr pNotification, const Poco::Timestamp& time, TimerTask*)
+	{
+		_queue.enqueueNotification(pNotification, time);
+	}
+
+	void enqueueUrgent(Poco::Notification::Ptr pNotification)
+	{
+		_queue.enqueueNotification(pNotification, 0);
+	}
+
+	Poco::Notification* waitDequeue()
+	{
+		return _queue.waitDequeueNotification();
+	}
+
+	void clear()
+	{
+		_queue.clear();
+	}
+
+private:
+	Poco::TimedNotificationQueue _queue;
+};
+
+
+class TimingWheelTimerQueue: public TimerQueue
+{
+public:
+	TimingWheelTimerQueue(const Poco::Timespan& resolution):
+		_wheel(resolution)
+	{
+	}
+
+	void enqueue(Poco::Notification::Ptr pNotification, const Poco::Timestamp& time, TimerTask* pTask)
+	{
+		Poco::TimingWheel::Entry::Ptr pEntry = _wheel.schedule(pNotification, time);
+		// lets TimerTask::cancel() remove the task from the wheel
+		if (pTask) pTask->setEntry(pEntry);
+	}
+
+	void enqueueUrgent(Poco::Notification::Ptr pNotification)
+	{
+		_wheel.enqueueUrgentNotification(pNotification);
+	}
+
+	Poco::Notification* waitDequeue()
+	{
+		return _wheel.waitDequeueNotification();
+	}
+
+	void clear()
+	{
+		_wheel.clear();
+	}
+
+private:
+	Poco::TimingWheel _wheel;
+};
+
+
 class TimerNotification: public Poco::Notification
 {
 public:
-	TimerNotification(Poco::TimedNotificationQueue& queue):
-		_queue(queue)
+	TimerNotification(Timer& timer):
+		_timer(timer)
 	{
 	}
 	
@@ -61,21 +146,27 @@ public:
 	
 	virtual bool execute() = 0;
 	
-	Poco::TimedNotificationQueue& queue()
+protected:
+	void clearQueue()
+	{
+		_timer._pQueue->clear();
+	}
+	
+	void reschedule(const Poco::Timestamp& time, TimerTask* pTask)
 	{
-		return _queue;
+		_timer._pQueue->enqueue(Poco::Notification::Ptr(this, true), time, pTask);
 	}
 	
 private:
-	Poco::TimedNotificationQueue& _queue;
+	Timer& _timer;
 };
 
 
 class StopNotification: public TimerNotification
 {
 public:
-	StopNotification(Poco::TimedNotificationQueue& queue):
-		TimerNotification(queue)
+	StopNotification(Timer& timer):
+		TimerNotification(timer)
 	{
 	}
 	
@@ -85,7 +176,7 @@ public:
 	
 	bool execute()
 	{
-		queue().clear();
+		clearQueue();
 		return false;
 	}
 };
@@ -94,8 +185,8 @@ public:
 class CancelNotification: public TimerNotification
 {
 public:
-	CancelNotification(Poco::TimedNotificationQueue& queue):
-		TimerNotification(queue)
+	CancelNotification(Timer& timer):
+		TimerNotification(timer)
 	{
 	}
 	
@@ -105,7 +196,7 @@ public:
 	
 	bool execute()
 	{
-		queue().clear();
+		clearQueue();
 		_finished.set();
 		return true;
 	}
@@ -123,8 +214,8 @@ private:
 class TaskNotification: public TimerNotification
 {
 public:
-	TaskNotification(Poco::TimedNotificationQueue& queue, TimerTask::Ptr pTask):
-		TimerNotification(queue),
+	TaskNotification(Timer& timer, TimerTask::Ptr pTask):
+		TimerNotification(timer),
 		_pTask(pTask)
 	{
 	}
@@ -171,8 +262,8 @@ private:
 class PeriodicTaskNotification: public TaskNotification
 {
 public:
-	PeriodicTaskNotification(Poco::TimedNotificationQueue& queue, TimerTask::Ptr pTask, long interval):
-		TaskNotification(queue, pTask),
+	PeriodicTaskNotification(Timer& timer, TimerTask::Ptr pTask, long interval):
+		TaskNotification(timer, pTask),
 		_interval(interval)
 	{
 	}
@@ -191,8 +282,7 @@ public:
 			Poco::Timestamp nextExecution;
 			nextExecution += static_cast<Poco::Timestamp::TimeDiff>(_interval)*1000;
 			if (nextExecution < now) nextExecution = now;
-			queue().enqueueNotification(this, nextExecution);
-			duplicate();
+			reschedule(nextExecution, task());
 		}
 		return true;		
 	}
@@ -205,8 +295,8 @@ private:
 class FixedRateTaskNotification: public TaskNotification
 {
 public:
-	FixedRateTaskNotification(Poco::TimedNotificationQueue& queue, TimerTask::Ptr pTask, long interval, Poco::Timestamp time):
-		TaskNotification(queue, pTask),
+	FixedRateTaskNotification(Timer& timer, TimerTask::Ptr pTask, long interval, Poco::Timestamp time):
+		TaskNotification(timer, pTask),
 		_interval(interval),
 		_nextExecution(time)
 	{
@@ -225,8 +315,7 @@ public:
 			Poco::Timestamp now;
 			_nextExecution += static_cast<Poco::Timestamp::TimeDiff>(_interval)*1000;
 			if (_nextExecution < now) _nextExecution = now;
-			queue().enqueueNotification(this, _nextExecution);
-			duplicate();
+			reschedule(_nextExecution, task());
 		}
 		return true;			
 	}
@@ -237,13 +326,23 @@ private:
 };
 
 
-Timer::Timer()
+Timer::Timer():
+	_pQueue(new TimedNotificationTimerQueue)
 {
 	_thread.start(*this);
 }
 
 
-Timer::Timer(Poco::Thread::Priority priority)
+Timer::Timer(Poco::Thread::Priority priority):
+	_pQueue(new TimedNotificationTimerQueue)
+{
+	_thread.setPriority(priority);
+	_thread.start(*this);
+}
+
+
+Timer::Timer(const Poco::Timespan& resolution, Poco::Thread::Priority priority):
+	_pQueue(new TimingWheelTimerQueue(resolution))
 {
 	_thread.setPriority(priority);
 	_thread.start(*this);
@@ -252,15 +351,16 @@ Timer::Timer(Poco::Thread::Priority priority)
 
 Timer::~Timer()
 {
-	_queue.enqueueNotification(new StopNotification(_queue), 0);
+	_pQueue->enqueueUrgent(new StopNotification(*this));
 	_thread.join();
+	delete _pQueue;
 }
 
 	
 void Timer::cancel(bool wait)
 {
-	Poco::AutoPtr<CancelNotification> pNf = new CancelNotification(_queue);
-	_queue.enqueueNotification(pNf, 0);
+	Poco::AutoPtr<CancelNotification> pNf = new CancelNotification(*this);
+	_pQueue->enqueueUrgent(pNf);
 	if (wait)
 	{
 		pNf->wait();
@@ -270,7 +370,7 @@ void Timer::cancel(bool wait)
 
 void Timer::schedule(TimerTask::Ptr pTask, Poco::Timestamp time)
 {
-	_queue.enqueueNotification(new TaskNotification(_queue, pTask), time);
+	_pQueue->enqueue(new TaskNotification(*this, pTask), time, pTask);
 }
 
 	
@@ -284,7 +384,7 @@ void Timer::schedule(TimerTask::Ptr pTask, long delay, long interval)
 
 void Timer::schedule(TimerTask::Ptr pTask, Poco::Timestamp time, long interval)
 {
-	_queue.enqueueNotification(new PeriodicTaskNotification(_queue, pTask, interval), time);
+	_pQueue->enqueue(new PeriodicTaskNotification(*this, pTask, interval), time, pTask);
 }
 
 	
@@ -298,7 +398,7 @@ void Timer::scheduleAtFixedRate(TimerTask::Ptr pTask, long delay, long interval)
 
 void Timer::scheduleAtFixedRate(TimerTask::Ptr pTask, Poco::Timestamp time, long interval)
 {
-	_queue.enqueueNotification(new FixedRateTaskNotification(_queue, pTask, interval, time), time);
+	_pQueue->enqueue(new FixedRateTaskNotification(*this, pTask, interval, time), time, pTask);
 }
 
 
@@ -307,8 +407,9 @@ void Timer::run()
 	bool cont = true;
 	while (cont)
 	{
-		Poco::AutoPtr<TimerNotification> pNf = static_cast<TimerNotification*>(_queue.waitDequeueNotification());
-		cont = pNf->execute();
+		Poco::Notification* pNf = _pQueue->waitDequeue();
+		Poco::AutoPtr<TimerNotification> pTimerNf = static_cast<TimerNotification*>(pNf);
+		cont = pTimerNf->execute();
 	}
 }
 
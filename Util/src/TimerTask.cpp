@@ -56,6 +56,21 @@ TimerTask::~TimerTask()
 void TimerTask::cancel()
 {
 	_isCancelled = true;
+
+	Poco::TimingWheel::Entry::Ptr pEntry;
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		pEntry.swap(_pEntry);
+	}
+	if (pEntry) pEntry->cancel();
+}
+
+
+void TimerTask::setEntry(Poco::TimingWheel::Entry::Ptr pEntry)
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	if (!_isCancelled) _pEntry = pEntry;
 }
 
 
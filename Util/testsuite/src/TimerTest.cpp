@@ -35,6 +35,8 @@
 #include "CppUnit/TestSuite.h"
 #include "Poco/Util/Timer.h"
 #include "Poco/Util/TimerTaskAdapter.h"
+#include "Poco/AtomicCounter.h"
+#include <vector>
 
 
 using Poco::Util::Timer;
@@ -43,6 +45,28 @@ using Poco::Util::TimerTaskAdapter;
 using Poco::Timestamp;
 
 
+namespace
+{
+	class CountingTask: public TimerTask
+	{
+	public:
+		void run()
+		{
+			Poco::Thread::sleep(100);
+			++_count;
+		}
+		
+		int count() const
+		{
+			return _count.value();
+		}
+		
+	private:
+		Poco::AtomicCounter _count;
+	};
+}
+
+
 TimerTest::TimerTest(const std::string& name): CppUnit::TestCase(name)
 {
 }
@@ -129,6 +153,92 @@ void TimerTest::testScheduleAtFixedRate()
 }
 
 
+void TimerTest::testTimingWheel()
+{
+	Timer timer(Poco::Timespan(0, 10000));
+	
+	Timestamp time;
+	time += 500000;
+	
+	TimerTask::Ptr pTask = new TimerTaskAdapter<TimerTest>(*this, &TimerTest::onTimer);
+	timer.schedule(pTask, time);
+	
+	_event.wait();
+	assert (pTask->lastExecution() >= time);
+	assert (pTask->lastExecution().elapsed() < 130000);
+
+	time.update();
+	timer.scheduleAtFixedRate(pTask, 200, 200);
+
+	_event.wait();
+	assert (time.elapsed() >= 200000);
+	_event.wait();
+	assert (time.elapsed() >= 400000);
+
+	pTask->cancel();
+	assert (pTask->isCancelled());
+}
+
+
+void TimerTest::testTimingWheelCancel()
+{
+	Timer timer(Poco::Timespan(0, 10000));
+
+	TimerTask::Ptr pTask = new TimerTaskAdapter<TimerTest>(*this, &TimerTest::onTimer);
+	for (int i = 0; i < 1000; ++i)
+	{
+		timer.schedule(pTask, 200 + i, 1000);
+	}
+	timer.cancel(true);
+
+	Timestamp time;
+	time += 100000;
+	timer.schedule(pTask, time);
+	_event.wait();
+	assert (pTask->lastExecution() >= time);
+	assert (!_event.tryWait(500));
+}
+
+
+void TimerTest::testTimingWheelTaskCancel()
+{
+	Timer timer(Poco::Timespan(0, 10000));
+
+	std::vector<TimerTask::Ptr> tasks;
+	for (int i = 0; i < 100; ++i)
+	{
+		TimerTask::Ptr pTask = new TimerTaskAdapter<TimerTest>(*this, &TimerTest::onTimer);
+		timer.schedule(pTask, 60000 + i, 1000);
+		tasks.push_back(pTask);
+	}
+	for (std::vector<TimerTask::Ptr>::iterator it = tasks.begin(); it != tasks.end(); ++it)
+	{
+		// the task is held by the timer until it is cancelled
+		assert ((*it)->referenceCount() == 2);
+		(*it)->cancel();
+		assert ((*it)->referenceCount() == 1);
+	}
+}
+
+
+void TimerTest::testTimingWheelCancelPriority()
+{
+	Timer timer(Poco::Timespan(0, 10000));
+
+	CountingTask* pCountingTask = new CountingTask;
+	TimerTask::Ptr pTask(pCountingTask);
+	for (int i = 0; i < 5; ++i)
+	{
+		timer.schedule(pTask, Timestamp());
+	}
+	Poco::Thread::sleep(50);
+
+	// the cancellation runs before the remaining expired tasks
+	timer.cancel(true);
+	assert (pCountingTask->count() <= 1);
+}
+
+
 void TimerTest::setUp()
 {
 }
@@ -153,6 +263,10 @@ CppUnit::Test* TimerTest::suite()
 	CppUnit_addTest(pSuite, TimerTest, testSchedule);
 	CppUnit_addTest(pSuite, TimerTest, testScheduleInterval);
 	CppUnit_addTest(pSuite, TimerTest, testScheduleAtFixedRate);
+	CppUnit_addTest(pSuite, TimerTest, testTimingWheel);
+	CppUnit_addTest(pSuite, TimerTest, testTimingWheelCancel);
+	CppUnit_addTest(pSuite, TimerTest, testTimingWheelTaskCancel);
+	CppUnit_addTest(pSuite, TimerTest, testTimingWheelCancelPriority);
 
 	return pSuite;
 }
@@ -51,6 +51,10 @@ public:
 	void testSchedule();
 	void testScheduleInterval();
 	void testScheduleAtFixedRate();
+	void testTimingWheel();
+	void testTimingWheelCancel();
+	void testTimingWheelTaskCancel();
+	void testTimingWheelCancelPriority();
 
 	void setUp();
 	void tearDown();